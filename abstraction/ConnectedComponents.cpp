@@ -0,0 +1,141 @@
+#include "ConnectedComponents.h"
+
+#include "constants.h"
+#include "graph.h"
+
+#include <algorithm>
+
+const int ConnectedComponents::kNoComponent;
+
+ConnectedComponents::ConnectedComponents(int width_, int height_)
+	throw(std::invalid_argument)
+{
+	if(width_ <= 0 || height_ <= 0)
+		throw std::invalid_argument("ConnectedComponents: map dimensions must be positive");
+
+	width = width_;
+	height = height_;
+	clear();
+}
+
+ConnectedComponents::~ConnectedComponents()
+{
+}
+
+void
+ConnectedComponents::label(graph* g)
+{
+	clear();
+	for(int i=0; i<g->getNumNodes(); i++)
+	{
+		node* n = g->getNode(i);
+		addLocation(n->getLabelL(kFirstData), n->getLabelL(kFirstData+1));
+	}
+
+	edge_iterator ei = g->getEdgeIter();
+	for(edge* e = g->edgeIterNext(ei); e; e = g->edgeIterNext(ei))
+	{
+		node* from = g->getNode(e->getFrom());
+		node* to = g->getNode(e->getTo());
+		join(from->getLabelL(kFirstData), from->getLabelL(kFirstData+1),
+				to->getLabelL(kFirstData), to->getLabelL(kFirstData+1));
+	}
+	compact();
+}
+
+void
+ConnectedComponents::clear()
+{
+	labels.assign(width*height, kNoComponent);
+	size.assign(width*height, 0);
+	numComponents = 0;
+}
+
+void
+ConnectedComponents::addLocation(int x, int y)
+{
+	if(x < 0 || x >= width || y < 0 || y >= height)
+		return;
+
+	int index = x + y*width;
+	if(labels[index] == kNoComponent)
+	{
+		labels[index] = index;
+		size[index] = 1;
+	}
+}
+
+void
+ConnectedComponents::join(int x1, int y1, int x2, int y2)
+{
+	if(x1 < 0 || x1 >= width || y1 < 0 || y1 >= height ||
+	   x2 < 0 || x2 >= width || y2 < 0 || y2 >= height)
+		return;
+
+	int first = x1 + y1*width;
+	int second = x2 + y2*width;
+	if(labels[first] == kNoComponent || labels[second] == kNoComponent)
+		return;
+
+	first = find(first);
+	second = find(second);
+	if(first == second)
+		return;
+
+	// the smaller component joins the larger one
+	if(size[first] < size[second])
+		std::swap(first, second);
+	labels[second] = first;
+	size[first] += size[second];
+}
+
+// @return: the location which represents the component of index. Every
+// other location on the way is pointed at its grandparent (path halving).
+int
+ConnectedComponents::find(int index)
+{
+	while(labels[index] != index)
+	{
+		labels[index] = labels[labels[index]];
+		index = labels[index];
+	}
+	return index;
+}
+
+void
+ConnectedComponents::compact()
+{
+	std::vector<int> roots(labels.size(), kNoComponent);
+	for(unsigned int i=0; i<labels.size(); i++)
+		if(labels[i] != kNoComponent)
+			roots[i] = find(i);
+
+	// representatives are numbered in the order they are found;
+	// size is reused to hold the number given to each one
+	numComponents = 0;
+	for(unsigned int i=0; i<labels.size(); i++)
+		if(roots[i] == (int)i)
+			size[i] = numComponents++;
+
+	for(unsigned int i=0; i<labels.size(); i++)
+		if(roots[i] != kNoComponent)
+			labels[i] = size[roots[i]];
+	size.clear();
+}
+
+int
+ConnectedComponents::getComponent(int x, int y) const
+{
+	if(x < 0 || x >= width || y < 0 || y >= height)
+		return kNoComponent;
+	return labels[x + y*width];
+}
+
+bool
+ConnectedComponents::connected(node* first, node* second) const
+{
+	int c = getComponent(first->getLabelL(kFirstData),
+			first->getLabelL(kFirstData+1));
+	return c != kNoComponent && c == getComponent(
+			second->getLabelL(kFirstData), second->getLabelL(kFirstData+1));
+}
@@ -0,0 +1,76 @@
+#ifndef CONNECTEDCOMPONENTS_H
+#define CONNECTEDCOMPONENTS_H
+
+// ConnectedComponents.h
+//
+// Labels every location on a map with the connected component it belongs
+// to. Two locations with different labels cannot reach one another, so
+// a query between them can be rejected without searching.
+//
+// Components are found with union-find: locations are added one at a time
+// and joined with each neighbour they can move to. ::label does this for
+// every edge of a grid graph; callers with their own movement rules (e.g.
+// one set of labels for each agent capability) can use ::addLocation and
+// ::join directly and call ::compact when done.
+//
+// Labels are indexed by map coordinates, so any node which records its
+// location (kFirstData) can be looked up, at any level of an abstraction.
+//
+// @created: 17/10/2026
+
+#include <stdexcept>
+#include <vector>
+
+class graph;
+class node;
+class ConnectedComponents
+{
+	public:
+		static const int kNoComponent = -1;
+
+		ConnectedComponents(int width, int height) throw(std::invalid_argument);
+		~ConnectedComponents();
+
+		// Labels the locations of the nodes in g; two locations are
+		// connected if there is an edge between them. Any existing labels
+		// are discarded.
+		void label(graph* g);
+
+		// Discards all labels.
+		void clear();
+
+		// Adds a traversable location; initially in a component of its own.
+		void addLocation(int x, int y);
+
+		// Merges the components of two locations added by ::addLocation.
+		void join(int x1, int y1, int x2, int y2);
+
+		// Numbers the components from 0 to ::getNumComponents - 1. Must be
+		// called before labels are looked up.
+		void compact();
+
+		// @return: the component of the location or kNoComponent if it is not
+		// traversable.
+		int getComponent(int x, int y) const;
+
+		// @return: true if the locations of both nodes have a label and it is
+		// the same one.
+		bool connected(node* first, node* second) const;
+
+		unsigned int getNumComponents() const { return numComponents; }
+
+	private:
+		int find(int index);
+
+		int width, height;
+		unsigned int numComponents;
+
+		// one entry for each location, row-major. Before ::compact, each
+		// traversable location refers to another in its component (or to
+		// itself, if it represents the component); afterwards, entries are
+		// component numbers.
+		std::vector<int> labels;
+		std::vector<int> size;
+};
+
+#endif
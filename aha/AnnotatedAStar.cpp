@@ -9,6 +9,8 @@
 
 #include "AnnotatedAStar.h"
 #include "AnnotatedMapAbstraction.h"
+#include "ConnectedComponents.h"
+#include "fpUtil.h"
 #include "timer.h"
 
 using namespace std;
@@ -58,6 +60,12 @@ path* AnnotatedAStar::getPath(graphAbstraction *aMap, node *from, node* to, rese
 	/* both locations need to be reachable by agent */
 	if(from->getClearance(capability) < clearance || to->getClearance(capability) < clearance) 
 		return NULL;		
+
+	/* and in the same connected component */
+	AnnotatedMapAbstraction* ama = dynamic_cast<AnnotatedMapAbstraction*>(aMap);
+	ConnectedComponents* cc = ama ? ama->getComponents(capability, clearance) : NULL;
+	if(cc && !cc->connected(from, to))
+		return NULL;
 	
 	//TODO: need a test to check that we've set the fCost value of the start node.
 	// label start node cost 0 
@@ -67,9 +75,17 @@ path* AnnotatedAStar::getPath(graphAbstraction *aMap, node *from, node* to, rese
 	/* initialise the search params */
 	graph *g = aMap->getAbstractGraph(from->getLabelL(kAbstractionLevel));
 	heap* openList = new heap(30);
-	AAStarUtil::NodeMap closedList;
+	nextGeneration(g->getNumNodes());
 	openList->add(from);
+	openstamp[from->getNum()] = generation;
 	path *p = NULL;
+
+	/* use precomputed traversal masks if the map has them */
+	if(ama && from->getLabelL(kAbstractionLevel) == 0)
+	{
+		moves = ama->getTraversalMasks(capability, clearance);
+		nummoves = ama->getNumTraversalMasks();
+	}
 	
 	Timer t;
 	
@@ -109,10 +125,10 @@ path* AnnotatedAStar::getPath(graphAbstraction *aMap, node *from, node* to, rese
 			int ny = neighbour->getLabelL(kFirstData+1);
 			double weight = e->getWeight();*/
 
-			if(!closedList[neighbour->getUniqueID()]) // skip nodes we've already closed
+			if(closedstamp[neighbourid] != generation) // skip nodes we've already closed
 			{
 				// if a node on the openlist is reachable via this new edge, relax the edge (see cormen et al)
-				if(openList->isIn(neighbour)) 
+				if(openstamp[neighbourid] == generation) 
 				{	
 					if(evaluate(current, neighbour)) 
 					{
@@ -128,6 +144,7 @@ path* AnnotatedAStar::getPath(graphAbstraction *aMap, node *from, node* to, rese
 						neighbour->setKeyLabel(kTemporaryLabel); // an initial key value for prioritisation in the openlist
 						neighbour->markEdge(0);  // reset any marked edges (we use marked edges to backtrack over optimal path when goal is found)
 						openList->add(neighbour);
+						openstamp[neighbourid] = generation;
 						relaxEdge(openList, g, e, current->getNum(), neighbourid, to); 
 						nodesTouched++;
 					}
@@ -137,7 +154,7 @@ path* AnnotatedAStar::getPath(graphAbstraction *aMap, node *from, node* to, rese
 			e = current->edgeIterNext(ei);
 		}
 
-		closedList[current->getUniqueID()] = true;
+		closedstamp[current->getNum()] = generation;
 		
 		/* check if there is anything left to search; fail if not */
 		if(openList->empty())
@@ -145,10 +162,182 @@ path* AnnotatedAStar::getPath(graphAbstraction *aMap, node *from, node* to, rese
 	}
 	searchtime = t.endTimer();
 	delete openList; 
-	closedList.clear();
+	moves = NULL;
+	nummoves = 0;
 	return p;	
 }
 
+/* getPathsFrom
+	Finds a path from one node to each of several targets. paths[i] is the path to targets[i], or NULL if there is none.
+	Search statistics are summed over every search made.
+	
+	The default implementation runs one search per target.
+*/
+void AbstractAnnotatedAStar::getPathsFrom(graphAbstraction *aMap, node *from, const std::vector<node*>& targets, std::vector<path*>& paths)
+{
+	long expanded = 0, touched = 0, peak = 0;
+	double time = 0;
+
+	paths.clear();
+	for(unsigned int i=0; i<targets.size(); i++)
+	{
+		paths.push_back(getPath(aMap, from, targets[i]));
+		expanded += getNodesExpanded();
+		touched += getNodesTouched();
+		peak = getPeakMemory()>peak?getPeakMemory():peak;
+		time += getSearchTime();
+	}
+
+	nodesExpanded = expanded;
+	nodesTouched = touched;
+	peakmemory = peak;
+	searchtime = time;
+}
+
+/* getPathsFrom
+	A single Dijkstra search from the start node which stops once every target has been closed. The paths found are 
+	as short as those returned by getPath for each target in turn (though ties between equally short paths may be 
+	broken differently).
+	
+	When limited to a cluster corridor, the search does not leave the cluster of the start node.
+*/
+void AnnotatedAStar::getPathsFrom(graphAbstraction *aMap, node *from, const std::vector<node*>& targets, std::vector<path*>& paths)
+{
+	nodesExpanded=0;
+	nodesTouched=0;
+	peakmemory = 0;
+	searchtime =0;
+	
+	paths.assign(targets.size(), (path*)NULL);
+
+	if(aMap == NULL || !dynamic_cast<AbstractAnnotatedMapAbstraction*>(aMap))
+		return;
+		
+	setGraphAbstraction(aMap);
+	int clearance = this->getClearance();
+	int capability = this->getCapability();
+
+	if(clearance <= 0 || !from)
+		return;
+	if(from->getClearance(capability) < clearance) 
+		return;
+	
+	/* targets we still need to reach; those getPath would reject are left out */
+	AnnotatedMapAbstraction* ama = dynamic_cast<AnnotatedMapAbstraction*>(aMap);
+	ConnectedComponents* cc = ama ? ama->getComponents(capability, clearance) : NULL;
+	std::vector<unsigned int> pending;
+	for(unsigned int i=0; i<targets.size(); i++)
+	{
+		node* to = targets[i];
+		if(!to || from->getUniqueID() == to->getUniqueID())
+			continue;
+		if(from->getLabelL(kFirstData) == to->getLabelL(kFirstData) && from->getLabelL(kFirstData+1) == to->getLabelL(kFirstData+1))
+			continue;
+		if(to->getClearance(capability) < clearance)
+			continue;
+		if(cc && !cc->connected(from, to))
+			continue;
+		pending.push_back(i);
+	}
+	if(pending.empty())
+		return;
+
+	from->setLabelF(kTemporaryLabel, 0);
+	from->markEdge(0);
+	
+	graph *g = aMap->getAbstractGraph(from->getLabelL(kAbstractionLevel));
+	heap* openList = new heap(30);
+	nextGeneration(g->getNumNodes());
+	openList->add(from);
+	openstamp[from->getNum()] = generation;
+
+	if(ama && from->getLabelL(kAbstractionLevel) == 0)
+	{
+		moves = ama->getTraversalMasks(capability, clearance);
+		nummoves = ama->getNumTraversalMasks();
+	}
+	
+	Timer t;
+	
+	if(useCorridor)
+		this->setCorridorClusters(from->getParentCluster(),from->getParentCluster());
+	
+	t.startTimer();
+	while(!openList->empty() && !pending.empty()) 
+	{
+		peakmemory = openList->size()>peakmemory?openList->size():peakmemory;
+		node* current = ((node*)openList->remove()); 
+		nodesExpanded++;
+		closedstamp[current->getNum()] = generation;
+		
+		for(unsigned int i=0; i<pending.size(); )
+		{
+			if(targets[pending[i]] == current)
+			{
+				paths[pending[i]] = extractBestPath(g, current->getNum());
+				pending[i] = pending.back();
+				pending.pop_back();
+			}
+			else
+				i++;
+		}
+		
+		edge_iterator ei = current->getEdgeIter();
+		e = current->edgeIterNext(ei);
+		while(e)
+		{
+			int neighbourid = e->getFrom()==current->getNum()?e->getTo():e->getFrom();
+			node* neighbour = g->getNode(neighbourid);
+
+			if(closedstamp[neighbourid] != generation && evaluate(current, neighbour))
+			{
+				double gcost = current->getLabelF(kTemporaryLabel) + e->getWeight();
+				if(openstamp[neighbourid] != generation)
+				{
+					neighbour->setLabelF(kTemporaryLabel, gcost);
+					neighbour->setKeyLabel(kTemporaryLabel);
+					neighbour->markEdge(e);
+					openList->add(neighbour);
+					openstamp[neighbourid] = generation;
+				}
+				else if(fless(gcost, neighbour->getLabelF(kTemporaryLabel)))
+				{
+					neighbour->setLabelF(kTemporaryLabel, gcost);
+					openList->decreaseKey(neighbour);
+					neighbour->markEdge(e);
+				}
+				nodesTouched++;
+			}
+			e = current->edgeIterNext(ei);
+		}
+	}
+	searchtime = t.endTimer();
+	delete openList; 
+	moves = NULL;
+	nummoves = 0;
+}
+
+/* nextGeneration
+	Starts a new search over a graph with the given number of nodes. Stamps from previous searches become stale, so the open 
+	and closed lists need only be cleared when the generation counter wraps around.
+*/
+void AnnotatedAStar::nextGeneration(unsigned int numnodes)
+{
+	if(openstamp.size() < numnodes)
+	{
+		openstamp.resize(numnodes, 0);
+		closedstamp.resize(numnodes, 0);
+	}
+
+	generation++;
+	if(generation == 0)
+	{
+		openstamp.assign(openstamp.size(), 0);
+		closedstamp.assign(closedstamp.size(), 0);
+		generation = 1;
+	}
+}
+
 /* evaluate()
 	check if it is possible to move from the current location to an adjacent target location.
 	things we look for:
@@ -175,6 +364,17 @@ bool AnnotatedAStar::evaluate(node* current, node* target)
 	AbstractAnnotatedMapAbstraction* ama = (AbstractAnnotatedMapAbstraction*)getGraphAbstraction();
 	//graph *g = ama->getAbstractGraph(0);
 
+	/* during getPath: look up the move in the precomputed traversal masks. 
+	   corridor searches also need the cardinal tiles of a diagonal move so we leave those to the general case. */
+	if(moves && current->getNum() < nummoves && target->getNum() < nummoves && 
+			target->getLabelL(kAbstractionLevel) == 0 && !useCorridor)
+	{
+		tDirection dir = getDirection(current, target);
+		if(dir == kStay)
+			return false;
+		return (moves[current->getNum()] & (1<<dir)) != 0;
+	}
+
 	int tx, ty, tcl, tterr;
 	tterr = target->getTerrainType();
 	tcl = target->getClearance(this->getCapability());
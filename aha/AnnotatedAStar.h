@@ -26,6 +26,8 @@
 #include "graph.h"
 #include "graphAbstraction.h"
 
+#include <vector>
+
 namespace AAStarUtil {      
   typedef __gnu_cxx::hash_map<int,bool> NodeMap;
 }
@@ -36,8 +38,11 @@ class AbstractAnnotatedAStar : public aStarOld
 {
 	public:	
 		AbstractAnnotatedAStar(int _capability, int _clearance) : useCorridor(false), capability(_capability), clearance(_clearance) { capability=0; clearance=0; }
+		virtual ~AbstractAnnotatedAStar() {}
+		virtual AbstractAnnotatedAStar* clone() = 0; // a new search of the same kind; shares no search state with this one
 		virtual const char* getName() = 0;
 		virtual path *getPath(graphAbstraction *aMap, node *from, node *to, reservationProvider *rp = 0) = 0;
+		virtual void getPathsFrom(graphAbstraction *aMap, node *from, const std::vector<node*>& targets, std::vector<path*>& paths);
 		
 		int getClearance() { return clearance;}
 		void setClearance(int clearance) { this->clearance = clearance; }
@@ -68,8 +73,11 @@ class AnnotatedAStar : public AbstractAnnotatedAStar
 			friend class AnnotatedAStarTest; // TODO: replace these stupid friends with an inheritance-based solution
 			friend class AnnotatedHierarchicalAStarTest;
 		#endif
-		AnnotatedAStar(int _capability=0, int _clearance=0) : AbstractAnnotatedAStar(_capability, _clearance) { e = NULL; }
+		AnnotatedAStar(int _capability=0, int _clearance=0) : AbstractAnnotatedAStar(_capability, _clearance) 
+			{ e = NULL; moves = NULL; nummoves = 0; generation = 0; }
+		virtual AbstractAnnotatedAStar* clone() { return new AnnotatedAStar(getCapability(), getClearance()); }
 		virtual path *getPath(graphAbstraction *aMap, node *from, node *to, reservationProvider *rp = 0);
+		virtual void getPathsFrom(graphAbstraction *aMap, node *from, const std::vector<node*>& targets, std::vector<path*>& paths);
 		virtual const char* getName() { return "AAStar"; }
 		static tDirection getDirection(node* current, node* target); // TODO: move this to a common AStar base class
 		virtual void logFinalStats(statCollection *stats);
@@ -78,7 +86,19 @@ class AnnotatedAStar : public AbstractAnnotatedAStar
 		virtual bool evaluate(node* n, node* target);
 		edge* traversing() { return e; }
 	private:
+		void nextGeneration(unsigned int numnodes);
+
 		edge* e;
+
+		/* legal moves of each node for the current search; see AnnotatedMapAbstraction::getTraversalMasks */
+		const unsigned short* moves;
+		unsigned int nummoves;
+
+		/* search state, indexed by node number. a node is on the open (closed) list if its stamp equals the 
+		   generation of the current search. */
+		std::vector<unsigned int> openstamp;
+		std::vector<unsigned int> closedstamp;
+		unsigned int generation;
 };
 
 #endif
@@ -89,7 +89,7 @@ const char* CannotBuildEntranceToSelfException::what() const throw() { return me
 unsigned AnnotatedCluster::uniqueClusterIdCnt = 0;
 
 AnnotatedCluster::AnnotatedCluster(int startx, int starty, int width, int height) throw(InvalidClusterDimensionsException, InvalidClusterOriginCoordinatesException)
-	:  Cluster(uniqueClusterIdCnt++,0,0,startx,starty,width,height)
+	:  Cluster(uniqueClusterIdCnt++,0,0,startx,starty,width,height), deferIntraEdges(false)
 {
 
 	if(width <= 0 || height <=0)
@@ -136,7 +136,8 @@ void AnnotatedCluster::addParent(node* parentnode, AnnotatedClusterAbstraction*
 	else
 		parentnode->setParentCluster(this->getClusterId());
 		
-	this->connectEntranceEndpoints(parentnode,aca);	
+	if(!deferIntraEdges)
+		this->connectEntranceEndpoints(parentnode,aca);	
 	Cluster::addParent(parentnode);
 }
 
@@ -150,10 +151,25 @@ void AnnotatedCluster::addNodesToCluster(AnnotatedClusterAbstraction* aMap)
 	for(int x=this->getHOrig(); x<getHOrig()+getWidth(); x++)
 		for(int y=this->getVOrig(); y<getVOrig()+getHeight(); y++)
 		{
-			addNode(aMap->getNodeFromMap(x,y));
+			node* n = aMap->getNodeFromMap(x,y);
+			if(n) // tiles with hard obstacles have no node
+				addNode(n);
 		}
 }
 
+/* getTransitionClearance
+	The clearance of a transition between two adjacent nodes is the smaller of their clearances. A missing node is a hard 
+	obstacle; it has clearance 0.
+*/
+int AnnotatedCluster::getTransitionClearance(node* n1, node* n2, int capability)
+{
+	if(n1 == NULL || n2 == NULL)
+		return 0;
+
+	return n1->getClearance(capability)>n2->getClearance(capability)?
+		n2->getClearance(capability):n1->getClearance(capability);
+}
+
 void AnnotatedCluster::addEntrance(node* from, node* to, int capability, int clearance, AnnotatedClusterAbstraction* aca) 
 	throw(InvalidClearanceParameterException, EntranceNodeIsNotTraversable)
 {					
@@ -195,8 +211,7 @@ void AnnotatedCluster::buildVerticalEntrances(int curCapability, AnnotatedCluste
 	
 		node* endpoint1 = aca->getNodeFromMap(x, maxY); // inside eastern neighbour
 		node* endpoint2 = aca->getNodeFromMap(x-1, maxY);
-		int clearance = endpoint1->getClearance(curCapability)>endpoint2->getClearance(curCapability)?
-				endpoint2->getClearance(curCapability):endpoint1->getClearance(curCapability);
+		int clearance = getTransitionClearance(endpoint1, endpoint2, curCapability);
 
 		if(clearance > 0)
 			this->addEntrance(endpoint2, endpoint1, curCapability, clearance, aca); // each transition we identify is a local maxima clearance for curCapability
@@ -212,8 +227,7 @@ int AnnotatedCluster::findLocalMinimaForVerticalEntrance(int x, int startY, int
 	{
 		node *c1 = aca->getNodeFromMap(x,y); // node in neighbouring cluster
 		node *c2 = aca->getNodeFromMap(x-1, y); // border node in 'this' cluster
-		int clearance = c1->getClearance(curCapability)>c2->getClearance(curCapability)?
-							c2->getClearance(curCapability):c1->getClearance(curCapability);
+		int clearance = getTransitionClearance(c1, c2, curCapability);
 	
 		if(clearance == 0)
 			return y;
@@ -239,8 +253,7 @@ int AnnotatedCluster::findLocalMaximaForVerticalEntrance(int x, int startY, int
 	{
 		node *c1 = aca->getNodeFromMap(x,y); // node in neighbouring cluster
 		node *c2 = aca->getNodeFromMap(x-1, y); // border node in 'this' cluster
-		int clearance = c1->getClearance(curCapability)>c2->getClearance(curCapability)?
-							c2->getClearance(curCapability):c1->getClearance(curCapability);
+		int clearance = getTransitionClearance(c1, c2, curCapability);
 		
 		if(clearance > maxClearance)
 		{
@@ -275,8 +288,7 @@ void AnnotatedCluster::buildHorizontalEntrances(int curCapability, AnnotatedClus
 	
 		node* endpoint1 = aca->getNodeFromMap(maxX, y); // inside eastern neighbour
 		node* endpoint2 = aca->getNodeFromMap(maxX, y-1);
-		int clearance = endpoint1->getClearance(curCapability)>endpoint2->getClearance(curCapability)?
-				endpoint2->getClearance(curCapability):endpoint1->getClearance(curCapability);
+		int clearance = getTransitionClearance(endpoint1, endpoint2, curCapability);
 
 		if(clearance > 0)
 			this->addEntrance(endpoint2, endpoint1, curCapability, clearance, aca); // each transition we identify is a local maxima clearance for curCapability
@@ -294,8 +306,7 @@ int AnnotatedCluster::findLocalMinimaForHorizontalEntrance(int y, int startX, in
 	{
 		node *c1 = aca->getNodeFromMap(x,y); // node in neighbouring cluster
 		node *c2 = aca->getNodeFromMap(x, y-1); // border node in 'this' cluster
-		int clearance = c1->getClearance(curCapability)>c2->getClearance(curCapability)?
-							c2->getClearance(curCapability):c1->getClearance(curCapability);
+		int clearance = getTransitionClearance(c1, c2, curCapability);
 	
 		if(clearance == 0)
 			return x;
@@ -321,8 +332,7 @@ int AnnotatedCluster::findLocalMaximaForHorizontalEntrance(int y, int startX, in
 	{
 		node *c1 = aca->getNodeFromMap(x,y); // node in neighbouring cluster
 		node *c2 = aca->getNodeFromMap(x, y-1); // border node in 'this' cluster
-		int clearance = c1->getClearance(curCapability)>c2->getClearance(curCapability)?
-							c2->getClearance(curCapability):c1->getClearance(curCapability);
+		int clearance = getTransitionClearance(c1, c2, curCapability);
 		
 		if(clearance > maxClearance)
 		{
@@ -429,11 +439,56 @@ void AnnotatedCluster::addTransitionToAbstractGraph(node* from, node* to, int ca
 
 void AnnotatedCluster::connectEntranceEndpoints(node* newendpoint, AnnotatedClusterAbstraction* aca)
 {
-	for(unsigned int i=0; i<getParents().size(); i++)
+	IntraEdgeBuffer buffer;
+	findEdgesToParents(newendpoint, getParents().size(), aca->getSearchAlgorithm(), aca, buffer);
+	addIntraEdges(buffer, aca);
+}
+
+/* findIntraEdges
+	Finds the intra-cluster edges of every parent node, each connected to the parents added before it, just as addParent 
+	does when edges are not deferred. The edges are only kept in the buffer; the abstract graph is not changed, so several 
+	clusters can be searched at once as long as each has its own search algorithm.
+*/
+void AnnotatedCluster::findIntraEdges(AbstractAnnotatedAStar* aastar, AnnotatedClusterAbstraction* aca, IntraEdgeBuffer& buffer)
+{
+	for(unsigned int i=1; i<getParents().size(); i++)
+		findEdgesToParents(getParents()[i], i, aastar, aca, buffer);
+}
+
+/* adds the buffered edges to the abstract graph in the order they were found */
+void AnnotatedCluster::addIntraEdges(IntraEdgeBuffer& buffer, AnnotatedClusterAbstraction* aca)
+{
+	graph* absg = aca->getAbstractGraph(1);
+	for(unsigned int i=0; i<buffer.edges.size(); i++)
+	{
+		IntraEdge& ie = buffer.edges[i];
+		edge* e = new edge(ie.from, ie.to, ie.weight);
+		e->setClearance(ie.capability, ie.clearance);
+		absg->addEdge(e);
+		aca->addPathToCache(e, ie.p);
+	}
+	buffer.edges.clear();
+
+	/* record some metrics about the operation */
+	aca->setNodesExpanded(aca->getNodesExpanded() + buffer.nodesExpanded);
+	aca->setNodesTouched(aca->getNodesTouched() + buffer.nodesTouched);
+	aca->setPeakMemory(buffer.peakMemory>aca->getPeakMemory()?buffer.peakMemory:aca->getPeakMemory());
+	aca->setSearchTime(aca->getSearchTime() + buffer.searchTime);
+}
+
+/* finds the edges between a new endpoint and the first numparents parent nodes */
+void AnnotatedCluster::findEdgesToParents(node* newendpoint, unsigned int numparents, AbstractAnnotatedAStar* aastar, 
+		AnnotatedClusterAbstraction* aca, IntraEdgeBuffer& buffer)
+{
+	/* a single search from the new endpoint finds paths to all existing endpoints for a given capability and size.
+	 each search is run the first time one of its paths is needed; edges are still found one pair at a time, in the order below */
+	std::vector<std::vector<path*> > solutions(NUMCAPABILITIES*NUMAGENTSIZES);
+	unsigned int firstedge = buffer.edges.size();
+	
+	for(unsigned int i=0; i<numparents; i++)
 	{
 		/* simplest capabilities (those involving fewest terrains) first and others last. important to avoid creating identical edges 
 		NB: assumes capabilities array is sorted accordingly  */
-		node* existingendpoint = getParents()[i];		
 		for(int capindex=0; capindex < NUMCAPABILITIES ; capindex++) 
 		{
 			int capability = capabilities[capindex];
@@ -442,64 +497,103 @@ void AnnotatedCluster::connectEntranceEndpoints(node* newendpoint, AnnotatedClus
 			for(int sizeindex = NUMAGENTSIZES-1; sizeindex>=0; sizeindex--) 
 			{
 				int size = agentsizes[sizeindex]; 
-				connectEntranceEndpointsForAGivenCapabilityAndSize(newendpoint, existingendpoint, capability, size, aca);
+				findEdgeForAGivenCapabilityAndSize(newendpoint, i, numparents, capability, size, 
+						solutions[capindex*NUMAGENTSIZES+sizeindex], firstedge, aastar, aca, buffer);
 			}
 		}
 	}
+	
+	/* paths we found but did not need */
+	for(unsigned int i=0; i<solutions.size(); i++)
+		for(unsigned int j=0; j<solutions[i].size(); j++)
+			delete solutions[i][j];
 }
 
-void AnnotatedCluster::connectEntranceEndpointsForAGivenCapabilityAndSize(node* newendpoint, node* existingendpoint, int capability, int size, AnnotatedClusterAbstraction* aca)
+void AnnotatedCluster::findEdgeForAGivenCapabilityAndSize(node* newendpoint, unsigned int parentindex, unsigned int numparents, 
+		int capability, int size, std::vector<path*>& solutions, unsigned int firstedge, AbstractAnnotatedAStar* aastar, 
+		AnnotatedClusterAbstraction* aca, IntraEdgeBuffer& buffer)
 {
+	node* existingendpoint = getParents()[parentindex];
 	double maxdist = getWidth()*getHeight(); // use maximum possible distance between these two endpoints as an upperbound param when searching for existing edges that may exist between these two endpoints
-	edge* e=0;
 	
+	/* check if an existing intra-edge dominates the proposed transition; not done for high quality abstractions */
 	if(aca->getQualityParam() == ACAUtil::kLowQualityAbstraction)
+		if(hasIntraEdge(buffer, firstedge, newendpoint, existingendpoint, capability, size, maxdist))
+			return;
+	
+	if(solutions.size() == 0)
+		findShortestPathsFromEndpoint(newendpoint, numparents, capability, size, solutions, aastar, aca, buffer);
+
+	path* solution = solutions[parentindex];
+	solutions[parentindex] = 0;
+	if(solution == 0)
+		return;
+	
+	double dist = aca->distance(solution);
+	if(aca->getQualityParam() == ACAUtil::kHighQualityAbstraction) // don't add paths twice (optimal paths between two nodes may be identical for two capabilities/sizes)
 	{
-		/* check if an existing intra-edge dominates the proposed transition */
-		e = newendpoint->findAnnotatedEdge(existingendpoint,capability,size,maxdist); 
-		if(e == 0)
-			findShortestPathBetweenTwoEndpoints(newendpoint, existingendpoint, capability, size, aca);
+		if(hasIntraEdge(buffer, firstedge, newendpoint, existingendpoint, capability, size, dist))
+		{
+			delete solution;
+			return; 
+		}
 	}
-	else
-		findShortestPathBetweenTwoEndpoints(newendpoint, existingendpoint, capability, size, aca); // don't use intra-edge dominance-checking
+
+	IntraEdge e;
+	e.from = newendpoint->getNum();
+	e.to = existingendpoint->getNum();
+	e.capability = capability;
+	e.clearance = size;
+	e.weight = dist;
+	e.p = solution;
+	buffer.edges.push_back(e);
 }
 
-void AnnotatedCluster::findShortestPathBetweenTwoEndpoints(node* n1, node* n2, int capability, int size, AnnotatedClusterAbstraction* aca)
+/* hasIntraEdge
+	The buffered counterpart of node::findAnnotatedEdge: true if, among the edges found since firstedge, one joins the two 
+	nodes, is traversable by the given capability and clearance and weighs no more than the given weight. 
+	Edges between a new endpoint and its parents are all found together, so no other edge can join them.
+*/
+bool AnnotatedCluster::hasIntraEdge(IntraEdgeBuffer& buffer, unsigned int firstedge, node* n1, node* n2, int capability, 
+		int clearance, double weight)
+{
+	for(unsigned int i=firstedge; i<buffer.edges.size(); i++)
+	{
+		IntraEdge& e = buffer.edges[i];
+		if(!((e.from == n1->getNum() && e.to == n2->getNum()) || (e.from == n2->getNum() && e.to == n1->getNum())))
+			continue;
+		
+		int eclearance = (e.capability & capability) == e.capability ? e.clearance : 0; // see edge::getClearance
+		if(e.weight <= weight && eclearance >= clearance)
+			return true;
+	}
+	return false;
+}
+
+/* find the shortest path from an endpoint to each of the first numparents endpoints of the cluster. solutions[i] is the path 
+to the i'th parent node, or NULL if there is none */
+void AnnotatedCluster::findShortestPathsFromEndpoint(node* n1, unsigned int numparents, int capability, int size, 
+		std::vector<path*>& solutions, AbstractAnnotatedAStar* aastar, AnnotatedClusterAbstraction* aca, IntraEdgeBuffer& buffer)
 {
-		graph* absg = aca->getAbstractGraph(1);
-		AbstractAnnotatedAStar* aastar = aca->getSearchAlgorithm();
 		aastar->limitSearchToClusterCorridor(true);
 
 		node* from = aca->getNodeFromMap(n1->getLabelL(kFirstData),n1->getLabelL(kFirstData+1)); // get low-level nodes
-		node* to = aca->getNodeFromMap(n2->getLabelL(kFirstData),n2->getLabelL(kFirstData+1)); 
+		std::vector<node*> targets;
+		for(unsigned int i=0; i<numparents; i++)
+		{
+			node* n2 = getParents()[i];
+			targets.push_back(aca->getNodeFromMap(n2->getLabelL(kFirstData),n2->getLabelL(kFirstData+1)));
+		}
 
 		aastar->setCapability(capability);
 		aastar->setClearance(size);
-		path* solution = aastar->getPath(aca, from, to);
-		if(solution != 0)
-		{
-			double dist = aca->distance(solution);
-			edge* e = 0;
-			if(aca->getQualityParam() == ACAUtil::kHighQualityAbstraction) // don't add paths twice (optimal paths between two nodes may be identical for two capabilities/sizes)
-			{
-				e = n1->findAnnotatedEdge(n2,capability,size,dist); 			
-				if(e != 0)
-					return; 
-			}
-
-			//std::cout << "connecting endpoints in cluster "<<getClusterId()<<". new edge, dist: "<<dist<<std::endl;
-			e = new edge(n1->getNum(), n2->getNum(), dist);
-			e->setClearance(capability,size);
-			absg->addEdge(e);
-			aca->addPathToCache(e, solution);				
-			//std::cout << "\n adding way cool edege for cluster "<<getClusterId();
-		}
+		aastar->getPathsFrom(aca, from, targets, solutions);
 		
 		/* record some metrics about the operation */
-		aca->setNodesExpanded(aca->getNodesExpanded() + aastar->getNodesExpanded());
-		aca->setNodesTouched(aca->getNodesTouched() + aastar->getNodesTouched());
-		aca->setPeakMemory(aastar->getPeakMemory()>aca->getPeakMemory()?aastar->getPeakMemory():aca->getPeakMemory());
-		aca->setSearchTime(aca->getSearchTime() + aastar->getSearchTime());
+		buffer.nodesExpanded += aastar->getNodesExpanded();
+		buffer.nodesTouched += aastar->getNodesTouched();
+		buffer.peakMemory = aastar->getPeakMemory()>buffer.peakMemory?aastar->getPeakMemory():buffer.peakMemory;
+		buffer.searchTime += aastar->getSearchTime();
 		
 		aastar->limitSearchToClusterCorridor(false);
 }
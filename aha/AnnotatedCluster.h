@@ -12,9 +12,12 @@
 
 #include "clusterAbstraction.h"
 #include <exception>
+#include <vector>
 
 class AnnotatedCluster;
+class AbstractAnnotatedAStar;
 class node;
+class path;
 class AnnotatedClusterAbstractionIsNullException : public std::exception
 {
 	public:
@@ -169,6 +172,25 @@ class InvalidTransitionWeightException : public std::exception
 };
 
 
+/* an intra-cluster edge which has been found but not yet added to the abstract graph */
+struct IntraEdge
+{
+	int from, to; // abstract node ids
+	int capability, clearance;
+	double weight;
+	path* p; // low-level path the edge stands for
+};
+
+/* intra-cluster edges found for one cluster and the search effort spent finding them */
+struct IntraEdgeBuffer
+{
+	IntraEdgeBuffer() : nodesExpanded(0), nodesTouched(0), peakMemory(0), searchTime(0) { }
+
+	std::vector<IntraEdge> edges;
+	long nodesExpanded, nodesTouched, peakMemory;
+	double searchTime;
+};
+
 class AnnotatedClusterAbstraction;
 class AnnotatedCluster : public Cluster
 {
@@ -183,6 +205,11 @@ class AnnotatedCluster : public Cluster
 		virtual void addParent(node *, AnnotatedClusterAbstraction*);
 		virtual void addNodesToCluster(AnnotatedClusterAbstraction*);
 		virtual void buildEntrances(AnnotatedClusterAbstraction*) throw (AnnotatedClusterAbstractionIsNullException);
+
+		/* while set, addParent leaves new parents unconnected; findIntraEdges and addIntraEdges connect them later */
+		void setDeferIntraEdges(bool defer) { deferIntraEdges = defer; }
+		void findIntraEdges(AbstractAnnotatedAStar* aastar, AnnotatedClusterAbstraction* aca, IntraEdgeBuffer& buffer);
+		void addIntraEdges(IntraEdgeBuffer& buffer, AnnotatedClusterAbstraction* aca);
 		
 	protected:
 		virtual bool addNode(node *) throw(NodeIsAlreadyAssignedToClusterException, ClusterFullException, NodeIsNullException); 
@@ -194,15 +221,22 @@ class AnnotatedCluster : public Cluster
 		
 		
 	private:		
-		void findShortestPathBetweenTwoEndpoints(node* n1, node* n2, int capability, int clearance, AnnotatedClusterAbstraction* aca);
+		void findShortestPathsFromEndpoint(node* n1, unsigned int numparents, int capability, int clearance, std::vector<path*>& solutions, 
+			AbstractAnnotatedAStar* aastar, AnnotatedClusterAbstraction* aca, IntraEdgeBuffer& buffer);
 		void validateMapAbstraction(AnnotatedClusterAbstraction*) throw(ValidateMapAbstractionException);
 		void validateTransitionEndpoints(node*, node*) throw(ValidateTransitionEndpointsException);
 		void addEndpointsToAbstractGraph(node*, node*, AnnotatedClusterAbstraction*) 
 			throw(EntranceNodesAreNotAdjacentException, CannotBuildEntranceToSelfException, CannotBuildEntranceFromAbstractNodeException);
 		void addTransitionToAbstractGraph(node* from, node* to, int capability, int clearance, double weight, AnnotatedClusterAbstraction* aca) throw (InvalidTransitionWeightException);
 		void connectEntranceEndpoints(node* newendpoint, AnnotatedClusterAbstraction* aca);
-		void connectEntranceEndpointsForAGivenCapabilityAndSize(node* newendpoint, node* existingendpoint, int capability, int size, AnnotatedClusterAbstraction* aca);
+		void findEdgesToParents(node* newendpoint, unsigned int numparents, AbstractAnnotatedAStar* aastar, AnnotatedClusterAbstraction* aca, 
+			IntraEdgeBuffer& buffer);
+		void findEdgeForAGivenCapabilityAndSize(node* newendpoint, unsigned int parentindex, unsigned int numparents, int capability, int size, 
+			std::vector<path*>& solutions, unsigned int firstedge, AbstractAnnotatedAStar* aastar, AnnotatedClusterAbstraction* aca, 
+			IntraEdgeBuffer& buffer);
+		static bool hasIntraEdge(IntraEdgeBuffer& buffer, unsigned int firstedge, node* n1, node* n2, int capability, int clearance, double weight);
 		void getPathClearance(path *p, int& capability, int& clearance);
+		int getTransitionClearance(node* n1, node* n2, int capability);
 		int findLocalMinimaForVerticalEntrance(int x, int startY, int curCapability, AnnotatedClusterAbstraction* aca);
 		int findLocalMaximaForVerticalEntrance(int x, int startY, int endY, int curCapability, AnnotatedClusterAbstraction* aca);
 		int findLocalMinimaForHorizontalEntrance(int y, int startX, int curCapability, AnnotatedClusterAbstraction* aca);
@@ -210,6 +244,7 @@ class AnnotatedCluster : public Cluster
 
 
 		static unsigned int uniqueClusterIdCnt;
+		bool deferIntraEdges;
 		
 };
 
@@ -12,6 +12,7 @@
 #include "clusterAbstraction.h"
 #include "AHAConstants.h"
 #include "AnnotatedAStar.h"
+#include "WorkerThreads.h"
 #include "map.h"
 
 #include "glUtil.h"
@@ -23,6 +24,7 @@
 #include <GL/gl.h>
 #endif
 
+#include <map>
 #include <sstream>
 
 
@@ -88,43 +90,123 @@ void AnnotatedClusterAbstraction::buildClusters(IAnnotatedClusterFactory* acfact
 }
 
 
+/* finds the intra-cluster edges of each cluster. every thread has its own search algorithm; the first uses the abstraction's. */
+class IntraEdgeTask : public ParallelTask
+{
+	public:
+		IntraEdgeTask(AnnotatedClusterAbstraction* aca_, std::vector<AnnotatedCluster*>& clusters_, std::vector<IntraEdgeBuffer>& buffers_)
+			: aca(aca_), clusters(clusters_), buffers(buffers_)
+		{
+			searches.push_back(aca->getSearchAlgorithm());
+			for(int i=1; i<WorkerThreads::getNumThreads(); i++)
+				searches.push_back(aca->getSearchAlgorithm()->clone());
+		}
+
+		virtual ~IntraEdgeTask()
+		{
+			for(unsigned int i=1; i<searches.size(); i++)
+				delete searches[i];
+		}
+
+		virtual void run(int cluster, int thread)
+		{
+			clusters[cluster]->findIntraEdges(searches[thread], aca, buffers[cluster]);
+		}
+
+	private:
+		AnnotatedClusterAbstraction* aca;
+		std::vector<AnnotatedCluster*>& clusters;
+		std::vector<IntraEdgeBuffer>& buffers;
+		std::vector<AbstractAnnotatedAStar*> searches;
+};
+
+/* compares every pair of transitions in a group; the transitions of a group are marked only by the thread comparing them */
+class DominatedTransitionTask : public ParallelTask
+{
+	public:
+		DominatedTransitionTask(AnnotatedClusterAbstraction* aca_, std::vector<std::vector<edge*> >& groups_)
+			: aca(aca_), groups(groups_) { }
+
+		virtual void run(int group, int)
+		{
+			std::vector<edge*>& transitions = groups[group];
+			for(unsigned int i=0; i<transitions.size(); i++)
+				for(unsigned int j=i+1; j<transitions.size(); j++)
+					aca->findAndMarkDominatedTransition(transitions[i], transitions[j]);
+		}
+
+	private:
+		AnnotatedClusterAbstraction* aca;
+		std::vector<std::vector<edge*> >& groups;
+};
+
+/* buildEntrances
+	1. find the entrances of each cluster, in order. this adds every abstract node and transition but leaves the endpoints 
+	   of each cluster unconnected.
+	2. search for the intra-cluster edges of each cluster on worker threads.
+	3. add the intra-cluster edges to the abstract graph, cluster by cluster, so the graph does not depend on the number 
+	   of threads.
+*/
 void AnnotatedClusterAbstraction::buildEntrances()
 {
+	for(unsigned int i=0; i<clusters.size(); i++)
+		clusters[i]->setDeferIntraEdges(true);
 	for(unsigned int i=0; i<clusters.size(); i++)
 	{
 		AnnotatedCluster* ac = clusters[i];
 		ac->buildEntrances(this);
 	}
-	
+	for(unsigned int i=0; i<clusters.size(); i++)
+		clusters[i]->setDeferIntraEdges(false);
 
+	std::vector<IntraEdgeBuffer> buffers(clusters.size());
+	IntraEdgeTask task(this, clusters, buffers);
+	WorkerThreads::run(&task, clusters.size());
+	for(unsigned int i=0; i<clusters.size(); i++)
+		clusters[i]->addIntraEdges(buffers[i], this);
 	
 	if(quality == ACAUtil::kLowQualityAbstraction)
 	{	
-		/* find & mark all dominated edges */
-		graph* absg = this->getAbstractGraph(1);
-		edge_iterator ei1, ei2;
-		edge *first, *second;
-		ei1 = absg->getEdgeIter();
-		first = absg->edgeIterNext(ei1);
-		while(first)
-		{
-			ei2 = ei1;
-			second = absg->edgeIterNext(ei2);
-			while(second)
-			{
-				findAndMarkDominatedTransition(first, second);
-				second = absg->edgeIterNext(ei2);
-			}
-			first = absg->edgeIterNext(ei1);
-		}
+		markDominatedTransitions();
 		
 		/* delete all dominated edges */
 		removeDominatedEdgesAndEndpoints();
-	
 	}
 
 }
 
+/* markDominatedTransitions
+	A transition can only dominate another which joins the same two clusters, so transitions are grouped by the pair of 
+	clusters they join and each group is compared on a worker thread. Groups keep the order of the abstract graph's edges.
+*/
+void AnnotatedClusterAbstraction::markDominatedTransitions()
+{
+	graph* absg = this->getAbstractGraph(1);
+	std::map<std::pair<int, int>, int> groupid;
+	std::vector<std::vector<edge*> > groups;
+
+	edge_iterator ei = absg->getEdgeIter();
+	for(edge* e = absg->edgeIterNext(ei); e; e = absg->edgeIterNext(ei))
+	{
+		int c1 = absg->getNode(e->getFrom())->getParentCluster();
+		int c2 = absg->getNode(e->getTo())->getParentCluster();
+		if(c1 == c2)
+			continue; // intra-cluster edge
+		
+		std::pair<int, int> key = c1<c2?std::make_pair(c1, c2):std::make_pair(c2, c1);
+		std::map<std::pair<int, int>, int>::iterator it = groupid.find(key);
+		if(it == groupid.end())
+		{
+			it = groupid.insert(std::make_pair(key, (int)groups.size())).first;
+			groups.push_back(std::vector<edge*>());
+		}
+		groups[it->second].push_back(e);
+	}
+
+	DominatedTransitionTask task(this, groups);
+	WorkerThreads::run(&task, groups.size());
+}
+
 double AnnotatedClusterAbstraction::distance(path* p)
 {
 
@@ -43,6 +43,7 @@ class AnnotatedClusterAbstraction : public AnnotatedMapAbstraction
 	#ifdef UNITTEST
 		friend class AnnotatedClusterAbstractionTest;
 	#endif
+	friend class DominatedTransitionTask;
 	
 	public: 
 		AnnotatedClusterAbstraction(Map* m, AbstractAnnotatedAStar* searchalg, int clustersize, ACAUtil::GraphQualityParameter qual=ACAUtil::kHighQualityAbstraction);
@@ -88,6 +89,7 @@ class AnnotatedClusterAbstraction : public AnnotatedMapAbstraction
 
 	private:
 		void findAndMarkDominatedTransition(edge* first, edge* second);
+		void markDominatedTransitions();
 		bool hasMoreInterEdges(node* n, graph* absg);
 		void removeDominatedEdgesAndEndpoints();
 		void removeDominatedNodeFromGraph(node* n, graph* absg);
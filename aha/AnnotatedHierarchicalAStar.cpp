@@ -9,6 +9,11 @@
 
 #include "AnnotatedHierarchicalAStar.h"
 #include "AnnotatedClusterAbstraction.h"
+#include "ConnectedComponents.h"
+#include "fpUtil.h"
+#include "timer.h"
+
+#include <queue>
 
 bool AnnotatedHierarchicalAStar::evaluate(node* n, node* target) 
 {
@@ -38,11 +43,6 @@ bool AnnotatedHierarchicalAStar::evaluate(node* n, node* target)
 
 /* 
 Find an abstract path and refine it using the path cache
-
- NB: sometimes we may require a cached path which was obtained by planning in the reverse direction to current requirements
- ie. we store the path from n1 -> n2, but we may require the path from n2 -> n1. 
- In such cases, we specify the id of the node that should be at the head of the path. if the cached path doesn't meet those
- requirements, we reverse it. 
 */
 path* AnnotatedHierarchicalAStar::getPath(graphAbstraction* aMap, node* from, node* to, reservationProvider *rp)
 {
@@ -52,22 +52,19 @@ path* AnnotatedHierarchicalAStar::getPath(graphAbstraction* aMap, node* from, no
 	insertNodesExpanded = insertNodesTouched = insertPeakMemory =0;
 	insertSearchTime = 0;
 
+	/* no need to insert or search if the goal is in another connected component */
+	ConnectedComponents* cc = aca->getComponents(this->getCapability(), this->getClearance());
+	if(cc && !cc->connected(from, to))
+	{
+		nodesExpanded = nodesTouched = peakmemory = 0;
+		searchtime = 0;
+		return 0;
+	}
+
 	path* thepath=0;
 
 	if(from->getParentCluster() == to->getParentCluster())
-	{
-		AnnotatedAStar aastar;
-		aastar.setGraphAbstraction(aMap);
-		aastar.setCapability(this->getCapability());
-		aastar.setClearance(this->getClearance());
-		aastar.limitSearchToClusterCorridor(true);
-		thepath = aastar.getPath(aMap, from, to, rp);
-		this->nodesExpanded += aastar.getNodesExpanded();
-		this->nodesTouched += aastar.getNodesTouched();
-		if(this->peakmemory < aastar.getPeakMemory())
-			this->peakmemory = aastar.getPeakMemory();
-		this->searchtime += aastar.getSearchTime();
-	}
+		thepath = findPathInCluster(aMap, from, to, this->getCapability(), this->getClearance());
 	
 	if(thepath==0)
 	{
@@ -89,80 +86,9 @@ path* AnnotatedHierarchicalAStar::getPath(graphAbstraction* aMap, node* from, no
 	*/
 
 		path* abspath = getAbstractPath(aMap, absstart, absgoal);
-		
 		if(abspath)
-		{
-			// debugging
-	/*		std::cout << "\n abstract path: ";
-			path* tmpptr = abspath;
-			while(tmpptr)
-			{
-				node* n = tmpptr->n;
-				std::cout << "\n id: "<<n->getUniqueID()<<" node @ "<<n->getLabelL(kFirstData) << ","<<n->getLabelL(kFirstData+1);
-				tmpptr = tmpptr->next;
-			}
-		
-	*/
-			AnnotatedAStar aastar;
-			int capability = this->getCapability();
-			int clearance = this->getClearance();
-			path* tail;
-			path* tmp = abspath;//->next;
-			while(tmp->next)
-			{
-				edge* e = tmp->n->findAnnotatedEdge(tmp->next->n,capability,clearance,MAXINT);
-				if(e == NULL)
-				{
-					std::cout << "\n AHA::getPath -- something went horribly wrong; I couldn't find any cached paths. Search params: ";
-					std::cout << "from: "<<from->getLabelL(kFirstData)<<","<<from->getLabelL(kFirstData+1);
-					std::cout << " to: "<<to->getLabelL(kFirstData)<<","<<to->getLabelL(kFirstData+1);
-					std::cout << " caps: "<<capability<<" clearance: "<<clearance;
-					exit(-1);
-				}
-				
-//				path refinement. enable this and comment out section below to turn off caching (one or the other)
-				// [refine]
-				node* llstart = aca->getNodeFromMap(tmp->n->getLabelL(kFirstData), tmp->n->getLabelL(kFirstData+1));
-				node* llgoal = aca->getNodeFromMap(tmp->next->n->getLabelL(kFirstData), tmp->next->n->getLabelL(kFirstData+1));
-				aastar.setCapability(this->getCapability());
-				aastar.setClearance(this->getClearance());
-				path* cachedpath = aastar.getPath(aMap,llstart, llgoal); 
-				this->nodesExpanded += aastar.getNodesExpanded();
-				this->nodesTouched += aastar.getNodesTouched();
-				if(this->peakmemory < aastar.getPeakMemory())
-					this->peakmemory = aastar.getPeakMemory();
-				this->searchtime += aastar.getSearchTime();
-				// [/refine]
-
-/*				// [cache]
-				path* cachedpath = aca->getPathFromCache(e)->clone();
-				if(e->getFrom() != tmp->n->getNum()) // fix segments if necessary
-					cachedpath = cachedpath->reverse();
-				// [/cache]
-*/
-				if(thepath == 0)
-					thepath = cachedpath;				
-				tail = thepath->tail();	
-				
-				/*	// debugging
-					node* n1 = absg->getNode(e->getFrom());
-					node* n2 = absg->getNode(e->getTo());		
-					std::cout << "\n expanding abstract edge between nodes: "<<n1->getUniqueID()<<" and "<<n2->getUniqueID();
-					path* meh = cachedpath;
-					std::cout << "\n expanding cached path: ";
-					while(meh)
-					{
-						std::cout << "\n id: "<<meh->n->getUniqueID()<<" node @ "<<meh->n->getLabelL(kFirstData) << ","<<meh->n->getLabelL(kFirstData+1);
-						meh = meh->next;
-					}
-				*/
-				
-				if(tail->n->getNum() == cachedpath->n->getNum()) // avoid overlap where the cached path segments overlap (one ends where another begins)
-					tail->next = cachedpath->next;
-				
-				tmp = tmp->next;
-			}
-		}	
+			thepath = refineAbstractPath(aca, abspath, from, to, this->getCapability(), this->getClearance());
+
 		insertNodesExpanded = aca->getNodesExpanded();
 		insertNodesTouched = aca->getNodesTouched();
 		insertPeakMemory = aca->getPeakMemory();
@@ -183,6 +109,325 @@ path* AnnotatedHierarchicalAStar::getPath(graphAbstraction* aMap, node* from, no
 	return thepath;
 }
 
+/* getPaths
+	Batched version of getPath: finds a path between the same pair of locations for several agents, each with its own 
+	capability and clearance. paths[i] is the solution for agents[i] (or NULL if there is none).
+
+	The start and goal are inserted into the abstract graph only once and a single search of the abstract graph serves 
+	every agent (see getAbstractPaths). Performance metrics accumulate over the whole batch. 
+*/
+void AnnotatedHierarchicalAStar::getPaths(graphAbstraction* aMap, node* from, node* to, 
+		const std::vector<AHAStarUtil::AgentType>& agents, std::vector<path*>& paths)
+{
+	AnnotatedClusterAbstraction* aca = dynamic_cast<AnnotatedClusterAbstraction*>(aMap);
+	assert(aca != 0); 
+
+	nodesExpanded = nodesTouched = peakmemory = 0;
+	searchtime = 0;
+	insertNodesExpanded = insertNodesTouched = insertPeakMemory =0;
+	insertSearchTime = 0;
+
+	paths.assign(agents.size(), (path*)0);
+
+	/* agents that can't solve the problem in the cluster of the start and goal need the abstract graph */
+	std::vector<AHAStarUtil::AgentType> absagents;
+	std::vector<int> absindex;
+	for(unsigned int i=0; i<agents.size(); i++)
+	{
+		/* agents for which the goal is in another connected component have no path */
+		ConnectedComponents* cc = aca->getComponents(agents[i].first, agents[i].second);
+		if(cc && !cc->connected(from, to))
+			continue;
+
+		if(from->getParentCluster() == to->getParentCluster())
+			paths[i] = findPathInCluster(aMap, from, to, agents[i].first, agents[i].second);
+
+		if(paths[i] == 0)
+		{
+			absagents.push_back(agents[i]);
+			absindex.push_back(i);
+		}
+	}
+
+	if(absagents.size() == 0)
+		return;
+
+	aca->insertStartAndGoalNodesIntoAbstractGraph(from, to);
+	graph *absg = aca->getAbstractGraph(1);
+	node* absstart = absg->getNode(from->getLabelL(kParent));
+	node* absgoal = absg->getNode(to->getLabelL(kParent));
+
+	std::vector<path*> abspaths;
+	getAbstractPaths(aMap, absstart, absgoal, absagents, abspaths);
+	for(unsigned int i=0; i<absagents.size(); i++)
+	{
+		if(abspaths[i])
+			paths[absindex[i]] = refineAbstractPath(aca, abspaths[i], from, to, 
+					absagents[i].first, absagents[i].second);
+		delete abspaths[i];
+	}
+
+	insertNodesExpanded = aca->getNodesExpanded();
+	insertNodesTouched = aca->getNodesTouched();
+	insertPeakMemory = aca->getPeakMemory();
+	insertSearchTime = aca->getSearchTime();
+	aca->removeStartAndGoalNodesFromAbstractGraph();
+
+	this->nodesExpanded += insertNodesExpanded;
+	this->nodesTouched += insertNodesTouched;
+	this->searchtime += insertSearchTime;
+	if(this->peakmemory < insertPeakMemory)
+		this->peakmemory = insertPeakMemory;
+}
+
+namespace
+{
+	/* an entry on the open list of getAbstractPaths: the cost of reaching some node for a single agent */
+	struct AgentLabel
+	{
+		double f, g;
+		int node, agent;
+	};
+
+	/* orders labels by f then g (larger first) then node number. labels of different agents at the same node with 
+	   the same g-cost are adjacent and can be expanded together. */
+	struct AgentLabelGreater
+	{
+		bool operator()(const AgentLabel& a, const AgentLabel& b) const
+		{
+			if(a.f != b.f) return a.f > b.f;
+			if(a.g != b.g) return a.g < b.g;
+			return a.node > b.node;
+		}
+	};
+}
+
+/* getAbstractPaths
+	Searches for a path between two abstract nodes for several agents at once. Every agent has its own g-cost and parent 
+	at each node; all labels share a single open list and are settled in order of f-cost, so the search returns, for each 
+	agent, the same cost as an individual search on the abstract graph. 
+	
+	Labels of different agents at the same node with equal g-cost (eg. agents whose capabilities share a corridor) are 
+	expanded together: the edges of the node are read once and each is relaxed for every agent that can traverse it. 
+*/
+void AnnotatedHierarchicalAStar::getAbstractPaths(graphAbstraction* aMap, node* from, node* to, 
+		const std::vector<AHAStarUtil::AgentType>& agents, std::vector<path*>& abspaths)
+{
+	abspaths.assign(agents.size(), (path*)0);
+	if(!from || !to || from->getUniqueID() == to->getUniqueID())
+		return;
+	if(from->getLabelL(kFirstData) == to->getLabelL(kFirstData) && from->getLabelL(kFirstData+1) == to->getLabelL(kFirstData+1))
+		return;
+
+	Timer t;
+	t.startTimer();
+
+	graph* g = aMap->getAbstractGraph(from->getLabelL(kAbstractionLevel));
+	unsigned int numagents = agents.size();
+	unsigned int numlabels = g->getNumNodes()*numagents;
+	std::vector<double> gcost(numlabels, -1); // -1 = unreached
+	std::vector<int> parent(numlabels, -1);
+	std::vector<bool> closed(numlabels, false);
+	std::vector<bool> done(numagents, false); // agents whose path has been found
+
+	std::priority_queue<AgentLabel, std::vector<AgentLabel>, AgentLabelGreater> open;
+	unsigned int remaining = 0;
+	for(unsigned int i=0; i<numagents; i++)
+	{
+		if(agents[i].second <= 0 || from->getClearance(agents[i].first) < agents[i].second ||
+				to->getClearance(agents[i].first) < agents[i].second)
+			continue;
+
+		AgentLabel label;
+		label.g = 0;
+		label.f = h(from, to);
+		label.node = from->getNum();
+		label.agent = i;
+		gcost[label.node*numagents + i] = 0;
+		open.push(label);
+		remaining++;
+	}
+
+	std::vector<int> batch;
+	while(!open.empty() && remaining > 0)
+	{
+		if((long)open.size() > peakmemory)
+			peakmemory = open.size();
+		AgentLabel current = open.top();
+		open.pop();
+
+		/* gather every agent for which the current node is reached with the same (optimal) cost */
+		batch.clear();
+		if(!closed[current.node*numagents + current.agent] && !done[current.agent])
+			batch.push_back(current.agent);
+		while(!open.empty() && open.top().node == current.node && open.top().g == current.g)
+		{
+			int agent = open.top().agent;
+			if(!closed[current.node*numagents + agent] && !done[agent])
+				batch.push_back(agent);
+			open.pop();
+		}
+		if(batch.size() == 0)
+			continue;
+
+		nodesExpanded++;
+		for(unsigned int i=0; i<batch.size(); i++)
+			closed[current.node*numagents + batch[i]] = true;
+
+		node* n = g->getNode(current.node);
+		if(n == to)
+		{
+			for(unsigned int i=0; i<batch.size(); i++)
+			{
+				/* extract the path by following parents back to the start */
+				path* p = 0;
+				for(int num = current.node; num != -1; num = parent[num*numagents + batch[i]])
+					p = new path(g->getNode(num), p);
+				abspaths[batch[i]] = p;
+				done[batch[i]] = true;
+				remaining--;
+			}
+			continue;
+		}
+
+		edge_iterator ei = n->getEdgeIter();
+		for(edge* e = n->edgeIterNext(ei); e; e = n->edgeIterNext(ei))
+		{
+			int neighbourid = e->getFrom()==n->getNum()?e->getTo():e->getFrom();
+			node* neighbour = g->getNode(neighbourid);
+			double ng = current.g + e->getWeight();
+			double nh = -1;
+			for(unsigned int i=0; i<batch.size(); i++)
+			{
+				int agent = batch[i];
+				int label = neighbourid*numagents + agent;
+				if(closed[label] || e->getClearance(agents[agent].first) < agents[agent].second)
+					continue;
+				if(gcost[label] != -1 && !fless(ng, gcost[label]))
+					continue;
+
+				if(nh == -1)
+					nh = h(neighbour, to);
+				gcost[label] = ng;
+				parent[label] = current.node;
+
+				AgentLabel next;
+				next.g = ng;
+				next.f = ng + nh;
+				next.node = neighbourid;
+				next.agent = agent;
+				open.push(next);
+				nodesTouched++;
+			}
+		}
+	}
+
+	searchtime += t.endTimer();
+}
+
+/* refineAbstractPath
+	Turns an abstract path into a low-level path by planning between each pair of consecutive abstract nodes.
+
+	NB: sometimes we may require a cached path which was obtained by planning in the reverse direction to current requirements
+	ie. we store the path from n1 -> n2, but we may require the path from n2 -> n1. 
+	In such cases, we specify the id of the node that should be at the head of the path. if the cached path doesn't meet those
+	requirements, we reverse it. 
+*/
+path* AnnotatedHierarchicalAStar::refineAbstractPath(AnnotatedClusterAbstraction* aca, path* abspath, node* from, node* to, 
+		int capability, int clearance)
+{
+	// debugging
+/*	std::cout << "\n abstract path: ";
+	path* tmpptr = abspath;
+	while(tmpptr)
+	{
+		node* n = tmpptr->n;
+		std::cout << "\n id: "<<n->getUniqueID()<<" node @ "<<n->getLabelL(kFirstData) << ","<<n->getLabelL(kFirstData+1);
+		tmpptr = tmpptr->next;
+	}
+
+*/
+	path* thepath = 0;
+	aastar.limitSearchToClusterCorridor(false);
+	path* tail;
+	path* tmp = abspath;//->next;
+	while(tmp->next)
+	{
+		edge* e = tmp->n->findAnnotatedEdge(tmp->next->n,capability,clearance,MAXINT);
+		if(e == NULL)
+		{
+			std::cout << "\n AHA::getPath -- something went horribly wrong; I couldn't find any cached paths. Search params: ";
+			std::cout << "from: "<<from->getLabelL(kFirstData)<<","<<from->getLabelL(kFirstData+1);
+			std::cout << " to: "<<to->getLabelL(kFirstData)<<","<<to->getLabelL(kFirstData+1);
+			std::cout << " caps: "<<capability<<" clearance: "<<clearance;
+			exit(-1);
+		}
+		
+//		path refinement. enable this and comment out section below to turn off caching (one or the other)
+		// [refine]
+		node* llstart = aca->getNodeFromMap(tmp->n->getLabelL(kFirstData), tmp->n->getLabelL(kFirstData+1));
+		node* llgoal = aca->getNodeFromMap(tmp->next->n->getLabelL(kFirstData), tmp->next->n->getLabelL(kFirstData+1));
+		aastar.setCapability(capability);
+		aastar.setClearance(clearance);
+		path* cachedpath = aastar.getPath(aca,llstart, llgoal); 
+		updateSearchStats(aastar);
+		// [/refine]
+
+/*		// [cache]
+		path* cachedpath = aca->getPathFromCache(e)->clone();
+		if(e->getFrom() != tmp->n->getNum()) // fix segments if necessary
+			cachedpath = cachedpath->reverse();
+		// [/cache]
+*/
+		if(thepath == 0)
+			thepath = cachedpath;				
+		tail = thepath->tail();	
+		
+		/*	// debugging
+			graph* absg = aca->getAbstractGraph(1);
+			node* n1 = absg->getNode(e->getFrom());
+			node* n2 = absg->getNode(e->getTo());		
+			std::cout << "\n expanding abstract edge between nodes: "<<n1->getUniqueID()<<" and "<<n2->getUniqueID();
+			path* meh = cachedpath;
+			std::cout << "\n expanding cached path: ";
+			while(meh)
+			{
+				std::cout << "\n id: "<<meh->n->getUniqueID()<<" node @ "<<meh->n->getLabelL(kFirstData) << ","<<meh->n->getLabelL(kFirstData+1);
+				meh = meh->next;
+			}
+		*/
+		
+		if(tail->n->getNum() == cachedpath->n->getNum()) // avoid overlap where the cached path segments overlap (one ends where another begins)
+			tail->next = cachedpath->next;
+		
+		tmp = tmp->next;
+	}
+	return thepath;
+}
+
+/* findPathInCluster
+	Low-level search for problems where the start and goal are in the same cluster. The search is limited to that cluster.
+*/
+path* AnnotatedHierarchicalAStar::findPathInCluster(graphAbstraction* aMap, node* from, node* to, int capability, int clearance)
+{
+	aastar.setGraphAbstraction(aMap);
+	aastar.setCapability(capability);
+	aastar.setClearance(clearance);
+	aastar.limitSearchToClusterCorridor(true);
+	path* thepath = aastar.getPath(aMap, from, to);
+	updateSearchStats(aastar);
+	return thepath;
+}
+
+void AnnotatedHierarchicalAStar::updateSearchStats(AnnotatedAStar& alg)
+{
+	this->nodesExpanded += alg.getNodesExpanded();
+	this->nodesTouched += alg.getNodesTouched();
+	if(this->peakmemory < alg.getPeakMemory())
+		this->peakmemory = alg.getPeakMemory();
+	this->searchtime += alg.getSearchTime();
+}
+
 void AnnotatedHierarchicalAStar::logFinalStats(statCollection* stats)
 {
 	AnnotatedAStar::logFinalStats(stats);
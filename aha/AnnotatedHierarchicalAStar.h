@@ -12,6 +12,15 @@
 
 #include "AnnotatedAStar.h"
 
+#include <utility>
+#include <vector>
+
+namespace AHAStarUtil
+{
+	typedef std::pair<int, int> AgentType; // (capability, clearance)
+}
+
+class AnnotatedClusterAbstraction;
 class AnnotatedHierarchicalAStar : public AnnotatedAStar
 {
 	#ifdef UNITTEST
@@ -19,8 +28,11 @@ class AnnotatedHierarchicalAStar : public AnnotatedAStar
 	#endif
 	
 	public:	
+		virtual AbstractAnnotatedAStar* clone() { return new AnnotatedHierarchicalAStar(); }
 		virtual const char* getName() { return "AHAStar"; }
 		virtual path* getPath(graphAbstraction* aMap, node* from, node* to, reservationProvider *rp=0);
+		virtual void getPaths(graphAbstraction* aMap, node* from, node* to, 
+				const std::vector<AHAStarUtil::AgentType>& agents, std::vector<path*>& paths);
 		long getInsertNodesExpanded() { return insertNodesExpanded; }
 		long getInsertNodesTouched() { return insertNodesTouched; }
 		long getInsertPeakMemory() { return insertPeakMemory; }
@@ -33,8 +45,16 @@ class AnnotatedHierarchicalAStar : public AnnotatedAStar
 			return AnnotatedAStar::getPath(aMap, from, to); 			
 		}
 		virtual bool evaluate(node* n, node* target);
+		virtual void getAbstractPaths(graphAbstraction* aMap, node* from, node* to, 
+				const std::vector<AHAStarUtil::AgentType>& agents, std::vector<path*>& abspaths);
 		
 	private:		
+		path* refineAbstractPath(AnnotatedClusterAbstraction* aca, path* abspath, node* from, node* to, 
+				int capability, int clearance);
+		path* findPathInCluster(graphAbstraction* aMap, node* from, node* to, int capability, int clearance);
+		void updateSearchStats(AnnotatedAStar& alg);
+
+		AnnotatedAStar aastar; // low-level searches; reused so its search state is allocated only once
 		long insertNodesExpanded;
 		long insertNodesTouched;
 		long insertPeakMemory;
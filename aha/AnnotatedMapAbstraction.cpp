@@ -17,6 +17,10 @@
 	Each node has 1 clearance value annotation for each combination of individual terrain types.
 	Eg. If the basic terrain types are Ground and Trees then 2^n - 1 combinations of terrain exist and hence 2^n - n annotations are needed.
 
+	The annotations are computed in one sweep over the map by a ClearanceGrid. The grid is the only store of clearance: 
+	node::getClearance reads the value of the node's tile from it. By default every capability in AHAConstants is 
+	annotated; any other list of capabilities can be given to the constructor.
+
  *  hog
  *
  *  Created by Daniel Harabor on 5/12/07.
@@ -37,14 +41,14 @@
 #include "AHAConstants.h"
 #include "AnnotatedNodeFactory.h"
 #include "AnnotatedEdgeFactory.h"
+#include "ClearanceGrid.h"
+#include "ConnectedComponents.h"
 #include "graph.h"
 
 using namespace std;
 
 AbstractAnnotatedMapAbstraction::AbstractAnnotatedMapAbstraction(Map* m, AbstractAnnotatedAStar* alg) : mapAbstraction(m)
 {
-	std::cerr << "\nHAA* is currently broken. See http://code.google.com/p/ahastar/issues/detail?id=12 for more details";
-	exit(-1);
 	this->anf = new AnnotatedNodeFactory();
 	this->aef = new AnnotatedEdgeFactory();
 //	abstractions.push_back(getMapGraph(m, anf, aef));
@@ -55,75 +59,189 @@ AbstractAnnotatedMapAbstraction::AbstractAnnotatedMapAbstraction(Map* m, Abstrac
 
 AnnotatedMapAbstraction::AnnotatedMapAbstraction(Map* m, AbstractAnnotatedAStar* searchalg) : AbstractAnnotatedMapAbstraction(m, searchalg) 
 {
+	init(std::vector<int>(capabilities, capabilities+NUMCAPABILITIES));
+}
+
+AnnotatedMapAbstraction::AnnotatedMapAbstraction(Map* m, AbstractAnnotatedAStar* searchalg, 
+		const std::vector<int>& capabilities_) throw(std::invalid_argument) 
+	: AbstractAnnotatedMapAbstraction(m, searchalg) 
+{
+	init(capabilities_);
+}
+
+/* init
+	Annotates the map for the given capabilities. Any terrain bitmask is a capability.
+*/
+void AnnotatedMapAbstraction::init(const std::vector<int>& capabilities_) throw(std::invalid_argument)
+{
+	if(capabilities_.size() == 0)
+		throw std::invalid_argument("AnnotatedMapAbstraction: no capabilities given");
+
+	caps = capabilities_;
+	clearance = 0;
+	nummasks = 0;
 	annotateMap();
 	
 	drawCV=false; // disable drawing of clearance values
 }
 
+AnnotatedMapAbstraction::~AnnotatedMapAbstraction()
+{
+	delete clearance;
+	for(unsigned int i=0; i<components.size(); i++)
+		delete components[i];
+}
+
 /* annotateMap
 	Annotates the mapAbstraction with terrain and clearance value annotations 
 */
 void AnnotatedMapAbstraction::annotateMap() 
 {
+	// clearance is capped at 255; much larger than any agent we annotate for
+	delete clearance;
+	clearance = new ClearanceGrid(getMap(), caps, 255);
 
-	// clearance values is a recursive process; the bottom-right corner of the grid is the recursive base for all other calculations.
 	for(int x=getMap()->getMapWidth()-1;x>=0; x--)
 	{
 		for(int y=getMap()->getMapHeight()-1;y>=0; y--)
 		{
 			node* n = getNodeFromMap(x,y);
-			annotateNode(n);
-			n->setLabelL(kParent, -1);
+			if(n)
+			{
+				n->setTerrainType(getMap()->getTerrainType(x,y));
+				n->setClearanceGrid(clearance);
+				n->setLabelL(kParent, -1);
+			}
 		}
 	}
+
+	computeTraversalMasks();
 }
 
-void AnnotatedMapAbstraction::annotateNode(node* n)
+/* computeTraversalMasks
+	Precomputes, for every level 0 node and every capability/agentsize pair, which of the eight adjacent tiles an agent can move
+	to. A cardinal move is legal if the agent fits at the target; a diagonal move also requires the agent to fit at both cardinal
+	tiles it cuts between (see AnnotatedAStar::evaluate). The masks are stored one capability/agentsize pair after another.
+*/
+void AnnotatedMapAbstraction::computeTraversalMasks()
 {
-	if(n) // some tiles may not have corresponding nodes (HOG does not create node objects for tiles with type ('@'))
-	{	
+	graph* g = getAbstractGraph(0);
+	nummasks = g->getNumNodes();
+	masks.assign(nummasks*caps.size()*MAXAGENTSIZE, 0);
+
+	for(unsigned int num=0; num < nummasks; num++)
+	{
+		node* n = g->getNode(num);
 		int x = n->getLabelL(kFirstData);
 		int y = n->getLabelL(kFirstData+1);
-		n->setTerrainType(getMap()->getTerrainType(x,y)); //NB: duplicates map data but much easier to access; separate tiles/nodes sucks
-		int nterr = n->getTerrainType();
-		if(nterr != 0) // only want to consider nodes with valid terrain types
-		{	
-			node *adj1, *adj2, *adj3; // adjacent neighbours
-			adj1 = getNodeFromMap(x+1, y+1);
-			adj2 = getNodeFromMap(x+1,y);
-			adj3 = getNodeFromMap(x,y+1);
-			
-			if(adj1 && adj2 && adj3)
-			{	
-				/* one annotation per capability */
-				for(int i=0; i<NUMCAPABILITIES; i++) // NB: hard-coded assumption about # of valid terrains
-				{
-					/* only want to calculate annotations for capabilities that include the node's terrain type */
-					if((capabilities[i]&n->getTerrainType())==n->getTerrainType())
-					{
-						int min = adj1->getClearance(capabilities[i]);
-						min = adj2->getClearance(capabilities[i])<min?adj2->getClearance(capabilities[i]):min;
-						min = adj3->getClearance(capabilities[i])<min?adj3->getClearance(capabilities[i]):min;
-						n->setClearance(capabilities[i], min+1); // NB: +1 for minimum tile clearance
-					}
-					else
-						n->setClearance(capabilities[i], 0);
+		for(unsigned int i=0; i<caps.size(); i++)
+			for(int size=1; size<=MAXAGENTSIZE; size++)
+			{
+				int cap = caps[i];
+				unsigned short mask = 0;
+				bool north = canEnter(x, y-1, cap, size);
+				bool south = canEnter(x, y+1, cap, size);
+				bool east = canEnter(x+1, y, cap, size);
+				bool west = canEnter(x-1, y, cap, size);
+				if(north) mask |= 1<<kN;
+				if(south) mask |= 1<<kS;
+				if(east) mask |= 1<<kE;
+				if(west) mask |= 1<<kW;
+				if(north && east && canEnter(x+1, y-1, cap, size)) mask |= 1<<kNE;
+				if(north && west && canEnter(x-1, y-1, cap, size)) mask |= 1<<kNW;
+				if(south && east && canEnter(x+1, y+1, cap, size)) mask |= 1<<kSE;
+				if(south && west && canEnter(x-1, y+1, cap, size)) mask |= 1<<kSW;
+				masks[(i*MAXAGENTSIZE + size-1)*nummasks + num] = mask;
+			}
+	}
 
-				}
+	computeComponents();
+}
+
+/* computeComponents
+	Labels the connected components of the map for every capability/agentsize pair. Locations the agent can enter are 
+	joined with each neighbour its traversal mask allows it to move to. Diagonal moves need not be considered; each one 
+	is only legal if both cardinal moves around it are.
+*/
+void AnnotatedMapAbstraction::computeComponents()
+{
+	for(unsigned int i=0; i<components.size(); i++)
+		delete components[i];
+	components.assign(caps.size()*MAXAGENTSIZE, (ConnectedComponents*)NULL);
+
+	graph* g = getAbstractGraph(0);
+	int width = getMap()->getMapWidth();
+	int height = getMap()->getMapHeight();
+	for(unsigned int i=0; i<caps.size(); i++)
+		for(int size=1; size<=MAXAGENTSIZE; size++)
+		{
+			int index = i*MAXAGENTSIZE + size-1;
+			const unsigned short* moves = &masks[index*nummasks];
+			ConnectedComponents* cc = new ConnectedComponents(width, height);
+			for(unsigned int num=0; num < nummasks; num++)
+			{
+				node* n = g->getNode(num);
+				int x = n->getLabelL(kFirstData);
+				int y = n->getLabelL(kFirstData+1);
+				if(canEnter(x, y, caps[i], size))
+					cc->addLocation(x, y);
 			}
-			else // tile is on a border or perimeter boundary. clearance = 1
+			for(unsigned int num=0; num < nummasks; num++)
 			{
-				for(int i=0; i<NUMCAPABILITIES; i++) 
-				{
-					if((capabilities[i]&n->getTerrainType())==n->getTerrainType())
-						n->setClearance(capabilities[i], 1);
-					else
-						n->setClearance(capabilities[i], 0);
-				}
-
+				node* n = g->getNode(num);
+				int x = n->getLabelL(kFirstData);
+				int y = n->getLabelL(kFirstData+1);
+				if(moves[num] & (1<<kE))
+					cc->join(x, y, x+1, y);
+				if(moves[num] & (1<<kS))
+					cc->join(x, y, x, y+1);
 			}
+			cc->compact();
+			components[index] = cc;
 		}
-	}
+}
+
+/* getComponents
+	Returns the connected components for the given capability/agentsize pair, or NULL if they have not been computed.
+*/
+ConnectedComponents* AnnotatedMapAbstraction::getComponents(int capability, int agentsize)
+{
+	if(agentsize < 1 || agentsize > MAXAGENTSIZE || components.size() == 0)
+		return NULL;
+
+	int i = findCapability(capability);
+	if(i == -1)
+		return NULL;
+	return components[i*MAXAGENTSIZE + agentsize-1];
+}
+
+int AnnotatedMapAbstraction::findCapability(int capability)
+{
+	for(unsigned int i=0; i<caps.size(); i++)
+		if(caps[i] == capability)
+			return i;
+	return -1;
+}
+
+bool AnnotatedMapAbstraction::canEnter(int x, int y, int capability, int agentsize)
+{
+	node* n = getNodeFromMap(x, y);
+	return n && n->getClearance(capability) >= agentsize;
+}
+
+/* getTraversalMasks
+	Returns the traversal masks for the given capability/agentsize pair, indexed by node number, or NULL if no masks exist 
+	for the pair.
+*/
+const unsigned short* AnnotatedMapAbstraction::getTraversalMasks(int capability, int agentsize)
+{
+	if(agentsize < 1 || agentsize > MAXAGENTSIZE || masks.size() == 0)
+		return NULL;
+
+	int i = findCapability(capability);
+	if(i == -1)
+		return NULL;
+	return &masks[(i*MAXAGENTSIZE + agentsize-1)*nummasks];
 }
 
 /* addMissingEdges
@@ -181,15 +299,23 @@ void AbstractAnnotatedMapAbstraction::addMissingEdges()
 }
 
 /*	Determines if a valid solution exists between two locations given some size and terrain constraints 
-	NB: Unlike other HOG mapAbstractions, pathable is really difficult to do here; there's no actual abstraction going on; 
-	only a 1:1 node/tile representation which we annotate with clearance values for navigation.
-	Consequently, the only way to determine pathability is to run the search and see if it's OK -- so, not very useful for quickly
-	evaluating sets of locations!
+	Answered by comparing connected component labels (see computeComponents). Capability/agentsize pairs without labels 
+	fall back to running the search and seeing if it's OK -- not very useful for quickly evaluating sets of locations!
 	
 	Class is a building-block for AnnotatedClusterAbstraction (which handles the above much better)
 */
 bool AnnotatedMapAbstraction::pathable(node* from, node* to, int capability, int agentsize)
 {	
+	ConnectedComponents* cc = getComponents(capability, agentsize);
+	if(cc)
+	{
+		if(!from || !to || from->getUniqueID() == to->getUniqueID())
+			return false;
+		if(from->getClearance(capability) < agentsize || to->getClearance(capability) < agentsize)
+			return false;
+		return cc->connected(from, to);
+	}
+
 	AbstractAnnotatedAStar* aastar = dynamic_cast<AbstractAnnotatedAStar*>(getSearchAlgorithm());
 	assert(aastar != 0);
 	
@@ -21,6 +21,11 @@
 #include "AnnotatedNodeFactory.h"
 #include "AnnotatedEdgeFactory.h"
 
+#include <stdexcept>
+#include <vector>
+
+class ClearanceGrid;
+class ConnectedComponents;
 class graph;
 class node;
 class edge;
@@ -60,6 +65,9 @@ class AnnotatedMapAbstraction : public AbstractAnnotatedMapAbstraction
 		#endif
 
 		AnnotatedMapAbstraction(Map *m, AbstractAnnotatedAStar* searchalg);		
+		AnnotatedMapAbstraction(Map *m, AbstractAnnotatedAStar* searchalg, 
+				const std::vector<int>& capabilities) throw(std::invalid_argument);
+		virtual ~AnnotatedMapAbstraction();
 		virtual bool pathable(node* from, node* to, int terrain, int agentsize);
 		virtual void openGLDraw(); 
 	
@@ -74,9 +82,33 @@ class AnnotatedMapAbstraction : public AbstractAnnotatedMapAbstraction
 		void repairAbstraction() {}
 		mapAbstraction* clone(Map *) { return NULL; }
 
+		/* the capabilities annotated by annotateMap; nodes have clearance 0 for any other capability */
+		const std::vector<int>& getCapabilities() { return caps; }
+		/* clearance of every tile for each capability; read by node::getClearance */
+		ClearanceGrid* getClearanceGrid() { return clearance; }
+
+		/* traversal masks: one bitmask of legal moves (bit 1<<tDirection) 
+		   for each node at level 0 and each capability/agentsize pair. 
+		   recompute if node annotations are changed after annotateMap. */
+		void computeTraversalMasks();
+		const unsigned short* getTraversalMasks(int capability, int agentsize);
+		unsigned int getNumTraversalMasks() { return nummasks; }
+
+		/* connected components: computed with the traversal masks, one set of labels for each capability/agentsize pair.
+		   locations with different labels are not pathable for that pair. */
+		ConnectedComponents* getComponents(int capability, int agentsize);
 	
 	private:
-		void annotateNode(node*);
+		void init(const std::vector<int>& capabilities) throw(std::invalid_argument);
+		int findCapability(int capability);
+		bool canEnter(int x, int y, int capability, int agentsize);
+
+		std::vector<int> caps;
+		ClearanceGrid* clearance;
+		std::vector<unsigned short> masks;
+		unsigned int nummasks;
+		std::vector<ConnectedComponents*> components;
+		void computeComponents();
 		void drawClearanceInfo();
 		bool drawCV; 
 
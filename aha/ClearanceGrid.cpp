@@ -0,0 +1,134 @@
+/*
+ *  ClearanceGrid.cpp
+ *  hog
+ *
+ *  Created on 17/10/2026.
+ *
+ */
+
+#include "ClearanceGrid.h"
+#include "map.h"
+
+ClearanceGrid::ClearanceGrid(Map* m, const std::vector<int>& capabilities_,
+		int maxAgentSize_) throw(std::invalid_argument)
+{
+	if(m == 0)
+		throw std::invalid_argument("ClearanceGrid: map is null");
+	if(capabilities_.size() == 0)
+		throw std::invalid_argument("ClearanceGrid: no capabilities given");
+	if(maxAgentSize_ < 1 || maxAgentSize_ > 255)
+		throw std::invalid_argument("ClearanceGrid: maximum agent size must "
+				"be between 1 and 255");
+
+	map = m;
+	width = m->getMapWidth();
+	height = m->getMapHeight();
+	maxAgentSize = maxAgentSize_;
+	capabilities = capabilities_;
+	grid.resize(capabilities.size()*width*height, 0);
+
+	computeClearance();
+}
+
+ClearanceGrid::~ClearanceGrid()
+{
+}
+
+/* computeClearance
+	Recomputes the clearance grids of every capability from the terrain of 
+	the map. The terrain is read once and shared by all grids.
+*/
+void ClearanceGrid::computeClearance()
+{
+	if(width == 0 || height == 0)
+		return;
+
+	std::vector<int> terrain(width*height);
+	for(int y=0; y<height; y++)
+		for(int x=0; x<width; x++)
+			terrain[y*width + x] = map->getTerrainType(x, y);
+
+	for(unsigned int i=0; i<capabilities.size(); i++)
+		computeClearance(i, &terrain[0]);
+}
+
+/* computeClearance
+	The clearance of a traversable tile is one more than the minimum 
+	clearance of its S, E and SE neighbours. Each grid is filled in a single
+	sweep from the bottom-right corner to the top-left. 
+	
+	Every row is processed in two passes. The first bounds the clearance of
+	each tile by its terrain, the maximum agent size and its S and SE 
+	neighbours; no tile depends on another, so the loop vectorises. The 
+	second runs right to left and only folds in the E neighbour: 
+	row[x] = min(bound[x], row[x+1]+1). Tiles outside the map have 
+	clearance 0.
+*/
+void ClearanceGrid::computeClearance(int index, const int* terrain)
+{
+	int capability = capabilities.at(index);
+	unsigned char* cgrid = &grid[index*width*height];
+
+	std::vector<unsigned char> zero(width, 0);
+	std::vector<unsigned char> bound(width, 0);
+	for(int y=height-1; y>=0; y--)
+	{
+		unsigned char* row = cgrid + y*width;
+		const unsigned char* next = y+1 < height ? row + width : &zero[0];
+		const int* tiles = terrain + y*width;
+
+		for(int x=0; x<width-1; x++)
+		{
+			int below = next[x] < next[x+1] ? next[x] : next[x+1];
+			int value = below + 1 < maxAgentSize ? below + 1 : maxAgentSize;
+			bool traversable = tiles[x] != 0 && (tiles[x] & capability) == tiles[x];
+			bound[x] = traversable ? value : 0;
+		}
+		// the last column has no SE neighbour
+		int last = tiles[width-1];
+		bound[width-1] = last != 0 && (last & capability) == last ? 1 : 0;
+
+		int east = 0;
+		for(int x=width-1; x>=0; x--)
+		{
+			east = bound[x] < east + 1 ? bound[x] : east + 1;
+			row[x] = east;
+		}
+	}
+}
+
+int ClearanceGrid::getClearance(int x, int y, int capability)
+{
+	if(x < 0 || x >= width || y < 0 || y >= height)
+		return 0;
+
+	int index = findCapability(capability);
+	if(index == -1)
+		return 0;
+
+	return grid[index*width*height + y*width + x];
+}
+
+void ClearanceGrid::setClearance(int x, int y, int capability, int value)
+{
+	if(x < 0 || x >= width || y < 0 || y >= height)
+		return;
+
+	int index = findCapability(capability);
+	if(index == -1)
+		return;
+
+	if(value < 0)
+		value = 0;
+	if(value > maxAgentSize)
+		value = maxAgentSize;
+	grid[index*width*height + y*width + x] = value;
+}
+
+int ClearanceGrid::findCapability(int capability)
+{
+	for(unsigned int i=0; i<capabilities.size(); i++)
+		if(capabilities[i] == capability)
+			return i;
+	return -1;
+}
@@ -0,0 +1,60 @@
+/*
+ *  ClearanceGrid.h
+ *  hog
+ *
+	Dense clearance annotations for a map.
+
+	One grid of 8-bit clearance values is kept for each capability. A 
+	capability is a bitmask of terrain types; a tile is traversable by a
+	capability if its terrain type is non-zero and included in the mask.
+	Any number of capabilities can be annotated and clearance values are 
+	capped at a maximum agent size (at most 255); larger values carry no
+	extra information for agents no bigger than that.
+
+	Clearance is defined as in AnnotatedMapAbstraction: the size of the
+	largest obstacle-free square with its top-left corner at a given tile.
+ 
+ *  Created on 17/10/2026.
+ *
+ */
+
+#ifndef CLEARANCEGRID_H
+#define CLEARANCEGRID_H
+
+#include <stdexcept>
+#include <vector>
+
+class Map;
+class ClearanceGrid
+{
+	public:
+		ClearanceGrid(Map* m, const std::vector<int>& capabilities, 
+				int maxAgentSize) throw(std::invalid_argument);
+		~ClearanceGrid();
+
+		void computeClearance();
+
+		// 0 if the tile is not traversable or the capability is unknown
+		int getClearance(int x, int y, int capability);
+		// overrides a computed value, capped at the maximum agent size. 
+		// Ignored for unknown capabilities and tiles outside the map.
+		void setClearance(int x, int y, int capability, int value);
+
+		int getNumCapabilities() { return capabilities.size(); }
+		int getCapability(int index) { return capabilities.at(index); }
+		int getMaxAgentSize() { return maxAgentSize; }
+
+	private:
+		void computeClearance(int index, const int* terrain);
+		int findCapability(int capability);
+
+		Map* map;
+		int width, height;
+		int maxAgentSize;
+		std::vector<int> capabilities;
+
+		// one width*height grid per capability, stored row-major
+		std::vector<unsigned char> grid;
+};
+
+#endif
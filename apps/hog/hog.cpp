@@ -21,12 +21,20 @@
  */
 
 #include "aStar3.h"
+#include "ArcFlags.h"
+#include "ArcFlagsFilter.h"
+#include "CachedHeuristic.h"
+#include "CHSearch.h"
 #include "ClusterAStar.h"
 #include "ClusterAStar.h"
 #include "ClusterAStarFactory.h"
 #include "ClusterNodeFactory.h"
 #include "common.h"
+#include "CompressedPathDatabase.h"
+#include "ContractionHierarchy.h"
+#include "CPDSearch.h"
 #include "hog.h"
+#include "DeadEndFilter.h"
 #include "DefaultInsertionPolicy.h"
 #include "DefaultRefinementPolicy.h"
 #include "EdgeFactory.h"
@@ -42,7 +50,10 @@
 #include "JPAExpansionPolicy.h"
 #include "JumpPointAbstraction.h"
 #include "JumpPointsExpansionPolicy.h"
+#include "LandmarkHeuristicFactory.h"
+#include "LazyEdgesExpansionPolicy.h"
 #include "mapFlatAbstraction.h"
+#include "MacroEdgeFactory.h"
 #include "MacroNodeFactory.h"
 #include "ManhattanHeuristic.h"
 #include "NodeFactory.h"
@@ -51,14 +62,23 @@
 #include "OctileHeuristic.h"
 #include "EmptyClusterFactory.h"
 #include "RRExpansionPolicy.h"
+#include "RRJumpExpansionPolicy.h"
 #include "ScenarioManager.h"
 #include "searchUnit.h"
+#include "SelectiveExpansionPolicy.h"
 #include "statCollection.h"
+#include "SubgoalGraphAbstraction.h"
+#include "SubgoalInsertionPolicy.h"
+#include "SubgoalRefinementPolicy.h"
+#include "StreamingHierarchicalSearch.h"
+#include "VirtualOverlayExpansionPolicy.h"
+#include "WorkerThreads.h"
 
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 bool mouseTracking;
 int px1, py1, px2, py2;
@@ -71,10 +91,28 @@ bool verbose = false;
 bool allowDiagonals = true;
 bool reducePerimeter = false;
 bool bfReduction = false;
+bool lazyIntraEdges = false;
+bool adaptiveClusters = false;
+bool contractAbsGraph = false;
+bool pruneEdges = false;
+bool implicitSecondaryEdges = false;
+bool roomJumps = false;
+bool streamRefinement = false;
 bool checkOptimality = false;
+bool pruneDeadEnds = false;
+bool cacheHeuristic = false;
+unsigned int numLandmarks = 0;
 char* algName;
 HOG::AbstractionType absType = HOG::FLAT;
 
+// built or loaded on first use and shared by every search created for 
+// sharedDataMap; see useSharedDataFor
+mapAbstraction* sharedDataMap = 0;
+LandmarkHeuristicFactory* landmarkFactory = 0;
+CompressedPathDatabase* sharedCPD = 0;
+ArcFlags* sharedArcFlags = 0;
+std::vector<ContractionHierarchy*> sharedCH; // at most one per graph
+
 /**
  * This function is called each time a unitSimulation is deallocated to
  * allow any necessary stat processing beforehand
@@ -160,7 +198,15 @@ processStats(statCollection* stat, const char* unitname)
 		fprintf(f, "%.8f,\t", insst);
 
 	}
-	
+
+	if(cacheHeuristic)
+	{
+		double hitrate = 0;
+		if(stat->lookupStat("hCacheHitRate", unitname, val))
+			hitrate = val.fval;
+		fprintf(f, "%.3f,\t", hitrate);
+	}
+
 	if(getDisableGUI())
 	{
 		exists = stat->lookupStat("distanceMoved", unitname, val);
@@ -204,6 +250,18 @@ createSimulation(unitSimulation * &unitSim)
 		case HOG::JPA:
 			std::cout << "JPA";
 			break;
+		case HOG::CPD:
+			std::cout << "CPD";
+			break;
+		case HOG::SSG:
+			std::cout << "SSG";
+			break;
+		case HOG::CH:
+			std::cout << "CH";
+			break;
+		case HOG::AF:
+			std::cout << "AF";
+			break;
 		default:
 			std::cout << "Unknown?? Fix me!!";
 			break;
@@ -233,31 +291,60 @@ createSimulation(unitSimulation * &unitSim)
 		{
 			aMap = new HPAClusterAbstraction(map, new HPAClusterFactory(), 
 					new ClusterNodeFactory(), new EdgeFactory());
+			dynamic_cast<HPAClusterAbstraction*>(aMap)->setLazyIntraEdges(
+					lazyIntraEdges);
+			dynamic_cast<HPAClusterAbstraction*>(aMap)->setAdaptiveClusters(
+					adaptiveClusters);
 			dynamic_cast<HPAClusterAbstraction*>(aMap)->buildClusters();
 			dynamic_cast<HPAClusterAbstraction*>(aMap)->buildEntrances();
 			dynamic_cast<HPAClusterAbstraction*>(aMap)->clearColours();
+			if(pruneEdges)
+				std::cout << "pruned dominated edges: " << 
+					dynamic_cast<HPAClusterAbstraction*>(aMap)->
+					pruneDominatedEdges() << std::endl;
 			break;
 		}
 		case HOG::ERR:
 		{
 			aMap = new EmptyClusterAbstraction(map, 
 					new EmptyClusterFactory(), new MacroNodeFactory(),
-				   	new EdgeFactory(), allowDiagonals, reducePerimeter, 
+				   	new MacroEdgeFactory(), allowDiagonals, reducePerimeter, 
 					bfReduction);
 
 			dynamic_cast<EmptyClusterAbstraction*>(aMap)->setVerbose(verbose);
+			dynamic_cast<EmptyClusterAbstraction*>(aMap)->
+				setImplicitSecondaryEdges(implicitSecondaryEdges);
 			dynamic_cast<EmptyClusterAbstraction*>(aMap)->buildClusters();
 			dynamic_cast<EmptyClusterAbstraction*>(aMap)->buildEntrances();
 			dynamic_cast<EmptyClusterAbstraction*>(aMap)->clearColours();
+			if(pruneEdges)
+				std::cout << "pruned dominated edges: " << 
+					dynamic_cast<EmptyClusterAbstraction*>(aMap)->
+					pruneDominatedEdges() << std::endl;
 
 			break;
 		}
+		case HOG::AF:
+		{
+			// clusters only; their entrances are not needed
+			aMap = new HPAClusterAbstraction(map, new HPAClusterFactory(), 
+					new ClusterNodeFactory(), new EdgeFactory());
+			dynamic_cast<HPAClusterAbstraction*>(aMap)->buildClusters();
+			dynamic_cast<HPAClusterAbstraction*>(aMap)->clearColours();
+			break;
+		}
 		case HOG::JPA:
 		{
 			aMap = new JumpPointAbstraction(map, new NodeFactory(), 
 					new EdgeFactory(), verbose);
 			break;
 		}
+		case HOG::SSG:
+		{
+			aMap = new SubgoalGraphAbstraction(map, new NodeFactory(), 
+					new EdgeFactory(), verbose);
+			break;
+		}
 		default:
 			aMap = new mapFlatAbstraction(map);
 			break;
@@ -282,6 +369,12 @@ createSimulation(unitSimulation * &unitSim)
 			avgNodesPruned = ecmap->getAverageNodesPruned();
 			avgClusterSize = ecmap->getAverageClusterSize();
 		}
+		else if(dynamic_cast<HPAClusterAbstraction*>(aMap))
+		{
+			HPAClusterAbstraction* hpamap = 
+				dynamic_cast<HPAClusterAbstraction*>(aMap);
+			avgClusterSize = hpamap->getAverageClusterSize();
+		}
 
 		FILE *f = fopen(ss.str().c_str(), "a+");
 		fprintf(f, "%i,\t%i,\t", g->getNumNodes(), g->getNumEdges());
@@ -407,6 +500,7 @@ gogoGadgetNOGUIScenario(mapAbstraction* aMap)
 	}
 	
 	delete alg;
+	releaseSharedData();
 	delete aMap;
 
 	if(checkOptimality)
@@ -506,21 +600,67 @@ initializeHandlers()
 			"Disallow diagonal moves during search "
 			"(default = false)");
 
+	installCommandLineHandler(myAllPurposeCLHandler, "-prune", "-prune", 
+			"Remove dominated edges from hpa and err abstract graphs "
+			"(default = false)");
+
+	installCommandLineHandler(myAllPurposeCLHandler, "-implicit", "-implicit", 
+			"Generate err secondary edges during search instead of storing "
+			"them; use with err_bfr or err_pr_bfr (default = false)");
+
+	installCommandLineHandler(myAllPurposeCLHandler, "-stream", "-stream", 
+			"Units refine hierarchical paths one abstract segment at a time "
+			"(default = false)");
+
 	installCommandLineHandler(myAllPurposeCLHandler, "-checkopt", "-checkopt", 
 			"Verify each experiment ran is solved optimally."
 			"(default = false)");
 
+	installCommandLineHandler(myAllPurposeCLHandler, "-deadends", "-deadends", 
+			"Skip dead ends (regions behind a narrow entrance) which hold "
+			"neither start nor goal; use with hpa or err (default = false)");
+
+	installCommandLineHandler(myAllPurposeCLHandler, "-landmarks", 
+			"-landmarks [number of landmarks]", 
+			"Use a differential heuristic over the given number of landmarks "
+			"instead of the octile or manhattan distance; tables are saved as "
+			"<map>.landmarks (default = off)");
+
+	installCommandLineHandler(myAllPurposeCLHandler, "-hcache", "-hcache", 
+			"Remember heuristic values between queries to the same goal; "
+			"pays off with -landmarks, where each value costs a lookup per "
+			"landmark, but not with the octile distance (default = false)");
+
+	installCommandLineHandler(myAllPurposeCLHandler, "-threads", 
+			"-threads [number of threads]", 
+			"Build abstractions on the given number of threads "
+			"(default = number of processors)");
+
 	installCommandLineHandler(myAllPurposeCLHandler, "-abs", 
-			"-abs [flat | flatjump | hpa | err | err_pr | err_bfr | err_pr_bfr]", 
+			"-abs [flat | flatjump | hpa | hpa_lazy | hpa_adaptive | hpa_ch | err | err_pr | err_bfr | err_pr_bfr | err_jump | ssg | cpd | ch | af]", 
 			"Abstraction Type:\n"
 			"\tflat = no abstraction (default)\n"
 			"\tflatjump = like flat but use jump points to speed search\n"
 			"\thpa = hpa cluster abstraction (cluster size = 10x10)\n"
+			"\thpa_lazy = hpa with intra-edge costs computed on first use\n"
+			"\thpa_adaptive = hpa with clusters sized by obstacle density "
+			"and entrance count (5x5 to 40x40)\n"
+			"\thpa_ch = hpa with abstract paths found by a contraction "
+			"hierarchy (built and saved as <map>.hpa.ch if not found)\n"
 			"\terr = empty rectangular rooms abstraction\n"
 			"\terr_pr = err with perimeter reduction\n"
 			"\terr_bfr = err with branching factor optimisations\n"
 			"\terr_pr_bfr = err with both perimeter reduction and branching "
-			"factor optimisations\n");
+			"factor optimisations\n"
+			"\terr_jump = like flatjump but use err rooms to speed up "
+			"jump point scans\n"
+			"\tssg = simple subgoal graph; subgoals at obstacle corners\n"
+			"\tcpd = no abstraction; paths are read from a compressed path "
+			"database (built and saved as <map>.cpd if not found)\n"
+			"\tch = no abstraction; paths are found by a contraction "
+			"hierarchy (built and saved as <map>.ch if not found)\n"
+			"\taf = no abstraction; search is limited by arc flags over "
+			"hpa clusters (built and saved as <map>.arcflags if not found)\n");
 
 	installMouseClickHandler(myClickHandler);
 }
@@ -544,11 +684,62 @@ myAllPurposeCLHandler(char* argument[], int maxNumArgs)
 		verbose = true;
 		argsParsed++;
 	}
+	else if(strcmp(argument[0], "-prune") == 0)
+	{
+		pruneEdges = true;
+		argsParsed++;
+	}
+	else if(strcmp(argument[0], "-implicit") == 0)
+	{
+		implicitSecondaryEdges = true;
+		argsParsed++;
+	}
+	else if(strcmp(argument[0], "-stream") == 0)
+	{
+		streamRefinement = true;
+		argsParsed++;
+	}
 	else if(strcmp(argument[0], "-checkopt") == 0)
 	{
 		checkOptimality = true;
 		argsParsed++;
 	}
+	else if(strcmp(argument[0], "-deadends") == 0)
+	{
+		pruneDeadEnds = true;
+		argsParsed++;
+	}
+	else if(strcmp(argument[0], "-landmarks") == 0)
+	{
+		argsParsed++;
+		int num = maxNumArgs > 1 ? atoi(argument[1]) : 0;
+		if(num <= 0)
+		{
+			std::cout << "-landmarks: number of landmarks must be positive.\n";
+			printCommandLineArguments();
+			exit(1);
+		}
+		numLandmarks = num;
+		argsParsed++;
+	}
+	else if(strcmp(argument[0], "-hcache") == 0)
+	{
+		cacheHeuristic = true;
+		argsParsed++;
+	}
+	else if(strcmp(argument[0], "-threads") == 0)
+	{
+		argsParsed++;
+		int num = maxNumArgs > 1 ? atoi(argument[1]) : 0;
+		if(num <= 0)
+		{
+			std::cout << "-threads: number of threads must be positive.\n";
+			printCommandLineArguments();
+			exit(1);
+		}
+		WorkerThreads::setNumThreads(num);
+		argsParsed++;
+	}
 	else if(strcmp(argument[0], "-abs") == 0)
 	{
 		argsParsed++;
@@ -557,6 +748,24 @@ myAllPurposeCLHandler(char* argument[], int maxNumArgs)
 			absType = HOG::HPA; 
 			argsParsed++;
 		}
+		else if(strcmp(argument[1], "hpa_lazy") == 0)
+		{
+			argsParsed++;
+			absType = HOG::HPA; 
+			lazyIntraEdges = true;
+		}
+		else if(strcmp(argument[1], "hpa_adaptive") == 0)
+		{
+			argsParsed++;
+			absType = HOG::HPA; 
+			adaptiveClusters = true;
+		}
+		else if(strcmp(argument[1], "hpa_ch") == 0)
+		{
+			argsParsed++;
+			absType = HOG::HPA; 
+			contractAbsGraph = true;
+		}
 		else if(strcmp(argument[1], "err") == 0)
 		{
 			argsParsed++;
@@ -581,6 +790,12 @@ myAllPurposeCLHandler(char* argument[], int maxNumArgs)
 			bfReduction = true;
 			reducePerimeter = true;
 		}
+		else if(strcmp(argument[1], "err_jump") == 0)
+		{
+			argsParsed++;
+			absType = HOG::ERR; 
+			roomJumps = true;
+		}
 		else if(strcmp(argument[1], "flat") == 0)
 		{
 			argsParsed++;
@@ -596,6 +811,26 @@ myAllPurposeCLHandler(char* argument[], int maxNumArgs)
 			argsParsed++;
 			absType = HOG::JPA;
 		}
+		else if(strcmp(argument[1], "ssg") == 0)
+		{
+			argsParsed++;
+			absType = HOG::SSG;
+		}
+		else if(strcmp(argument[1], "cpd") == 0)
+		{
+			argsParsed++;
+			absType = HOG::CPD;
+		}
+		else if(strcmp(argument[1], "ch") == 0)
+		{
+			argsParsed++;
+			absType = HOG::CH;
+		}
+		else if(strcmp(argument[1], "af") == 0)
+		{
+			argsParsed++;
+			absType = HOG::AF;
+		}
 		else
 		{
 			std::cout << argument[1] << ": invalid abstraction type.\n";
@@ -753,14 +988,14 @@ myNewUnitKeyHandler(unitSimulation *unitSim, tKeyboardModifier mod, char)
 		{
 			astar = newSearchAlgorithm(aMap); 
 			astar->verbose = verbose;
-			unitSim->addUnit(u=new searchUnit(x2, y2, targ, astar)); 
+			unitSim->addUnit(u=newSearchUnit(x2, y2, targ, astar)); 
 			u->setColor(0.3,0.7,0.3);
 			targ->setColor(0.3,0.7,0.3);
 			break;
 		}
 		default:
 		{
-			astar = new FlexibleAStar(newExpansionPolicy(aMap), newHeuristic());	
+			astar = new FlexibleAStar(newExpansionPolicy(aMap), newHeuristic(aMap));	
 			astar->verbose = verbose;
 			unitSim->addUnit(u=new searchUnit(x2, y2, targ, astar)); 
 			u->setColor(1,1,0);
@@ -822,7 +1057,7 @@ runNextExperiment(unitSimulation *unitSim)
 	searchAlgorithm* alg = newSearchAlgorithm(aMap, true); 
 	alg->verbose = verbose;
 	algName = (char*)alg->getName();
-	nextUnit = new searchUnit(nextExperiment->getStartX(), 
+	nextUnit = newSearchUnit(nextExperiment->getStartX(), 
 			nextExperiment->getStartY(), nextTarget, alg); 
 	nextUnit->setColor(0.1,0.1,0.5);
 	nextTarget->setColor(0.1,0.1,0.5);
@@ -838,31 +1073,67 @@ runNextExperiment(unitSimulation *unitSim)
 	expnum++;
 }
 
+// Hierarchical searches are streamed to the unit one refined segment at a 
+// time when -stream is given. 
+searchUnit*
+newSearchUnit(int x, int y, unit* target, searchAlgorithm* alg)
+{
+	HierarchicalSearch* hsearch = dynamic_cast<HierarchicalSearch*>(alg);
+	if(streamRefinement && hsearch)
+	{
+		StreamingHierarchicalSearch* ssearch = 
+			new StreamingHierarchicalSearch(hsearch);
+		ssearch->verbose = verbose;
+		return new searchUnit(x, y, target, ssearch);
+	}
+	return new searchUnit(x, y, target, alg);
+}
+
 ExpansionPolicy* 
 newExpansionPolicy(mapAbstraction* map)
 {
 	ExpansionPolicy* policy;
 	if(bfReduction)
 		policy = new RRExpansionPolicy(map);
+	else if(lazyIntraEdges)
+		policy = new LazyEdgesExpansionPolicy(
+				dynamic_cast<GenericClusterAbstraction*>(map));
 	else
 		policy = new IncidentEdgesExpansionPolicy(map);
+
+	SelectiveExpansionPolicy* selective = 
+		dynamic_cast<SelectiveExpansionPolicy*>(policy);
+	GenericClusterAbstraction* clusters = 
+		dynamic_cast<GenericClusterAbstraction*>(map);
+	if(pruneDeadEnds && selective && clusters)
+		selective->addFilter(new DeadEndFilter(clusters));
 	return policy;
 }
 
-Heuristic* newHeuristic()
+Heuristic* newHeuristic(mapAbstraction* aMap)
 {
 	Heuristic* h;
-	if(allowDiagonals)
+	if(numLandmarks > 0)
+	{
+		useSharedDataFor(aMap);
+		if(landmarkFactory == 0)
+			landmarkFactory = new LandmarkHeuristicFactory(aMap, numLandmarks);
+		h = landmarkFactory->newHeuristic();
+	}
+	else if(allowDiagonals)
 		h = new OctileHeuristic();
 	else
 		h = new ManhattanHeuristic();
 
+	if(cacheHeuristic)
+		h = new CachedHeuristic(h);
 	return h;
 }
 
 searchAlgorithm*
 newSearchAlgorithm(mapAbstraction* aMap, bool refineAbsPath)
 {
+	useSharedDataFor(aMap);
 	searchAlgorithm* alg = 0;
 	switch(absType)
 	{
@@ -870,9 +1141,20 @@ newSearchAlgorithm(mapAbstraction* aMap, bool refineAbsPath)
 		{
 			GenericClusterAbstraction* map = 
 				dynamic_cast<GenericClusterAbstraction*>(aMap);
+			if(contractAbsGraph)
+			{
+				std::string filename(map->getMap()->getMapName());
+				alg = new HierarchicalSearch(new DefaultInsertionPolicy(map),
+						new CHSearch(getContractionHierarchy(
+								map->getAbstractGraph(1), filename + ".hpa.ch")),
+						new DefaultRefinementPolicy(map));
+				((HierarchicalSearch*)alg)->setName("HPACH");
+				alg->verbose = verbose;
+				break;
+			}
 			alg = new HierarchicalSearch(new DefaultInsertionPolicy(map),
 					new FlexibleAStar(newExpansionPolicy(map), 
-						newHeuristic()),
+						newHeuristic(aMap)),
 					new DefaultRefinementPolicy(map));
 			((HierarchicalSearch*)alg)->setName("HPA");
 			alg->verbose = verbose;
@@ -882,9 +1164,22 @@ newSearchAlgorithm(mapAbstraction* aMap, bool refineAbsPath)
 		{
 			EmptyClusterAbstraction* map = 
 				dynamic_cast<EmptyClusterAbstraction*>(aMap);
-			alg = new HierarchicalSearch(new EmptyClusterInsertionPolicy(map),
-					new FlexibleAStar(newExpansionPolicy(map), 
-						newHeuristic()),
+			if(roomJumps)
+			{
+				alg = new HierarchicalSearch(new NoInsertionPolicy(),
+						new FlexibleAStar(new RRJumpExpansionPolicy(map), 
+							newHeuristic(aMap)),
+						new OctileDistanceRefinementPolicy(map));
+				((HierarchicalSearch*)alg)->setName("RSRJPS");
+				alg->verbose = verbose;
+				break;
+			}
+			EmptyClusterInsertionPolicy* insertion = 
+				new EmptyClusterInsertionPolicy(map);
+			alg = new HierarchicalSearch(insertion,
+					new FlexibleAStar(new VirtualOverlayExpansionPolicy(
+							newExpansionPolicy(map), insertion), 
+						newHeuristic(aMap)),
 					new OctileDistanceRefinementPolicy(map));
 			((HierarchicalSearch*)alg)->setName("RSR");
 			alg->verbose = verbose;
@@ -896,7 +1191,7 @@ newSearchAlgorithm(mapAbstraction* aMap, bool refineAbsPath)
 			alg = new HierarchicalSearch(new NoInsertionPolicy(),
 						new FlexibleAStar(
 							new JumpPointsExpansionPolicy(), 
-								newHeuristic()),
+								newHeuristic(aMap)),
 						new OctileDistanceRefinementPolicy(aMap));
 			((HierarchicalSearch*)alg)->setName("JPS");
 			alg->verbose = verbose;
@@ -907,19 +1202,159 @@ newSearchAlgorithm(mapAbstraction* aMap, bool refineAbsPath)
 			alg = new HierarchicalSearch(new NoInsertionPolicy(),
 						new FlexibleAStar(
 							new JPAExpansionPolicy(), 
-								newHeuristic()),
+								newHeuristic(aMap)),
 						new OctileDistanceRefinementPolicy(aMap));
 			((HierarchicalSearch*)alg)->setName("JPAS");
 			alg->verbose = verbose;
 			break;
 		}
+		case HOG::SSG:
+		{
+			SubgoalGraphAbstraction* map = 
+				dynamic_cast<SubgoalGraphAbstraction*>(aMap);
+			alg = new HierarchicalSearch(new SubgoalInsertionPolicy(map),
+						new FlexibleAStar(
+							new IncidentEdgesExpansionPolicy(map), 
+								newHeuristic(aMap)),
+						new SubgoalRefinementPolicy(map));
+			((HierarchicalSearch*)alg)->setName("SSG");
+			alg->verbose = verbose;
+			break;
+		}
+		case HOG::CPD:
+		{
+			alg = new CPDSearch(getCompressedPathDatabase(aMap));
+			alg->verbose = verbose;
+			break;
+		}
+		case HOG::CH:
+		{
+			std::string filename(aMap->getMap()->getMapName());
+			alg = new CHSearch(getContractionHierarchy(
+						aMap->getAbstractGraph(0), filename + ".ch"));
+			alg->verbose = verbose;
+			break;
+		}
+
+		case HOG::AF:
+		{
+			IncidentEdgesExpansionPolicy* policy = 
+				new IncidentEdgesExpansionPolicy(aMap);
+			policy->addFilter(new ArcFlagsFilter(getArcFlags(
+							dynamic_cast<GenericClusterAbstraction*>(aMap))));
+			alg = new FlexibleAStar(policy, newHeuristic(aMap));
+			alg->verbose = verbose;
+			break;
+		}
 
 		default:
 		{
-			alg = new FlexibleAStar(newExpansionPolicy(aMap), newHeuristic());
+			alg = new FlexibleAStar(newExpansionPolicy(aMap), newHeuristic(aMap));
 			alg->verbose = verbose;
 			break;
 		}
 	}
 	return alg;
 }
+
+// Returns the contraction hierarchy of g. The first call for g loads it
+// from filename, or builds it and saves it there if it cannot be loaded.
+ContractionHierarchy*
+getContractionHierarchy(graph* g, const std::string& filename)
+{
+	for(unsigned int i=0; i<sharedCH.size(); i++)
+		if(sharedCH[i]->getGraph() == g)
+			return sharedCH[i];
+
+	ContractionHierarchy* ch = new ContractionHierarchy(g);
+	if(!ch->load(filename.c_str()))
+	{
+		ch->build();
+		try
+		{
+			ch->save(filename.c_str());
+		}
+		catch(std::invalid_argument& e)
+		{
+			std::cout << e.what() << std::endl;
+		}
+	}
+	sharedCH.push_back(ch);
+	return ch;
+}
+
+// Returns the compressed path database of the map. The first call loads 
+// it from the default file, or builds it and saves it there.
+CompressedPathDatabase*
+getCompressedPathDatabase(mapAbstraction* aMap)
+{
+	if(sharedCPD)
+		return sharedCPD;
+
+	sharedCPD = new CompressedPathDatabase(aMap);
+	std::string filename = sharedCPD->getDefaultFileName();
+	if(!sharedCPD->load(filename.c_str()))
+	{
+		sharedCPD->build();
+		try
+		{
+			sharedCPD->save(filename.c_str());
+		}
+		catch(std::invalid_argument& e)
+		{
+			std::cout << e.what() << std::endl;
+		}
+	}
+	return sharedCPD;
+}
+
+// Returns the arc flags of the map's clusters. The first call loads them
+// from the default file, or builds them and saves them there.
+ArcFlags*
+getArcFlags(GenericClusterAbstraction* map)
+{
+	if(sharedArcFlags)
+		return sharedArcFlags;
+
+	sharedArcFlags = new ArcFlags(map);
+	std::string filename = sharedArcFlags->getDefaultFileName();
+	if(!sharedArcFlags->load(filename.c_str()))
+	{
+		sharedArcFlags->build();
+		try
+		{
+			sharedArcFlags->save(filename.c_str());
+		}
+		catch(std::invalid_argument& e)
+		{
+			std::cout << e.what() << std::endl;
+		}
+	}
+	return sharedArcFlags;
+}
+
+// Discards the data shared between searches if it was made for another
+// map. Searches using it must have been deleted.
+void
+useSharedDataFor(mapAbstraction* aMap)
+{
+	if(aMap == sharedDataMap)
+		return;
+	releaseSharedData();
+	sharedDataMap = aMap;
+}
+
+void
+releaseSharedData()
+{
+	delete landmarkFactory;
+	landmarkFactory = 0;
+	delete sharedCPD;
+	sharedCPD = 0;
+	delete sharedArcFlags;
+	sharedArcFlags = 0;
+	for(unsigned int i=0; i<sharedCH.size(); i++)
+		delete sharedCH[i];
+	sharedCH.clear();
+	sharedDataMap = 0;
+}
@@ -17,15 +17,21 @@
  *
  */
 
+class ArcFlags;
+class CompressedPathDatabase;
+class ContractionHierarchy;
+class GenericClusterAbstraction;
+class graph;
 class Heuristic;
 class ExpansionPolicy;
 class mapAbstraction;
+class searchUnit;
 
 namespace HOG
 {
 	typedef enum
 	{ 
-		HPA, ERR, FLAT, FLATJUMP, JPA
+		HPA, ERR, FLAT, FLATJUMP, JPA, CPD, SSG, CH, AF
 	} 
 	AbstractionType;
 }
@@ -40,7 +46,14 @@ bool myClickHandler(unitSimulation *, int x, int y, point3d loc, tButtonType, tM
 void runNextExperiment(unitSimulation *unitSim);
 void processStats(statCollection* stat, const char* unitname);
 void gogoGadgetNOGUIScenario(mapAbstraction* ecmap);
+searchUnit* newSearchUnit(int x, int y, unit* target, searchAlgorithm* alg);
 ExpansionPolicy* newExpansionPolicy(mapAbstraction* map);
-Heuristic* newHeuristic();
+Heuristic* newHeuristic(mapAbstraction* map);
 searchAlgorithm* newSearchAlgorithm(mapAbstraction* aMap, bool refine=true);
+ContractionHierarchy* getContractionHierarchy(graph* g, 
+		const std::string& filename);
+CompressedPathDatabase* getCompressedPathDatabase(mapAbstraction* aMap);
+ArcFlags* getArcFlags(GenericClusterAbstraction* map);
+void useSharedDataFor(mapAbstraction* aMap);
+void releaseSharedData();
 
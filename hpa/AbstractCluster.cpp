@@ -140,6 +140,23 @@ AbstractCluster::addNode(node* n_) throw(std::invalid_argument)
 	nodes[n->getUniqueID()] = n;
 }
 
+// removeNode is responsible for unassigning nodes which are no longer
+// traversable. NB: any parent of the node must be removed beforehand.
+void
+AbstractCluster::removeNode(node* n_)
+{
+	ClusterNode* n = dynamic_cast<ClusterNode*>(n_);
+	if(n == 0)
+		return;
+
+	HPAUtil::nodeTable::iterator it = nodes.find(n->getUniqueID());
+	if(it == nodes.end())
+		return;
+
+	n->setParentClusterId(-1);
+	nodes.erase(it);
+}
+
 // a transition point connects two nodes on the map. usually the nodes are on the
 // border of two adjacent clusters (in which case the transition results in an
 // inter-edge being created) but this is not necessary.
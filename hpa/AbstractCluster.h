@@ -32,10 +32,20 @@ class AbstractCluster
 		virtual void buildEntrances() = 0;
 		virtual void connectParent(node*) 
 			throw(std::invalid_argument) = 0;
+
+		// rebuilds every entrance of the cluster after its nodes have 
+		// changed. the default is only correct for clusters that build 
+		// entrances along all of their borders.
+		virtual void repairEntrances() { buildEntrances(); }
+
+		// replaces the lower bound weight of a lazy intra-edge with its real 
+		// cost. clusters which build lazy intra-edges must override this.
+		virtual void resolveEdge(edge*) { }
 	
 		// methods for managing nodes associated with the cluster
 		virtual void addNode(node* n) 
 			throw(std::invalid_argument);
+		virtual void removeNode(node* n);
 		virtual void addParent(node*) 
 			throw(std::invalid_argument);
 		virtual void removeParent(node* n);
@@ -7,16 +7,34 @@
 #include "IncidentEdgesExpansionPolicy.h"
 #include "OctileHeuristic.h"
 #include "path.h"
-#include "timer.h"
 
 DefaultRefinementPolicy::DefaultRefinementPolicy(mapAbstraction* _map)
 		: RefinementPolicy(_map)
 {
 	verbose = false;
+	cf = 0;
+	astar = 0;
 }
 
 DefaultRefinementPolicy::~DefaultRefinementPolicy()
 {
+	delete astar; // also deletes policy and filter
+}
+
+// Each refinement uses a new search whose cluster filter accumulates the 
+// clusters of every segment refined so far.
+void
+DefaultRefinementPolicy::beginRefinement(path* abspath)
+{
+	RefinementPolicy::beginRefinement(abspath);
+
+	delete astar;
+	cf = new ReverseClusterFilter();
+	IncidentEdgesExpansionPolicy* policy = new IncidentEdgesExpansionPolicy(map);
+	policy->addFilter(cf);
+	astar = new FlexibleAStar(policy, new OctileHeuristic());
+	astar->verbose = false; 
+	astar->markForVis = false;
 }
 
 // NB: there is bug when trying to visualise all nodes expanded during
@@ -27,85 +45,35 @@ DefaultRefinementPolicy::~DefaultRefinementPolicy()
 // not correct until we can somehow represent nodes that have been 
 // expanded multiple times (once per refinement).
 path*
-DefaultRefinementPolicy::refine(path* abspath)
+DefaultRefinementPolicy::refineSegment(node* start, node* goal)
 {
-	resetMetrics();
-
-	ReverseClusterFilter *cf = new ReverseClusterFilter();
-	IncidentEdgesExpansionPolicy* policy = new IncidentEdgesExpansionPolicy(map);
-	policy->addFilter(cf);
-	FlexibleAStar *astar = new FlexibleAStar(policy, new OctileHeuristic());
-	astar->verbose = false; 
-	astar->markForVis = false;
-
-	Timer t;
-	t.startTimer();
-	//std::cout << "refining path: \n";
-	//DebugUtility debuug(map, astar->getHeuristic());
-	//debuug.printPath(abspath); 
-	//std::cout << std::endl;
-	if(abspath == 0)
-		return 0;
-
-	path* thepath = 0;
-	path* tail = 0;
-	for(path* current = abspath; current->next != 0; current = current->next)
+	// limit search to the two clusters the start and goal are located in
+	if(dynamic_cast<ClusterNode*>(start))
 	{
-		node* start = map->getNodeFromMap(
-				current->n->getLabelL(kFirstData), 
-				current->n->getLabelL(kFirstData+1));
-		node* goal =  map->getNodeFromMap(
-				current->next->n->getLabelL(kFirstData), 
-				current->next->n->getLabelL(kFirstData+1));
-
-		// limit search to the two clusters the start and goal are located in
-		if(dynamic_cast<ClusterNode*>(start))
-		{
-			int parentClusterId = dynamic_cast<ClusterNode*>(start)->getParentClusterId();
-			if(parentClusterId != -1)
-				cf->addTargetCluster(parentClusterId);
-		}
-		if(dynamic_cast<ClusterNode*>(goal))
-		{
-			int parentClusterId = dynamic_cast<ClusterNode*>(goal)->getParentClusterId();
-			if(parentClusterId != -1)
-				cf->addTargetCluster(parentClusterId);
-		}
-
-		path* segment = astar->getPath(map, start, goal); 
-
-		nodesExpanded += astar->getNodesExpanded();
-		nodesTouched += astar->getNodesTouched();
-		nodesGenerated += astar->getNodesGenerated();
+		int parentClusterId = dynamic_cast<ClusterNode*>(start)->getParentClusterId();
+		if(parentClusterId != -1)
+			cf->addTargetCluster(parentClusterId);
+	}
+	if(dynamic_cast<ClusterNode*>(goal))
+	{
+		int parentClusterId = dynamic_cast<ClusterNode*>(goal)->getParentClusterId();
+		if(parentClusterId != -1)
+			cf->addTargetCluster(parentClusterId);
+	}
 
-		if(verbose) 
-		{
-			std::cout << "refined segment: "<<std::endl; 
-			DebugUtility debug(map, astar->getHeuristic());
-			debug.printPath(segment); 
-			std::cout << " distance: "<<map->distance(segment)<<std::endl; 
-		}
+	path* segment = astar->getPath(map, start, goal); 
 
-		// append segment to refined path
-		if(thepath == 0)
-		{
-			thepath = segment;										
-			tail = segment->tail();
-		}
+	nodesExpanded += astar->getNodesExpanded();
+	nodesTouched += astar->getNodesTouched();
+	nodesGenerated += astar->getNodesGenerated();
 
-		//avoid overlap between successive segments 
-		//(i.e one segment ends with the same node as the next begins)
-		if(tail->n->getNum() == segment->n->getNum()) 
-		{
-			tail->next = segment->next;
-			tail = segment->tail();
-			segment->next = 0;
-			delete segment;
-		}
+	if(verbose) 
+	{
+		std::cout << "refined segment: "<<std::endl; 
+		DebugUtility debug(map, astar->getHeuristic());
+		debug.printPath(segment); 
+		std::cout << " distance: "<<map->distance(segment)<<std::endl; 
 	}
 
-	searchTime = t.endTimer();
-	delete astar; // also deletes policy and filter
-
-	return thepath;
+	return segment;
 }
@@ -5,19 +5,26 @@
 
 class FlexibleAStar;
 class mapAbstraction;
+class node;
 class path;
+class ReverseClusterFilter;
 class DefaultRefinementPolicy : public RefinementPolicy
 {
 	public:
 		DefaultRefinementPolicy(mapAbstraction* _map);
 		virtual ~DefaultRefinementPolicy();
 
-		virtual path* refine(path* abspath);
+		virtual void beginRefinement(path* abspath);
 		inline void setVerbose(bool _verbose) { verbose = _verbose; }
 		inline bool getVerbose() { return verbose; }
 
+	protected:
+		virtual path* refineSegment(node* start, node* goal);
+
 	private:
 		bool verbose;
+		ReverseClusterFilter* cf;
+		FlexibleAStar* astar;
 };
 
 
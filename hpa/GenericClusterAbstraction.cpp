@@ -1,13 +1,19 @@
 #include "GenericClusterAbstraction.h"
 
 #include "ClusterNode.h"
+#include "ConnectedComponents.h"
 #include "IClusterFactory.h"
 #include "IEdgeFactory.h"
 #include "INodeFactory.h"
 #include "ManhattanHeuristic.h"
 #include "OctileHeuristic.h"
 
+#include "fpUtil.h"
 #include "graph.h"
+#include "map.h"
+
+#include <cstdio>
+#include <vector>
 
 GenericClusterAbstraction::GenericClusterAbstraction(Map* m, IClusterFactory* cf, 
 		INodeFactory* nf, IEdgeFactory* ef, bool allowDiagonals_) throw(std::invalid_argument)
@@ -28,8 +34,14 @@ GenericClusterAbstraction::GenericClusterAbstraction(Map* m, IClusterFactory* cf
 		
 	abstractions.push_back(getMapGraph(this->getMap(), nf, ef, allowDiagonals)); 
 	abstractions.push_back(new graph());	
+	components = new ConnectedComponents(getMap()->getMapWidth(), 
+			getMap()->getMapHeight());
+	components->label(abstractions[0]);
+	componentsValid = true;
 	drawClusters=true;
 	verbose = false;
+	lazyIntraEdges = false;
+	numEdgesResolved = 0;
 
 	if(allowDiagonals)
 		heuristic = new OctileHeuristic();
@@ -51,6 +63,7 @@ GenericClusterAbstraction::~GenericClusterAbstraction()
 	delete cf;
 	delete nf;
 	delete heuristic;
+	delete components;
 }
 
 double 
@@ -59,6 +72,19 @@ GenericClusterAbstraction::h(node *a, node *b)
 	return heuristic->h(a, b);
 }
 
+// Nodes at any level can be compared; each is looked up by its location.
+// The labels are recomputed on first use after the map graph changes.
+bool
+GenericClusterAbstraction::pathable(node* from, node* to)
+{
+	if(!componentsValid)
+	{
+		components->label(abstractions[0]);
+		componentsValid = true;
+	}
+	return components->connected(from, to);
+}
+
 AbstractCluster* 
 GenericClusterAbstraction::getCluster(int cid)
 {		
@@ -90,6 +116,19 @@ GenericClusterAbstraction::addCluster(AbstractCluster* cluster)
 	clusters[cluster->getId()] = cluster;
 } 
 
+// Deletes a cluster. Any abstract nodes associated with the cluster should
+// be removed beforehand.
+void
+GenericClusterAbstraction::removeCluster(int cid)
+{
+	HPAUtil::clusterTable::iterator it = clusters.find(cid);
+	if(it == clusters.end())
+		return;
+
+	delete (*it).second;
+	clusters.erase(it);
+}
+
 /* paths are cached in the direction of the edge (from, to) */
 void
 GenericClusterAbstraction::addPathToCache(edge* e, path* p)
@@ -115,6 +154,34 @@ GenericClusterAbstraction::getPathFromCache(edge* e)
 	return 0;
 }
 
+// an edge is unresolved only if the cluster which created it marked it so.
+// NB: unset labels are reported as MAXINT.
+bool
+GenericClusterAbstraction::isResolved(edge* e)
+{
+	return e->getLabelL(kUnresolvedEdge) != 1;
+}
+
+// computes the real cost of a lazy intra-edge. the cluster containing both 
+// endpoints replaces the lower bound with the cost of the shortest path 
+// between them and caches the path. Resolved edges are left unchanged.
+void
+GenericClusterAbstraction::resolveEdge(edge* e)
+{
+	if(e == 0 || isResolved(e))
+		return;
+
+	ClusterNode* from = dynamic_cast<ClusterNode*>(
+			getAbstractGraph(1)->getNode(e->getFrom()));
+	assert(from);
+	AbstractCluster* cluster = getCluster(from->getParentClusterId());
+	assert(cluster);
+
+	cluster->resolveEdge(e);
+	e->setLabelL(kUnresolvedEdge, 0);
+	numEdgesResolved++;
+}
+
 void GenericClusterAbstraction::deletePathFromCache(edge* e)
 {
 	if(e == NULL)
@@ -129,6 +196,363 @@ void GenericClusterAbstraction::deletePathFromCache(edge* e)
 }
 
 
+// Removes a node from the map graph (e.g. when a tile becomes blocked).
+// The cluster containing the node is queued for repair. Abstract nodes are 
+// managed internally and cannot be removed this way.
+void 
+GenericClusterAbstraction::removeNode(node* n)
+{
+	if(n == 0 || n->getLabelL(kAbstractionLevel) != 0)
+		return;
+
+	componentsValid = false;
+	graph* g = abstractions[0];
+	if(n->getLabelL(kParent) != -1)
+		disconnectAbstractNode(abstractions[1]->getNode(n->getLabelL(kParent)));
+
+	AbstractCluster* cluster = getCluster(
+			dynamic_cast<ClusterNode*>(n)->getParentClusterId());
+	if(cluster)
+	{
+		cluster->removeNode(n);
+		repairQueue.insert(cluster->getId());
+	}
+
+	edge_iterator ei = n->getEdgeIter();
+	for(edge* e = n->edgeIterNext(ei); e != 0; 
+			e = n->edgeIterNext(ei = n->getEdgeIter()))
+	{
+		g->removeEdge(e);
+		delete e;
+	}
+
+	// HOG moves the last node of the graph into the vacated slot
+	int x = n->getLabelL(kFirstData);
+	int y = n->getLabelL(kFirstData+1);
+	unsigned int oldID;
+	node* moved = g->removeNode(n, oldID);
+	getMap()->setNodeNum(kNoGraphNode, x, y);
+	if(moved)
+		getMap()->setNodeNum(moved->getNum(), moved->getLabelL(kFirstData), 
+				moved->getLabelL(kFirstData+1));
+	delete n;
+}
+
+void 
+GenericClusterAbstraction::removeEdge(edge* e, unsigned int absLevel)
+{
+	if(e == 0 || absLevel != 0)
+		return;
+
+	componentsValid = false;
+	graph* g = abstractions[0];
+	ClusterNode* from = dynamic_cast<ClusterNode*>(g->getNode(e->getFrom()));
+	ClusterNode* to = dynamic_cast<ClusterNode*>(g->getNode(e->getTo()));
+	if(getCluster(from->getParentClusterId()))
+		repairQueue.insert(from->getParentClusterId());
+	if(getCluster(to->getParentClusterId()))
+		repairQueue.insert(to->getParentClusterId());
+
+	g->removeEdge(e);
+	delete e;
+}
+
+// Adds a new node to the map graph (e.g. when a tile becomes traversable).
+// The node needs coordinate labels; edges are added separately (see addEdge).
+void 
+GenericClusterAbstraction::addNode(node* n)
+{
+	if(n == 0 || n->getLabelL(kAbstractionLevel) != 0)
+		return;
+
+	componentsValid = false;
+	int x = n->getLabelL(kFirstData);
+	int y = n->getLabelL(kFirstData+1);
+	getMap()->setNodeNum(abstractions[0]->addNode(n), x, y);
+	
+	AbstractCluster* cluster = findClusterContaining(x, y);
+	if(cluster)
+	{
+		cluster->addNode(n);
+		repairQueue.insert(cluster->getId());
+	}
+}
+
+void 
+GenericClusterAbstraction::addEdge(edge* e, unsigned int absLevel)
+{
+	if(e == 0 || absLevel != 0)
+		return;
+
+	componentsValid = false;
+	graph* g = abstractions[0];
+	g->addEdge(e);
+
+	ClusterNode* from = dynamic_cast<ClusterNode*>(g->getNode(e->getFrom()));
+	ClusterNode* to = dynamic_cast<ClusterNode*>(g->getNode(e->getTo()));
+	if(getCluster(from->getParentClusterId()))
+		repairQueue.insert(from->getParentClusterId());
+	if(getCluster(to->getParentClusterId()))
+		repairQueue.insert(to->getParentClusterId());
+}
+
+// Rebuilds the abstract graph in the vicinity of every cluster affected by 
+// a change to the map graph. The remainder of the abstract graph is not 
+// touched:
+// 	1. Remove every abstract node (and hence every intra-edge, inter-edge 
+// 	and cached path) associated with an affected cluster.
+// 	2. Rebuild the entrances of each affected cluster. Existing entrance 
+// 	endpoints in neighbouring clusters are reused where possible.
+// 	3. Remove any endpoint in a neighbouring cluster that is no longer 
+// 	part of an entrance.
+void 
+GenericClusterAbstraction::repairAbstraction()
+{
+	if(repairQueue.size() == 0)
+		return;
+
+	for(std::set<int>::iterator it = repairQueue.begin(); 
+			it != repairQueue.end(); it++)
+	{
+		HPAUtil::nodeTable* parents = getCluster(*it)->getParents();
+		while(parents->size() > 0)
+			disconnectAbstractNode((*parents->begin()).second);
+	}
+
+	for(std::set<int>::iterator it = repairQueue.begin(); 
+			it != repairQueue.end(); it++)
+	{
+		AbstractCluster* cluster = getCluster(*it);
+		if(getVerbose())
+		{
+			std::cout << "repairAbstraction; ";
+			cluster->print(std::cout);
+			std::cout << std::endl;
+		}
+		cluster->repairEntrances();
+	}
+
+	for(HPAUtil::nodeTable::iterator it = repairNeighbours.begin(); 
+			it != repairNeighbours.end(); it++)
+	{
+		if(!hasInterEdges((*it).second))
+			removeAbstractNode((*it).second);
+	}
+
+	repairNeighbours.clear();
+	repairQueue.clear();
+}
+
+// Makes the tile at (x, y) traversable and connects it to its neighbours 
+// using the same rules as getMapGraph (see mapAbstraction.cpp).
+void 
+GenericClusterAbstraction::openTile(int x, int y)
+{
+	Map* m = getMap();
+	if(x < 0 || y < 0 || x >= m->getMapWidth() || y >= m->getMapHeight())
+		return;
+	if(getNodeFromMap(x, y))
+		return;
+
+	m->setTerrainType(x, y, kGround);
+
+	char name[32];
+	sprintf(name, "(%d, %d)", x, y);
+	node* n = getNodeFactory()->newNode(name);
+	n->setLabelL(kAbstractionLevel, 0);
+	n->setLabelL(kNumAbstractedNodes, 1);
+	n->setLabelL(kParent, -1);
+	n->setLabelF(kXCoordinate, kUnknownPosition);
+	n->setLabelL(kNodeBlocked, 0);
+	n->setLabelL(kFirstData, x);
+	n->setLabelL(kFirstData+1, y);
+	n->setLabelL(kFirstData+2, kNone);
+	addNode(n);
+
+	for(int dx = -1; dx <= 1; dx++)
+		for(int dy = -1; dy <= 1; dy++)
+		{
+			if((dx == 0 && dy == 0) || (!allowDiagonals && dx != 0 && dy != 0))
+				continue;
+
+			node* neighbour = getNodeFromMap(x+dx, y+dy);
+			if(neighbour && canConnect(x, y, x+dx, y+dy))
+			{
+				double weight = (dx != 0 && dy != 0)?ROOT_TWO:1.0;
+				addEdge(getEdgeFactory()->newEdge(n->getNum(), 
+							neighbour->getNum(), weight), 0);
+			}
+		}
+}
+
+// Makes the tile at (x, y) an obstacle.
+void 
+GenericClusterAbstraction::closeTile(int x, int y)
+{
+	node* n = getNodeFromMap(x, y);
+	if(n == 0)
+		return;
+
+	removeNode(n);
+	getMap()->setTerrainType(x, y, kOutOfBounds);
+}
+
+// Mirrors the edge conditions in addMapEdges: a diagonal step must be able
+// to cut at least one corner.
+bool 
+GenericClusterAbstraction::canConnect(int x1, int y1, int x2, int y2)
+{
+	Map* m = getMap();
+	if(x1 == x2 || y1 == y2)
+		return m->canStep(x1, y1, x2, y2);
+
+	return (m->canStep(x1, y1, x2, y1) && m->canStep(x2, y1, x2, y2)) ||
+		(m->canStep(x1, y1, x1, y2) && m->canStep(x1, y2, x2, y2));
+}
+
+// Deletes an abstract node that belongs to a cluster in need of repair. 
+// Endpoints at the other end of its inter-edges are remembered; if they are 
+// not part of any entrance after the repair they are deleted too. 
+void 
+GenericClusterAbstraction::disconnectAbstractNode(node* absn_)
+{
+	ClusterNode* absn = dynamic_cast<ClusterNode*>(absn_);
+	if(absn == 0)
+		return;
+
+	graph* absg = abstractions[1];
+	repairNeighbours.erase(absn->getUniqueID());
+	edge_iterator ei = absn->getEdgeIter();
+	for(edge* e = absn->edgeIterNext(ei); e != 0; e = absn->edgeIterNext(ei))
+	{
+		int nid = e->getFrom() == absn->getNum()?e->getTo():e->getFrom();
+		ClusterNode* nb = dynamic_cast<ClusterNode*>(absg->getNode(nid));
+		if(nb->getParentClusterId() != absn->getParentClusterId())
+			repairNeighbours[nb->getUniqueID()] = nb;
+	}
+	removeAbstractNode(absn);
+}
+
+// Deletes an abstract node together with its edges and their cached paths.
+void 
+GenericClusterAbstraction::removeAbstractNode(node* absn_)
+{
+	ClusterNode* absn = dynamic_cast<ClusterNode*>(absn_);
+	if(absn == 0)
+		return;
+
+	graph* absg = abstractions[1];
+	edge_iterator ei = absn->getEdgeIter();
+	for(edge* e = absn->edgeIterNext(ei); e != 0; 
+			e = absn->edgeIterNext(ei = absn->getEdgeIter()))
+	{
+		deletePathFromCache(e);
+		absg->removeEdge(e);
+		delete e;
+	}
+
+	AbstractCluster* cluster = getCluster(absn->getParentClusterId());
+	if(cluster)
+		cluster->removeParent(absn);
+
+	node* low = getNodeFromMap(absn->getLabelL(kFirstData), 
+			absn->getLabelL(kFirstData+1));
+	if(low)
+		low->setLabelL(kParent, -1);
+
+	// HOG moves the last node of the graph into the vacated slot; the child
+	// of that node needs to know about it.
+	unsigned int oldID;
+	node* moved = absg->removeNode(absn, oldID);
+	if(moved)
+	{
+		low = getNodeFromMap(moved->getLabelL(kFirstData), 
+				moved->getLabelL(kFirstData+1));
+		if(low && low->getLabelL(kParent) == (long)oldID)
+			low->setLabelL(kParent, moved->getNum());
+	}
+	delete absn;
+}
+
+// Removes every edge from the abstract graph whose weight is matched by a 
+// path of two edges through another abstract node. Distances in the abstract
+// graph are unchanged: both edges on such a path are strictly shorter than 
+// the edge they replace and are themselves either kept or replaced in the 
+// same way. Unresolved edges are never removed nor used to replace others.
+int
+GenericClusterAbstraction::pruneDominatedEdges()
+{
+	graph* absg = abstractions[1];
+	std::vector<edge*> dominated;
+
+	edge_iterator it = absg->getEdgeIter();
+	for(edge* e = absg->edgeIterNext(it); e != 0; e = absg->edgeIterNext(it))
+	{
+		if(isResolved(e) && isDominated(e))
+			dominated.push_back(e);
+	}
+
+	for(unsigned int i=0; i < dominated.size(); i++)
+	{
+		deletePathFromCache(dominated[i]);
+		absg->removeEdge(dominated[i]);
+		delete dominated[i];
+	}
+
+	if(getVerbose())
+		std::cout << "pruneDominatedEdges removed "<<dominated.size()
+			<<" edges"<<std::endl;
+	return dominated.size();
+}
+
+bool
+GenericClusterAbstraction::isDominated(edge* e)
+{
+	graph* absg = abstractions[1];
+	node* from = absg->getNode(e->getFrom());
+	unsigned int toId = e->getTo();
+
+	edge_iterator it = from->getEdgeIter();
+	for(edge* first = from->edgeIterNext(it); first != 0; 
+			first = from->edgeIterNext(it))
+	{
+		if(first == e || !isResolved(first) || 
+				!fgreater(first->getWeight(), 0))
+			continue;
+
+		unsigned int viaId = first->getFrom() == from->getNum()?
+			first->getTo():first->getFrom();
+		if(viaId == toId)
+			continue;
+
+		edge* second = absg->findEdge(viaId, toId);
+		if(second == 0 || !isResolved(second) || 
+				!fgreater(second->getWeight(), 0))
+			continue;
+
+		if(!fgreater(first->getWeight() + second->getWeight(), e->getWeight()))
+			return true;
+	}
+	return false;
+}
+
+bool 
+GenericClusterAbstraction::hasInterEdges(node* absn)
+{
+	graph* absg = abstractions[1];
+	int cid = dynamic_cast<ClusterNode*>(absn)->getParentClusterId();
+
+	edge_iterator ei = absn->getEdgeIter();
+	for(edge* e = absn->edgeIterNext(ei); e != 0; e = absn->edgeIterNext(ei))
+	{
+		int nid = e->getFrom() == absn->getNum()?e->getTo():e->getFrom();
+		ClusterNode* nb = dynamic_cast<ClusterNode*>(absg->getNode(nid));
+		if(nb->getParentClusterId() != cid)
+			return true;
+	}
+	return false;
+}
+
 AbstractCluster* 
 GenericClusterAbstraction::clusterIterNext(cluster_iterator &iter) const
 {
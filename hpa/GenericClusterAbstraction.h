@@ -22,9 +22,11 @@
 #include "HPAUtil.h"
 
 #include <iostream>
+#include <set>
 #include <stdexcept>
 
 class ClusterNode;
+class ConnectedComponents;
 class IClusterFactory;
 class INodeFactory;
 class IEdgeFactory;
@@ -53,26 +55,51 @@ class GenericClusterAbstraction : public mapAbstraction
 		void deletePathFromCache(edge* e);
 		int getPathCacheSize() { return pathCache.size(); }
 
+		// lazy intra-edges. when enabled, clusters connect their abstract 
+		// nodes using an admissible lower bound and only compute the real 
+		// cost (and path) of an edge the first time it is needed.
+		inline void setLazyIntraEdges(bool lazy) { lazyIntraEdges = lazy; }
+		inline bool getLazyIntraEdges() { return lazyIntraEdges; }
+		bool isResolved(edge* e);
+		void resolveEdge(edge* e);
+		int getNumEdgesResolved() { return numEdgesResolved; }
+
+		// removes abstract edges which are no shorter than some two-hop 
+		// path; returns the number of edges removed.
+		int pruneDominatedEdges();
+
 		// drawing and overlay methods 
 		virtual void openGLDraw(); 
 
 		void setDrawClusters(bool draw) { drawClusters = draw; }
 		bool getDrawClusters() { return drawClusters; }
 		
-		// needed to implement a concrete mapAbstraction 
-		virtual bool pathable(node*, node*) { return false; }
+		// needed to implement a concrete mapAbstraction. 
+		// pathable is false if the nodes lie in different connected 
+		// components of the map graph.
+		virtual bool pathable(node*, node*);
 		virtual void verifyHierarchy() {}
-		virtual void removeNode(node*) {} 
-		virtual void removeEdge(edge*, unsigned int) {}
-		virtual void addNode(node*) {}
-		virtual void addEdge(edge*, unsigned int) {}
-		virtual void repairAbstraction() {}
 		virtual mapAbstraction* clone(Map *) { return NULL; }
 
+		// dynamic map changes. each operation on the map graph records 
+		// which clusters it invalidates. follow any number of operations 
+		// with a single call to repairAbstraction.
+		virtual void removeNode(node* n); 
+		virtual void removeEdge(edge* e, unsigned int absLevel);
+		virtual void addNode(node* n);
+		virtual void addEdge(edge* e, unsigned int absLevel);
+		virtual void repairAbstraction();
+		int getNumClustersToRepair() { return repairQueue.size(); }
+
+		// make a tile traversable (or not) and update the map graph 
+		void openTile(int x, int y);
+		void closeTile(int x, int y);
+
 		// cluster getters and iterator functions 
 		cluster_iterator getClusterIter() const { return clusters.begin(); }
 		AbstractCluster* clusterIterNext(cluster_iterator&) const;
 		AbstractCluster* getCluster(int cid);
+		virtual AbstractCluster* findClusterContaining(int, int) { return 0; }
 		int getNumClusters() { return clusters.size(); } 
 	
 		IEdgeFactory* getEdgeFactory() { return ef; }
@@ -86,15 +113,27 @@ class GenericClusterAbstraction : public mapAbstraction
 		
 	protected:
 		void addCluster(AbstractCluster* cluster);
+		void removeCluster(int cid);
 		int getNumberOfAbstractionLevels() { return abstractions.size(); }
 		void printUniqueIdsOfAllNodesInGraph(graph *g);
+		void disconnectAbstractNode(node* absn);
+		virtual void removeAbstractNode(node* absn);
+		bool hasInterEdges(node* absn);
+		bool isDominated(edge* e);
+		bool canConnect(int x1, int y1, int x2, int y2);
 
 		bool drawClusters; 
 		bool verbose;
 		bool allowDiagonals;
+		bool lazyIntraEdges;
+		int numEdgesResolved;
+		std::set<int> repairQueue;
+		HPAUtil::nodeTable repairNeighbours;
 	
 	private:
 		Heuristic* heuristic;
+		ConnectedComponents* components;
+		bool componentsValid; // false after the map graph changes
 		IClusterFactory* cf;
 		INodeFactory* nf;
 		IEdgeFactory* ef;
@@ -8,9 +8,11 @@
 #include "HPAUtil.h"
 #include "IEdgeFactory.h"
 #include "map.h"
+#include <cassert>
 #include <stdexcept>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "glUtil.h"
 #ifdef OS_MAC
@@ -136,6 +138,12 @@ HPACluster::connectParent(node* absStart) throw(std::invalid_argument)
 	if(absStart == 0)
 		throw std::invalid_argument("HPACluster::connectParent null argument");
 
+	if(map->getLazyIntraEdges())
+	{
+		connectParentLazily(absStart);
+		return;
+	}
+
 	for(HPAUtil::nodeTable::iterator nodeIter = parents.begin(); 
 		nodeIter != parents.end(); 
 		nodeIter++)
@@ -143,18 +151,7 @@ HPACluster::connectParent(node* absStart) throw(std::invalid_argument)
 		node* absGoal = (*nodeIter).second;
 		graph* absg = map->getAbstractGraph(1);
 		
-		alg->markForVis = false;
-		alg->setCorridorNodes(&nodes);
-
-		// get low-level nodes
-		node* from = map->getNodeFromMap(
-				absStart->getLabelL(kFirstData),
-				absStart->getLabelL(kFirstData+1)); 
-		node* to = map->getNodeFromMap(
-				absGoal->getLabelL(kFirstData),
-				absGoal->getLabelL(kFirstData+1)); 
-
-		path* solution = alg->getPath(map, from, to);
+		path* solution = findIntraPath(absStart, absGoal);
 		if(solution != 0)
 		{
 			double dist = map->distance(solution);
@@ -162,14 +159,115 @@ HPACluster::connectParent(node* absStart) throw(std::invalid_argument)
 			absg->addEdge(e);
 			map->addPathToCache(e, solution);				
 		}
+	}
+}
+
+// Connects a new parent node with every other parent node reachable from it
+// inside the cluster. Reachability is established with a single flood fill;
+// each new edge is weighted with a lower bound and resolved on demand 
+// (see ::resolveEdge).
+void
+HPACluster::connectParentLazily(node* absStart)
+{
+	graph* g = map->getAbstractGraph(0);
+	graph* absg = map->getAbstractGraph(1);
+	node* from = map->getNodeFromMap(
+			absStart->getLabelL(kFirstData),
+			absStart->getLabelL(kFirstData+1)); 
+
+	HPAUtil::nodeTable reachable;
+	std::vector<node*> open;
+	reachable[from->getUniqueID()] = from;
+	open.push_back(from);
+	while(open.size() > 0)
+	{
+		node* current = open.back();
+		open.pop_back();
+		nodesExpanded++;
+
+		edge_iterator it = current->getEdgeIter();
+		for(edge* e = current->edgeIterNext(it); e != 0; 
+				e = current->edgeIterNext(it))
+		{
+			int nid = e->getFrom()==current->getNum()?e->getTo():e->getFrom();
+			node* neighbour = g->getNode(nid);
+			nodesTouched++;
+			if(nodes.find(neighbour->getUniqueID()) == nodes.end() ||
+				reachable.find(neighbour->getUniqueID()) != reachable.end())
+				continue;
+
+			reachable[neighbour->getUniqueID()] = neighbour;
+			open.push_back(neighbour);
+			nodesGenerated++;
+		}
+	}
+
+	for(HPAUtil::nodeTable::iterator nodeIter = parents.begin(); 
+		nodeIter != parents.end(); 
+		nodeIter++)
+	{
+		node* absGoal = (*nodeIter).second;
+		if(absGoal == absStart)
+			continue;
+
+		node* to = map->getNodeFromMap(
+				absGoal->getLabelL(kFirstData),
+				absGoal->getLabelL(kFirstData+1)); 
+		if(reachable.find(to->getUniqueID()) == reachable.end())
+			continue;
+
+		edge* e = new edge(absStart->getNum(), absGoal->getNum(), 
+				map->h(absStart, absGoal));
+		e->setLabelL(kUnresolvedEdge, 1);
+		absg->addEdge(e);
+	}
+}
+
+void
+HPACluster::resolveEdge(edge* e)
+{
+	graph* absg = map->getAbstractGraph(1);
+	path* solution = findIntraPath(absg->getNode(e->getFrom()), 
+			absg->getNode(e->getTo()));
 
-		// record some metrics about the operation
-		// NB: searchTime is measured by AbstractCluster::addParent (which calls
-		// this function)
-		nodesExpanded += alg->getNodesExpanded();
-		nodesGenerated += alg->getNodesGenerated();
-		nodesTouched += alg->getNodesTouched();
+	// every lazy edge connects two nodes known to be reachable 
+	assert(solution);
+	if(solution == 0)
+	{
+		e->setWeight(MAXINT);
+		return;
 	}
+
+	e->setWeight(map->distance(solution));
+	map->addPathToCache(e, solution);
+}
+
+// Finds a shortest path, restricted to the cluster, between the low-level 
+// nodes associated with two parent nodes.
+path*
+HPACluster::findIntraPath(node* absStart, node* absGoal)
+{
+	alg->markForVis = false;
+	alg->setCorridorNodes(&nodes);
+
+	// get low-level nodes
+	node* from = map->getNodeFromMap(
+			absStart->getLabelL(kFirstData),
+			absStart->getLabelL(kFirstData+1)); 
+	node* to = map->getNodeFromMap(
+			absGoal->getLabelL(kFirstData),
+			absGoal->getLabelL(kFirstData+1)); 
+
+	path* solution = alg->getPath(map, from, to);
+
+	// record some metrics about the operation
+	// NB: searchTime is measured by AbstractCluster::addParent (which calls
+	// this function)
+	nodesExpanded += alg->getNodesExpanded();
+	nodesGenerated += alg->getNodesGenerated();
+	nodesTouched += alg->getNodesTouched();
+
+	return solution;
 }
 
 void 
@@ -188,6 +286,21 @@ HPACluster::buildEntrances()
 //		buildDiagonalEntrances();
 }
 
+// Entrances along the western and northern borders are normally built by 
+// the neighbouring clusters. When the cluster changes they need to be rebuilt 
+// from this side.
+// NB: entrances end wherever the cluster on either side of the border changes
+// so they are placed in the same way from both sides.
+void 
+HPACluster::repairEntrances()
+{
+	buildEntrances();
+	if(this->getHOrigin() > 0)
+		buildVerticalEntrances(this->getHOrigin());
+	if(this->getVOrigin() > 0)
+		buildHorizontalEntrances(this->getVOrigin());
+}
+
 // Each cluster only considers veritcal entrances along the length of its eastern border. 
 // A naive method would duplicate the creation of some entrances 
 void 
@@ -199,6 +312,14 @@ HPACluster::buildVerticalEntrances()
 		return; 
 
 	// scan for vertical entrances along the eastern border 
+	buildVerticalEntrances(x);
+}
+
+// Scans for vertical entrances between column x-1 and column x, over the
+// vertical extent of the cluster. 
+void
+HPACluster::buildVerticalEntrances(int x)
+{
 	int y = this->getVOrigin();
 	while(y < this->getVOrigin()+this->getHeight())
 	{
@@ -242,13 +363,27 @@ HPACluster::processVerticalEntrance(int x, int y, int length)
 	}
 }
 
+// NB: an entrance also ends where the cluster on either side of the border 
+// changes. This only happens when neighbouring clusters differ in size.
 int 
 HPACluster::findVerticalEntranceLength(int x, int y)
 {
 	int length = 0;
+	int eastId = -1;
+	int westId = -1;
 	while(y < this->getVOrigin()+this->getHeight())
 	{
-		if(map->getNodeFromMap(x, y) == NULL || map->getNodeFromMap(x-1, y) == NULL)
+		ClusterNode* east = dynamic_cast<ClusterNode*>(map->getNodeFromMap(x, y));
+		ClusterNode* west = dynamic_cast<ClusterNode*>(map->getNodeFromMap(x-1, y));
+		if(east == NULL || west == NULL)
+			break;
+		if(length == 0)
+		{
+			eastId = east->getParentClusterId();
+			westId = west->getParentClusterId();
+		}
+		else if(east->getParentClusterId() != eastId || 
+				west->getParentClusterId() != westId)
 			break;
 		y++;
 		length++;
@@ -265,7 +400,15 @@ HPACluster::buildHorizontalEntrances()
 	if(y == mapheight)
 		return; 
 
-	// scan for vertical entrances along the eastern border 
+	// scan for horizontal entrances along the southern border 
+	buildHorizontalEntrances(y);
+}
+
+// Scans for horizontal entrances between row y-1 and row y, over the
+// horizontal extent of the cluster. 
+void
+HPACluster::buildHorizontalEntrances(int y)
+{
 	int x = this->getHOrigin();
 	while(x < this->getHOrigin()+this->getWidth())
 	{
@@ -313,9 +456,21 @@ int
 HPACluster::findHorizontalEntranceLength(int x, int y)
 {
 	int length = 0;
+	int southId = -1;
+	int northId = -1;
 	while(x < this->getHOrigin()+this->getWidth())
 	{
-		if(map->getNodeFromMap(x, y) == NULL || map->getNodeFromMap(x, y-1) == NULL)
+		ClusterNode* south = dynamic_cast<ClusterNode*>(map->getNodeFromMap(x, y));
+		ClusterNode* north = dynamic_cast<ClusterNode*>(map->getNodeFromMap(x, y-1));
+		if(south == NULL || north == NULL)
+			break;
+		if(length == 0)
+		{
+			southId = south->getParentClusterId();
+			northId = north->getParentClusterId();
+		}
+		else if(south->getParentClusterId() != southId || 
+				north->getParentClusterId() != northId)
 			break;
 		x++;
 		length++;
@@ -16,7 +16,9 @@
 #include <iostream>
 #include <stdexcept>
 
+class edge;
 class node;
+class path;
 class searchAlgorithm;
 class AbstractClusterAStar;
 class HPAClusterAbstraction;
@@ -38,8 +40,10 @@ class HPACluster : public AbstractCluster
 
 		virtual void buildCluster();
 		virtual void buildEntrances();
+		virtual void repairEntrances();
 		virtual void connectParent(node*) 
 			throw(std::invalid_argument);
+		virtual void resolveEdge(edge* e);
 		
 		inline	void setSearchAlgorithm(AbstractClusterAStar* _alg) 
 		{ alg = _alg; }
@@ -69,8 +73,12 @@ class HPACluster : public AbstractCluster
 			throw(std::invalid_argument);
 
 		void insertNodeIntoAbstractGraph(node* n);
+		void connectParentLazily(node* absStart);
+		path* findIntraPath(node* absStart, node* absGoal);
 		void buildHorizontalEntrances();
+		void buildHorizontalEntrances(int y);
 		void buildVerticalEntrances();
+		void buildVerticalEntrances(int x);
 		void buildDiagonalEntrances();
 		void processHorizontalEntrance(int x, int y, int length);
 		void processVerticalEntrance(int x, int y, int length);
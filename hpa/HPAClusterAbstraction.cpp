@@ -23,10 +23,19 @@
 
 const unsigned int DEFAULTCLUSTERSIZE = 10;
 
+// adaptive clusters are at most ADAPTIVE_MAXSCALE times, and at least half,
+// the nominal cluster size. areas larger than the nominal size are split 
+// when their obstacle density or the number of transitions on their 
+// perimeter is too high; smaller areas only when splitting reduces the 
+// number of intra-edges.
+const int ADAPTIVE_MAXSCALE = 4;
+const double ADAPTIVE_MAXDENSITY = 0.2;
+const int ADAPTIVE_MAXENTRANCES = 8;
+
 HPAClusterAbstraction::HPAClusterAbstraction(Map* m, HPAClusterFactory* _cf, 
 	INodeFactory* _nf, IEdgeFactory* _ef, bool allowDiagonals_) :
 		GenericClusterAbstraction(m, _cf, _nf, _ef, allowDiagonals_),
-		clustersize(DEFAULTCLUSTERSIZE)
+		clustersize(DEFAULTCLUSTERSIZE), adaptiveClusters(false)
 {	
 }
 
@@ -38,6 +47,12 @@ HPAClusterAbstraction::~HPAClusterAbstraction()
 void 
 HPAClusterAbstraction::buildClusters()
 {
+	if(getAdaptiveClusters())
+	{
+		buildAdaptiveClusters();
+		return;
+	}
+
 	int mapwidth = this->getMap()->getMapWidth();
 	int mapheight= this->getMap()->getMapHeight();
 
@@ -53,13 +68,182 @@ HPAClusterAbstraction::buildClusters()
 			if(y+cheight > mapheight)
 				cheight = mapheight - y;
 				
-			HPACluster *cluster = static_cast<HPACluster*>(
-					getClusterFactory()->createCluster(x,y,this));
-			cluster->setWidth(cwidth);
-			cluster->setHeight(cheight);
-			addCluster( cluster ); // nb: also assigns a new id to cluster
-			cluster->buildCluster();
+			makeCluster(x, y, cwidth, cheight);
+		}
+}
+
+// Covers the map with blocks of the largest cluster size and decomposes
+// each one as necessary. 
+void
+HPAClusterAbstraction::buildAdaptiveClusters()
+{
+	int mapwidth = this->getMap()->getMapWidth();
+	int mapheight= this->getMap()->getMapHeight();
+
+	int csize = getClusterSize()*ADAPTIVE_MAXSCALE;
+	for(int x=0; x<mapwidth; x+=csize)
+		for(int y=0; y<mapheight; y+= csize)
+		{	
+			int cwidth=csize;
+			if(x+cwidth > mapwidth)
+				cwidth = mapwidth - x;
+			int cheight=csize;
+			if(y+cheight > mapheight)
+				cheight = mapheight - y;
+
+			decompose(x, y, cwidth, cheight);
+		}
+}
+
+// An area becomes a single cluster if it is entirely traversable, entirely
+// blocked or too small to split any further. Otherwise it is split into 
+// quadrants if it has a high obstacle density or if splitting reduces the 
+// number of intra-edges implied by the entrances of the area.
+void
+HPAClusterAbstraction::decompose(int x, int y, int width, int height)
+{
+	int minsize = getClusterSize() / 2;
+	if(minsize < 1)
+		minsize = 1;
+
+	int w1 = width/2;
+	int h1 = height/2;
+	bool split = false;
+	if(width >= minsize*2 && height >= minsize*2)
+	{
+		int area = width*height;
+		int obstacles = countObstacles(x, y, width, height);
+		if(obstacles < area)
+		{
+			bool large = width > getClusterSize() || height > getClusterSize();
+			int entrances = countEntrances(x, y, width, height);
+			if(large && obstacles > area*ADAPTIVE_MAXDENSITY)
+				split = true;
+			else if(entrances > ADAPTIVE_MAXENTRANCES)
+			{
+				int e1 = countEntrances(x, y, w1, h1);
+				int e2 = countEntrances(x+w1, y, width-w1, h1);
+				int e3 = countEntrances(x, y+h1, w1, height-h1);
+				int e4 = countEntrances(x+w1, y+h1, width-w1, height-h1);
+				split = large || 
+					e1*e1 + e2*e2 + e3*e3 + e4*e4 < entrances*entrances;
+			}
+		}
+	}
+
+	if(!split)
+	{
+		makeCluster(x, y, width, height);
+		return;
+	}
+
+	decompose(x, y, w1, h1);
+	decompose(x+w1, y, width-w1, h1);
+	decompose(x, y+h1, w1, height-h1);
+	decompose(x+w1, y+h1, width-w1, height-h1);
+}
+
+void
+HPAClusterAbstraction::makeCluster(int x, int y, int width, int height)
+{
+	HPACluster *cluster = static_cast<HPACluster*>(
+			getClusterFactory()->createCluster(x,y,this));
+	cluster->setWidth(width);
+	cluster->setHeight(height);
+	addCluster( cluster ); // nb: also assigns a new id to cluster
+	cluster->buildCluster();
+
+	int mapwidth = getMap()->getMapWidth();
+	if(tileCluster.empty())
+		tileCluster.assign(mapwidth*getMap()->getMapHeight(), -1);
+	for(int j=y; j<y+height; j++)
+		for(int i=x; i<x+width; i++)
+			tileCluster[i + j*mapwidth] = cluster->getId();
+}
+
+int
+HPAClusterAbstraction::countObstacles(int x, int y, int width, int height)
+{
+	int obstacles = 0;
+	for(int i=x; i<x+width; i++)
+		for(int j=y; j<y+height; j++)
+			if(getNodeFromMap(i, j) == 0)
+				obstacles++;
+	return obstacles;
+}
+
+// Estimates how many transition points would be placed along the perimeter 
+// of an area. 
+int
+HPAClusterAbstraction::countEntrances(int x, int y, int width, int height)
+{
+	int mapwidth = this->getMap()->getMapWidth();
+	int mapheight= this->getMap()->getMapHeight();
+
+	int entrances = 0;
+	if(x > 0)
+		entrances += countEntrances(x, y, 0, 1, height, -1, 0);
+	if(x+width < mapwidth)
+		entrances += countEntrances(x+width-1, y, 0, 1, height, 1, 0);
+	if(y > 0)
+		entrances += countEntrances(x, y, 1, 0, width, 0, -1);
+	if(y+height < mapheight)
+		entrances += countEntrances(x, y+height-1, 1, 0, width, 0, 1);
+	return entrances;
+}
+
+// Walks one side of an area, starting at (x, y) and moving (dx, dy) at each 
+// step. Each entrance is a maximal run of tiles traversable on both sides 
+// of the border; (nx, ny) is the offset to the tile across the border.
+int
+HPAClusterAbstraction::countEntrances(int x, int y, int dx, int dy, 
+		int length, int nx, int ny)
+{
+	int entrances = 0;
+	int run = 0;
+	for(int i=0; i<=length; i++)
+	{
+		int tx = x + i*dx;
+		int ty = y + i*dy;
+		if(i < length && getNodeFromMap(tx, ty) && 
+				getNodeFromMap(tx+nx, ty+ny))
+		{
+			run++;
+			continue;
 		}
+
+		if(run >= HPAUtil::MAX_SINGLE_TRANSITION_ENTRANCE_SIZE)
+			entrances += 2;
+		else if(run > 0)
+			entrances++;
+		run = 0;
+	}
+	return entrances;
+}
+
+AbstractCluster* 
+HPAClusterAbstraction::findClusterContaining(int x, int y)
+{
+	int width = getMap()->getMapWidth();
+	if(x < 0 || x >= width || y < 0 || y >= getMap()->getMapHeight() ||
+			tileCluster.empty())
+		return 0;
+	return getCluster(tileCluster[x + y*width]);
+}
+
+double 
+HPAClusterAbstraction::getAverageClusterSize()
+{
+	if(getNumClusters() == 0)
+		return 0;
+
+	double total = 0;
+	cluster_iterator iter = getClusterIter();
+	AbstractCluster* cluster = 0;
+	while((cluster = clusterIterNext(iter)))
+		total += cluster->getNumNodes();
+
+	return total/getNumClusters();
 }
 
 void 
@@ -15,6 +15,7 @@
 #include "HPAUtil.h"
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 class HPACluster;
 class IClusterAStarFactory;
@@ -34,15 +35,38 @@ class HPAClusterAbstraction : public GenericClusterAbstraction
 		
 		// need to make GenericClusterAbstraction concrete
 		virtual void buildClusters();
+		virtual AbstractCluster* findClusterContaining(int x, int y);
 
 		virtual void print(std::ostream& out);
 		void verifyClusters();
 
 		int getClusterSize() { return clustersize; } 
 		void setClusterSize(unsigned int csz) { clustersize = csz; }
+		double getAverageClusterSize();
+
+		// adaptive clusters are sized quadtree-style: open or obstacle-free 
+		// areas are covered by large clusters while areas with many 
+		// obstacles or entrances are split into clusters as small as half 
+		// the nominal cluster size.
+		void setAdaptiveClusters(bool adaptive) { adaptiveClusters = adaptive; }
+		bool getAdaptiveClusters() { return adaptiveClusters; }
 
 	private:
+		void buildAdaptiveClusters();
+		void decompose(int x, int y, int width, int height);
+		void makeCluster(int x, int y, int width, int height);
+		int countObstacles(int x, int y, int width, int height);
+		int countEntrances(int x, int y, int width, int height);
+		int countEntrances(int x, int y, int dx, int dy, int length, 
+				int nx, int ny);
+
 		unsigned int clustersize;
+		bool adaptiveClusters;
+
+		// the id of the cluster covering each tile (x + y*width), 
+		// traversable or not, so that nodes added later can be assigned 
+		// to a cluster without searching for it.
+		std::vector<int> tileCluster;
 };
 
 #endif
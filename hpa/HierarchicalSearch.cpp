@@ -1,6 +1,8 @@
 #include "HierarchicalSearch.h"
 
+#include "CachedHeuristic.h"
 #include "DebugUtility.h"
+#include "FlexibleAStar.h"
 #include "InsertionPolicy.h"
 #include "OctileHeuristic.h"
 #include "path.h"
@@ -41,6 +43,10 @@ HierarchicalSearch::getPath(graphAbstraction *aMap, node *from,
 	resetMetrics();
 	alg->verbose = verbose;
 
+	// skip insertion if the goal is in another connected component
+	if(aMap && from && to && !aMap->pathable(from, to))
+		return 0;
+
 	node* start = insertPolicy->insert(from);
 	node* goal = insertPolicy->insert(to);
 
@@ -74,6 +80,63 @@ HierarchicalSearch::getPath(graphAbstraction *aMap, node *from,
 	return refinedPath;
 }
 
+bool
+HierarchicalSearch::beginPath(graphAbstraction *aMap, node *from, 
+		node *to, reservationProvider *rp)
+{
+	resetMetrics();
+	alg->verbose = verbose;
+
+	if(aMap && from && to && !aMap->pathable(from, to))
+	{
+		refinePolicy->beginRefinement(0);
+		return false;
+	}
+
+	node* start = insertPolicy->insert(from);
+	node* goal = insertPolicy->insert(to);
+
+	path* abspath = alg->getPath(aMap, start, goal, rp);
+	refinePolicy->beginRefinement(abspath);
+	bool found = abspath != 0;
+	delete abspath;
+
+	insertPolicy->remove(start);
+	insertPolicy->remove(goal);
+
+	nodesExpanded = alg->getNodesExpanded() + insertPolicy->getNodesExpanded();
+	nodesGenerated = alg->getNodesGenerated() + 
+		insertPolicy->getNodesGenerated();
+	nodesTouched = alg->getNodesTouched() + insertPolicy->getNodesTouched();
+	searchTime = alg->getSearchTime() + insertPolicy->getSearchTime();
+
+	return found;
+}
+
+bool
+HierarchicalSearch::hasNextSegment()
+{
+	return refinePolicy->hasNextSegment();
+}
+
+path*
+HierarchicalSearch::nextSegment()
+{
+	long expanded = refinePolicy->getNodesExpanded();
+	long generated = refinePolicy->getNodesGenerated();
+	long touched = refinePolicy->getNodesTouched();
+	double time = refinePolicy->getSearchTime();
+
+	path* segment = refinePolicy->nextSegment();
+
+	nodesExpanded = refinePolicy->getNodesExpanded() - expanded;
+	nodesGenerated = refinePolicy->getNodesGenerated() - generated;
+	nodesTouched = refinePolicy->getNodesTouched() - touched;
+	searchTime = refinePolicy->getSearchTime() - time;
+
+	return segment;
+}
+
 void 
 HierarchicalSearch::resetMetrics()
 {
@@ -122,4 +185,8 @@ HierarchicalSearch::logFinalStats(statCollection* stats)
 	stats->addStat("insNodesTouched",getName(),getInsertNodesTouched());
 	stats->addStat("insNodesGenerated",getName(),getInsertNodesGenerated());
 	stats->addStat("insSearchTime",getName(),getInsertSearchTime());
+
+	FlexibleAStar* astar = dynamic_cast<FlexibleAStar*>(alg);
+	if(astar && astar->getHeuristicCache())
+		astar->getHeuristicCache()->logFinalStats(stats, getName());
 }
@@ -28,6 +28,15 @@ class HierarchicalSearch : public searchAlgorithm
 		virtual path *getPath(graphAbstraction *aMap, node *from, node *to, 
 				reservationProvider *rp = 0);	
 
+		// incremental alternative to ::getPath. ::beginPath finds an abstract
+		// path and returns false if none exists. Each call to ::nextSegment 
+		// then refines and returns the next part of the path; metrics only 
+		// count the work done by the most recent call.
+		bool beginPath(graphAbstraction *aMap, node *from, node *to, 
+				reservationProvider *rp = 0);
+		bool hasNextSegment();
+		path* nextSegment();
+
 		long getInsertNodesExpanded();
 		long getInsertNodesTouched();
 		long getInsertNodesGenerated();
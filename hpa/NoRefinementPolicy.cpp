@@ -30,3 +30,10 @@ path* NoRefinementPolicy::refine(path* abspath)
 	}
 	return thepath;
 }
+
+// @return: a path containing only the two endpoints of the abstract segment
+path* 
+NoRefinementPolicy::refineSegment(node* start, node* goal)
+{
+	return new path(start, new path(goal, 0));
+}
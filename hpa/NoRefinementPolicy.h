@@ -19,6 +19,9 @@ class NoRefinementPolicy : public RefinementPolicy
 		virtual ~NoRefinementPolicy();
 
 		virtual path* refine(path* thepath);
+
+	protected:
+		virtual path* refineSegment(node* start, node* goal);
 };
 
 #endif
@@ -1,14 +1,19 @@
 #include "RefinementPolicy.h"
 
 #include "mapAbstraction.h"
+#include "path.h"
+#include "timer.h"
 
 RefinementPolicy::RefinementPolicy(mapAbstraction* _map)
 {
 	map = _map;
+	waypoints = nextWaypoint = 0;
+	resetMetrics();
 }
 
 RefinementPolicy::~RefinementPolicy()
 {
+	clearWaypoints();
 }
 
 void
@@ -17,3 +22,110 @@ RefinementPolicy::resetMetrics()
 	searchTime = 0;
 	nodesExpanded = nodesGenerated = nodesTouched = 0;
 }
+
+// Refines abspath in one go by joining together each of its refined
+// segments.
+//
+// @return: the refined path or 0 if some segment could not be refined.
+path*
+RefinementPolicy::refine(path* abspath)
+{
+	beginRefinement(abspath);
+
+	path* thepath = 0;
+	path* tail = 0;
+	while(hasNextSegment())
+	{
+		path* segment = nextSegment();
+		if(segment == 0)
+		{
+			delete thepath;
+			return 0;
+		}
+
+		if(thepath == 0)
+		{
+			thepath = segment;
+			tail = segment->tail();
+			continue;
+		}
+
+		//avoid overlap between successive segments 
+		//(i.e one segment ends with the same node as the next begins)
+		if(tail->n->getNum() == segment->n->getNum()) 
+		{
+			path* rest = segment->next;
+			segment->next = 0;
+			delete segment;
+			segment = rest;
+		}
+
+		if(segment)
+		{
+			tail->next = segment;
+			tail = segment->tail();
+		}
+	}
+	return thepath;
+}
+
+// Prepares to refine abspath one segment at a time. 
+// Each abstract node is stored as its corresponding node from the map; 
+// any nodes temporarily inserted into the abstract graph can thus be removed
+// before refinement has finished.
+void 
+RefinementPolicy::beginRefinement(path* abspath)
+{
+	resetMetrics();
+	clearWaypoints();
+
+	path* last = 0;
+	for(path* current = abspath; current != 0; current = current->next)
+	{
+		node* n = current->n;
+		if(map)
+			n = map->getNodeFromMap(n->getLabelL(kFirstData), 
+					n->getLabelL(kFirstData+1));
+
+		path* p = new path(n, 0);
+		if(last == 0)
+			waypoints = p;
+		else
+			last->next = p;
+		last = p;
+	}
+	nextWaypoint = waypoints;
+}
+
+bool 
+RefinementPolicy::hasNextSegment()
+{
+	return nextWaypoint != 0 && nextWaypoint->next != 0;
+}
+
+// @return: the refined path between the next pair of nodes on the abstract 
+// path or 0 if no such path exists or there are no segments left to refine.
+// Successive segments share an endpoint.
+path* 
+RefinementPolicy::nextSegment()
+{
+	if(!hasNextSegment())
+		return 0;
+
+	Timer t;
+	t.startTimer();
+	path* segment = refineSegment(nextWaypoint->n, nextWaypoint->next->n);
+	searchTime += t.endTimer();
+
+	nextWaypoint = nextWaypoint->next;
+	if(segment == 0)
+		nextWaypoint = 0;
+	return segment;
+}
+
+void 
+RefinementPolicy::clearWaypoints()
+{
+	delete waypoints;
+	waypoints = nextWaypoint = 0;
+}
@@ -10,11 +10,17 @@
 // because not all nodes on an abstract path are necessarily next to one 
 // another.
 //
+// Paths can be refined all at once (::refine) or one abstract segment at a
+// time (::beginRefinement, ::nextSegment). The latter lets a caller start
+// moving before the rest of the path has been refined and skip the work of
+// refining segments it never uses.
+//
 // @author: dharabor
 // @created: 08/03/2011
 //
 
 class mapAbstraction;
+class node;
 class path;
 class RefinementPolicy
 {
@@ -22,7 +28,13 @@ class RefinementPolicy
 		RefinementPolicy(mapAbstraction* map);
 		virtual ~RefinementPolicy();
 
-		virtual path* refine(path* abspath) = 0;
+		virtual path* refine(path* abspath);
+
+		// incremental refinement. ::beginRefinement keeps its own copy of the
+		// abstract path; the caller may delete abspath as soon as it returns.
+		virtual void beginRefinement(path* abspath);
+		bool hasNextSegment();
+		path* nextSegment();
 		
 		// metrics
 		long getNodesExpanded() { return nodesExpanded; }
@@ -32,12 +44,22 @@ class RefinementPolicy
 		void resetMetrics();
 
 	protected:
+		// @return: a path from start to goal, or 0 if none exists.
+		// Implementations add the cost of the search to the metrics above.
+		virtual path* refineSegment(node* start, node* goal) = 0;
+
 		mapAbstraction* map;
 
 		long nodesExpanded;
 		long nodesTouched;
 		long nodesGenerated;
 		double searchTime;
+
+	private:
+		void clearWaypoints();
+
+		path* waypoints;
+		path* nextWaypoint;
 };
 
 #endif
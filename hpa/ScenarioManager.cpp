@@ -1,5 +1,5 @@
 #include "ScenarioManager.h"
-#include "aStar3.h"
+#include "CanonicalDijkstra.h"
 #include "mapAbstraction.h"
 
 AbstractScenarioManager::~AbstractScenarioManager()
@@ -45,6 +45,7 @@ void ScenarioManager::generateExperiments(mapAbstraction* absMap, int numexperim
 {
 	assert(absMap != 0); // need a test here; throw exception if absMap is null
 	
+	CanonicalDijkstra search(absMap);
 	int tries=0;
 	int generated=0;
 	while(generated < numexperiments)
@@ -52,7 +53,7 @@ void ScenarioManager::generateExperiments(mapAbstraction* absMap, int numexperim
 		if(tries >= MAXTRIES)
 			throw TooManyTriesException(generated, numexperiments);
 		
-		Experiment* exp = generateSingleExperiment(absMap); 
+		Experiment* exp = generateSingleExperiment(absMap, search); 
 		if(exp != NULL) 
 		{
 			this->addExperiment(exp);
@@ -62,7 +63,8 @@ void ScenarioManager::generateExperiments(mapAbstraction* absMap, int numexperim
 	}
 }
 
-Experiment* ScenarioManager::generateSingleExperiment(mapAbstraction* absMap)
+Experiment* ScenarioManager::generateSingleExperiment(mapAbstraction* absMap, 
+		CanonicalDijkstra& search)
 {
 	graph *g = absMap->getAbstractGraph(0);
 	const char* _map = absMap->getMap()->getMapName();
@@ -71,27 +73,24 @@ Experiment* ScenarioManager::generateSingleExperiment(mapAbstraction* absMap)
 	Experiment* newexp;
 
 	r1 = r2 = 0;
-	path *p=0;
 
 	r1 = g->getRandomNode();
 	r2 = g->getRandomNode();
-
-	//ClusterAStar searchalg;
-	//searchalg.cardinal = true;
-	aStarOld searchalg;
-	p = searchalg.getPath(absMap, r1, r2);
-
-	if(!p)
+	if(!r1 || !r2 || r1 == r2)
 		return NULL;
-		
-	double dist = absMap->distance(p);
+
 	int x1, x2, y1, y2;
 	
 	x1 = r1->getLabelL(kFirstData); y1 = r1->getLabelL(kFirstData+1);
 	x2 = r2->getLabelL(kFirstData); y2 = r2->getLabelL(kFirstData+1);
+
+	// distances from r1 to every location; -1 if there is no path
+	search.search(r1);
+	double dist = search.getDistance(x2, y2);
+	if(dist < 0)
+		return NULL;
+		
 	newexp = new Experiment(x1, y1, x2, y2, 1, 1, 0, dist, _map);
-	
-	delete p;
 	return newexp;
 }
 
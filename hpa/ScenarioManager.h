@@ -31,6 +31,7 @@ class TooManyTriesException : public std::exception
 		int generated, target;
 };
 
+class CanonicalDijkstra;
 class mapAbstraction;
 
 /*
@@ -76,7 +77,8 @@ class ScenarioManager : public AbstractScenarioManager
 			 throw(std::invalid_argument);
 
 	protected:
-		Experiment* generateSingleExperiment(mapAbstraction* absMap);
+		Experiment* generateSingleExperiment(mapAbstraction* absMap, 
+				CanonicalDijkstra& search);
 		void loadV1ScenarioFile(std::ifstream& infile);
 		void loadV2ScenarioFile(std::ifstream& infile);
 		void loadV21ScenarioFile(std::ifstream& infile);
@@ -0,0 +1,107 @@
+#include "StreamingHierarchicalSearch.h"
+
+#include "HierarchicalSearch.h"
+#include "path.h"
+
+StreamingHierarchicalSearch::StreamingHierarchicalSearch(
+		HierarchicalSearch* _search) : spreadExecSearchAlgorithm()
+{
+	search = _search;
+	planned = false;
+	lastNode = planGoal = 0;
+	start = end = 0;
+	rp = 0;
+	aMap = 0;
+	nodesGenerated = 0;
+}
+
+StreamingHierarchicalSearch::~StreamingHierarchicalSearch()
+{
+	delete search;
+}
+
+const char* 
+StreamingHierarchicalSearch::getName()
+{
+	return search->getName();
+}
+
+// @return: the first refined segment of a path from 'from' to 'to', or 0 if 
+// no path exists. Subsequent segments are returned by ::think.
+path* 
+StreamingHierarchicalSearch::getPath(graphAbstraction *_aMap, node *from, 
+		node *to, reservationProvider *_rp)
+{
+	setTargets(_aMap, from, to, _rp);
+	return think();
+}
+
+void 
+StreamingHierarchicalSearch::setTargets(graphAbstraction *_aMap, node *s, 
+		node *e, reservationProvider *_rp)
+{
+	if(_aMap != aMap || s != lastNode || e != planGoal)
+		planned = false;
+	spreadExecSearchAlgorithm::setTargets(_aMap, s, e, _rp);
+}
+
+int 
+StreamingHierarchicalSearch::getNumThinkSteps()
+{
+	return -1;
+}
+
+// @return: the next refined segment of the current plan or 0 if the plan
+// is exhausted or no path exists between the current targets.
+path* 
+StreamingHierarchicalSearch::think()
+{
+	nodesExpanded = nodesTouched = nodesGenerated = 0;
+	searchTime = 0;
+
+	if(!planned)
+	{
+		lastNode = planGoal = 0;
+		if(start == 0 || end == 0 || start == end)
+			return 0;
+
+		search->verbose = verbose;
+		if(!search->beginPath(aMap, start, end, rp))
+			return 0;
+		addMetrics();
+
+		planned = true;
+		planGoal = end;
+	}
+
+	if(!search->hasNextSegment())
+		return 0;
+
+	path* segment = search->nextSegment();
+	addMetrics();
+
+	// the abstract path could not be refined; search again next time
+	if(segment == 0)
+	{
+		planned = false;
+		return 0;
+	}
+
+	lastNode = segment->tail()->n;
+	return segment;
+}
+
+void
+StreamingHierarchicalSearch::addMetrics()
+{
+	nodesExpanded += search->getNodesExpanded();
+	nodesTouched += search->getNodesTouched();
+	nodesGenerated += search->getNodesGenerated();
+	searchTime += search->getSearchTime();
+}
+
+void 
+StreamingHierarchicalSearch::logFinalStats(statCollection* sc)
+{
+	search->logFinalStats(sc);
+}
@@ -0,0 +1,52 @@
+#ifndef STREAMINGHIERARCHICALSEARCH_H
+#define STREAMINGHIERARCHICALSEARCH_H
+
+// StreamingHierarchicalSearch.h
+//
+// Adapts a HierarchicalSearch for units that execute their paths 
+// incrementally (see searchUnit). Rather than refining the entire abstract 
+// path up front, each call to ::think refines and returns only the next 
+// abstract segment. 
+//
+// The time to the first move thus no longer depends on the length of the 
+// path, and a unit that abandons its plan (e.g. because its target moved or 
+// its way is blocked) never pays to refine the rest of it.
+//
+// The current plan is kept for as long as each new start target is the last
+// node returned by ::think and the goal target is unchanged. Any other 
+// target triggers a new abstract search on the next call to ::think.
+//
+// @created: 17/10/2026
+//
+
+#include "spreadExecSearchAlgorithm.h"
+
+class HierarchicalSearch;
+class statCollection;
+class StreamingHierarchicalSearch : public spreadExecSearchAlgorithm
+{
+	public:
+		// takes ownership of the wrapped search
+		StreamingHierarchicalSearch(HierarchicalSearch* search);
+		virtual ~StreamingHierarchicalSearch();
+
+		virtual const char* getName();
+		virtual path* getPath(graphAbstraction *aMap, node *from, node *to, 
+				reservationProvider *rp = 0);
+		virtual void setTargets(graphAbstraction *_aMap, node *s, node *e, 
+				reservationProvider *_rp = 0);
+		virtual int getNumThinkSteps();
+		virtual path* think();
+		virtual void logFinalStats(statCollection* sc);
+
+	private:
+		void addMetrics();
+
+		HierarchicalSearch* search;
+		bool planned;
+		node* lastNode;
+		node* planGoal;
+};
+
+#endif
+
@@ -1,5 +1,6 @@
 #include "JumpPointAbstraction.h"
 
+#include "ConnectedComponents.h"
 #include "IEdgeFactory.h"
 #include "INodeFactory.h"
 #include "graph.h"
@@ -12,15 +13,19 @@ JumpPointAbstraction::JumpPointAbstraction(Map* _m, INodeFactory* _nf,
 {
 	nf = _nf;
 	ef = _ef;
+	components = new ConnectedComponents(_m->getMapWidth(), 
+			_m->getMapHeight());
 
 	makeJumpPointGraph();
 	verifyHierarchy();
+	labelComponents();
 }
 
 JumpPointAbstraction::~JumpPointAbstraction()
 {
 	delete nf;
 	delete ef;
+	delete components;
 }
 
 mapAbstraction*
@@ -32,7 +37,7 @@ JumpPointAbstraction::clone(Map* _m)
 bool 
 JumpPointAbstraction::pathable(node* n, node* m)
 {
-	return true;
+	return components->connected(n, m);
 }
 
 void
@@ -115,6 +120,19 @@ JumpPointAbstraction::repairAbstraction()
 	delete g;
 
 	makeJumpPointGraph();
+	labelComponents();
+}
+
+// Jump point edges skip over most nodes so components are found on a 
+// temporary grid graph of the map instead. Both graphs are built by 
+// makeMapNodes and number their nodes the same way, so the node numbers 
+// the map records remain valid.
+void
+JumpPointAbstraction::labelComponents()
+{
+	graph* grid = getMapGraph(this->getMap());
+	components->label(grid);
+	delete grid;
 }
 
 void
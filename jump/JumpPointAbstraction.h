@@ -13,6 +13,7 @@
 #include "mapAbstraction.h"
 #include "Jump.h"
 
+class ConnectedComponents;
 class IEdgeFactory;
 class INodeFactory;
 class Map;
@@ -42,8 +43,10 @@ class JumpPointAbstraction : public mapAbstraction
 		bool verbose;
 		INodeFactory* nf;
 		IEdgeFactory* ef;
+		ConnectedComponents* components;
 
-		void makeJumpPointGraph();		
+		void makeJumpPointGraph();
+		void labelComponents();		
 		node* findJumpNode(Jump::Direction d, int x, int y);
 		node* findObstacleJumpNode(Jump::Direction d, int x, int y);
 };
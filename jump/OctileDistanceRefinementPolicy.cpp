@@ -15,50 +15,24 @@ OctileDistanceRefinementPolicy::~OctileDistanceRefinementPolicy()
 }
 
 path* 
-OctileDistanceRefinementPolicy::refine(path* abspath)
+OctileDistanceRefinementPolicy::refineSegment(node* start, node* goal)
 {
-	if(!abspath)
-		return 0;
-
-	path* refinedpath = 0;
-	path* tail = 0;
-	for(path* current = abspath; current->next != 0; 
-				current = current->next)
+	path* segment = 0;
+	path* segtail = 0;
+	for(node* first = start; first != 0; first = nextStep(first, goal))
 	{
-		path* segment = 0;
-		path* segtail = 0;
-		for(node* first = map->getNodeFromMap(
-					current->n->getLabelL(kFirstData),
-					current->n->getLabelL(kFirstData+1)); 
-				first != 0; 
-				first = nextStep(first, current->next->n))
-		{
-			path* p = new path(first, 0);
-			if(segment == 0)
-			{
-				segment = segtail = p;
-			}
-			else
-			{
-				segtail->next = p;
-				segtail = p;
-			}
-		}
-
-		if(refinedpath == 0)
+		path* p = new path(first, 0);
+		if(segment == 0)
 		{
-			refinedpath = segment;
-			tail = segtail;
+			segment = segtail = p;
 		}
 		else
 		{
-			tail->next = segment->next;
-			tail = segtail;
-			segment->next = 0;
-			delete segment;
+			segtail->next = p;
+			segtail = p;
 		}
-	}	
-	return refinedpath;
+	}
+	return segment;
 }
 
 node* 
@@ -25,7 +25,8 @@ class OctileDistanceRefinementPolicy : public RefinementPolicy
 		OctileDistanceRefinementPolicy(mapAbstraction* map);
 		virtual ~OctileDistanceRefinementPolicy();
 
-		virtual path* refine(path* abspath);
+	protected:
+		virtual path* refineSegment(node* start, node* goal);
 
 	private:
 		node* nextStep(node* first, node* last);
@@ -0,0 +1,388 @@
+#include "ArcFlags.h"
+
+#include "AbstractCluster.h"
+#include "GenericClusterAbstraction.h"
+#include "graph.h"
+#include "map.h"
+#include "WorkerThreads.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <sstream>
+
+// identifies the file format written by ::save
+static const int kArcFlagsFileVersion = 1;
+
+// two path costs closer than this are taken to be the same
+static const double kEpsilon = 0.000001;
+
+const int ArcFlags::kNoRegion;
+
+// orders the arcs by their flags so that identical sets end up next to
+// each other
+class FlagSetLess
+{
+	public:
+		FlagSetLess(const std::vector<unsigned int>& flags_, unsigned int words_)
+			: flags(flags_), words(words_) { }
+
+		bool operator()(unsigned int a, unsigned int b) const
+		{
+			return std::lexicographical_compare(
+					flags.begin() + a*words, flags.begin() + (a+1)*words,
+					flags.begin() + b*words, flags.begin() + (b+1)*words);
+		}
+
+	private:
+		const std::vector<unsigned int>& flags;
+		unsigned int words;
+};
+
+ArcFlags::ArcFlags(GenericClusterAbstraction* map_)
+	throw(std::invalid_argument)
+{
+	if(map_ == 0)
+		throw std::invalid_argument("ArcFlags: null map abstraction");
+
+	this->map = map_;
+	computeAdjacency();
+	computeRegions();
+}
+
+ArcFlags::~ArcFlags()
+{
+}
+
+// Copies the grid graph into flat arrays; building the flags searches
+// the graph once for every boundary node and this is much cheaper to
+// traverse.
+void
+ArcFlags::computeAdjacency()
+{
+	graph* g = map->getAbstractGraph(0);
+	int numnodes = g->getNumNodes();
+	adjStart.assign(numnodes+1, 0);
+	adjNode.clear();
+	adjWeight.clear();
+
+	for(int i=0; i<numnodes; i++)
+	{
+		adjStart[i] = adjNode.size();
+		node* n = g->getNode(i);
+		edge_iterator ei = n->getEdgeIter();
+		for(edge* e = n->edgeIterNext(ei); e; e = n->edgeIterNext(ei))
+		{
+			adjNode.push_back(e->getFrom() == (unsigned int)i ? e->getTo() : e->getFrom());
+			adjWeight.push_back(e->getWeight());
+		}
+	}
+	adjStart[numnodes] = adjNode.size();
+}
+
+// Numbers the clusters and records the region of each node
+void
+ArcFlags::computeRegions()
+{
+	int numnodes = map->getAbstractGraph(0)->getNumNodes();
+	nodeRegion.assign(numnodes, kNoRegion);
+	numRegions = 0;
+
+	cluster_iterator it = map->getClusterIter();
+	for(AbstractCluster* cluster = map->clusterIterNext(it); cluster;
+			cluster = map->clusterIterNext(it))
+	{
+		HPAUtil::nodeTable* nodes = cluster->getNodes();
+		for(HPAUtil::nodeTable::iterator ni = nodes->begin();
+				ni != nodes->end(); ni++)
+		{
+			node* n = (*ni).second;
+			if(n && n->getNum() < (unsigned int)numnodes)
+				nodeRegion[n->getNum()] = numRegions;
+		}
+		numRegions++;
+	}
+	words = (numRegions + 31) / 32;
+}
+
+// Runs the searches from a share of the boundary nodes. Each thread
+// flags arcs in its own buffer so the searches need not be synchronised.
+class ArcFlagsSearchTask : public ParallelTask
+{
+	public:
+		ArcFlagsSearchTask(const ArcFlags* flags_,
+				const std::vector<int>& boundary_)
+			: flags(flags_), boundary(boundary_),
+			  buffers(WorkerThreads::getNumThreads()),
+			  dist(WorkerThreads::getNumThreads()) { }
+
+		virtual void run(int piece, int thread)
+		{
+			if(buffers[thread].size() == 0)
+			{
+				buffers[thread].assign(flags->adjNode.size()*flags->words, 0);
+				dist[thread].assign(flags->nodeRegion.size(), -1);
+			}
+			flags->search(boundary[piece], dist[thread]);
+			flags->flagPathsTo(boundary[piece], dist[thread], buffers[thread]);
+		}
+
+		// ORs the flags set by every thread into result
+		void merge(std::vector<unsigned int>& result)
+		{
+			for(unsigned int t=0; t<buffers.size(); t++)
+			{
+				for(unsigned int i=0; i<buffers[t].size(); i++)
+					result[i] |= buffers[t][i];
+				std::vector<unsigned int>().swap(buffers[t]);
+			}
+		}
+
+	private:
+		const ArcFlags* flags;
+		const std::vector<int>& boundary;
+		std::vector<std::vector<unsigned int> > buffers;
+		std::vector<std::vector<double> > dist;
+};
+
+void
+ArcFlags::build()
+{
+	int numnodes = nodeRegion.size();
+	std::vector<unsigned int> flags(adjNode.size()*words, 0);
+	std::vector<int> boundary;
+
+	for(int b=0; b<numnodes; b++)
+	{
+		int region = nodeRegion[b];
+		if(region == kNoRegion)
+			continue;
+		unsigned int word = region / 32;
+		unsigned int bit = 1u << (region % 32);
+
+		bool isBoundary = false;
+		for(unsigned int a=adjStart[b]; a<adjStart[b+1]; a++)
+		{
+			if(nodeRegion[adjNode[a]] == region)
+				flags[a*words + word] |= bit;
+			else
+				isBoundary = true;
+		}
+		if(isBoundary)
+			boundary.push_back(b);
+	}
+
+	ArcFlagsSearchTask task(this, boundary);
+	WorkerThreads::run(&task, boundary.size());
+	task.merge(flags);
+
+	compress(flags);
+}
+
+// Flags, for the region of b, every arc on an optimal path to b. dist
+// holds the distance from b to every node (see ::search).
+void
+ArcFlags::flagPathsTo(int b, const std::vector<double>& dist,
+		std::vector<unsigned int>& flags) const
+{
+	int numnodes = nodeRegion.size();
+	unsigned int word = nodeRegion[b] / 32;
+	unsigned int bit = 1u << (nodeRegion[b] % 32);
+	for(int u=0; u<numnodes; u++)
+	{
+		if(dist[u] < 0)
+			continue;
+		for(unsigned int a=adjStart[u]; a<adjStart[u+1]; a++)
+		{
+			double dv = dist[adjNode[a]];
+			if(dv >= 0 && fabs(dist[u] - adjWeight[a] - dv) < kEpsilon)
+				flags[a*words + word] |= bit;
+		}
+	}
+}
+
+// Dijkstra search from source over the whole graph. dist holds the
+// distance to every node afterwards, -1 if it cannot be reached.
+void
+ArcFlags::search(int source, std::vector<double>& dist) const
+{
+	typedef std::pair<double, int> QueueEntry;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+		std::greater<QueueEntry> > open;
+
+	std::fill(dist.begin(), dist.end(), -1);
+	dist[source] = 0;
+	open.push(QueueEntry(0, source));
+	while(!open.empty())
+	{
+		double d = open.top().first;
+		int current = open.top().second;
+		open.pop();
+		if(d > dist[current])
+			continue;
+
+		for(unsigned int a=adjStart[current]; a<adjStart[current+1]; a++)
+		{
+			int neighbour = adjNode[a];
+			double nd = d + adjWeight[a];
+			if(dist[neighbour] >= 0 && nd >= dist[neighbour])
+				continue;
+			dist[neighbour] = nd;
+			open.push(QueueEntry(nd, neighbour));
+		}
+	}
+}
+
+// Keeps one copy of each distinct set of flags
+void
+ArcFlags::compress(const std::vector<unsigned int>& flags)
+{
+	unsigned int numarcs = adjNode.size();
+	std::vector<unsigned int> byFlags(numarcs);
+	for(unsigned int a=0; a<numarcs; a++)
+		byFlags[a] = a;
+	std::sort(byFlags.begin(), byFlags.end(), FlagSetLess(flags, words));
+
+	arcSet.assign(numarcs, 0);
+	flagSets.clear();
+	for(unsigned int i=0; i<numarcs; i++)
+	{
+		unsigned int a = byFlags[i];
+		if(i == 0 || FlagSetLess(flags, words)(byFlags[i-1], a))
+			flagSets.insert(flagSets.end(), flags.begin() + a*words,
+					flags.begin() + (a+1)*words);
+		arcSet[a] = flagSets.size()/words - 1;
+	}
+}
+
+int
+ArcFlags::findArc(int from, int to) const
+{
+	if(from < 0 || from+1 >= (int)adjStart.size())
+		return -1;
+	for(unsigned int a=adjStart[from]; a<adjStart[from+1]; a++)
+		if(adjNode[a] == to)
+			return a;
+	return -1;
+}
+
+bool
+ArcFlags::isFlagged(node* from, node* to, int region) const
+{
+	if(region == kNoRegion || !isBuilt() ||
+			getRegion(from) == kNoRegion || getRegion(to) == kNoRegion)
+		return true;
+
+	int a = findArc(from->getNum(), to->getNum());
+	if(a == -1)
+		return true;
+	return (flagSets[arcSet[a]*words + region/32] >> (region % 32)) & 1;
+}
+
+int
+ArcFlags::getRegion(node* n) const
+{
+	if(n == 0 || n->getLabelL(kAbstractionLevel) != 0 ||
+			n->getNum() >= nodeRegion.size())
+		return kNoRegion;
+	return nodeRegion[n->getNum()];
+}
+
+unsigned int
+ArcFlags::getNumFlagSets() const
+{
+	return words == 0 ? 0 : flagSets.size() / words;
+}
+
+std::string
+ArcFlags::getDefaultFileName()
+{
+	std::string filename(map->getMap()->getMapName());
+	return filename + ".arcflags";
+}
+
+void
+ArcFlags::save(const char* filename) throw(std::invalid_argument)
+{
+	std::ofstream out(filename, std::ios::out | std::ios::binary);
+	if(!out.good())
+	{
+		std::stringstream ss;
+		ss << "ArcFlags: cannot write arc flags file: "<<filename;
+		throw std::invalid_argument(ss.str());
+	}
+
+	int numnodes = nodeRegion.size();
+	int numarcs = adjNode.size();
+	int numsets = getNumFlagSets();
+	out.write((const char*)&kArcFlagsFileVersion, sizeof(int));
+	out.write((const char*)&numnodes, sizeof(int));
+	out.write((const char*)&numarcs, sizeof(int));
+	out.write((const char*)&numRegions, sizeof(int));
+	out.write((const char*)&numsets, sizeof(int));
+	if(numnodes > 0)
+		out.write((const char*)&nodeRegion[0], numnodes*sizeof(int));
+	if(numarcs > 0)
+	{
+		out.write((const char*)&adjNode[0], numarcs*sizeof(int));
+		out.write((const char*)&arcSet[0], numarcs*sizeof(unsigned int));
+	}
+	if(flagSets.size() > 0)
+		out.write((const char*)&flagSets[0],
+				flagSets.size()*sizeof(unsigned int));
+	out.close();
+}
+
+bool
+ArcFlags::load(const char* filename)
+{
+	std::ifstream in(filename, std::ios::in | std::ios::binary);
+	if(!in.good())
+		return false;
+
+	int version, numnodes, numarcs, numsets;
+	unsigned int regions;
+	in.read((char*)&version, sizeof(int));
+	in.read((char*)&numnodes, sizeof(int));
+	in.read((char*)&numarcs, sizeof(int));
+	in.read((char*)&regions, sizeof(int));
+	in.read((char*)&numsets, sizeof(int));
+	if(!in.good() || version != kArcFlagsFileVersion ||
+			numnodes != (int)nodeRegion.size() ||
+			numarcs != (int)adjNode.size() || numsets < 0)
+		return false;
+
+	// the arcs must be listed in the same order as the graph's edges
+	unsigned int w = (regions + 31) / 32;
+	std::vector<int> nr(numnodes);
+	std::vector<int> an(numarcs);
+	std::vector<unsigned int> as(numarcs);
+	std::vector<unsigned int> fs(numsets*w);
+	if(numnodes > 0)
+		in.read((char*)&nr[0], numnodes*sizeof(int));
+	if(numarcs > 0)
+	{
+		in.read((char*)&an[0], numarcs*sizeof(int));
+		in.read((char*)&as[0], numarcs*sizeof(unsigned int));
+	}
+	if(fs.size() > 0)
+		in.read((char*)&fs[0], fs.size()*sizeof(unsigned int));
+	if(!in.good() || an != adjNode)
+		return false;
+
+	for(int i=0; i<numnodes; i++)
+		if(nr[i] < kNoRegion || nr[i] >= (int)regions)
+			return false;
+	for(int a=0; a<numarcs; a++)
+		if(as[a] >= (unsigned int)numsets)
+			return false;
+
+	numRegions = regions;
+	words = w;
+	nodeRegion.swap(nr);
+	arcSet.swap(as);
+	flagSets.swap(fs);
+	return true;
+}
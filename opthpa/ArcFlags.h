@@ -0,0 +1,101 @@
+#ifndef ARCFLAGS_H
+#define ARCFLAGS_H
+
+// ArcFlags.h
+//
+// Arc flags over the clusters of a GenericClusterAbstraction (HPA etc.).
+// Each cluster is a region; each arc of the grid graph (an edge, taken in
+// one direction) has one flag per region which is set if the arc lies on
+// some optimal path into that region. A search towards a goal need only
+// follow arcs flagged for the goal's region and still finds an optimal
+// path; arcs leading elsewhere are skipped (see ArcFlagsFilter).
+//
+// Flags are computed with one Dijkstra search from every boundary node
+// (a node with a neighbour in another region): an arc (u, v) is on an
+// optimal path to boundary node b if dist(u, b) = cost(u, v) + dist(v, b).
+// Arcs between two nodes of the same region are always flagged for it.
+// The searches run on worker threads; each thread sets flags in its own
+// buffer and the buffers are ORed together once all searches are done.
+//
+// Most arcs share their flags with many others, so each distinct set of
+// flags is stored once and every arc refers to one of them.
+//
+// Saved flags may be loaded only as long as the grid graph and the
+// clusters do not change.
+//
+// @created: 17/10/2026
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class GenericClusterAbstraction;
+class node;
+class ArcFlags
+{
+	public:
+		static const int kNoRegion = -1;
+
+		ArcFlags(GenericClusterAbstraction* map) throw(std::invalid_argument);
+		~ArcFlags();
+
+		// Computes the flags of every arc. Any existing flags are discarded.
+		void build();
+
+		// @return: true if the arc from one node of the grid graph to
+		// another is flagged for region. Arcs the flags know nothing about
+		// (e.g. to nodes added after they were built) are always flagged, as
+		// is every arc when region is kNoRegion.
+		bool isFlagged(node* from, node* to, int region) const;
+
+		// @return: the region of a node of the grid graph, or kNoRegion.
+		int getRegion(node* n) const;
+
+		// Writes the flags to a file.
+		void save(const char* filename) throw(std::invalid_argument);
+
+		// Reads flags written by ::save.
+		// @return: false if the file does not exist or it was written for a
+		// different graph.
+		bool load(const char* filename);
+
+		// @return: the default location of the flags for the map; next
+		// to the map file itself.
+		std::string getDefaultFileName();
+
+		bool isBuilt() const { return flagSets.size() > 0; }
+		unsigned int getNumRegions() const { return numRegions; }
+		unsigned int getNumArcs() const { return adjNode.size(); }
+		unsigned int getNumFlagSets() const;
+
+	private:
+		friend class ArcFlagsSearchTask;
+
+		void computeAdjacency();
+		void computeRegions();
+		void search(int source, std::vector<double>& dist) const;
+		void flagPathsTo(int b, const std::vector<double>& dist,
+				std::vector<unsigned int>& flags) const;
+		void compress(const std::vector<unsigned int>& flags);
+		int findArc(int from, int to) const;
+
+		GenericClusterAbstraction* map;
+		unsigned int numRegions;
+		unsigned int words; // per set of flags
+
+		// the region of each node in the grid graph
+		std::vector<int> nodeRegion;
+
+		// the grid graph as flat arrays; the arcs of node i are those from
+		// adjStart[i] up to adjStart[i+1]
+		std::vector<unsigned int> adjStart;
+		std::vector<int> adjNode;
+		std::vector<double> adjWeight;
+
+		// the set of flags of each arc and the distinct sets, ::words
+		// words each
+		std::vector<unsigned int> arcSet;
+		std::vector<unsigned int> flagSets;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#include "ArcFlagsFilter.h"
+
+#include "ArcFlags.h"
+#include "ProblemInstance.h"
+
+ArcFlagsFilter::ArcFlagsFilter(ArcFlags* flags_) throw(std::invalid_argument)
+	: NodeFilter()
+{
+	if(flags_ == 0)
+		throw std::invalid_argument("ArcFlagsFilter: null arc flags");
+
+	this->flags = flags_;
+	goalRegion = ArcFlags::kNoRegion;
+}
+
+ArcFlagsFilter::~ArcFlagsFilter()
+{
+}
+
+// returns true if the edge (from, to) is not flagged for the region of 
+// the goal
+bool 
+ArcFlagsFilter::filter(node* from, node* to)
+{
+	if(from == 0 || to == 0)
+		return false;
+	return !flags->isFlagged(from, to, goalRegion);
+}
+
+void 
+ArcFlagsFilter::setProblemInstance(ProblemInstance* p)
+{
+	goalRegion = p ? flags->getRegion(p->getGoalNode()) : ArcFlags::kNoRegion;
+}
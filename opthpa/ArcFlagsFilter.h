@@ -0,0 +1,38 @@
+#ifndef ARCFLAGSFILTER_H
+#define ARCFLAGSFILTER_H
+
+// ArcFlagsFilter.h
+//
+// A filter that skips every edge of the grid graph which is not flagged
+// for the region of the goal (see ArcFlags). Searches on the grid graph
+// still find optimal paths but expand far fewer nodes.
+//
+// The filter does not own its ArcFlags; several filters may share them,
+// and the caller deletes them once they are done.
+//
+// @created: 17/10/2026
+
+#include "NodeFilter.h"
+
+#include <stdexcept>
+
+class ArcFlags;
+class ArcFlagsFilter : public NodeFilter
+{
+	public:
+		ArcFlagsFilter(ArcFlags* flags) throw(std::invalid_argument);
+		virtual ~ArcFlagsFilter();
+
+		// flags belong to edges; a node on its own is never filtered
+		virtual bool filter(node* n) { return false; }
+		virtual bool filter(node* from, node* to);
+		virtual void setProblemInstance(ProblemInstance* p);
+
+		ArcFlags* getArcFlags() { return flags; }
+
+	private:
+		ArcFlags* flags;
+		int goalRegion;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#include "CHSearch.h"
+
+#include "ContractionHierarchy.h"
+#include "graph.h"
+#include "path.h"
+#include "timer.h"
+
+CHSearch::CHSearch(ContractionHierarchy* ch)
+	: searchAlgorithm()
+{
+	this->ch = ch;
+	nodesGenerated = 0;
+}
+
+CHSearch::~CHSearch()
+{
+}
+
+const char* 
+CHSearch::getName()
+{
+	return "CH";
+}
+
+path* 
+CHSearch::getPath(graphAbstraction *aMap, node *start, node *goal,
+		reservationProvider *rp)
+{
+	Timer t;
+	t.startTimer();
+
+	path* p = ch->getPath(start, goal);
+	if(p == 0 && verbose)
+		std::cout << "CH: no path to goal. "<<std::endl;
+
+	nodesExpanded = ch->getNodesExpanded();
+	nodesTouched = ch->getNodesTouched();
+	nodesGenerated = ch->getNodesGenerated();
+	searchTime = t.endTimer();
+	return p;
+}
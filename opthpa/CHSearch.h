@@ -0,0 +1,36 @@
+#ifndef CHSEARCH_H
+#define CHSEARCH_H
+
+// CHSearch.h
+//
+// Answers path queries using a ContractionHierarchy. 
+//
+// The nodes given to ::getPath must belong to the graph the hierarchy was
+// built from, or have been added to it since (e.g. by the InsertionPolicy
+// of a HierarchicalSearch) and only be connected to nodes which do.
+//
+// The search does not own the hierarchy; several searches may share one,
+// and the caller deletes it once they are done.
+//
+// @created: 17/10/2026
+
+#include "searchAlgorithm.h"
+
+class ContractionHierarchy;
+class CHSearch : public searchAlgorithm
+{
+	public:
+		CHSearch(ContractionHierarchy* ch);
+		virtual ~CHSearch();
+
+		virtual const char *getName();
+		virtual path *getPath(graphAbstraction *aMap, node *from, node *goal,
+				reservationProvider *rp = 0);
+
+		ContractionHierarchy* getHierarchy() { return ch; }
+
+	private:
+		ContractionHierarchy* ch;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#include "CPDSearch.h"
+
+#include "CompressedPathDatabase.h"
+#include "graph.h"
+#include "mapAbstraction.h"
+#include "path.h"
+#include "timer.h"
+
+CPDSearch::CPDSearch(CompressedPathDatabase* cpd)
+	: searchAlgorithm()
+{
+	this->cpd = cpd;
+	nodesGenerated = 0;
+}
+
+CPDSearch::~CPDSearch()
+{
+}
+
+const char* 
+CPDSearch::getName()
+{
+	return "CPD";
+}
+
+path* 
+CPDSearch::getPath(graphAbstraction *aMap, node *start, node *goal,
+		reservationProvider *rp)
+{
+	nodesExpanded = 0;
+	nodesTouched = 0;
+	nodesGenerated = 0;
+	searchTime = 0;
+
+	if(start == 0 || goal == 0 || start == goal)
+		return 0;
+
+	Timer t;
+	t.startTimer();
+
+	// an optimal path visits each node at most once; any more steps mean
+	// the moves in the database lead around in a cycle
+	int maxsteps = cpd->getMapAbstraction()->getAbstractGraph(0)->getNumNodes();
+
+	path* p = new path(start, 0);
+	path* tail = p;
+	node* current = start;
+	while(current != goal)
+	{
+		if(nodesExpanded >= maxsteps)
+		{
+			if(verbose) 
+				std::cout << "CPD: no goal after "<<maxsteps<<" steps. "<<std::endl;
+			delete p;
+			p = 0;
+			break;
+		}
+
+		// every step is one lookup in the database
+		nodesExpanded++;
+		nodesTouched++;
+		node* next = cpd->step(current, cpd->getFirstMove(current, goal));
+		if(next == 0)
+		{
+			if(verbose) 
+				std::cout << "CPD: no path to goal. "<<std::endl;
+			delete p;
+			p = 0;
+			break;
+		}
+
+		tail->next = new path(next, 0);
+		tail = tail->next;
+		current = next;
+	}
+
+	searchTime = t.endTimer();
+	return p;
+}
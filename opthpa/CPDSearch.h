@@ -0,0 +1,40 @@
+#ifndef CPDSEARCH_H
+#define CPDSEARCH_H
+
+// CPDSearch.h
+//
+// Answers path queries using a CompressedPathDatabase. Starting at the
+// start location, the first move towards the goal is looked up and taken
+// until the goal is reached; each step costs one lookup and no search
+// takes place.
+//
+// The nodes given to ::getPath must belong to the grid graph of the map
+// abstraction the database was built from. A walk which has not reached
+// the goal after one step for each node of the grid graph is abandoned
+// and no path is returned.
+//
+// The search does not own the database; several searches may share one,
+// and the caller deletes it once they are done.
+//
+// @created: 17/10/2026
+
+#include "searchAlgorithm.h"
+
+class CompressedPathDatabase;
+class CPDSearch : public searchAlgorithm
+{
+	public:
+		CPDSearch(CompressedPathDatabase* cpd);
+		virtual ~CPDSearch();
+
+		virtual const char *getName();
+		virtual path *getPath(graphAbstraction *aMap, node *from, node *goal,
+				reservationProvider *rp = 0);
+
+		CompressedPathDatabase* getDatabase() { return cpd; }
+
+	private:
+		CompressedPathDatabase* cpd;
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "CachedHeuristic.h"
+
+#include "constants.h"
+#include "graph.h"
+#include "statCollection.h"
+
+#include <stdexcept>
+
+CachedHeuristic::CachedHeuristic(Heuristic* heuristic_)
+{
+	this->heuristic = heuristic_;
+	generation = 0;
+	goalX = goalY = goalLevel = -1;
+	lookups = hits = 0;
+}
+
+CachedHeuristic::~CachedHeuristic()
+{
+	delete heuristic;
+}
+
+double
+CachedHeuristic::h(node* first, node* second) const
+{
+	if(first == 0 || second == 0)
+		throw std::invalid_argument("null node");
+
+	setGoal(second);
+	lookups++;
+
+	double value;
+	if(find(first, value))
+	{
+		hits++;
+		return value;
+	}
+
+	value = heuristic->h(first, second);
+	store(first, value);
+	return value;
+}
+
+void
+CachedHeuristic::h_batch(node** first, unsigned int count, node* second,
+		double* out) const
+{
+	if(second == 0)
+		throw std::invalid_argument("null node");
+
+	setGoal(second);
+	lookups += count;
+
+	missed.clear();
+	missedIndex.clear();
+	for(unsigned int i=0; i<count; i++)
+	{
+		if(first[i] == 0)
+			throw std::invalid_argument("null node");
+
+		if(find(first[i], out[i]))
+			hits++;
+		else
+		{
+			missed.push_back(first[i]);
+			missedIndex.push_back(i);
+		}
+	}
+	if(missed.empty())
+		return;
+
+	missedValue.resize(missed.size());
+	heuristic->h_batch(&missed[0], missed.size(), second, &missedValue[0]);
+	for(unsigned int i=0; i<missed.size(); i++)
+	{
+		out[missedIndex[i]] = missedValue[i];
+		store(missed[i], missedValue[i]);
+	}
+}
+
+double
+CachedHeuristic::getHitRate() const
+{
+	return lookups == 0 ? 0 : hits / (double)lookups;
+}
+
+void
+CachedHeuristic::logFinalStats(statCollection* stats, const char* name) const
+{
+	stats->addStat("hCacheLookups", name, lookups);
+	stats->addStat("hCacheHits", name, hits);
+	stats->addStat("hCacheHitRate", name, getHitRate());
+}
+
+// Starts a new generation unless goal is at the same location as the
+// last one.
+void
+CachedHeuristic::setGoal(node* goal) const
+{
+	int x = goal->getLabelL(kFirstData);
+	int y = goal->getLabelL(kFirstData+1);
+	int level = goal->getLabelL(kAbstractionLevel);
+	if(generation != 0 && x == goalX && y == goalY && level == goalLevel)
+		return;
+
+	goalX = x;
+	goalY = y;
+	goalLevel = level;
+	generation++;
+	if(generation == 0)
+	{
+		// the stamps have wrapped around; old entries might look current
+		entries.clear();
+		generation = 1;
+	}
+}
+
+bool
+CachedHeuristic::find(node* n, double& value) const
+{
+	unsigned int num = n->getNum();
+	if(num >= entries.size())
+		return false;
+
+	const Entry& e = entries[num];
+	if(e.generation != generation || e.x != n->getLabelL(kFirstData) ||
+			e.y != n->getLabelL(kFirstData+1) ||
+			e.level != n->getLabelL(kAbstractionLevel))
+		return false;
+
+	value = e.value;
+	return true;
+}
+
+void
+CachedHeuristic::store(node* n, double value) const
+{
+	unsigned int num = n->getNum();
+	if(num >= entries.size())
+	{
+		Entry blank;
+		blank.generation = 0;
+		blank.x = blank.y = blank.level = -1;
+		blank.value = 0;
+		entries.resize(num+1, blank);
+	}
+
+	Entry& e = entries[num];
+	e.generation = generation;
+	e.x = n->getLabelL(kFirstData);
+	e.y = n->getLabelL(kFirstData+1);
+	e.level = n->getLabelL(kAbstractionLevel);
+	e.value = value;
+}
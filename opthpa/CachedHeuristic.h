@@ -0,0 +1,82 @@
+#ifndef CACHEDHEURISTIC_H
+#define CACHEDHEURISTIC_H
+
+// CachedHeuristic.h
+//
+// Remembers the values of another heuristic for one goal at a time.
+// Useful when that heuristic is expensive (e.g. LandmarkHeuristic): a
+// search evaluates h(n, goal) for the same node many times (once for each
+// time it is generated and again whenever altheap breaks a tie), and
+// consecutive queries often share a goal, e.g. units of a simulation
+// heading for the same location.
+//
+// Values are kept in a dense array indexed by node number. Each entry is
+// stamped with the generation it was computed in; asking for a different
+// goal starts a new generation, which invalidates every entry at once
+// without clearing the array.
+//
+// Goals and nodes are identified by their location and abstraction level
+// rather than by pointer, since insertion policies create and destroy
+// start and goal nodes on every query and node numbers are reused. The
+// wrapped heuristic must therefore depend only on the locations of the
+// two nodes, as all heuristics here do.
+//
+// @created: 17/10/2026
+
+#include "Heuristic.h"
+
+#include <vector>
+
+class statCollection;
+class CachedHeuristic : public Heuristic
+{
+	public:
+		// takes ownership of heuristic
+		CachedHeuristic(Heuristic* heuristic);
+		virtual ~CachedHeuristic();
+
+		virtual double h(node* first, node* second) const;
+		virtual void h_batch(node** first, unsigned int count, node* second,
+				double* out) const;
+
+		Heuristic* getHeuristic() { return heuristic; }
+
+		long getLookups() const { return lookups; }
+		long getHits() const { return hits; }
+		double getHitRate() const;
+		void resetMetrics() { lookups = hits = 0; }
+
+		// records lookups, hits and hit rate for the search algorithm name
+		void logFinalStats(statCollection* stats, const char* name) const;
+
+	private:
+		struct Entry
+		{
+			unsigned int generation;
+			int x, y, level;
+			double value;
+		};
+
+		void setGoal(node* goal) const;
+		bool find(node* n, double& value) const;
+		void store(node* n, double value) const;
+
+		Heuristic* heuristic;
+
+		// the memo for the current goal; entries whose generation differs
+		// from ::generation are stale
+		mutable std::vector<Entry> entries;
+		mutable unsigned int generation;
+		mutable int goalX, goalY, goalLevel;
+
+		// lets h_batch pass only the nodes it has no value for to the
+		// wrapped heuristic
+		mutable std::vector<node*> missed;
+		mutable std::vector<unsigned int> missedIndex;
+		mutable std::vector<double> missedValue;
+
+		mutable long lookups;
+		mutable long hits;
+};
+
+#endif
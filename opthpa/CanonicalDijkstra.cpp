@@ -0,0 +1,262 @@
+#include "CanonicalDijkstra.h"
+
+#include "graph.h"
+#include "map.h"
+#include "mapAbstraction.h"
+
+#include <cmath>
+#include <functional>
+#include <queue>
+
+// the grid offsets of each move: N, NE, E, SE, S, SW, W, NW
+static const int kMoveX[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+static const int kMoveY[8] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+
+// two path costs closer than this are taken to be the same
+static const double kEpsilon = 0.000001;
+
+// successors are not pruned when moves have no cost
+static const int kNoRules = 0;
+
+const int CanonicalDijkstra::kNoMove;
+
+static inline bool
+isDiagonal(int move)
+{
+	return move & 1;
+}
+
+static int
+getMove(int dx, int dy)
+{
+	for(int m=0; m<8; m++)
+		if(kMoveX[m] == dx && kMoveY[m] == dy)
+			return m;
+	return CanonicalDijkstra::kNoMove;
+}
+
+CanonicalDijkstra::CanonicalDijkstra(mapAbstraction* map_)
+	throw(std::invalid_argument)
+{
+	if(map_ == 0)
+		throw std::invalid_argument("CanonicalDijkstra: null map abstraction");
+
+	this->map = map_;
+	width = map->getMap()->getMapWidth();
+	height = map->getMap()->getMapHeight();
+	for(int m=0; m<8; m++)
+		offset[m] = kMoveX[m] + kMoveY[m]*width;
+
+	computeEdges();
+	computeSuccessors(1, ROOT_TWO);
+	edgesFollowed = 0;
+}
+
+CanonicalDijkstra::~CanonicalDijkstra()
+{
+}
+
+// Records, for each location, the moves for which the grid graph has an
+// edge. Edges which do not join neighbouring locations are ignored.
+void
+CanonicalDijkstra::computeEdges()
+{
+	graph* g = map->getAbstractGraph(0);
+	edges.assign(width*height, 0);
+	for(int i=0; i<g->getNumNodes(); i++)
+	{
+		node* n = g->getNode(i);
+		int x = n->getLabelL(kFirstData);
+		int y = n->getLabelL(kFirstData+1);
+		if(x < 0 || x >= width || y < 0 || y >= height)
+			continue;
+
+		edge_iterator ei = n->getEdgeIter();
+		for(edge* e = n->edgeIterNext(ei); e; e = n->edgeIterNext(ei))
+		{
+			node* nn = g->getNode(e->getFrom() == (unsigned int)i ? e->getTo() : e->getFrom());
+			int move = getMove(nn->getLabelL(kFirstData) - x,
+					nn->getLabelL(kFirstData+1) - y);
+			if(move != kNoMove)
+				edges[x + y*width] |= 1 << move;
+		}
+	}
+}
+
+// The rules depend only on how the cost of a diagonal move compares with
+// one and two straight moves; searches with different costs share them
+// whenever those comparisons agree.
+int
+CanonicalDijkstra::getRules(double straight, double diagonal) const
+{
+	if(straight <= 0 || diagonal <= 0)
+		return kNoRules;
+
+	int shorter = diagonal < straight ? 0 : (diagonal == straight ? 1 : 2);
+	int longer = diagonal < 2*straight ? 0 : (diagonal == 2*straight ? 1 : 2);
+	return 1 + shorter*3 + longer;
+}
+
+void
+CanonicalDijkstra::computeSuccessors(double straight, double diagonal)
+{
+	rules = getRules(straight, diagonal);
+	successors.assign(width*height*9, 0);
+	for(int n=0; n<width*height; n++)
+	{
+		if(edges[n] == 0)
+			continue;
+
+		successors[n*9 + kNoMove] = edges[n];
+		for(int in=0; in<8; in++)
+		{
+			int p = n - offset[in];
+			if(!(edges[n] & (1 << ((in+4) % 8))))
+				continue;
+
+			unsigned char mask = 0;
+			for(int out=0; out<8; out++)
+				if((edges[n] & (1 << out)) && (rules == kNoRules ||
+						!pruned(p, in, out, straight, diagonal)))
+					mask |= 1 << out;
+			successors[n*9 + in] = mask;
+		}
+	}
+}
+
+// Having moved from p by in, is the move out never part of a canonical
+// path? It is if another path of at most two moves from p reaches the same
+// location for less, or for the same cost with its straight move first.
+bool
+CanonicalDijkstra::pruned(int p, int in, int out, double straight,
+		double diagonal) const
+{
+	int mx = kMoveX[in] + kMoveX[out];
+	int my = kMoveY[in] + kMoveY[out];
+	if(mx == 0 && my == 0)
+		return true;
+
+	double cost = (isDiagonal(in) ? diagonal : straight) +
+		(isDiagonal(out) ? diagonal : straight);
+
+	int direct = getMove(mx, my);
+	if(direct != kNoMove && (edges[p] & (1 << direct)) &&
+			(isDiagonal(direct) ? diagonal : straight) <= cost)
+		return true;
+
+	for(int first=0; first<8; first++)
+	{
+		if(first == in || !(edges[p] & (1 << first)))
+			continue;
+		int second = getMove(mx - kMoveX[first], my - kMoveY[first]);
+		if(second == kNoMove || !(edges[p + offset[first]] & (1 << second)))
+			continue;
+
+		double alt = (isDiagonal(first) ? diagonal : straight) +
+			(isDiagonal(second) ? diagonal : straight);
+		if(alt < cost)
+			return true;
+		if(alt == cost && !isDiagonal(first) && isDiagonal(in))
+			return true;
+		if(alt == cost && isDiagonal(first) == isDiagonal(in) &&
+				!isDiagonal(second) && isDiagonal(out))
+			return true;
+	}
+	return false;
+}
+
+void
+CanonicalDijkstra::search(node* source, double weightscale)
+{
+	typedef std::pair<double, int> QueueEntry;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+		std::greater<QueueEntry> > open;
+
+	double straight = 1;
+	double diagonal = ROOT_TWO;
+	if(weightscale > 0)
+	{
+		straight = floor(straight * weightscale);
+		diagonal = floor(diagonal * weightscale);
+	}
+	if(getRules(straight, diagonal) != rules)
+		computeSuccessors(straight, diagonal);
+
+	// only the locations reached by the last search need to be reset
+	if(dist.size() != (unsigned int)(width*height))
+	{
+		dist.assign(width*height, -1);
+		parent.assign(width*height, -1);
+		firstMove.assign(width*height, kNoMove);
+		incoming.assign(width*height, 0);
+		touched.clear();
+	}
+	for(unsigned int i=0; i<touched.size(); i++)
+	{
+		dist[touched[i]] = -1;
+		parent[touched[i]] = -1;
+		firstMove[touched[i]] = kNoMove;
+		incoming[touched[i]] = 0;
+	}
+	touched.clear();
+	edgesFollowed = 0;
+	if(source == 0)
+		return;
+
+	int sx = source->getLabelL(kFirstData);
+	int sy = source->getLabelL(kFirstData+1);
+	if(sx < 0 || sx >= width || sy < 0 || sy >= height)
+		return;
+
+	int start = sx + sy*width;
+	dist[start] = 0;
+	touched.push_back(start);
+	open.push(QueueEntry(0, start));
+	while(!open.empty())
+	{
+		double d = open.top().first;
+		int current = open.top().second;
+		open.pop();
+		if(d > dist[current])
+			continue;
+
+		unsigned char moves = 0;
+		if(current == start)
+			moves = successors[current*9 + kNoMove];
+		for(int in=0; in<8; in++)
+			if(incoming[current] & (1 << in))
+				moves |= successors[current*9 + in];
+
+		for(int out=0; out<8; out++)
+		{
+			if(!(moves & (1 << out)))
+				continue;
+
+			edgesFollowed++;
+			int next = current + offset[out];
+			double nd = d + (isDiagonal(out) ? diagonal : straight);
+			if(dist[next] < 0 || nd < dist[next] - kEpsilon)
+			{
+				if(dist[next] < 0)
+					touched.push_back(next);
+				dist[next] = nd;
+				parent[next] = current;
+				firstMove[next] = current == start ? out : firstMove[current];
+				incoming[next] = 1 << out;
+				open.push(QueueEntry(nd, next));
+			}
+			else if(nd < dist[next] + kEpsilon)
+			{
+				incoming[next] |= 1 << out;
+			}
+		}
+	}
+}
+
+double
+CanonicalDijkstra::getDistance(int x, int y) const
+{
+	if(x < 0 || x >= width || y < 0 || y >= height || dist.empty())
+		return -1;
+	return dist[x + y*width];
+}
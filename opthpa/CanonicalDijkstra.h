@@ -0,0 +1,99 @@
+#ifndef CANONICALDIJKSTRA_H
+#define CANONICALDIJKSTRA_H
+
+// CanonicalDijkstra.h
+//
+// Computes the distance from one location to every other location on a
+// grid map (a distance map) with a Dijkstra search over the grid graph of
+// a map abstraction.
+//
+// A plain Dijkstra search follows every edge of every node it expands.
+// This one follows a canonical ordering instead, in the manner of Jump
+// Point Search: of the optimal paths to a location only those which make
+// their straight moves first need to be followed, so each node is only
+// generated by its neighbours on such a path. In open areas that means one
+// or three edges per node instead of eight. (Jump Point Search puts
+// diagonal moves first; either order works, but straight moves first
+// gives first moves which CompressedPathDatabase compresses better.)
+//
+// The pruning rules are not hard-coded; they are worked out by the
+// constructor from the edges of the grid graph. Having reached n from p,
+// the move from n to m is skipped if some other path of at most two moves
+// from p to m is shorter, or is as short and makes its straight move
+// first. The rules hold whatever the corner cutting rules of the map. When
+// two optimal paths reach a location by different moves both moves are
+// remembered so ties cannot hide a canonical path.
+//
+// Results are indexed by map coordinates (x + y*width). Locations which
+// are blocked or cannot be reached have a distance of -1.
+//
+// Moves are numbered clockwise from north: N, NE, E, SE, S, SW, W, NW
+// (as in CompressedPathDatabase). If the grid graph changes, create a new
+// search.
+//
+// @created: 17/10/2026
+
+#include <stdexcept>
+#include <vector>
+
+class mapAbstraction;
+class node;
+class CanonicalDijkstra
+{
+	public:
+		static const int kNoMove = 8;
+
+		CanonicalDijkstra(mapAbstraction* map) throw(std::invalid_argument);
+		~CanonicalDijkstra();
+
+		// Computes the distance from source to every location on the map.
+		// If weightscale is given the cost of each move is multiplied by
+		// weightscale and rounded down.
+		void search(node* source, double weightscale = 0);
+
+		// The results of the last search.
+		const std::vector<double>& getDistances() const { return dist; }
+		double getDistance(int x, int y) const;
+
+		// @return: the location before index on an optimal path from the
+		// source, or -1.
+		int getParent(int index) const { return parent[index]; }
+
+		// @return: the first move of an optimal path from the source to
+		// index, or kNoMove.
+		int getFirstMove(int index) const { return firstMove[index]; }
+
+		// @return: the number of times the last search followed an edge.
+		unsigned long getEdgesFollowed() const { return edgesFollowed; }
+
+		int getWidth() const { return width; }
+		int getHeight() const { return height; }
+
+	private:
+		void computeEdges();
+		void computeSuccessors(double straight, double diagonal);
+		bool pruned(int p, int in, int out, double straight,
+				double diagonal) const;
+		int getRules(double straight, double diagonal) const;
+
+		mapAbstraction* map;
+		int width, height;
+		int offset[8]; // map index offset of each move
+
+		// the moves which have an edge from each location
+		std::vector<unsigned char> edges;
+
+		// the moves which continue a canonical path; nine per location, one
+		// for each move by which it can be reached and one for the source
+		std::vector<unsigned char> successors;
+		int rules; // the move costs the successors were computed for
+
+		std::vector<double> dist;
+		std::vector<int> parent;
+		std::vector<unsigned char> firstMove;
+		std::vector<unsigned char> incoming; // moves which reach each location optimally
+		std::vector<int> touched; // locations reached by the last search
+		unsigned long edgesFollowed;
+};
+
+#endif
@@ -0,0 +1,313 @@
+#include "CompressedPathDatabase.h"
+
+#include "CanonicalDijkstra.h"
+#include "MapChecksum.h"
+#include "WorkerThreads.h"
+#include "graph.h"
+#include "map.h"
+#include "mapAbstraction.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+// identifies the file format written by ::save
+static const int kCPDFileVersion = 2;
+
+// the number of rows computed in one piece of work by CPDRowTask
+static const int kRowsPerPiece = 32;
+
+// the grid offsets of each move: N, NE, E, SE, S, SW, W, NW
+static const int kMoveX[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+static const int kMoveY[8] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+
+const int CompressedPathDatabase::kNoMove;
+
+CompressedPathDatabase::CompressedPathDatabase(mapAbstraction* map_)
+	throw(std::invalid_argument)
+{
+	if(map_ == 0)
+		throw std::invalid_argument("CompressedPathDatabase: null map abstraction");
+
+	this->map = map_;
+	width = map->getMap()->getMapWidth();
+	height = map->getMap()->getMapHeight();
+	checksum = MapChecksum::compute(map->getMap());
+	computeOrdering();
+}
+
+CompressedPathDatabase::~CompressedPathDatabase()
+{
+}
+
+// Numbers the nodes of the grid graph in depth-first (preorder) order.
+// Locations which are close together on the map usually receive close
+// numbers and every connected area forms a single block of numbers, which
+// keeps the number of runs in each row small.
+void
+CompressedPathDatabase::computeOrdering()
+{
+	graph* g = map->getAbstractGraph(0);
+	int numnodes = g->getNumNodes();
+	order.clear();
+	order.reserve(numnodes);
+	rank.assign(numnodes, -1);
+
+	std::vector<int> stack;
+	for(int root=0; root<numnodes; root++)
+	{
+		if(rank[root] != -1)
+			continue;
+
+		stack.push_back(root);
+		while(stack.size() > 0)
+		{
+			int current = stack.back();
+			stack.pop_back();
+			if(rank[current] != -1)
+				continue;
+			rank[current] = order.size();
+			order.push_back(current);
+
+			node* n = g->getNode(current);
+			int x = n->getLabelL(kFirstData);
+			int y = n->getLabelL(kFirstData+1);
+			for(int m=7; m>=0; m--)
+			{
+				node* neighbour = map->getNodeFromMap(x+kMoveX[m], y+kMoveY[m]);
+				if(neighbour && rank[neighbour->getNum()] == -1 &&
+						g->findEdge(current, neighbour->getNum()))
+					stack.push_back(neighbour->getNum());
+			}
+		}
+	}
+}
+
+// Computes the rows of one block of kRowsPerPiece sources. Each thread
+// creates its own search the first time it is given a block.
+class CPDRowTask : public ParallelTask
+{
+	public:
+		CPDRowTask(const CompressedPathDatabase* cpd_, 
+				const std::vector<int>& location_, 
+				std::vector<std::vector<unsigned int> >& blocks_,
+				std::vector<unsigned int>& rowLength_)
+			: cpd(cpd_), location(location_), blocks(blocks_), 
+			  rowLength(rowLength_),
+			  searches(WorkerThreads::getNumThreads(), (CanonicalDijkstra*)0)
+		{ }
+
+		virtual ~CPDRowTask()
+		{
+			for(unsigned int i=0; i<searches.size(); i++)
+				delete searches[i];
+		}
+
+		virtual void run(int block, int thread)
+		{
+			if(searches[thread] == 0)
+				searches[thread] = new CanonicalDijkstra(cpd->map);
+
+			int first = block*kRowsPerPiece;
+			int last = std::min(first+kRowsPerPiece, (int)location.size());
+			for(int source = first; source < last; source++)
+			{
+				unsigned int size = blocks[block].size();
+				cpd->computeRow(source, *searches[thread], location, 
+						blocks[block]);
+				rowLength[source] = blocks[block].size() - size;
+			}
+		}
+
+	private:
+		const CompressedPathDatabase* cpd;
+		const std::vector<int>& location;
+		std::vector<std::vector<unsigned int> >& blocks;
+		std::vector<unsigned int>& rowLength;
+		std::vector<CanonicalDijkstra*> searches;
+};
+
+void
+CompressedPathDatabase::build()
+{
+	graph* g = map->getAbstractGraph(0);
+	int numnodes = g->getNumNodes();
+	computeOrdering();
+
+	rowStart.clear();
+	runs.clear();
+
+	// the map index of each node; results of the search are kept by location
+	std::vector<int> location(numnodes);
+	for(int i=0; i<numnodes; i++)
+	{
+		node* n = g->getNode(i);
+		location[i] = n->getLabelL(kFirstData) + n->getLabelL(kFirstData+1)*width;
+	}
+
+	int numblocks = (numnodes + kRowsPerPiece - 1) / kRowsPerPiece;
+	std::vector<std::vector<unsigned int> > blocks(numblocks);
+	std::vector<unsigned int> rowLength(numnodes);
+	CPDRowTask task(this, location, blocks, rowLength);
+	WorkerThreads::run(&task, numblocks);
+
+	rowStart.reserve(numnodes+1);
+	rowStart.push_back(0);
+	for(int i=0; i<numnodes; i++)
+		rowStart.push_back(rowStart.back() + rowLength[i]);
+
+	runs.reserve(rowStart.back());
+	for(int i=0; i<numblocks; i++)
+	{
+		runs.insert(runs.end(), blocks[i].begin(), blocks[i].end());
+		std::vector<unsigned int>().swap(blocks[i]);
+	}
+}
+
+// Searches from source, which finds the first move of an optimal path to
+// every node, then appends the row of source to row.
+void
+CompressedPathDatabase::computeRow(int source, CanonicalDijkstra& search,
+		const std::vector<int>& location, 
+		std::vector<unsigned int>& row) const
+{
+	search.search(map->getAbstractGraph(0)->getNode(source));
+
+	// the move towards source itself is never asked for; it joins
+	// whichever run precedes it
+	int last = -1;
+	for(unsigned int r=0; r<order.size(); r++)
+	{
+		int target = order[r];
+		if(target == source && r > 0)
+			continue;
+
+		int move = search.getFirstMove(location[target]);
+		if(move != last)
+		{
+			row.push_back((r << 4) | move);
+			last = move;
+		}
+	}
+}
+
+int
+CompressedPathDatabase::getFirstMove(node* source, node* target) const
+{
+	if(source == target || !isBuilt())
+		return kNoMove;
+
+	unsigned int s = source->getNum();
+	unsigned int t = target->getNum();
+	if(s >= rank.size() || t >= rank.size())
+		return kNoMove;
+
+	// the last run which starts at or before the target
+	std::vector<unsigned int>::const_iterator first = runs.begin() + rowStart[s];
+	std::vector<unsigned int>::const_iterator last = runs.begin() + rowStart[s+1];
+	std::vector<unsigned int>::const_iterator run =
+		std::upper_bound(first, last, ((unsigned int)rank[t] << 4) | 0xF);
+	if(run == first)
+		return kNoMove;
+	return *(run-1) & 0xF;
+}
+
+node*
+CompressedPathDatabase::step(node* n, int move) const
+{
+	if(move < 0 || move >= kNoMove)
+		return 0;
+
+	int x = n->getLabelL(kFirstData);
+	int y = n->getLabelL(kFirstData+1);
+	return map->getNodeFromMap(x+kMoveX[move], y+kMoveY[move]);
+}
+
+std::string
+CompressedPathDatabase::getDefaultFileName()
+{
+	std::string filename(map->getMap()->getMapName());
+	return filename + ".cpd";
+}
+
+void
+CompressedPathDatabase::save(const char* filename) throw(std::invalid_argument)
+{
+	std::ofstream out(filename, std::ios::out | std::ios::binary);
+	if(!out.good())
+	{
+		std::stringstream ss;
+		ss << "CompressedPathDatabase: cannot write database file: "<<filename;
+		throw std::invalid_argument(ss.str());
+	}
+
+	int numnodes = order.size();
+	int numruns = runs.size();
+	out.write((const char*)&kCPDFileVersion, sizeof(int));
+	out.write((const char*)&width, sizeof(int));
+	out.write((const char*)&height, sizeof(int));
+	out.write((const char*)&checksum, sizeof(unsigned int));
+	out.write((const char*)&numnodes, sizeof(int));
+	out.write((const char*)&numruns, sizeof(int));
+	if(numnodes > 0)
+		out.write((const char*)&order[0], numnodes*sizeof(int));
+	if(rowStart.size() > 0)
+		out.write((const char*)&rowStart[0], rowStart.size()*sizeof(unsigned int));
+	if(numruns > 0)
+		out.write((const char*)&runs[0], numruns*sizeof(unsigned int));
+	out.close();
+}
+
+bool
+CompressedPathDatabase::load(const char* filename)
+{
+	std::ifstream in(filename, std::ios::in | std::ios::binary);
+	if(!in.good())
+		return false;
+
+	int version, w, h, numnodes, numruns;
+	unsigned int sum;
+	in.read((char*)&version, sizeof(int));
+	in.read((char*)&w, sizeof(int));
+	in.read((char*)&h, sizeof(int));
+	in.read((char*)&sum, sizeof(unsigned int));
+	in.read((char*)&numnodes, sizeof(int));
+	in.read((char*)&numruns, sizeof(int));
+	if(!in.good() || version != kCPDFileVersion || w != width ||
+			h != height || sum != checksum || numnodes != map->getAbstractGraph(0)->getNumNodes() ||
+			numruns < 0)
+		return false;
+
+	std::vector<int> o(numnodes);
+	std::vector<unsigned int> rs(numnodes+1);
+	std::vector<unsigned int> r(numruns);
+	if(numnodes > 0)
+		in.read((char*)&o[0], numnodes*sizeof(int));
+	in.read((char*)&rs[0], rs.size()*sizeof(unsigned int));
+	if(numruns > 0)
+		in.read((char*)&r[0], numruns*sizeof(unsigned int));
+	if(!in.good())
+		return false;
+
+	std::vector<int> rk(numnodes, -1);
+	for(int i=0; i<numnodes; i++)
+	{
+		if(o[i] < 0 || o[i] >= numnodes || rk[o[i]] != -1)
+			return false;
+		rk[o[i]] = i;
+	}
+
+	// each row must lie inside the runs and follow the one before it;
+	// getFirstMove does not check
+	if(rs[0] != 0 || rs[numnodes] != (unsigned int)numruns)
+		return false;
+	for(int i=0; i<numnodes; i++)
+		if(rs[i] > rs[i+1])
+			return false;
+
+	order.swap(o);
+	rank.swap(rk);
+	rowStart.swap(rs);
+	runs.swap(r);
+	return true;
+}
@@ -0,0 +1,95 @@
+#ifndef COMPRESSEDPATHDATABASE_H
+#define COMPRESSEDPATHDATABASE_H
+
+// CompressedPathDatabase.h
+//
+// A compressed path database (CPD) stores, for every pair of locations
+// (s, t) on a grid map, the first move of an optimal path from s to t.
+// Paths are extracted with one table lookup per step; no search is needed.
+//
+// There is one row for each source location. A row lists the first move
+// towards every target. Targets are numbered in depth-first order over the
+// grid graph, so nearby targets tend to share a first move. Each row is
+// stored as a sequence of runs of identical moves and a lookup is a
+// binary search over the runs of one row.
+//
+// Rows are computed with one Dijkstra search (see CanonicalDijkstra) for
+// each source location, O(n^2 log n) time in total. Blocks of sources are
+// searched on worker threads, each thread with its own search, and the
+// rows are joined in source order; the database does not depend on the
+// number of threads. It is still meant to be built once, saved, and
+// loaded on subsequent runs.
+//
+// @created: 17/10/2026
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class CanonicalDijkstra;
+class mapAbstraction;
+class node;
+class CompressedPathDatabase
+{
+	friend class CPDRowTask;
+
+	public:
+		// moves are directions on the grid; kNoMove means there is no path
+		static const int kNoMove = 8;
+
+		CompressedPathDatabase(mapAbstraction* map) throw(std::invalid_argument);
+		~CompressedPathDatabase();
+
+		// Computes every row of the database. Any existing rows are
+		// discarded.
+		void build();
+
+		// @return: the first move of an optimal path from source to target,
+		// or kNoMove if target is the source or it cannot be reached.
+		// Both nodes must belong to the grid graph of the map abstraction
+		// the database was built from.
+		int getFirstMove(node* source, node* target) const;
+
+		// @return: the grid neighbour of n in the direction of move, or 0 if
+		// there is none.
+		node* step(node* n, int move) const;
+
+		// Writes the database to a file.
+		void save(const char* filename) throw(std::invalid_argument);
+
+		// Reads a database written by ::save.
+		// @return: false if the file does not exist, it was written for a
+		// different map (including one with the same dimensions but 
+		// different terrain) or its rows do not fit inside its runs.
+		bool load(const char* filename);
+
+		// @return: the default location of the database for the map; next
+		// to the map file itself.
+		std::string getDefaultFileName();
+
+		bool isBuilt() const { return rowStart.size() > 0; }
+		unsigned int getNumRuns() const { return runs.size(); }
+		mapAbstraction* getMapAbstraction() const { return map; }
+
+	private:
+		void computeOrdering();
+		void computeRow(int source, CanonicalDijkstra& search,
+				const std::vector<int>& location, 
+				std::vector<unsigned int>& row) const;
+
+		mapAbstraction* map;
+		int width, height;
+		unsigned int checksum; // see MapChecksum
+
+		// targets, by node number, in depth-first order and the inverse
+		std::vector<int> order;
+		std::vector<int> rank;
+
+		// rowStart[i] is the index of the first run in the row of node i;
+		// there is one extra entry to mark the end of the last row.
+		// a run is stored as (rank of its first target << 4) | move.
+		std::vector<unsigned int> rowStart;
+		std::vector<unsigned int> runs;
+};
+
+#endif
@@ -0,0 +1,555 @@
+#include "ContractionHierarchy.h"
+
+#include "MapChecksum.h"
+#include "fpUtil.h"
+#include "graph.h"
+#include "path.h"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <queue>
+#include <sstream>
+
+// identifies the file format written by ::save
+static const int kCHFileVersion = 2;
+
+// witness searches give up after settling this many nodes; the shortcut
+// is then added whether it is needed or not. Searches made only to estimate
+// the priority of a node are smaller.
+static const int kWitnessLimit = 500;
+static const int kSimulatedWitnessLimit = 50;
+
+typedef std::pair<double, int> QueueEntry;
+
+ContractionHierarchy::ContractionHierarchy(graph* g_)
+	throw(std::invalid_argument)
+{
+	if(g_ == 0)
+		throw std::invalid_argument("ContractionHierarchy: null graph");
+
+	this->g = g_;
+	numShortcuts = 0;
+	numEdges = 0;
+	checksum = 0;
+	generation = 0;
+	nodesExpanded = nodesTouched = nodesGenerated = 0;
+}
+
+ContractionHierarchy::~ContractionHierarchy()
+{
+}
+
+void
+ContractionHierarchy::build()
+{
+	int numnodes = g->getNumNodes();
+	numEdges = g->getNumEdges();
+	checksum = MapChecksum::compute(g);
+	numShortcuts = 0;
+
+	adj.assign(numnodes, std::vector<Arc>());
+	for(int i=0; i<numnodes; i++)
+	{
+		node* n = g->getNode(i);
+		edge_iterator ei = n->getEdgeIter();
+		for(edge* e = n->edgeIterNext(ei); e; e = n->edgeIterNext(ei))
+		{
+			int neighbour = e->getFrom() == (unsigned int)i ? e->getTo() : e->getFrom();
+			if(neighbour != i)
+				addArc(i, neighbour, e->getWeight(), -1);
+		}
+	}
+	contracted.assign(numnodes, false);
+	contractedNeighbours.assign(numnodes, 0);
+	witnessDist.assign(numnodes, -1);
+	witnessTouched.clear();
+
+	std::vector<int> priority(numnodes);
+	std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int> >,
+		std::greater<std::pair<int, int> > > order;
+	for(int i=0; i<numnodes; i++)
+	{
+		priority[i] = getPriority(i);
+		order.push(std::pair<int, int>(priority[i], i));
+	}
+
+	// the edges from each node towards the nodes contracted after it
+	std::vector<std::vector<Arc> > upward(numnodes);
+	rank.assign(numnodes, -1);
+	int next = 0;
+	while(!order.empty())
+	{
+		int v = order.top().second;
+		int p = order.top().first;
+		order.pop();
+		if(contracted[v] || p != priority[v])
+			continue;
+
+		// priorities change as the graph is contracted; put v back if it is
+		// no longer the least important node
+		priority[v] = getPriority(v);
+		if(!order.empty() && priority[v] > order.top().first)
+		{
+			order.push(std::pair<int, int>(priority[v], v));
+			continue;
+		}
+
+		upward[v] = adj[v];
+		contract(v, false);
+		rank[v] = next++;
+
+		for(unsigned int i=0; i<upward[v].size(); i++)
+		{
+			int neighbour = upward[v][i].to;
+			contractedNeighbours[neighbour]++;
+			priority[neighbour] = getPriority(neighbour);
+			order.push(std::pair<int, int>(priority[neighbour], neighbour));
+		}
+	}
+
+	upStart.clear();
+	up.clear();
+	for(int i=0; i<numnodes; i++)
+	{
+		upStart.push_back(up.size());
+		up.insert(up.end(), upward[i].begin(), upward[i].end());
+	}
+	upStart.push_back(up.size());
+
+	adj.clear();
+	contracted.clear();
+	contractedNeighbours.clear();
+	witnessDist.clear();
+	prepareQuery();
+}
+
+// Adds an edge to the remaining graph, in one direction only. If there
+// already is an edge between from and to, the shorter one is kept.
+void
+ContractionHierarchy::addArc(int from, int to, double weight, int middle)
+{
+	std::vector<Arc>& arcs = adj[from];
+	for(unsigned int i=0; i<arcs.size(); i++)
+	{
+		if(arcs[i].to == to)
+		{
+			if(weight < arcs[i].weight)
+			{
+				arcs[i].weight = weight;
+				arcs[i].middle = middle;
+			}
+			return;
+		}
+	}
+	arcs.push_back(Arc(to, weight, middle));
+}
+
+void
+ContractionHierarchy::removeArc(int from, int to)
+{
+	std::vector<Arc>& arcs = adj[from];
+	for(unsigned int i=0; i<arcs.size(); i++)
+	{
+		if(arcs[i].to == to)
+		{
+			arcs[i] = arcs.back();
+			arcs.pop_back();
+			return;
+		}
+	}
+}
+
+// Removes v from the remaining graph and adds the shortcuts this requires.
+// If simulate is true the graph is left unchanged.
+// @return: the number of shortcuts required.
+int
+ContractionHierarchy::contract(int v, bool simulate)
+{
+	// shortcuts added below change adj[v]'s neighbours, never adj[v]
+	const std::vector<Arc>& arcs = adj[v];
+	int shortcuts = 0;
+	for(unsigned int i=0; i<arcs.size(); i++)
+	{
+		double limit = 0;
+		for(unsigned int j=i+1; j<arcs.size(); j++)
+			limit = std::max(limit, arcs[i].weight + arcs[j].weight);
+		if(limit == 0)
+			continue;
+
+		witnessSearch(arcs[i].to, v, limit,
+				simulate ? kSimulatedWitnessLimit : kWitnessLimit);
+		for(unsigned int j=i+1; j<arcs.size(); j++)
+		{
+			double via = arcs[i].weight + arcs[j].weight;
+			double witness = witnessDist[arcs[j].to];
+			if(witness >= 0 && !fgreater(witness, via))
+				continue;
+
+			shortcuts++;
+			if(!simulate)
+			{
+				addArc(arcs[i].to, arcs[j].to, via, v);
+				addArc(arcs[j].to, arcs[i].to, via, v);
+				numShortcuts++;
+			}
+		}
+
+		for(unsigned int k=0; k<witnessTouched.size(); k++)
+			witnessDist[witnessTouched[k]] = -1;
+		witnessTouched.clear();
+	}
+
+	if(!simulate)
+	{
+		for(unsigned int i=0; i<arcs.size(); i++)
+			removeArc(arcs[i].to, v);
+		adj[v].clear();
+		contracted[v] = true;
+	}
+	return shortcuts;
+}
+
+// Dijkstra search from source over the remaining graph, without passing
+// through avoid. Stops once every node within limit of source is settled,
+// or after maxSettled nodes. Distances are left in witnessDist.
+void
+ContractionHierarchy::witnessSearch(int source, int avoid, double limit,
+		int maxSettled)
+{
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+		std::greater<QueueEntry> > queue;
+	witnessDist[source] = 0;
+	witnessTouched.push_back(source);
+	queue.push(QueueEntry(0, source));
+
+	int settled = 0;
+	while(!queue.empty() && settled < maxSettled)
+	{
+		double d = queue.top().first;
+		int current = queue.top().second;
+		queue.pop();
+		if(d > witnessDist[current])
+			continue;
+		if(fgreater(d, limit))
+			break;
+		settled++;
+
+		const std::vector<Arc>& arcs = adj[current];
+		for(unsigned int i=0; i<arcs.size(); i++)
+		{
+			int neighbour = arcs[i].to;
+			if(neighbour == avoid)
+				continue;
+
+			double nd = d + arcs[i].weight;
+			if(witnessDist[neighbour] >= 0 && nd >= witnessDist[neighbour])
+				continue;
+
+			if(witnessDist[neighbour] < 0)
+				witnessTouched.push_back(neighbour);
+			witnessDist[neighbour] = nd;
+			queue.push(QueueEntry(nd, neighbour));
+		}
+	}
+}
+
+// The edge difference of v, plus the number of its neighbours which have
+// already been contracted.
+int
+ContractionHierarchy::getPriority(int v)
+{
+	return contract(v, true) - (int)adj[v].size() + contractedNeighbours[v];
+}
+
+void
+ContractionHierarchy::prepareQuery()
+{
+	int numnodes = rank.size();
+	for(int dir=0; dir<2; dir++)
+	{
+		dist[dir].assign(numnodes, 0);
+		parent[dir].assign(numnodes, -1);
+		closed[dir].assign(numnodes, false);
+		stamp[dir].assign(numnodes, 0);
+		open[dir].clear();
+	}
+	generation = 0;
+}
+
+bool
+ContractionHierarchy::inHierarchy(node* n)
+{
+	return n->getNum() < rank.size() && g->getNode(n->getNum()) == n;
+}
+
+path*
+ContractionHierarchy::getPath(node* start, node* goal)
+{
+	nodesExpanded = nodesTouched = nodesGenerated = 0;
+	if(start == 0 || goal == 0 || start == goal || !isBuilt())
+		return 0;
+
+	int meet;
+	double best;
+	search(start, goal, meet, best);
+	if(best < 0)
+		return 0;
+
+	// the hierarchy nodes on the path, from start to goal, with every
+	// shortcut between them unpacked
+	std::vector<int> nodes;
+	if(meet != -1)
+	{
+		std::vector<int> chain;
+		for(int n = meet; n != -1; n = parent[0][n])
+			chain.push_back(n);
+		std::reverse(chain.begin(), chain.end());
+		for(int n = parent[1][meet]; n != -1; n = parent[1][n])
+			chain.push_back(n);
+
+		nodes.push_back(chain[0]);
+		for(unsigned int i=1; i<chain.size(); i++)
+			unpack(chain[i-1], chain[i], nodes);
+	}
+
+	path* p = 0;
+	if(!inHierarchy(goal))
+		p = new path(goal, p);
+	for(int i=nodes.size()-1; i>=0; i--)
+		p = new path(g->getNode(nodes[i]), p);
+	if(!inHierarchy(start))
+		p = new path(start, p);
+	return p;
+}
+
+// Bidirectional search from start and goal which only follows edges
+// towards more important nodes.
+// @param meet: set to the most important node of the path found, or -1 if
+// the shortest path is a single edge between two nodes outside the
+// hierarchy.
+// @param best: set to the length of the path found, or -1 if there is none.
+void
+ContractionHierarchy::search(node* start, node* goal, int& meet, double& best)
+{
+	generation++;
+	if(generation == 0)
+	{
+		prepareQuery();
+		generation = 1;
+	}
+
+	meet = -1;
+	best = -1;
+	double direct = -1;
+	seed(0, start, goal, direct);
+	seed(1, goal, start, direct);
+	if(direct >= 0)
+		best = direct;
+
+	int dir = 1;
+	while(open[0].size() > 0 || open[1].size() > 0)
+	{
+		// alternate between directions while both have nodes to expand
+		if(open[1-dir].size() > 0)
+			dir = 1-dir;
+
+		std::pop_heap(open[dir].begin(), open[dir].end(),
+				std::greater<QueueEntry>());
+		double d = open[dir].back().first;
+		int current = open[dir].back().second;
+		open[dir].pop_back();
+		if(closed[dir][current] || d > dist[dir][current])
+			continue;
+
+		// nothing further in this direction can improve on best
+		if(best >= 0 && d >= best)
+		{
+			open[dir].clear();
+			continue;
+		}
+
+		closed[dir][current] = true;
+		nodesExpanded++;
+		if(isCurrent(1-dir, current))
+		{
+			double total = d + dist[1-dir][current];
+			if(best < 0 || total < best)
+			{
+				best = total;
+				meet = current;
+			}
+		}
+
+		for(unsigned int i=upStart[current]; i<upStart[current+1]; i++)
+		{
+			nodesTouched++;
+			relax(dir, up[i].to, d + up[i].weight, current);
+		}
+	}
+}
+
+// Starts the search in direction dir from endpoint. If the endpoint is not
+// part of the hierarchy, its neighbours are used instead; if one of them is
+// the other endpoint, also outside the hierarchy, direct is set to the
+// length of the edge between them.
+void
+ContractionHierarchy::seed(int dir, node* endpoint, node* other, double& direct)
+{
+	open[dir].clear();
+	if(inHierarchy(endpoint))
+	{
+		relax(dir, endpoint->getNum(), 0, -1);
+		return;
+	}
+
+	int num = endpoint->getNum();
+	edge_iterator ei = endpoint->getEdgeIter();
+	for(edge* e = endpoint->edgeIterNext(ei); e; e = endpoint->edgeIterNext(ei))
+	{
+		nodesTouched++;
+		int neighbour = (int)e->getFrom() == num ? e->getTo() : e->getFrom();
+		if(neighbour == (int)other->getNum() && !inHierarchy(other))
+		{
+			if(direct < 0 || e->getWeight() < direct)
+				direct = e->getWeight();
+		}
+		else if(neighbour < (int)rank.size())
+			relax(dir, neighbour, e->getWeight(), -1);
+	}
+}
+
+void
+ContractionHierarchy::relax(int dir, int n, double d, int from)
+{
+	if(!isCurrent(dir, n))
+	{
+		stamp[dir][n] = generation;
+		closed[dir][n] = false;
+	}
+	else if(closed[dir][n] || d >= dist[dir][n])
+		return;
+
+	dist[dir][n] = d;
+	parent[dir][n] = from;
+	open[dir].push_back(QueueEntry(d, n));
+	std::push_heap(open[dir].begin(), open[dir].end(),
+			std::greater<QueueEntry>());
+	nodesGenerated++;
+}
+
+// Appends to nodes the nodes of the original graph on the edge from 'from'
+// to 'to', excluding 'from' itself.
+void
+ContractionHierarchy::unpack(int from, int to, std::vector<int>& nodes) const
+{
+	const Arc* arc = findArc(from, to);
+	if(arc == 0 || arc->middle == -1)
+	{
+		nodes.push_back(to);
+		return;
+	}
+
+	int middle = arc->middle;
+	unpack(from, middle, nodes);
+	unpack(middle, to, nodes);
+}
+
+// @return: the edge between from and to; it is stored with whichever of
+// the two was contracted first.
+const ContractionHierarchy::Arc*
+ContractionHierarchy::findArc(int from, int to) const
+{
+	int lower = rank[from] < rank[to] ? from : to;
+	int higher = lower == from ? to : from;
+	for(unsigned int i=upStart[lower]; i<upStart[lower+1]; i++)
+		if(up[i].to == higher)
+			return &up[i];
+	return 0;
+}
+
+void
+ContractionHierarchy::save(const char* filename) throw(std::invalid_argument)
+{
+	std::ofstream out(filename, std::ios::out | std::ios::binary);
+	if(!out.good())
+	{
+		std::stringstream ss;
+		ss << "ContractionHierarchy: cannot write hierarchy file: "<<filename;
+		throw std::invalid_argument(ss.str());
+	}
+
+	int numnodes = rank.size();
+	int numarcs = up.size();
+	out.write((const char*)&kCHFileVersion, sizeof(int));
+	out.write((const char*)&numnodes, sizeof(int));
+	out.write((const char*)&numEdges, sizeof(unsigned int));
+	out.write((const char*)&checksum, sizeof(unsigned int));
+	out.write((const char*)&numShortcuts, sizeof(unsigned int));
+	out.write((const char*)&numarcs, sizeof(int));
+	if(numnodes > 0)
+	{
+		out.write((const char*)&rank[0], numnodes*sizeof(int));
+		out.write((const char*)&upStart[0], upStart.size()*sizeof(unsigned int));
+	}
+	for(int i=0; i<numarcs; i++)
+	{
+		out.write((const char*)&up[i].to, sizeof(int));
+		out.write((const char*)&up[i].weight, sizeof(double));
+		out.write((const char*)&up[i].middle, sizeof(int));
+	}
+	out.close();
+}
+
+bool
+ContractionHierarchy::load(const char* filename)
+{
+	std::ifstream in(filename, std::ios::in | std::ios::binary);
+	if(!in.good())
+		return false;
+
+	int version, numnodes, numarcs;
+	unsigned int edges, sum, shortcuts;
+	in.read((char*)&version, sizeof(int));
+	in.read((char*)&numnodes, sizeof(int));
+	in.read((char*)&edges, sizeof(unsigned int));
+	in.read((char*)&sum, sizeof(unsigned int));
+	in.read((char*)&shortcuts, sizeof(unsigned int));
+	in.read((char*)&numarcs, sizeof(int));
+	if(!in.good() || version != kCHFileVersion ||
+			numnodes != g->getNumNodes() || edges != (unsigned int)g->getNumEdges() ||
+			sum != MapChecksum::compute(g) || numarcs < 0)
+		return false;
+
+	std::vector<int> r(numnodes);
+	std::vector<unsigned int> us(numnodes+1);
+	if(numnodes > 0)
+	{
+		in.read((char*)&r[0], numnodes*sizeof(int));
+		in.read((char*)&us[0], us.size()*sizeof(unsigned int));
+	}
+	std::vector<Arc> arcs;
+	arcs.reserve(numarcs);
+	for(int i=0; i<numarcs && in.good(); i++)
+	{
+		int to, middle;
+		double weight;
+		in.read((char*)&to, sizeof(int));
+		in.read((char*)&weight, sizeof(double));
+		in.read((char*)&middle, sizeof(int));
+		if(to < 0 || to >= numnodes || middle < -1 || middle >= numnodes)
+			return false;
+		arcs.push_back(Arc(to, weight, middle));
+	}
+	if(!in.good() || us[numnodes] != (unsigned int)numarcs)
+		return false;
+
+	rank.swap(r);
+	upStart.swap(us);
+	up.swap(arcs);
+	numEdges = edges;
+	checksum = sum;
+	numShortcuts = shortcuts;
+	prepareQuery();
+	return true;
+}
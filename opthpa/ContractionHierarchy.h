@@ -0,0 +1,141 @@
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+// ContractionHierarchy.h
+//
+// A contraction hierarchy (CH) over any HOG graph: the grid graph of a map
+// abstraction or an abstract graph built on top of it (HPA etc.).
+//
+// Nodes are contracted one at a time, least important first. Contracting
+// a node removes it from the graph and adds a shortcut edge between each
+// pair of its remaining neighbours, unless a witness search finds a path
+// between them that is no longer than the one through the removed node.
+// A node's importance is its edge difference: the number of shortcuts its
+// contraction would add less the number of edges it would remove. The
+// number of neighbours already contracted is added to spread contraction
+// evenly over the graph.
+//
+// Each shortcut remembers the node it bypasses. A query is a bidirectional
+// Dijkstra search which only follows edges towards more important nodes;
+// the shortcuts on the path found are then unpacked into edges of the
+// original graph.
+//
+// The hierarchy is meant to be built once, saved, and loaded on subsequent
+// runs. The graph must not change between building and querying, other
+// than by adding nodes for the duration of a query (see ::getPath). Saved
+// hierarchies record a checksum of the graph, edge weights included (see
+// MapChecksum), and are not loaded for any other graph.
+//
+// @created: 17/10/2026
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+class graph;
+class node;
+class path;
+class ContractionHierarchy
+{
+	public:
+		ContractionHierarchy(graph* g) throw(std::invalid_argument);
+		~ContractionHierarchy();
+
+		// Contracts every node of the graph. Any existing hierarchy is
+		// discarded.
+		void build();
+
+		// @return: a shortest path from start to goal in the graph, or 0 if
+		// goal is unreachable or the same as start.
+		//
+		// start and goal may be nodes added to the graph after the hierarchy
+		// was built (e.g. by an InsertionPolicy) so long as each of their
+		// neighbours is either part of the hierarchy or the other endpoint.
+		path* getPath(node* start, node* goal);
+
+		// Writes the hierarchy to a file.
+		void save(const char* filename) throw(std::invalid_argument);
+
+		// Reads a hierarchy written by ::save.
+		// @return: false if the file does not exist or was written for a
+		// different graph.
+		bool load(const char* filename);
+
+		bool isBuilt() const { return upStart.size() > 0; }
+		unsigned int getNumNodes() const { return rank.size(); }
+		unsigned int getNumShortcuts() const { return numShortcuts; }
+		graph* getGraph() const { return g; }
+
+		// metrics for the last call to ::getPath
+		long getNodesExpanded() const { return nodesExpanded; }
+		long getNodesTouched() const { return nodesTouched; }
+		long getNodesGenerated() const { return nodesGenerated; }
+
+	private:
+		// an edge of the graph while it is being contracted; middle is the
+		// bypassed node for shortcuts and -1 otherwise
+		struct Arc
+		{
+			Arc(int to_, double weight_, int middle_)
+				: to(to_), weight(weight_), middle(middle_) { }
+			int to;
+			double weight;
+			int middle;
+		};
+
+		void addArc(int from, int to, double weight, int middle);
+		void removeArc(int from, int to);
+		int contract(int v, bool simulate);
+		void witnessSearch(int source, int avoid, double limit, int maxSettled);
+		int getPriority(int v);
+
+		bool inHierarchy(node* n);
+		void prepareQuery();
+		void search(node* start, node* goal, int& meet, double& best);
+		void seed(int dir, node* endpoint, node* other, double& direct);
+		void relax(int dir, int n, double d, int parent);
+		void unpack(int from, int to, std::vector<int>& nodes) const;
+		const Arc* findArc(int from, int to) const;
+		bool isCurrent(int dir, int n) const
+		{ return stamp[dir][n] == generation; }
+
+		graph* g;
+		unsigned int numShortcuts;
+		unsigned int numEdges; // in g when the hierarchy was built
+		unsigned int checksum; // of g when the hierarchy was built
+
+		// rank[i] is the position of node i in the contraction order
+		std::vector<int> rank;
+
+		// edges from each node to more important nodes; upStart[i] is the
+		// index of the first edge of node i and there is one extra entry to
+		// mark the end of the last node's edges.
+		std::vector<unsigned int> upStart;
+		std::vector<Arc> up;
+
+		// the remaining graph and working storage for witness searches;
+		// used only while building
+		std::vector<std::vector<Arc> > adj;
+		std::vector<bool> contracted;
+		std::vector<int> contractedNeighbours;
+		std::vector<double> witnessDist;
+		std::vector<int> witnessTouched;
+
+		// working storage for queries: one set for each direction, valid
+		// only where stamp matches the current generation.
+		// parent -1 means the node is the query endpoint or was reached
+		// directly from it.
+		std::vector<double> dist[2];
+		std::vector<int> parent[2];
+		std::vector<bool> closed[2];
+		std::vector<unsigned int> stamp[2];
+		std::vector<std::pair<double, int> > open[2];
+		unsigned int generation;
+
+		long nodesExpanded;
+		long nodesTouched;
+		long nodesGenerated;
+};
+
+#endif
@@ -0,0 +1,399 @@
+#include "DeadEndFilter.h"
+
+#include "AbstractCluster.h"
+#include "GenericClusterAbstraction.h"
+#include "ProblemInstance.h"
+#include "graph.h"
+#include "map.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+// dead ends with more gates than this are not considered; checking the
+// gates costs two searches for each one
+static const unsigned int kMaxGates = 16;
+
+// a search which checks the gates of a dead end gives up (and the dead end
+// is rejected) after settling this many nodes
+static const int kMaxSettled = 10000;
+
+static const double kEpsilon = 0.0001;
+
+const int DeadEndFilter::kNoRegion;
+
+DeadEndFilter::DeadEndFilter(GenericClusterAbstraction* map_)
+	throw(std::invalid_argument)
+{
+	if(map_ == 0)
+		throw std::invalid_argument("DeadEndFilter: null map abstraction");
+
+	this->map = map_;
+	width = map->getMap()->getMapWidth();
+	height = map->getMap()->getMapHeight();
+	numRegions = 0;
+	startRegion = goalRegion = kNoRegion;
+	generation = 0;
+
+	graph* g = map->getAbstractGraph(0);
+	int numnodes = g->getNumNodes();
+	dist.assign(numnodes, 0);
+	mark.assign(numnodes, 0);
+
+	// number the clusters
+	clusterOf.assign(numnodes, -1);
+	cluster_iterator it = map->getClusterIter();
+	for(AbstractCluster* cluster = map->clusterIterNext(it); cluster;
+			cluster = map->clusterIterNext(it))
+	{
+		std::vector<int> members;
+		HPAUtil::nodeTable* nodes = cluster->getNodes();
+		for(HPAUtil::nodeTable::iterator ni = nodes->begin();
+				ni != nodes->end(); ni++)
+		{
+			node* n = (*ni).second;
+			if(n && n->getNum() < (unsigned int)numnodes &&
+					clusterOf[n->getNum()] == -1)
+			{
+				clusterOf[n->getNum()] = clusterNodes.size();
+				members.push_back(n->getNum());
+			}
+		}
+		if(members.size() > 0)
+			clusterNodes.push_back(members);
+	}
+	for(int i=0; i<numnodes; i++)
+	{
+		if(clusterOf[i] == -1)
+		{
+			clusterOf[i] = clusterNodes.size();
+			clusterNodes.push_back(std::vector<int>(1, i));
+		}
+	}
+
+	// connect clusters between which there is at least one move
+	clusterAdj.assign(clusterNodes.size(), std::vector<int>());
+	edge_iterator ei = g->getEdgeIter();
+	for(edge* e = g->edgeIterNext(ei); e; e = g->edgeIterNext(ei))
+	{
+		int from = clusterOf[e->getFrom()];
+		int to = clusterOf[e->getTo()];
+		if(from != to)
+		{
+			clusterAdj[from].push_back(to);
+			clusterAdj[to].push_back(from);
+		}
+	}
+	for(unsigned int i=0; i<clusterAdj.size(); i++)
+	{
+		std::sort(clusterAdj[i].begin(), clusterAdj[i].end());
+		clusterAdj[i].erase(std::unique(clusterAdj[i].begin(),
+					clusterAdj[i].end()), clusterAdj[i].end());
+	}
+
+	std::vector<int> order;
+	std::vector<Candidate> candidates;
+	findCandidates(order, candidates);
+	std::sort(candidates.begin(), candidates.end());
+
+	// accept candidates which pass their checks, largest first. a
+	// candidate which overlaps one accepted earlier is skipped.
+	nodeRegion.assign(numnodes, kNoRegion);
+	std::vector<int> clusterRegion(clusterNodes.size(), kNoRegion);
+	std::vector<std::vector<int> > regionMembers;
+	std::vector<std::vector<int> > regionGates;
+	for(unsigned int c=0; c<candidates.size(); c++)
+	{
+		Candidate& candidate = candidates[c];
+		bool overlaps = false;
+		for(int k=candidate.first; k<candidate.last && !overlaps; k++)
+			overlaps = clusterRegion[order[k]] != kNoRegion;
+		if(overlaps)
+			continue;
+
+		int region = regionMembers.size();
+		std::vector<int> members;
+		for(int k=candidate.first; k<candidate.last; k++)
+		{
+			std::vector<int>& nodes = clusterNodes[order[k]];
+			members.insert(members.end(), nodes.begin(), nodes.end());
+		}
+		for(unsigned int i=0; i<members.size(); i++)
+			nodeRegion[members[i]] = region;
+
+		std::vector<int> gates;
+		if(findGates(members, gates) && verify(gates))
+		{
+			for(int k=candidate.first; k<candidate.last; k++)
+				clusterRegion[order[k]] = region;
+			regionMembers.push_back(members);
+			regionGates.push_back(gates);
+		}
+		else
+		{
+			for(unsigned int i=0; i<members.size(); i++)
+				nodeRegion[members[i]] = kNoRegion;
+		}
+	}
+
+	// each dead end was checked while avoiding only those accepted before
+	// it; check again now that all are known. dropping a dead end only
+	// makes it easier for the others to pass, so one round is enough.
+	std::vector<bool> keep(regionMembers.size(), true);
+	for(unsigned int r=0; r<regionMembers.size(); r++)
+	{
+		if(verify(regionGates[r]))
+			continue;
+		keep[r] = false;
+		for(unsigned int i=0; i<regionMembers[r].size(); i++)
+			nodeRegion[regionMembers[r][i]] = kNoRegion;
+	}
+
+	regions.assign(width*height, kNoRegion);
+	for(unsigned int r=0; r<regionMembers.size(); r++)
+	{
+		if(!keep[r])
+			continue;
+		for(unsigned int i=0; i<regionMembers[r].size(); i++)
+		{
+			int num = regionMembers[r][i];
+			node* n = g->getNode(num);
+			nodeRegion[num] = numRegions;
+			regions[n->getLabelL(kFirstData) +
+				n->getLabelL(kFirstData+1)*width] = numRegions;
+		}
+		numRegions++;
+	}
+}
+
+DeadEndFilter::~DeadEndFilter()
+{
+}
+
+// Finds the articulation clusters of the cluster graph with a depth-first
+// search (Tarjan). Each search starts at the largest cluster not yet
+// visited, which is taken to lie in the main part of the map.
+//
+// When a child v of cluster u cannot reach above u without passing
+// through it, the descendants of v are cut off by u and form a candidate.
+// Descendants are numbered consecutively, so each candidate is a range of
+// the depth-first order. Candidates which hold at least half of the
+// locations connected to them are the main part of the map rather than a
+// dead end; these are left out.
+void
+DeadEndFilter::findCandidates(std::vector<int>& order,
+		std::vector<Candidate>& candidates)
+{
+	int numclusters = clusterNodes.size();
+	std::vector<std::pair<int, int> > roots;
+	for(int i=0; i<numclusters; i++)
+		roots.push_back(std::pair<int, int>(-(int)clusterNodes[i].size(), i));
+	std::sort(roots.begin(), roots.end());
+
+	std::vector<int> disc(numclusters, -1);
+	std::vector<int> low(numclusters, 0);
+	std::vector<int> parent(numclusters, -1);
+	std::vector<std::pair<int, unsigned int> > stack;
+	order.clear();
+	for(unsigned int r=0; r<roots.size(); r++)
+	{
+		int root = roots[r].second;
+		if(disc[root] != -1)
+			continue;
+
+		std::vector<Candidate> found;
+		int begin = order.size();
+		disc[root] = low[root] = order.size();
+		order.push_back(root);
+		stack.push_back(std::pair<int, unsigned int>(root, 0));
+		while(stack.size() > 0)
+		{
+			int u = stack.back().first;
+			if(stack.back().second < clusterAdj[u].size())
+			{
+				int v = clusterAdj[u][stack.back().second++];
+				if(disc[v] == -1)
+				{
+					parent[v] = u;
+					disc[v] = low[v] = order.size();
+					order.push_back(v);
+					stack.push_back(std::pair<int, unsigned int>(v, 0));
+				}
+				else if(v != parent[u])
+					low[u] = std::min(low[u], disc[v]);
+				continue;
+			}
+
+			stack.pop_back();
+			int p = parent[u];
+			if(p == -1)
+				continue;
+			low[p] = std::min(low[p], low[u]);
+			if(low[u] >= disc[p])
+				found.push_back(Candidate(disc[u], order.size(), 0));
+		}
+
+		// prefix[k] is the number of locations in the first k clusters of
+		// this component, in depth-first order
+		std::vector<int> prefix(order.size()-begin+1, 0);
+		for(unsigned int k=begin; k<order.size(); k++)
+			prefix[k-begin+1] = prefix[k-begin] + clusterNodes[order[k]].size();
+
+		for(unsigned int c=0; c<found.size(); c++)
+		{
+			found[c].size = prefix[found[c].last-begin] - 
+				prefix[found[c].first-begin];
+			if(2*found[c].size < prefix.back())
+				candidates.push_back(found[c]);
+		}
+	}
+}
+
+// Collects the nodes outside the dead end which have an edge into it. The
+// members of the dead end must already be labelled in nodeRegion.
+// @return: false if there are too many gates or if the dead end borders
+// on another.
+bool
+DeadEndFilter::findGates(const std::vector<int>& members,
+		std::vector<int>& gates)
+{
+	graph* g = map->getAbstractGraph(0);
+	generation++;
+	for(unsigned int i=0; i<members.size(); i++)
+	{
+		node* n = g->getNode(members[i]);
+		int region = nodeRegion[members[i]];
+		edge_iterator ei = n->getEdgeIter();
+		for(edge* e = n->edgeIterNext(ei); e; e = n->edgeIterNext(ei))
+		{
+			int neighbour = e->getFrom() == (unsigned int)members[i] ?
+				e->getTo() : e->getFrom();
+			if(nodeRegion[neighbour] == region)
+				continue;
+			if(nodeRegion[neighbour] != kNoRegion)
+				return false;
+			if(mark[neighbour] == generation)
+				continue;
+
+			mark[neighbour] = generation;
+			gates.push_back(neighbour);
+			if(gates.size() > kMaxGates)
+				return false;
+		}
+	}
+	return true;
+}
+
+// @return: true if every pair of gates is connected by a path which enters
+// no dead end and is no longer than the shortest path between them.
+bool
+DeadEndFilter::verify(const std::vector<int>& gates)
+{
+	for(unsigned int i=0; i+1<gates.size(); i++)
+	{
+		std::vector<int> others(gates.begin()+i+1, gates.end());
+		std::vector<double> shortest, around;
+		if(!search(gates[i], others, false,
+					std::numeric_limits<double>::max(), shortest))
+			return false;
+
+		double furthest = *std::max_element(shortest.begin(), shortest.end());
+		if(!search(gates[i], others, true, furthest + kEpsilon, around))
+			return false;
+
+		for(unsigned int j=0; j<others.size(); j++)
+			if(around[j] > shortest[j] + kEpsilon)
+				return false;
+	}
+	return true;
+}
+
+// Dijkstra search on the map graph from source until every target is
+// settled; result holds the distance to each target.
+// @return: false if some target is not reached within the limit.
+bool
+DeadEndFilter::search(int source, const std::vector<int>& targets,
+		bool avoidDeadEnds, double limit, std::vector<double>& result)
+{
+	typedef std::pair<double, int> QueueEntry;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>,
+		std::greater<QueueEntry> > open;
+
+	graph* g = map->getAbstractGraph(0);
+	result.assign(targets.size(), -1);
+	unsigned int remaining = targets.size();
+	int settled = 0;
+
+	generation++;
+	mark[source] = generation;
+	dist[source] = 0;
+	open.push(QueueEntry(0, source));
+	while(!open.empty() && remaining > 0)
+	{
+		double d = open.top().first;
+		int current = open.top().second;
+		open.pop();
+		if(d > dist[current])
+			continue;
+		if(d > limit || ++settled > kMaxSettled)
+			return false;
+
+		for(unsigned int j=0; j<targets.size(); j++)
+		{
+			if(targets[j] == current && result[j] < 0)
+			{
+				result[j] = d;
+				remaining--;
+			}
+		}
+
+		node* n = g->getNode(current);
+		edge_iterator ei = n->getEdgeIter();
+		for(edge* e = n->edgeIterNext(ei); e; e = n->edgeIterNext(ei))
+		{
+			int neighbour = e->getFrom() == (unsigned int)current ? e->getTo() : e->getFrom();
+			if(avoidDeadEnds && nodeRegion[neighbour] != kNoRegion)
+				continue;
+
+			double nd = d + e->getWeight();
+			if(mark[neighbour] == generation && nd >= dist[neighbour])
+				continue;
+			mark[neighbour] = generation;
+			dist[neighbour] = nd;
+			open.push(QueueEntry(nd, neighbour));
+		}
+	}
+	return remaining == 0;
+}
+
+bool
+DeadEndFilter::filter(node* n)
+{
+	int region = getRegion(n);
+	return region != kNoRegion && region != startRegion &&
+		region != goalRegion;
+}
+
+void
+DeadEndFilter::setProblemInstance(ProblemInstance* p)
+{
+	startRegion = p ? getRegion(p->getStartNode()) : kNoRegion;
+	goalRegion = p ? getRegion(p->getGoalNode()) : kNoRegion;
+}
+
+int
+DeadEndFilter::getRegion(int x, int y) const
+{
+	if(x < 0 || x >= width || y < 0 || y >= height)
+		return kNoRegion;
+	return regions[x + y*width];
+}
+
+int
+DeadEndFilter::getRegion(node* n) const
+{
+	if(n == 0)
+		return kNoRegion;
+	return getRegion(n->getLabelL(kFirstData), n->getLabelL(kFirstData+1));
+}
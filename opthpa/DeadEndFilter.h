@@ -0,0 +1,105 @@
+#ifndef DEADENDFILTER_H
+#define DEADENDFILTER_H
+
+// DeadEndFilter.h
+//
+// A filter that prunes dead ends: regions of the map which connect to the
+// rest only through a narrow entrance and so can never be on an optimal
+// path unless they contain the start or the goal.
+//
+// Dead ends are found by a preprocessing pass over the cluster graph of an
+// HPA or ERR abstraction (one vertex for each cluster; an edge wherever
+// some move crosses from one cluster into another). Each articulation
+// cluster cuts off one or more groups of clusters from the part of the
+// graph with the largest cluster; every such group is a candidate.
+//
+// A candidate is kept only if its gates (the locations just outside it,
+// from which it can be entered) are few, are not part of another dead
+// end, and can all reach one another without entering any dead end and
+// without taking longer than they would through it. So long as this holds
+// any path which passes through a dead end can be shortened, or kept the
+// same length, by going around; skipping dead ends does not change the
+// cost of the paths found on the map graph. Larger candidates are tried
+// first.
+//
+// The filter is applied to nodes at any level of the abstraction: a node
+// is skipped if its location (kFirstData) lies in a dead end which holds
+// neither the start nor the goal of the current problem instance.
+//
+// The regions are computed once, by the constructor; rebuild the filter
+// if the map changes.
+//
+// @created: 17/10/2026
+
+#include "NodeFilter.h"
+
+#include <stdexcept>
+#include <vector>
+
+class GenericClusterAbstraction;
+class node;
+class DeadEndFilter : public NodeFilter
+{
+	public:
+		static const int kNoRegion = -1;
+
+		DeadEndFilter(GenericClusterAbstraction* map)
+			throw(std::invalid_argument);
+		virtual ~DeadEndFilter();
+
+		// returns true if n lies in a dead end which holds neither the
+		// start nor the goal of the current problem instance
+		virtual bool filter(node* n);
+		virtual void setProblemInstance(ProblemInstance* p);
+
+		// @return: the dead end which contains the location, or kNoRegion
+		int getRegion(int x, int y) const;
+		int getRegion(node* n) const;
+		unsigned int getNumRegions() const { return numRegions; }
+
+	private:
+		struct Candidate
+		{
+			Candidate(int first_, int last_, int size_)
+				: first(first_), last(last_), size(size_) { }
+			// larger candidates sort first
+			bool operator<(const Candidate& other) const
+			{ return size > other.size; }
+
+			// a range of clusters in depth-first order
+			int first, last;
+			int size;
+		};
+
+		void findCandidates(std::vector<int>& order,
+				std::vector<Candidate>& candidates);
+		bool findGates(const std::vector<int>& members,
+				std::vector<int>& gates);
+		bool verify(const std::vector<int>& gates);
+		bool search(int source, const std::vector<int>& gates,
+				bool avoidDeadEnds, double limit, std::vector<double>& result);
+
+		GenericClusterAbstraction* map;
+		int width, height;
+
+		// for each node of the map graph: its cluster (a dense index; nodes
+		// which belong to no cluster are given one of their own) and the
+		// dead end it belongs to, if any.
+		std::vector<int> clusterOf;
+		std::vector<int> nodeRegion;
+		std::vector<std::vector<int> > clusterNodes;
+		std::vector<std::vector<int> > clusterAdj;
+
+		// dead end of each location on the map
+		std::vector<int> regions;
+		unsigned int numRegions;
+		int startRegion, goalRegion;
+
+		// working storage for ::search
+		std::vector<double> dist;
+		std::vector<int> touched;
+		std::vector<unsigned int> mark;
+		unsigned int generation;
+};
+
+#endif
@@ -17,32 +17,88 @@ EmptyCluster::EmptyCluster(const int _x, const int _y,
 	starty = _y;
 	height = 1;
 	width = 1;
+	perimeterReduction = pr;
+	bfReduction = bfr;
+	implicitSecondaryEdges = false;
+	deferMacroEdges = false;
 }
 
 EmptyCluster::~EmptyCluster()
 {
-	graph* absg = map->getAbstractGraph(1);
-	while(secondaryEdges.size() > 0)
+	removeSecondaryEdges();
+}
+
+// Deletes every secondary edge of the cluster. Both endpoints of a secondary
+// edge are abstract nodes of this cluster.
+void
+EmptyCluster::removeSecondaryEdges()
+{
+	for(HPAUtil::nodeTable::iterator it = parents.begin(); 
+			it != parents.end(); it++)
 	{
-		edge* e = secondaryEdges.at(0);
-		MacroNode* from = dynamic_cast<MacroNode*>(
-				absg->getNode(e->getFrom()));
-		assert(from);
-		MacroNode* to = dynamic_cast<MacroNode*>(
-				absg->getNode(e->getTo()));
-		assert(to);
+		MacroNode* p = dynamic_cast<MacroNode*>((*it).second);
+		if(p)
+			p->clearSecondaryEdges();
+	}
 
-		from->removeSecondaryEdge(e->getEdgeNum());
-		to->removeSecondaryEdge(e->getEdgeNum());
-		secondaryEdges.erase(secondaryEdges.begin());
-		delete e;
+	for(unsigned int i=0; i<secondaryEdges.size(); i++)
+		delete secondaryEdges.at(i);
+	secondaryEdges.clear();
+}
+
+// Returns true if some node on the perimeter of the cluster should be an 
+// abstract node but is not, or vice versa. This happens when a tile next 
+// to the cluster is opened or closed and perimeter reduction is enabled.
+bool
+EmptyCluster::frameNeedsRepair()
+{
+	int maxx = getHOrigin() + getWidth() - 1;
+	int maxy = getVOrigin() + getHeight() - 1;
+	for(int y = getVOrigin(); y <= maxy; y++)
+	{
+		// interior rows contribute only their first and last node
+		int step = 1;
+		if(y != getVOrigin() && y != maxy && maxx > getHOrigin())
+			step = maxx - getHOrigin();
+
+		for(int x = getHOrigin(); x <= maxx; x += step)
+		{
+			node* n = map->getNodeFromMap(x, y);
+			assert(n);
+			bool framed = !perimeterReduction || isIncidentWithInterEdge(n);
+			if(framed != (n->getLabelL(kParent) != -1))
+				return true;
+		}
 	}
+	return false;
 }
 
 // Starting from a seed location (startx, starty), build a maximally
 // sized rectangular room that is free of obstacles.
 void 
 EmptyCluster::buildCluster()
+{
+	measureRoom();
+	buildCluster(width, height);
+}
+
+// Assigns every node of the room with the given dimensions, and its origin
+// at (startx, starty), to the cluster. 
+void
+EmptyCluster::buildCluster(int width_, int height_)
+{
+	width = width_;
+	height = height_;
+	for(int x=getHOrigin(); x<getHOrigin()+width; x++)
+		for(int y=getVOrigin(); y<getVOrigin()+height; y++)
+			addNode(map->getNodeFromMap(x, y));
+}
+
+// Sets the width and height of the cluster to those of the room 
+// ::buildCluster would create from the seed location (startx, starty).
+// No nodes are assigned to the cluster. 
+void
+EmptyCluster::measureRoom()
 {
 	ClusterNode* n = dynamic_cast<ClusterNode*>(
 		map->getNodeFromMap(getHOrigin(), getVOrigin()));
@@ -89,12 +145,6 @@ EmptyCluster::buildCluster()
 		height = squareheight;
 		width = maxwidth;
 	}
-
-	// assign nodes to the cluster
-	for(int x=getHOrigin(); x<getHOrigin()+width; x++)
-		for(int y=getVOrigin(); y<getVOrigin()+height; y++)
-			addNode(map->getNodeFromMap(x, y));
-
 }
 
 bool 
@@ -327,17 +377,77 @@ EmptyCluster::buildEntrances()
 			<<getHOrigin()<<", "<<getVOrigin()<<std::endl;
 	}
 
+	connectPerimeter();
+
+	// add interior macro edges
+	if(map->getAllowDiagonals())
+	   addMacroEdges();
+	else
+		addCardinalMacroEdges();
+}
+
+void
+EmptyCluster::connectPerimeter()
+{
 	// identfy perimeter nodes
 	frameCluster();
 
 	// connect perimeter nodes with neighbours from adjacent clusters
 	addInterEdges();
+}
 
-	// add interior macro edges
+// Works out the interior macro edges of the cluster but only records them;
+// the abstract graph is not changed. 
+void
+EmptyCluster::findMacroEdges()
+{
+	pendingEdges.clear();
+	deferMacroEdges = true;
 	if(map->getAllowDiagonals())
 	   addMacroEdges();
 	else
 		addCardinalMacroEdges();
+	deferMacroEdges = false;
+}
+
+// Adds the edges recorded by ::findMacroEdges, in the order they were found.
+void
+EmptyCluster::addFoundMacroEdges()
+{
+	graph* absg = map->getAbstractGraph(1);
+	for(unsigned int i=0; i<pendingEdges.size(); i++)
+	{
+		PendingEdge& pe = pendingEdges[i];
+		if(pe.from == -1)
+			macro = 0;
+		else
+			addSingleMacroEdge(absg->getNode(pe.from), absg->getNode(pe.to), 
+					pe.weight, absg, pe.secondary);
+	}
+	pendingEdges.clear();
+}
+
+// The macro edge count restarts at several points while macro edges are 
+// added; a deferred restart is recorded with the edges.
+void
+EmptyCluster::resetMacroCount()
+{
+	if(deferMacroEdges)
+	{
+		PendingEdge reset = { -1, -1, 0, false };
+		pendingEdges.push_back(reset);
+	}
+	else
+		macro = 0;
+}
+
+// Rebuilds the cluster's abstract nodes and edges after they have been 
+// removed. Neighbouring abstract nodes are reused by ::addInterEdges.
+void
+EmptyCluster::repairEntrances()
+{
+	macro = 0;
+	buildEntrances();
 }
 
 void 
@@ -386,6 +496,18 @@ EmptyCluster::addSingleMacroEdge(node* from_, node* to_, double weight,
 	assert(from && to);
 	assert(from->getParentClusterId() == to->getParentClusterId());
 
+	if(deferMacroEdges)
+	{
+		PendingEdge pe = { (int)from->getNum(), (int)to->getNum(), weight, 
+			secondaryEdge };
+		pendingEdges.push_back(pe);
+		return;
+	}
+
+	// secondary edges are generated during search instead
+	if(secondaryEdge && bfReduction && implicitSecondaryEdges)
+		return;
+
 	MacroEdge* e = static_cast<MacroEdge*>(
 			absg->findEdge(from->getNum(), to->getNum()));
 	if(e == 0 && from->getParentClusterId() == to->getParentClusterId())
@@ -453,8 +575,8 @@ EmptyCluster::addInterEdges()
 		graph* g = map->getAbstractGraph(0);
 		graph* absg = map->getAbstractGraph(1);
 
-		edge_iterator it = n->getEdgeIter();
-		for(edge* e = n->edgeIterNext(it); e != 0; e = n->edgeIterNext(it))
+		edge_iterator eit = n->getEdgeIter();
+		for(edge* e = n->edgeIterNext(eit); e != 0; e = n->edgeIterNext(eit))
 		{
 			double edgeweight = e->getWeight();
 			ClusterNode* nb = dynamic_cast<ClusterNode*>(
@@ -520,7 +642,7 @@ void EmptyCluster::addCardinalMacroEdges()
 		std::cout <<" diagonal edges allowed? "<<map->getAllowDiagonals()<< " "<<std::endl;
 	}
 	graph* absg = map->getAbstractGraph(1);
-	macro = 0;
+	resetMacroCount();
 
 	// connect nodes on directly opposite sides of the perimeter
 	if(this->getWidth() > 1)
@@ -598,7 +720,7 @@ void
 EmptyCluster::addDiagonalMacroEdges()
 {
 	graph* absg = map->getAbstractGraph(1);
-	macro = 0;
+	resetMacroCount();
 
 	// first, add diagonal edges between nodes on orthogonal sides of the 
 	// cluster
@@ -707,7 +829,7 @@ void
 EmptyCluster::addDiagonalFanMacroEdges()
 {
 	graph* absg = map->getAbstractGraph(1);
-	macro = 0;
+	resetMacroCount();
 
 
 	// add edges connecting nodes on the top side to nodes on the bottom 
@@ -947,6 +1069,153 @@ EmptyCluster::nextNodeInColumn(int x, int y, bool topToBottom)
 }
 
 
+// Computes the secondary neighbours of abstract node n from the dimensions of
+// the cluster rather than from stored edges. For each side of the cluster on
+// which n lies, n is connected to every abstract node on the opposite side 
+// that lies within its diagonal fan, plus the nearest abstract node beyond 
+// each edge of the fan (on 4-connected maps: the node directly opposite or, 
+// if there is none, the nearest to either side of it). These are the same 
+// neighbours as stored by ::addDiagonalFanMacroEdges and 
+// ::addCardinalMacroEdges when traversing the cluster outward from n; the
+// remaining stored edges lead into n, and the optimal paths that they 
+// support are found from the other endpoint's own fan instead.
+//
+// Each neighbour is at octile (or Manhattan) distance from n.
+void
+EmptyCluster::getSecondaryNeighbours(MacroNode* n, 
+		std::vector<MacroNode*>& neighbours)
+{
+	int x = n->getLabelL(kFirstData);
+	int y = n->getLabelL(kFirstData+1);
+	int left = getHOrigin();
+	int right = getHOrigin() + getWidth() - 1;
+	int top = getVOrigin();
+	int bottom = getVOrigin() + getHeight() - 1;
+
+	if(map->getAllowDiagonals())
+	{
+		if(getWidth() == 1 || getHeight() == 1)
+			return;
+
+		int max = getHeight() > getWidth()?getWidth():getHeight();
+		max--; // max # diagonal steps we can take in crossing this cluster
+
+		if(y == top)
+			addRowFan(x, bottom, max, neighbours);
+		if(y == bottom)
+			addRowFan(x, top, max, neighbours);
+		if(x == left)
+			addColumnFan(y, right, max, neighbours);
+		if(x == right)
+			addColumnFan(y, left, max, neighbours);
+	}
+	else
+	{
+		if(getWidth() > 1)
+		{
+			if(x == left)
+				addOppositeInColumn(y, right, neighbours);
+			if(x == right)
+				addOppositeInColumn(y, left, neighbours);
+		}
+		if(getHeight() > 1)
+		{
+			if(y == top)
+				addOppositeInRow(x, bottom, neighbours);
+			if(y == bottom)
+				addOppositeInRow(x, top, neighbours);
+		}
+	}
+}
+
+void
+EmptyCluster::addRowFan(int x, int row, int maxDiagSteps, 
+		std::vector<MacroNode*>& neighbours)
+{
+	// nodes in the fan are in the range [minx, maxx] 
+	int minx = (x-maxDiagSteps)<this->getHOrigin()?
+		(this->getHOrigin()):(x-maxDiagSteps); 
+	int maxx = (x+maxDiagSteps)>(this->getHOrigin()+this->getWidth()-1)?
+		(this->getHOrigin()+this->getWidth()-1):(x+maxDiagSteps);
+
+	for(int sx = minx+1; sx <= maxx-1; sx++)
+		addAbstractNode(sx, row, neighbours);
+
+	MacroNode* nb = nextNodeInRow(minx, row, false);
+	if(nb)
+		neighbours.push_back(nb);
+	nb = nextNodeInRow(maxx, row, true);
+	if(nb)
+		neighbours.push_back(nb);
+}
+
+void
+EmptyCluster::addColumnFan(int y, int column, int maxDiagSteps, 
+		std::vector<MacroNode*>& neighbours)
+{
+	// nodes in the fan are in the range [miny, maxy] 
+	int miny = (y-maxDiagSteps)<this->getVOrigin()?
+		(this->getVOrigin()):(y-maxDiagSteps); 
+	int maxy = (y+maxDiagSteps)>(this->getVOrigin()+this->getHeight()-1)?
+		(this->getVOrigin()+this->getHeight()-1):(y+maxDiagSteps);
+
+	for(int sy = miny+1; sy <= maxy-1; sy++)
+		addAbstractNode(column, sy, neighbours);
+
+	MacroNode* nb = nextNodeInColumn(column, miny, false);
+	if(nb)
+		neighbours.push_back(nb);
+	nb = nextNodeInColumn(column, maxy, true);
+	if(nb)
+		neighbours.push_back(nb);
+}
+
+void
+EmptyCluster::addOppositeInRow(int x, int row, 
+		std::vector<MacroNode*>& neighbours)
+{
+	if(map->getNodeFromMap(x, row)->getLabelL(kParent) != -1)
+	{
+		addAbstractNode(x, row, neighbours);
+		return;
+	}
+
+	MacroNode* nb = nextNodeInRow(x, row, false);
+	if(nb)
+		neighbours.push_back(nb);
+	nb = nextNodeInRow(x, row, true);
+	if(nb)
+		neighbours.push_back(nb);
+}
+
+void
+EmptyCluster::addOppositeInColumn(int y, int column, 
+		std::vector<MacroNode*>& neighbours)
+{
+	if(map->getNodeFromMap(column, y)->getLabelL(kParent) != -1)
+	{
+		addAbstractNode(column, y, neighbours);
+		return;
+	}
+
+	MacroNode* nb = nextNodeInColumn(column, y, false);
+	if(nb)
+		neighbours.push_back(nb);
+	nb = nextNodeInColumn(column, y, true);
+	if(nb)
+		neighbours.push_back(nb);
+}
+
+void
+EmptyCluster::addAbstractNode(int x, int y, 
+		std::vector<MacroNode*>& neighbours)
+{
+	int nodeId = map->getNodeFromMap(x, y)->getLabelL(kParent);
+	if(nodeId != -1)
+		neighbours.push_back(static_cast<MacroNode*>(
+					map->getAbstractGraph(1)->getNode(nodeId)));
+}
+
 edge* 
 EmptyCluster::findSecondaryEdge(unsigned int fromId, unsigned int toId)
 {
@@ -12,6 +12,8 @@
 
 #include "AbstractCluster.h"
 
+#include <vector>
+
 class EmptyClusterAbstraction;
 class MacroNode;
 class EmptyCluster : public AbstractCluster
@@ -22,16 +24,42 @@ class EmptyCluster : public AbstractCluster
 		virtual ~EmptyCluster();
 
 		virtual void buildCluster();
+		void buildCluster(int width, int height);
+		void measureRoom();
 		virtual void buildEntrances();
+
+		// ::buildEntrances in steps, for building many rooms together (see
+		// EmptyClusterAbstraction::buildEntrances). Only ::findMacroEdges 
+		// leaves the abstract graph unchanged; rooms may run it on separate
+		// threads once every room has connected its perimeter.
+		void connectPerimeter();
+		void findMacroEdges();
+		void addFoundMacroEdges();
+		virtual void repairEntrances();
 		virtual void connectParent(node*) 
 			throw(std::invalid_argument);
 
+		// support for incremental repair (see EmptyClusterAbstraction). 
+		// secondary edges must be removed before any abstract node of the
+		// cluster is deleted.
+		void removeSecondaryEdges();
+		bool frameNeedsRepair();
+
 		inline void setPerimeterReduction(bool pr) 
 		{ this->perimeterReduction = pr; }
 
 		inline void setBFReduction(bool bfr) 
 		{ this->bfReduction = bfr; }
 
+		// when set (together with bfReduction) secondary edges are not stored;
+		// ::getSecondaryNeighbours derives them from the cluster dimensions
+		inline void setImplicitSecondaryEdges(bool implicit) 
+		{ this->implicitSecondaryEdges = implicit; }
+		inline bool getImplicitSecondaryEdges() 
+		{ return this->implicitSecondaryEdges; }
+		void getSecondaryNeighbours(MacroNode* n, 
+				std::vector<MacroNode*>& neighbours);
+
 		MacroNode* nextNodeInColumn(int x, int y, bool topToBottom);
 		MacroNode* nextNodeInRow(int x, int y, bool leftToRight);
 
@@ -65,15 +93,39 @@ class EmptyCluster : public AbstractCluster
 		void addDiagonalMacroEdges();
 		void addDiagonalFanMacroEdges();
 
+		// support methods for ::getSecondaryNeighbours
+		void addRowFan(int x, int row, int maxDiagSteps, 
+				std::vector<MacroNode*>& neighbours);
+		void addColumnFan(int y, int column, int maxDiagSteps, 
+				std::vector<MacroNode*>& neighbours);
+		void addOppositeInRow(int x, int row, 
+				std::vector<MacroNode*>& neighbours);
+		void addOppositeInColumn(int y, int column, 
+				std::vector<MacroNode*>& neighbours);
+		void addAbstractNode(int x, int y, std::vector<MacroNode*>& neighbours);
+
 		// support methods for both
 		bool isIncidentWithInterEdge(node* n_);
 		void addSingleMacroEdge(node* from, node* to, double weight, 
 				graph* absg, bool secondaryEdge = false);
+		void resetMacroCount();
+
+		// a macro edge recorded by ::findMacroEdges; from == -1 marks a
+		// restart of the macro edge count
+		struct PendingEdge 
+		{
+			int from, to;
+			double weight;
+			bool secondary;
+		};
+		std::vector<PendingEdge> pendingEdges;
+		bool deferMacroEdges;
 
 		int width, height;
 		int startx, starty;
 		bool perimeterReduction;
 		bool bfReduction;
+		bool implicitSecondaryEdges;
 		std::vector<edge*> secondaryEdges; 
 		
 };
@@ -10,6 +10,11 @@
 #include "map.h"
 #include "MacroEdge.h"
 #include "MacroNode.h"
+#include "WorkerThreads.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
 
 EmptyClusterAbstraction::EmptyClusterAbstraction(Map* m, IClusterFactory* cf, 
 	INodeFactory* nf, IEdgeFactory* ef, bool allowDiagonals, bool perimeterReduction_,
@@ -25,6 +30,8 @@ EmptyClusterAbstraction::EmptyClusterAbstraction(Map* m, IClusterFactory* cf,
 				" EmptyCluster");
 				
 	sgEdge = 0;
+	implicitSecondaryEdges = false;
+	trialRoomSeeds = false;
 }
 
 EmptyClusterAbstraction::~EmptyClusterAbstraction()
@@ -51,101 +58,409 @@ void EmptyClusterAbstraction::buildClusters()
 		std::cout << "buildClusters...."<<std::endl;
 
 	Map* m = this->getMap();
-	int mapheight = m->getMapHeight();
-	int mapwidth = m->getMapWidth();
+	buildRooms(0, 0, m->getMapWidth(), m->getMapHeight(), 0);
+
+	if(this->getVerbose())
+	{
+		std::cout << "EmptyClusterAbstaction::buildClusters created"
+			<< getNumClusters() << " clusters\n";
+	}
+}
+
+// Rooms are carved from horizontal strips of this many rows, each on its
+// own thread. The strips do not depend on the number of threads, so 
+// neither do the rooms.
+static const int kRoomStripHeight = 64;
+
+// Carves the rooms of one strip (see EmptyClusterAbstraction::buildRooms)
+class RoomStripTask : public ParallelTask
+{
+	public:
+		RoomStripTask(EmptyClusterAbstraction* map_, int x0_, int y0_, 
+				int width_, int height_, 
+				std::vector<std::vector<EmptyClusterAbstraction::Room> >& strips_)
+			: map(map_), x0(x0_), y0(y0_), width(width_), height(height_), 
+			  strips(strips_) { }
+
+		virtual void run(int strip, int)
+		{
+			int sy = y0 + strip*kRoomStripHeight;
+			int sh = std::min(kRoomStripHeight, y0 + height - sy);
+			map->carveStrip(x0, sy, width, sh, strips[strip]);
+		}
+
+	private:
+		EmptyClusterAbstraction* map;
+		int x0, y0, width, height;
+		std::vector<std::vector<EmptyClusterAbstraction::Room> >& strips;
+};
+
+// Finds the macro edges of each room (see EmptyCluster::findMacroEdges)
+class MacroEdgeTask : public ParallelTask
+{
+	public:
+		MacroEdgeTask(std::vector<EmptyCluster*>& rooms_) : rooms(rooms_) { }
+
+		virtual void run(int room, int)
+		{
+			rooms[room]->findMacroEdges();
+		}
+
+	private:
+		std::vector<EmptyCluster*>& rooms;
+};
+
+// Decomposes every unassigned tile inside a rectangular area of the map into
+// empty rooms. Tiles outside the area are treated as obstacles; this is 
+// exact so long as no unassigned tile lies outside.
+//
+// The area is cut into strips (see kRoomStripHeight) which are carved in 
+// parallel, each as though the rows outside it were obstacles. A room and
+// the room below it are then joined if they meet at the edge of a strip and
+// span the same columns. Strips and joins are visited in a fixed order, so
+// the rooms and their ids do not depend on the number of threads.
+//
+// @param rooms: if not null, each new room is appended 
+void EmptyClusterAbstraction::buildRooms(int x0, int y0, int width, 
+		int height, std::vector<EmptyCluster*>* rooms)
+{
+	if(width <= 0 || height <= 0)
+		return;
+
+	int numstrips = (height + kRoomStripHeight - 1) / kRoomStripHeight;
+	std::vector<std::vector<Room> > strips(numstrips);
+	RoomStripTask task(this, x0, y0, width, height, strips);
+	WorkerThreads::run(&task, numstrips);
+
+	std::vector<Room> carved;
+	for(int i=0; i<numstrips; i++)
+		carved.insert(carved.end(), strips[i].begin(), strips[i].end());
+
+	for(int boundary = y0 + kRoomStripHeight; boundary < y0 + height; 
+			boundary += kRoomStripHeight)
+	{
+		// rooms ending at the boundary, by first column
+		std::map<int, int> above;
+		for(unsigned int i=0; i<carved.size(); i++)
+			if(carved[i].height > 0 && 
+					carved[i].y + carved[i].height == boundary)
+				above[carved[i].x] = i;
+
+		for(unsigned int i=0; i<carved.size(); i++)
+		{
+			Room& below = carved[i];
+			if(below.height == 0 || below.y != boundary)
+				continue;
+
+			std::map<int, int>::iterator it = above.find(below.x);
+			if(it == above.end() || carved[(*it).second].width != below.width)
+				continue;
+
+			carved[(*it).second].height += below.height;
+			below.height = 0;
+		}
+	}
+
+	for(unsigned int i=0; i<carved.size(); i++)
+	{
+		Room& r = carved[i];
+		if(r.height == 0)
+			continue;
+
+		EmptyCluster* cluster = dynamic_cast<EmptyCluster*>(
+				getClusterFactory()->createCluster(r.x, r.y, this)); 
+		cluster->setPerimeterReduction(perimeterReduction);
+		cluster->setBFReduction(bfReduction);
+		cluster->setImplicitSecondaryEdges(implicitSecondaryEdges);
+		cluster->buildCluster(r.width, r.height);
+		cluster->setVerbose(getVerbose());
+		addCluster(cluster);
+		if(rooms)
+			rooms->push_back(cluster);
+		if(this->getVerbose())
+		{
+			std::cout << "new cluster w/ priority "<<r.width*r.height<<":\n";
+			cluster->print(std::cout);	
+		}
+	}
+}
+
+// Greedily carves rooms from one strip of the map, largest first. Every
+// unassigned tile is a seed, with the size of the room that would grow 
+// from it (see ::computeRoomSizes) as its priority. Once rooms are carved
+// a seed's room may shrink, so the best seed is measured again before it
+// is used and put back with its new size if that is smaller.
+//
+// Runs on a worker thread. Only the nodes of the strip are touched: their
+// heap keys and kTemporaryLabel. 
+void EmptyClusterAbstraction::carveStrip(int x0, int y0, int width, 
+		int height, std::vector<Room>& rooms)
+{
+	// tiles which are traversable and in no room yet
+	std::vector<char> open(width*height, 0);
+	for(int y=0; y<height; y++)
+		for(int x=0; x<width; x++)
+		{
+			ClusterNode* n = dynamic_cast<ClusterNode*>(
+					this->getNodeFromMap(x0+x, y0+y));
+			open[y*width+x] = n && n->getParentClusterId() == -1;
+		}
 
 	// set initial priorities of all potential cluster origins
 	// based on # of interior nodes in maximal clearance square of each tile
+	std::vector<int> roomsizes;
+	if(trialRoomSeeds)
+		measureRoomSizes(open, width, height, roomsizes);
+	else
+		computeRoomSizes(open, width, height, roomsizes);
+
 	heap clusterseeds(30, false); // maxheap
-	for(int y=0; y<mapheight; y++)
-		for(int x=0; x<mapwidth; x++)
+	for(int y=0; y<height; y++)
+		for(int x=0; x<width; x++)
 		{
-			node* n = this->getNodeFromMap(x, y);
-			if(n)
-			{
-				EmptyCluster* cluster = dynamic_cast<EmptyCluster*>(
-						getClusterFactory()->createCluster(x, y, this)); 
-				cluster->setPerimeterReduction(perimeterReduction);
-				cluster->setBFReduction(bfReduction);
-				cluster->buildCluster();
-				cluster->setVerbose(getVerbose());
-
-				double priority = cluster->getNumNodes();
-//				n->Print(std::cout);
-//				std::cout << "cluster size: "<<cluster->getNumNodes() << 
-//					" priority: "<<priority;
-//				std::cout << std::endl;
-
-				n->setLabelF(kTemporaryLabel, priority);
-				n->setKeyLabel(kTemporaryLabel);
-				clusterseeds.add(n);
-				delete cluster;
-			}
+			if(!open[y*width+x])
+				continue;
+			node* n = this->getNodeFromMap(x0+x, y0+y);
+			n->setLabelF(kTemporaryLabel, roomsizes[y*width+x]);
+			n->setKeyLabel(kTemporaryLabel);
+			clusterseeds.add(n);
 		}
 
 	// start making clusters; prefer clusters with more interior nodes to others
 	// with less
 	while(!clusterseeds.empty())
 	{
-		ClusterNode* cur = dynamic_cast<ClusterNode*>(clusterseeds.peek());
-		assert(cur);
-		if(getVerbose())
+		node* cur = static_cast<node*>(clusterseeds.peek());
+		int x = cur->getLabelL(kFirstData) - x0;
+		int y = cur->getLabelL(kFirstData+1) - y0;
+		if(!open[y*width+x])
 		{
-			std::cout << "cluster seed ";
-			cur->Print(std::cout);
-			std::cout << " priority: "<<cur->getLabelF(kTemporaryLabel);
-			std::cout << std::endl;
+			clusterseeds.remove();
+			continue;
 		}
 
-		if(cur->getParentClusterId() == -1)
+		Room r;
+		measureRoom(open, width, height, x, y, r);
+		double priority = r.width*r.height;
+		if(priority >= cur->getLabelF(kTemporaryLabel))
 		{
-			EmptyCluster* cluster = dynamic_cast<EmptyCluster*>(
-					getClusterFactory()->createCluster(
-						cur->getLabelL(kFirstData), 
-						cur->getLabelL(kFirstData+1), 
-						this)); 
-			cluster->setPerimeterReduction(perimeterReduction);
-			cluster->setBFReduction(bfReduction);
-			cluster->buildCluster();
-			cluster->setVerbose(getVerbose());
-
-			double priority = cluster->getNumNodes();
-			if(priority >= cur->getLabelF(kTemporaryLabel))
-			{
-				addCluster(cluster);
-				if(this->getVerbose())
-				{
-					std::cout << "new cluster w/ priority "<<priority<<":\n";
-				    cluster->print(std::cout);	
-				}
-				clusterseeds.remove();
-				cluster = 0;
-			}
-			else
-			{
-				cur->setLabelF(kTemporaryLabel, priority); 
-				clusterseeds.decreaseKey(cur);
-				if(this->getVerbose())
-					std::cout << " updating; new priority "<<priority<<"\n";
-				delete cluster;
-			}
+			for(int ry=y; ry<y+r.height; ry++)
+				for(int rx=x; rx<x+r.width; rx++)
+					open[ry*width+rx] = 0;
+			r.x += x0;
+			r.y += y0;
+			rooms.push_back(r);
+			clusterseeds.remove();
 		}
 		else
 		{
-			if(this->getVerbose())
-				std::cout << " seed already assigned; removing\n";
-			clusterseeds.remove();
+			cur->setLabelF(kTemporaryLabel, priority); 
+			clusterseeds.decreaseKey(cur);
 		}
-		
 	}
+}
 
-	if(this->getVerbose())
+// Finds the room EmptyCluster::buildCluster would create with its origin at
+// (x, y), among the open tiles of an area. The room is first a clearance 
+// square and then extended either to the right or downwards, whichever 
+// gives the larger room.
+//
+// @param open: one entry per tile of the area, row by row; tiles outside
+// the area count as closed.
+// @param room: the origin, relative to the area, and size of the room
+void EmptyClusterAbstraction::measureRoom(const std::vector<char>& open, 
+		int width, int height, int x, int y, Room& room)
+{
+	int side = 1;
+	while(x+side < width && y+side < height)
 	{
-		std::cout << "EmptyClusterAbstaction::buildClusters created"
-			<< getNumClusters() << " clusters\n";
+		bool clear = true;
+		for(int i=0; i<=side && clear; i++)
+			clear = open[(y+i)*width + x+side] && open[(y+side)*width + x+i];
+		if(!clear)
+			break;
+		side++;
+	}
+
+	int maxwidth = side;
+	for(bool clear = true; clear && x+maxwidth < width; )
+	{
+		for(int i=0; i<side && clear; i++)
+			clear = open[(y+i)*width + x+maxwidth];
+		if(clear)
+			maxwidth++;
+	}
+
+	int maxheight = side;
+	for(bool clear = true; clear && y+maxheight < height; )
+	{
+		for(int i=0; i<side && clear; i++)
+			clear = open[(y+maxheight)*width + x+i];
+		if(clear)
+			maxheight++;
+	}
+
+	room.x = x;
+	room.y = y;
+	if(maxheight*side > side*maxwidth)
+	{
+		room.width = side;
+		room.height = maxheight;
+	}
+	else
+	{
+		room.width = maxwidth;
+		room.height = side;
 	}
 }
 
+// Room sizes found by measuring the room that grows from every tile, as 
+// the build did before ::computeRoomSizes; see ::setTrialRoomSeeds.
+void EmptyClusterAbstraction::measureRoomSizes(const std::vector<char>& open,
+		int width, int height, std::vector<int>& sizes)
+{
+	sizes.assign(width*height, 0);
+	for(int y=0; y<height; y++)
+		for(int x=0; x<width; x++)
+		{
+			if(!open[y*width+x])
+				continue;
+			Room r;
+			measureRoom(open, width, height, x, y, r);
+			sizes[y*width+x] = r.width*r.height;
+		}
+}
+
+// Computes, for every tile, the number of nodes in the room that 
+// EmptyCluster::buildCluster would create with that tile as its origin. 
+// Rather than growing a trial room at every tile, the sizes are derived from
+// three tables computed in a single pass over the area: 
+// 	- the size of the largest clearance square with its origin at each tile,
+// 	- the number of free tiles to the right of (and including) each tile, 
+// 	- the number of free tiles below (and including) each tile.
+// A room extended horizontally from the clearance square at (x, y) is then as
+// wide as the shortest run of free tiles to the right of the square's left
+// edge; vertical extensions are similar. These minima are taken over windows
+// that slide monotonically along each row and column, so the whole 
+// computation is linear in the size of the area.
+//
+// @param open: one entry per tile of the area, row by row; non-zero for
+// tiles that may join a room. Tiles outside the area are treated as 
+// obstacles.
+// @param sizes: room sizes, indexed like open. 0 for closed tiles.
+void EmptyClusterAbstraction::computeRoomSizes(const std::vector<char>& open,
+		int width, int height, std::vector<int>& sizes)
+{
+	int numtiles = height*width;
+
+	std::vector<int> square(numtiles, 0);
+	std::vector<int> right(numtiles, 0);
+	std::vector<int> down(numtiles, 0);
+	for(int y=height-1; y>=0; y--)
+		for(int x=width-1; x>=0; x--)
+		{
+			if(!open[y*width+x])
+				continue;
+
+			int i = y*width+x;
+			bool hasright = x+1 < width;
+			bool hasdown = y+1 < height;
+			right[i] = (hasright ? right[i+1] : 0) + 1;
+			down[i] = (hasdown ? down[i+width] : 0) + 1;
+			square[i] = std::min(std::min(
+						hasright ? square[i+1] : 0,
+						hasdown ? square[i+width] : 0),
+						(hasright && hasdown) ? square[i+width+1] : 0) + 1;
+		}
+
+	// widest extension of each clearance square along its rows and tallest
+	// extension along its columns
+	std::vector<int> maxwidth(numtiles, 0);
+	std::vector<int> maxheight(numtiles, 0);
+	for(int x=0; x<width; x++)
+		minOverSquares(square, right, x, width, height, maxwidth);
+	for(int y=0; y<height; y++)
+		minOverSquares(square, down, y*width, 1, width, maxheight);
+
+	sizes.assign(numtiles, 0);
+	for(int i=0; i<numtiles; i++)
+	{
+		int side = square[i];
+		sizes[i] = std::max(maxheight[i]*side, side*maxwidth[i]);
+	}
+}
+
+// Walks a line of tiles (a row or column of the map) and, for each tile, 
+// finds the minimum of 'values' over the window that starts at the tile and
+// spans the side of its clearance square. 
+//
+// Windows of adjacent tiles never move backwards: if the clearance square 
+// at one tile has side k then the square at the next tile on the line has 
+// side at least k-1. A monotone queue thus yields each minimum in amortised
+// constant time.
+//
+// @param first: index of the first tile on the line
+// @param stride: index offset between successive tiles on the line
+// @param length: number of tiles on the line
+void EmptyClusterAbstraction::minOverSquares(const std::vector<int>& square,
+		const std::vector<int>& values, int first, int stride, int length,
+		std::vector<int>& minima)
+{
+	std::deque<int> window; // positions on the line; values increasing
+	int last = -1; // last position added to the window
+	for(int pos=0; pos<length; pos++)
+	{
+		int side = square[first+pos*stride];
+		if(side == 0)
+		{
+			window.clear();
+			last = pos;
+			continue;
+		}
+
+		while(last < pos+side-1)
+		{
+			last++;
+			int v = values[first+last*stride];
+			while(!window.empty() && 
+					values[first+window.back()*stride] >= v)
+				window.pop_back();
+			window.push_back(last);
+		}
+		while(window.front() < pos)
+			window.pop_front();
+
+		minima[first+pos*stride] = values[first+window.front()*stride];
+	}
+}
+
+void EmptyClusterAbstraction::buildEntrances()
+{
+	std::vector<EmptyCluster*> rooms;
+	cluster_iterator it = getClusterIter();
+	for(EmptyCluster* room = clusterIterNext(it); room; 
+			room = clusterIterNext(it))
+		rooms.push_back(room);
+	connectRooms(rooms);
+}
+
+// Builds the abstract nodes and edges of new rooms. Perimeter nodes and 
+// inter-edges are added one room at a time, in order. Macro edges are then
+// found for every room in parallel, which only reads the abstract graph, 
+// and added in room order. The abstract graph is thus the same for any 
+// number of threads.
+void EmptyClusterAbstraction::connectRooms(std::vector<EmptyCluster*>& rooms)
+{
+	for(unsigned int i=0; i<rooms.size(); i++)
+		rooms[i]->connectPerimeter();
+
+	MacroEdgeTask task(rooms);
+	WorkerThreads::run(&task, rooms.size());
+
+	for(unsigned int i=0; i<rooms.size(); i++)
+		rooms[i]->addFoundMacroEdges();
+}
+
 EmptyCluster* EmptyClusterAbstraction::clusterIterNext(cluster_iterator& it) const
 {
        return static_cast<EmptyCluster*>(
@@ -158,6 +473,210 @@ EmptyCluster* EmptyClusterAbstraction::getCluster(int cid)
 		GenericClusterAbstraction::getCluster(cid));
 }
 
+// Rooms never contain obstacles, so a newly opened tile is not assigned to
+// any room until the abstraction is repaired.
+EmptyCluster* EmptyClusterAbstraction::findClusterContaining(int x, int y)
+{
+	ClusterNode* n = dynamic_cast<ClusterNode*>(getNodeFromMap(x, y));
+	if(n == 0)
+		return 0;
+	return getCluster(n->getParentClusterId());
+}
+
+void EmptyClusterAbstraction::addNode(node* n)
+{
+	GenericClusterAbstraction::addNode(n);
+	if(n && n->getLabelL(kAbstractionLevel) == 0)
+		openedTiles.insert(n->getLabelL(kFirstData+1)*getMap()->getMapWidth() 
+				+ n->getLabelL(kFirstData));
+}
+
+// Repairs the decomposition after tiles have been opened or closed. Only
+// rooms that contain (or are adjacent to) a changed tile are affected:
+// 	1. Each affected room is dissolved, together with its abstract nodes 
+// 	and edges. 
+// 	2. The dissolved rooms and newly opened tiles are grouped into regions
+// 	of changes which touch one another (see ::mergeRegions). Each region 
+// 	is decomposed anew, using the same method as ::buildClusters but 
+// 	restricted to its bounding box, so distant changes do not make one 
+// 	large area to decompose. Rooms next to an opened tile are thus merged 
+// 	with it where possible.
+// 	3. The new rooms build their entrances, reconnecting to the abstract 
+// 	nodes of neighbouring rooms.
+// 	4. With perimeter reduction, a neighbouring room may gain or lose a 
+// 	perimeter node; such rooms have their abstract nodes rebuilt.
+void EmptyClusterAbstraction::repairAbstraction()
+{
+	int mapwidth = getMap()->getMapWidth();
+	std::vector<Room> regions;
+	std::set<int> neighbours;
+
+	for(std::set<int>::iterator it = repairQueue.begin(); 
+			it != repairQueue.end(); it++)
+	{
+		EmptyCluster* room = getCluster(*it);
+		Room r = { room->getHOrigin(), room->getVOrigin(), room->getWidth(), 
+			room->getHeight() };
+		regions.push_back(r);
+		findAdjacentRooms(r.x, r.y, r.width, r.height, neighbours);
+
+		if(getVerbose())
+		{
+			std::cout << "repairAbstraction; dissolving ";
+			room->print(std::cout);
+			std::cout << std::endl;
+		}
+		dissolveRoom(room);
+	}
+
+	for(std::set<int>::iterator it = openedTiles.begin(); 
+			it != openedTiles.end(); it++)
+	{
+		int x = *it % mapwidth;
+		int y = *it / mapwidth;
+		ClusterNode* n = dynamic_cast<ClusterNode*>(getNodeFromMap(x, y));
+		if(n == 0 || n->getParentClusterId() != -1)
+			continue;
+
+		Room r = { x, y, 1, 1 };
+		regions.push_back(r);
+		findAdjacentRooms(x, y, 1, 1, neighbours);
+	}
+
+	mergeRegions(regions);
+	std::vector<EmptyCluster*> rooms;
+	for(unsigned int i=0; i<regions.size(); i++)
+	{
+		Room& r = regions[i];
+		if(getVerbose())
+			std::cout << "repairAbstraction; decomposing region ("<<r.x<<
+				", "<<r.y<<") "<<r.width<<"x"<<r.height<<std::endl;
+		buildRooms(r.x, r.y, r.width, r.height, &rooms);
+	}
+	connectRooms(rooms);
+
+	for(std::set<int>::iterator it = neighbours.begin(); 
+			it != neighbours.end(); it++)
+	{
+		EmptyCluster* room = getCluster(*it);
+		if(room == 0 || !room->frameNeedsRepair())
+			continue;
+
+		if(getVerbose())
+		{
+			std::cout << "repairAbstraction; reframing ";
+			room->print(std::cout);
+			std::cout << std::endl;
+		}
+		removeAbstractNodes(room);
+		room->repairEntrances();
+	}
+
+	repairNeighbours.clear();
+	repairQueue.clear();
+	openedTiles.clear();
+}
+
+// Merges rectangles which overlap or touch (also diagonally) into their 
+// bounding box, until no two rectangles touch. The first of each merged
+// pair keeps its place, so the order of the regions depends only on the 
+// order of the changes.
+void EmptyClusterAbstraction::mergeRegions(std::vector<Room>& regions)
+{
+	bool merged = true;
+	while(merged)
+	{
+		merged = false;
+		for(unsigned int i=0; i<regions.size(); i++)
+			for(unsigned int j=i+1; j<regions.size(); j++)
+			{
+				Room& a = regions[i];
+				Room& b = regions[j];
+				if(a.x > b.x+b.width || b.x > a.x+a.width || 
+						a.y > b.y+b.height || b.y > a.y+a.height)
+					continue;
+
+				int right = std::max(a.x+a.width, b.x+b.width);
+				int bottom = std::max(a.y+a.height, b.y+b.height);
+				a.x = std::min(a.x, b.x);
+				a.y = std::min(a.y, b.y);
+				a.width = right - a.x;
+				a.height = bottom - a.y;
+				regions.erase(regions.begin()+j);
+				merged = true;
+				j = i;
+			}
+	}
+}
+
+// Deletes a room along with its abstract nodes and edges. Its tiles are 
+// left unassigned.
+void EmptyClusterAbstraction::dissolveRoom(EmptyCluster* room)
+{
+	removeAbstractNodes(room);
+	removeCluster(room->getId());
+}
+
+// Deletes every abstract node of a room, and every edge incident to them.
+void EmptyClusterAbstraction::removeAbstractNodes(EmptyCluster* room)
+{
+	room->removeSecondaryEdges();
+	HPAUtil::nodeTable* parents = room->getParents();
+	while(parents->size() > 0)
+		disconnectAbstractNode((*parents->begin()).second);
+}
+
+// Collects the ids of rooms with a tile bordering (but outside) the given 
+// rectangle. Rooms queued for repair are ignored. 
+void EmptyClusterAbstraction::findAdjacentRooms(int x, int y, int width, 
+		int height, std::set<int>& rooms)
+{
+	for(int nx = x-1; nx <= x+width; nx++)
+		for(int ny = y-1; ny <= y+height; ny++)
+		{
+			if(nx >= x && nx < x+width && ny >= y && ny < y+height)
+			{
+				ny = y+height-1; // skip the interior of the column
+				continue;
+			}
+
+			ClusterNode* n = dynamic_cast<ClusterNode*>(
+					getNodeFromMap(nx, ny));
+			if(n && n->getParentClusterId() != -1 && 
+					repairQueue.find(n->getParentClusterId()) == 
+					repairQueue.end())
+				rooms.insert(n->getParentClusterId());
+		}
+}
+
+// HOG moves the last node of a graph into the slot of a deleted node. 
+// Secondary edges are not stored in the graph so their endpoints are 
+// updated here.
+void EmptyClusterAbstraction::removeAbstractNode(node* absn)
+{
+	graph* absg = getAbstractGraph(1);
+	MacroNode* last = 0;
+	if(absg->getNumNodes() > 0)
+		last = dynamic_cast<MacroNode*>(
+				absg->getNode(absg->getNumNodes()-1));
+	if(last == absn)
+		last = 0;
+	unsigned int oldID = last ? last->getNum() : 0;
+
+	GenericClusterAbstraction::removeAbstractNode(absn);
+
+	if(last == 0)
+		return;
+	for(unsigned int i=0; i<last->numSecondaryEdges(); i++)
+	{
+		edge* e = last->getSecondaryEdge(i);
+		if(e->getFrom() == oldID)
+			e->setFrom(last->getNum());
+		if(e->getTo() == oldID)
+			e->setTo(last->getNum());
+	}
+}
+
 double EmptyClusterAbstraction::getAverageClusterSize()
 {
 	double total = 0;
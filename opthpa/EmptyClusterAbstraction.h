@@ -19,6 +19,9 @@
 #include "GenericClusterAbstraction.h"
 #include "EmptyCluster.h"
 
+#include <set>
+#include <vector>
+
 class IClusterFactory;
 class INodeFactory;
 class IEdgeFactory;
@@ -41,12 +44,33 @@ class EmptyClusterAbstraction : public GenericClusterAbstraction
 		virtual ~EmptyClusterAbstraction();
 
 		virtual void buildClusters();
+		virtual void buildEntrances();
 
 		virtual	EmptyCluster* clusterIterNext(cluster_iterator&) const;
 		virtual EmptyCluster* getCluster(int cid);
+		virtual EmptyCluster* findClusterContaining(int x, int y);
+
+		// dynamic map changes. affected rooms are decomposed anew and
+		// reconnected to their neighbours; see ::repairAbstraction
+		virtual void addNode(node* n);
+		virtual void repairAbstraction();
 		
 		bool usingPerimeterRedction() { return perimeterReduction; }
 
+		// secondary edges are generated during search rather than stored 
+		// (see EmptyCluster::getSecondaryNeighbours). Only has an effect when
+		// bfReduction is set. Call before ::buildClusters. 
+		inline void setImplicitSecondaryEdges(bool implicit) 
+		{ implicitSecondaryEdges = implicit; }
+		inline bool getImplicitSecondaryEdges() 
+		{ return implicitSecondaryEdges; }
+
+		// rooms are seeded by measuring a trial room at every tile rather 
+		// than with ::computeRoomSizes. Slower but gives the same rooms; 
+		// for checking the latter. Call before ::buildClusters.
+		inline void setTrialRoomSeeds(bool trial) { trialRoomSeeds = trial; }
+		inline bool getTrialRoomSeeds() { return trialRoomSeeds; }
+
 
 		//virtual double h(node* from, node* to);
 		int getNumMacro();
@@ -54,7 +78,39 @@ class EmptyClusterAbstraction : public GenericClusterAbstraction
 		double getAverageNodesPruned();
 		int getNumAbsEdges();
 
+	protected:
+		virtual void removeAbstractNode(node* absn);
+
 	private:
+		friend class RoomStripTask;
+
+		// a rectangle of map tiles
+		struct Room
+		{
+			int x, y, width, height;
+		};
+
+		void buildRooms(int x0, int y0, int width, int height, 
+				std::vector<EmptyCluster*>* rooms);
+		void carveStrip(int x0, int y0, int width, int height, 
+				std::vector<Room>& rooms);
+		void connectRooms(std::vector<EmptyCluster*>& rooms);
+		static void mergeRegions(std::vector<Room>& regions);
+		static void measureRoom(const std::vector<char>& open, int width, 
+				int height, int x, int y, Room& room);
+		static void computeRoomSizes(const std::vector<char>& open, 
+				int width, int height, std::vector<int>& sizes);
+		static void measureRoomSizes(const std::vector<char>& open, 
+				int width, int height, std::vector<int>& sizes);
+		static void minOverSquares(const std::vector<int>& square, 
+				const std::vector<int>& values, int first, int stride, 
+				int length, std::vector<int>& minima);
+
+		void dissolveRoom(EmptyCluster* room);
+		void removeAbstractNodes(EmptyCluster* room);
+		void findAdjacentRooms(int x, int y, int width, int height, 
+				std::set<int>& rooms);
+
 		void connectSG(MacroNode* absNode);
 		void cardinalConnectSG(MacroNode* absNode);
 		void connectSGToNeighbour(MacroNode* absNode, MacroNode* absNeighbour);
@@ -63,6 +119,9 @@ class EmptyClusterAbstraction : public GenericClusterAbstraction
 
 		bool perimeterReduction;
 		bool bfReduction;
+		bool implicitSecondaryEdges;
+		bool trialRoomSeeds;
+		std::set<int> openedTiles; // y*mapwidth + x
 };
 
 #endif
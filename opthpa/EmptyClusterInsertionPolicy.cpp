@@ -2,8 +2,7 @@
 
 #include "EmptyCluster.h"
 #include "EmptyClusterAbstraction.h"
-#include "IEdgeFactory.h"
-#include "MacroEdge.h"
+#include "INodeFactory.h"
 #include "MacroNode.h"
 #include "timer.h"
 
@@ -14,6 +13,8 @@ EmptyClusterInsertionPolicy::EmptyClusterInsertionPolicy(
 
 EmptyClusterInsertionPolicy::~EmptyClusterInsertionPolicy()
 {
+	for(unsigned int i=0; i < virtualNodes.size(); i++)
+		delete virtualNodes[i];
 }
 
 
@@ -33,11 +34,7 @@ EmptyClusterInsertionPolicy::insert(node* _n)
 		EmptyCluster* nCluster = dynamic_cast<EmptyCluster*>(
 				map->getCluster(n->getParentClusterId()));
 
-		nCluster->addParent(n);
-		graph* absg = map->getAbstractGraph(1);
-		retVal = dynamic_cast<MacroNode*>(
-				absg->getNode(n->getLabelL(kParent)));
-
+		retVal = newVirtualNode(n);
 		if(map->getAllowDiagonals())
 		{
 			if(nCluster->getHeight() == 1 || nCluster->getWidth() == 1)
@@ -48,7 +45,6 @@ EmptyClusterInsertionPolicy::insert(node* _n)
 		else
 			cardinalConnect(retVal);
 
-		connectInserted(retVal);
 		addNode(retVal);
 	}
 	else
@@ -62,42 +58,112 @@ EmptyClusterInsertionPolicy::insert(node* _n)
 	return retVal;
 }
 
+// virtual nodes are returned to the pool; the abstract graph is untouched
 void 
 EmptyClusterInsertionPolicy::remove(node* _n) 
 	throw(std::runtime_error)
 {
 	if(removeNode(_n))
 	{
-		// then remove it from the abstract graph and its parent cluster
-		graph* g = map->getAbstractGraph(1);
-		MacroNode* n = dynamic_cast<MacroNode*>(g->getNode(_n->getNum()));
-
-		if(n)
-		{               
-			edge_iterator ei = n->getEdgeIter();
-			edge* e = n->edgeIterNext(ei);
-			while(e)
+		int index = findVirtualNode(_n);
+		if(index != -1)
+		{
+			inUse[index] = false;
+			perimeterNeighbours[index].clear();
+		}
+	}
+}
+
+bool
+EmptyClusterInsertionPolicy::isVirtual(node* n)
+{
+	return findVirtualNode(n) != -1;
+}
+
+// Appends to @param neighbours every node adjacent to n in the overlay.
+// For a virtual node these are its perimeter neighbours and any other 
+// virtual node from the same room. For a node in the abstract graph these
+// are the virtual nodes that list n as one of their perimeter neighbours.
+void
+EmptyClusterInsertionPolicy::getVirtualNeighbours(node* n, 
+		std::vector<node*>& neighbours)
+{
+	int index = findVirtualNode(n);
+	if(index != -1)
+	{
+		std::vector<MacroNode*>& perimeter = perimeterNeighbours[index];
+		neighbours.insert(neighbours.end(), perimeter.begin(), 
+				perimeter.end());
+
+		for(unsigned int i=0; i < virtualNodes.size(); i++)
+		{
+			if(inUse[i] && (int)i != index && 
+				virtualNodes[i]->getParentClusterId() == 
+				virtualNodes[index]->getParentClusterId())
 			{
-					g->removeEdge(e);
-					delete e;
-					ei = n->getEdgeIter();
-					e = n->edgeIterNext(ei);
+				neighbours.push_back(virtualNodes[i]);
 			}
+		}
+		return;
+	}
 
-			AbstractCluster* parentCluster = dynamic_cast<GenericClusterAbstraction*>(
-					map)->getCluster(n->getParentClusterId());
-			parentCluster->removeParent(n);
-			g->removeNode(n->getNum()); 
+	for(unsigned int i=0; i < virtualNodes.size(); i++)
+	{
+		if(!inUse[i])
+			continue;
 
-			node* originalN = map->getNodeFromMap(n->getLabelL(kFirstData), 
-							n->getLabelL(kFirstData+1));
-			originalN->setLabelL(kParent, -1);
-			delete n;
-			n = 0;
+		std::vector<MacroNode*>& perimeter = perimeterNeighbours[i];
+		for(unsigned int j=0; j < perimeter.size(); j++)
+		{
+			if(perimeter[j]->getUniqueID() == n->getUniqueID())
+			{
+				neighbours.push_back(virtualNodes[i]);
+				break;
+			}
 		}
 	}
 }
 
+// takes a virtual node from the pool (creating one only if all are in use)
+// and gives it the coordinates and parent cluster of the map node n.
+MacroNode*
+EmptyClusterInsertionPolicy::newVirtualNode(MacroNode* n)
+{
+	unsigned int index = 0;
+	while(index < virtualNodes.size() && inUse[index])
+		index++;
+
+	if(index == virtualNodes.size())
+	{
+		virtualNodes.push_back(dynamic_cast<MacroNode*>(
+				map->getNodeFactory()->newNode(n)));
+		inUse.push_back(false);
+		perimeterNeighbours.push_back(std::vector<MacroNode*>());
+	}
+
+	MacroNode* retVal = virtualNodes[index];
+	retVal->setLabelL(kFirstData, n->getLabelL(kFirstData));
+	retVal->setLabelL(kFirstData+1, n->getLabelL(kFirstData+1));
+	retVal->setLabelL(kAbstractionLevel, 1);
+	retVal->setLabelL(kParent, -1);
+	retVal->setParentClusterId(n->getParentClusterId());
+	retVal->backpointer = 0;
+	inUse[index] = true;
+	perimeterNeighbours[index].clear();
+	return retVal;
+}
+
+int
+EmptyClusterInsertionPolicy::findVirtualNode(node* n)
+{
+	for(unsigned int i=0; i < virtualNodes.size(); i++)
+	{
+		if(inUse[i] && virtualNodes[i]->getUniqueID() == n->getUniqueID())
+			return i;
+	}
+	return -1;
+}
+
 void 
 EmptyClusterInsertionPolicy::connect(MacroNode* absNode)
 {
@@ -307,7 +373,7 @@ EmptyClusterInsertionPolicy::cardinalConnect(MacroNode* absNode)
         MacroNode* absNeighbour = static_cast<MacroNode*>(
                         absg->getNode(
 						map->getNodeFromMap(nx, ny)->getLabelL(kParent)));
-        if(absNeighbour == 0 || absNeighbour->getNum() == absNode->getNum())
+        if(absNeighbour == 0 || absNeighbour->getUniqueID() == absNode->getUniqueID())
         {
 			absNeighbour = nodeCluster->nextNodeInRow(nx+1, ny, true);
 			if(absNeighbour)
@@ -326,7 +392,7 @@ EmptyClusterInsertionPolicy::cardinalConnect(MacroNode* absNode)
         absNeighbour = static_cast<MacroNode*>(
                         absg->getNode(
 						map->getNodeFromMap(nx, ny)->getLabelL(kParent)));
-        if(absNeighbour == 0 || absNeighbour->getNum() == absNode->getNum())
+        if(absNeighbour == 0 || absNeighbour->getUniqueID() == absNode->getUniqueID())
         {
                 absNeighbour = nodeCluster->nextNodeInRow(nx+1, ny, true);
                 if(absNeighbour)
@@ -346,7 +412,7 @@ EmptyClusterInsertionPolicy::cardinalConnect(MacroNode* absNode)
         absNeighbour = static_cast<MacroNode*>(
                         absg->getNode(
 						map->getNodeFromMap(nx, ny)->getLabelL(kParent)));
-        if(absNeighbour == 0 || absNeighbour->getNum() == absNode->getNum())
+        if(absNeighbour == 0 || absNeighbour->getUniqueID() == absNode->getUniqueID())
         {
                 absNeighbour = nodeCluster->nextNodeInColumn(nx, ny+1, true);
                 if(absNeighbour)
@@ -365,7 +431,7 @@ EmptyClusterInsertionPolicy::cardinalConnect(MacroNode* absNode)
         nx = nodeCluster->getHOrigin()+nodeCluster->getWidth()-1;
         absNeighbour = static_cast<MacroNode*>(
                         absg->getNode(map->getNodeFromMap(nx, ny)->getLabelL(kParent)));
-        if(absNeighbour == 0 || absNeighbour->getNum() == absNode->getNum())
+        if(absNeighbour == 0 || absNeighbour->getUniqueID() == absNode->getUniqueID())
         {
                 absNeighbour = nodeCluster->nextNodeInColumn(nx, ny+1, true);
                 if(absNeighbour)
@@ -383,48 +449,17 @@ void
 EmptyClusterInsertionPolicy::addMacroEdge(
 		MacroNode* absNode, MacroNode* absNeighbour)
 {
-//	assert(map->getNodeFromMap(absNode->getLabelL(kFirstData),
-//			absNode->getLabelL(kFirstData+1))->getLabelL(kParent) != -1);
-//	assert(map->getNodeFromMap(absNeighbour->getLabelL(kFirstData), 
-//			absNeighbour->getLabelL(kFirstData+1))->getLabelL(kParent) != -1);
-
 	if(absNode->getUniqueID() == absNeighbour->getUniqueID())
 		return;
 
-	graph* absg = map->getAbstractGraph(1);
-
-	assert((int)absNeighbour->getNum() < absg->getNumNodes());
-	assert((int)absNode->getNum() < absg->getNumNodes());
-
-	edge* e = map->getEdgeFactory()->newEdge(absNode->getNum(), absNeighbour->getNum(), 
-			map->h(absNode, absNeighbour));
-	absg->addEdge(e);
+	int index = findVirtualNode(absNode);
+	assert(index != -1);
+	perimeterNeighbours[index].push_back(absNeighbour);
 
 	if(getVerbose())
 	{
 		std::cout << "absNeighbour ("<<absNeighbour->getLabelL(kFirstData)<<", "
 			<<absNeighbour->getLabelL(kFirstData+1)<<") weight: "
-			<<e->getWeight() <<std::endl;
-	}
-}
-	
-void 
-EmptyClusterInsertionPolicy::connectInserted(MacroNode* n)
-{
-	// TODO: only add edges if node is in the interior (and not the
-	// perimeter) of the cluster. At the moment, we add edges unnecessarily
-	// when this is not the case.
-
-	if(getVerbose())
-			std::cout << "connecting to other inserted nodes from the "
-				"interior of the cluster"<<std::endl;
-
-	for(int i=0; i < getNumInserted(); i++)
-	{
-		MacroNode* neighbour = dynamic_cast<MacroNode*>(
-				getInsertedAtIndex(i));
-
-		if(n->getParentClusterId() == neighbour->getParentClusterId())
-			addMacroEdge(n, neighbour);
+			<<map->h(absNode, absNeighbour) <<std::endl;
 	}
 }
@@ -10,6 +10,12 @@
 // Two distinct insertion cases are implemented. Which is used depends on
 // whether or not the map allows diagonal movement.
 //
+// Inserted nodes are virtual: they are never added to the abstract graph
+// and no edges are created. Instead, each query keeps an overlay which 
+// records the perimeter neighbours of every inserted node. The overlay is
+// read during search by a VirtualOverlayExpansionPolicy. Virtual nodes are
+// pooled and reused from one query to the next.
+//
 // For more information, see the following papers:
 //		[Harabor and Botea, Breaking Symmetries in 4-connected Grid Maps
 // 		AIIDE, 2010]
@@ -23,6 +29,8 @@
 
 #include "InsertionPolicy.h"
 
+#include <vector>
+
 class EmptyClusterAbstraction;
 class node;
 class MacroNode;
@@ -34,14 +42,24 @@ class EmptyClusterInsertionPolicy : public InsertionPolicy
 
 		virtual node* insert(node* _n) throw(std::invalid_argument);
 		virtual void remove(node* _n) throw(std::runtime_error);
+
+		// overlay queries
+		bool isVirtual(node* n);
+		void getVirtualNeighbours(node* n, std::vector<node*>& neighbours);
 	
 	private:
 		void connect(MacroNode* absNode);
 		void cardinalConnect(MacroNode* absNode);
 		void addMacroEdge(MacroNode* absNode, MacroNode* absNeighbour);
-		void connectInserted(MacroNode* n);
+		MacroNode* newVirtualNode(MacroNode* n);
+		int findVirtualNode(node* n);
 
 		EmptyClusterAbstraction* map;
+
+		// pool of virtual nodes and the perimeter neighbours of each
+		std::vector<MacroNode*> virtualNodes;
+		std::vector<bool> inUse;
+		std::vector<std::vector<MacroNode*> > perimeterNeighbours;
 };
 
 #endif
@@ -38,7 +38,7 @@ class ExpansionPolicy
 		virtual bool hasNext() = 0;
 
 		node* getTarget() const { return target;}
-		void setProblemInstance(ProblemInstance* p);
+		virtual void setProblemInstance(ProblemInstance* p);
 		ProblemInstance* getProblemInstance(); 
 
 	protected:
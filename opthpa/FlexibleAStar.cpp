@@ -1,6 +1,7 @@
 #include "FlexibleAStar.h"
 
 #include "altheap.h"
+#include "CachedHeuristic.h"
 #include "DebugUtility.h"
 #include "ExpansionPolicy.h"
 #include "fpUtil.h"
@@ -10,6 +11,7 @@
 #include "path.h"
 #include "ProblemInstance.h"
 #include "reservationProvider.h"
+#include "statCollection.h"
 #include "timer.h"
 #include "unitSimulation.h"
 
@@ -18,6 +20,7 @@ FlexibleAStar::FlexibleAStar(ExpansionPolicy* policy, Heuristic* heuristic)
 {
 	this->policy = policy;
 	this->heuristic = heuristic;
+	this->cache = dynamic_cast<CachedHeuristic*>(heuristic);
 	this->markForVis = true;
 }
 
@@ -33,10 +36,28 @@ FlexibleAStar::getName()
 	return "FlexibleAStar";
 }
 
+void
+FlexibleAStar::logFinalStats(statCollection* stats)
+{
+	searchAlgorithm::logFinalStats(stats);
+	if(cache)
+		cache->logFinalStats(stats, getName());
+}
+
 path* 
 FlexibleAStar::getPath(graphAbstraction *aMap, node *start, node *goal,
 		reservationProvider *rp)
 {
+	// no need to search if the goal is in another connected component
+	if(aMap && start && goal && !aMap->pathable(start, goal))
+	{
+		nodesExpanded = nodesTouched = nodesGenerated = 0;
+		searchTime = 0;
+		if(cache)
+			cache->resetMetrics();
+		return 0;
+	}
+
 	debug = new DebugUtility(aMap, heuristic);
 	policy->setProblemInstance(new ProblemInstance(start, goal, 
 				dynamic_cast<mapAbstraction*>(aMap), heuristic));
@@ -53,6 +74,8 @@ FlexibleAStar::search(node* start, node* goal)
 	nodesTouched=0;
 	searchTime =0;
 	nodesGenerated = 0;
+	if(cache)
+		cache->resetMetrics();
 
 	if(verbose) 
 	{
@@ -146,17 +169,36 @@ FlexibleAStar::expand(node* current, node* goal, altheap* openList,
 	nodesExpanded++;
 	nodesTouched++;
 
+	// collect the neighbours first so the heuristic can be evaluated
+	// for all of them in a single call
 	policy->expand(current);
+	neighbours.clear();
+	costs.clear();
 	for(node* neighbour = policy->first(); neighbour != 0; 
 			neighbour = policy->next())
 	{
+		neighbours.push_back(neighbour);
+		costs.push_back(policy->cost_to_n());
+	}
+	if(neighbours.empty())
+		return;
+
+	hvals.resize(neighbours.size());
+	heuristic->h_batch(&neighbours[0], neighbours.size(), goal, &hvals[0]);
+	double gCurrent = current->getLabelF(kTemporaryLabel) - 
+		heuristic->h(current, goal);
+
+	for(unsigned int i = 0; i < neighbours.size(); i++)
+	{
+		node* neighbour = neighbours[i];
 		nodesTouched++;			
 		if(closedList->find(neighbour->getUniqueID()) == closedList->end()) 
 		{
 			if(openList->isIn(neighbour)) 
 			{	
 				double fVal = neighbour->getLabelF(kTemporaryLabel);
-				relaxNode(current, neighbour, goal, policy->cost_to_n(), openList); 
+				relaxNode(current, neighbour, gCurrent, costs[i], hvals[i], 
+						openList); 
 
 				if(verbose) 
 				{
@@ -186,7 +228,8 @@ FlexibleAStar::expand(node* current, node* goal, altheap* openList,
 				neighbour->setKeyLabel(kTemporaryLabel); // store priority here 
 				neighbour->backpointer = 0;  // reset any marked edges 
 				openList->add(neighbour);
-				relaxNode(current, neighbour, goal, policy->cost_to_n(), openList); 
+				relaxNode(current, neighbour, gCurrent, costs[i], hvals[i], 
+						openList); 
 				nodesGenerated++;
 
 				if(verbose)
@@ -206,12 +249,12 @@ FlexibleAStar::expand(node* current, node* goal, altheap* openList,
 				debug->printNode("\tclosed...", neighbour);
 				double fCur = current->getLabelF(kTemporaryLabel);
 				double gCur =  fCur - heuristic->h(current, goal);
-				double gAlt = gCur + policy->cost_to_n();
+				double gAlt = gCur + costs[i];
 				double fAlt = gAlt + heuristic->h(neighbour, goal);
 				double fClosed = neighbour->getLabelF(kTemporaryLabel);
 				std::cout << " (fClosed: "<<fClosed<<"; fAlt: "<<fAlt<<")";
 			}
-			debug->debugClosedNode(current, neighbour, policy->cost_to_n(), goal);
+			debug->debugClosedNode(current, neighbour, costs[i], goal);
 		}
 
 		if(verbose)
@@ -240,11 +283,10 @@ FlexibleAStar::checkParameters(node* from, node* to)
 }
 
 void 
-FlexibleAStar::relaxNode(node* from, node* to, node* goal, double cost, 
-		altheap* openList)
+FlexibleAStar::relaxNode(node* from, node* to, double g_from, double cost, 
+		double h_to, altheap* openList)
 {
-	double g_from = from->getLabelF(kTemporaryLabel) - heuristic->h(from, goal);
-	double f_to = g_from + cost + heuristic->h(to, goal);
+	double f_to = g_from + cost + h_to;
 	
 	if(fless(f_to, to->getLabelF(kTemporaryLabel)))
 	{
@@ -14,7 +14,9 @@
 #include "searchAlgorithm.h"
 #include <map>
 #include <string>
+#include <vector>
 
+class CachedHeuristic;
 class DebugUtility;
 class ExpansionPolicy;
 class altheap;
@@ -30,6 +32,10 @@ class FlexibleAStar : public searchAlgorithm
 				reservationProvider *rp = 0);
 
 		Heuristic* getHeuristic() { return heuristic; }
+
+		// @return: the heuristic if it memoises its values, 0 otherwise
+		CachedHeuristic* getHeuristicCache() { return cache; }
+		virtual void logFinalStats(statCollection* stats);
 		bool markForVis;	
 
 	protected:
@@ -37,8 +43,8 @@ class FlexibleAStar : public searchAlgorithm
 		Heuristic* heuristic;
 
 		path* search(node* from, node* goal);
-		void relaxNode(node* from, node* to, node* goal, double cost, 
-			altheap* openList);
+		void relaxNode(node* from, node* to, double g_from, double cost, 
+			double h_to, altheap* openList);
 		void expand(node* current, node* goal, altheap* openList,
 				std::map<int, node*>* closedList);
 		path* extractBestPath(node* goal);
@@ -47,6 +53,13 @@ class FlexibleAStar : public searchAlgorithm
 		void closeNode(node* current, std::map<int, node*>* closedList);
 		bool checkParameters(node* from, node* to);
 		DebugUtility* debug;
+		CachedHeuristic* cache;
+
+		// the neighbours of the node being expanded, the cost of reaching
+		// each one and its heuristic value
+		std::vector<node*> neighbours;
+		std::vector<double> costs;
+		std::vector<double> hvals;
 };
 
 #endif
@@ -9,6 +9,16 @@ class Heuristic
 		virtual ~Heuristic() { }
 
 		virtual double h(node* first, node* second) const = 0;
+
+		// computes h(first[i], second) for each of the count nodes in first.
+		// Heuristics which can do better than one call to ::h per node
+		// (e.g. by working on several nodes at once) override this.
+		virtual void h_batch(node** first, unsigned int count, node* second,
+				double* out) const
+		{
+			for(unsigned int i=0; i<count; i++)
+				out[i] = h(first[i], second);
+		}
 };
 
 #endif
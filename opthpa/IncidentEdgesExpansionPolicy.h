@@ -33,8 +33,9 @@ class IncidentEdgesExpansionPolicy : public SelectiveExpansionPolicy
 		virtual node* first_impl();
 		virtual node* n_impl();
 
-	private:
 		int which;
+
+	private:
 		graph* g;
 		graphAbstraction* map;
 };
@@ -0,0 +1,399 @@
+#include "LandmarkHeuristic.h"
+
+#include "CanonicalDijkstra.h"
+#include "MapChecksum.h"
+#include "graph.h"
+#include "map.h"
+#include "mapAbstraction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+// identifies the file format written by ::save
+static const int kLandmarkFileVersion = 2;
+
+const unsigned short LandmarkHeuristic::kUnreachable;
+
+LandmarkHeuristic::LandmarkHeuristic(mapAbstraction* map_)
+	throw(std::invalid_argument)
+{
+	if(map_ == 0)
+		throw std::invalid_argument("LandmarkHeuristic: null map abstraction");
+
+	this->map = map_;
+	width = map->getMap()->getMapWidth();
+	height = map->getMap()->getMapHeight();
+	checksum = MapChecksum::compute(map->getMap());
+	canonical = 0;
+}
+
+LandmarkHeuristic::~LandmarkHeuristic()
+{
+	delete canonical;
+}
+
+double
+LandmarkHeuristic::h(node* first, node* second) const
+{
+	double best = octile.h(first, second);
+
+	int x1 = first->getLabelL(kFirstData);
+	int y1 = first->getLabelL(kFirstData+1);
+	int x2 = second->getLabelL(kFirstData);
+	int y2 = second->getLabelL(kFirstData+1);
+	if(x1 < 0 || x1 >= width || y1 < 0 || y1 >= height ||
+	   x2 < 0 || x2 >= width || y2 < 0 || y2 >= height)
+		return best;
+
+	unsigned int size = width*height;
+	unsigned int i1 = x1 + y1*width;
+	unsigned int i2 = x2 + y2*width;
+	for(unsigned int l=0; l<landmarks.size(); l++)
+	{
+		int d1 = distances[l*size + i1];
+		int d2 = distances[l*size + i2];
+		if(d1 == kUnreachable || d2 == kUnreachable)
+			continue;
+
+		double bound = (d1 > d2 ? d1 - d2 : d2 - d1) / scale[l];
+		if(bound > best)
+			best = bound;
+	}
+	return best;
+}
+
+void
+LandmarkHeuristic::computeLandmarks(unsigned int numLandmarks,
+		LandmarkUtil::LandmarkSelection selection)
+{
+	landmarks.clear();
+	scale.clear();
+	distances.clear();
+
+	std::vector<double> dist;
+	for(unsigned int i=0; i<numLandmarks; i++)
+	{
+		node* landmark = 0;
+		switch(selection)
+		{
+			case LandmarkUtil::kFarthest:
+				landmark = selectFarthest();
+				break;
+			case LandmarkUtil::kAvoid:
+				landmark = selectAvoid();
+				break;
+			default:
+				landmark = selectRandom();
+				break;
+		}
+		if(landmark == 0)
+			break;
+
+		addLandmark(landmark);
+	}
+}
+
+// Computes the distance from source to every node in the grid graph.
+// Nodes which cannot be reached from source are assigned a distance of -1.
+// If parent is given, it records the shortest path tree: the number of the
+// node preceding each node on its path from source (or -1).
+// If weightscale is given, each edge weight is multiplied by weightscale 
+// and rounded down before it is used.
+void
+LandmarkHeuristic::dijkstra(node* source, std::vector<double>& dist,
+		std::vector<int>* parent, double weightscale)
+{
+	if(canonical == 0)
+		canonical = new CanonicalDijkstra(map);
+	canonical->search(source, weightscale);
+
+	graph* g = map->getAbstractGraph(0);
+	dist.assign(g->getNumNodes(), -1);
+	if(parent)
+		parent->assign(g->getNumNodes(), -1);
+
+	for(int i=0; i<g->getNumNodes(); i++)
+	{
+		node* n = g->getNode(i);
+		int index = n->getLabelL(kFirstData) + n->getLabelL(kFirstData+1)*width;
+		dist[i] = canonical->getDistances()[index];
+
+		int p = canonical->getParent(index);
+		if(parent && p != -1)
+			(*parent)[i] = map->getNodeFromMap(p % width, p / width)->getNum();
+	}
+}
+
+// Computes the distances from a new landmark and appends them to the
+// distance table. 
+// Rounding each distance to 16 bits could make the heuristic inconsistent.
+// Instead, each edge weight is scaled and rounded down before searching
+// from the landmark, so stored values are exact distances in a metric that
+// never exceeds the real one.
+// The scale is never less than 1; a smaller one would round every edge
+// weight down to 0. On maps too large for 16 bits, distances saturate at
+// kUnreachable-1 instead. min(d, c) changes by no more than d does, so
+// the differences remain admissible and consistent bounds.
+void
+LandmarkHeuristic::addLandmark(node* landmark)
+{
+	graph* g = map->getAbstractGraph(0);
+
+	std::vector<double> dist;
+	dijkstra(landmark, dist);
+	double maxdist = 0;
+	for(unsigned int i=0; i<dist.size(); i++)
+		maxdist = dist[i] > maxdist ? dist[i] : maxdist;
+	// powers of two keep stored values exact when scaled back
+	double s = 1;
+	if(maxdist > 0)
+		s = pow(2.0, floor(log((kUnreachable - 1) / maxdist) / log(2.0)));
+	if(s < 1)
+		s = 1;
+	dijkstra(landmark, dist, 0, s);
+
+	unsigned int size = width*height;
+	unsigned int offset = distances.size();
+	distances.resize(offset + size, kUnreachable);
+	for(unsigned int i=0; i<dist.size(); i++)
+	{
+		if(dist[i] < 0)
+			continue;
+
+		node* n = g->getNode(i);
+		int x = n->getLabelL(kFirstData);
+		int y = n->getLabelL(kFirstData+1);
+		distances[offset + x + y*width] = dist[i] < kUnreachable - 1 ? 
+			(unsigned short)dist[i] : kUnreachable - 1;
+	}
+
+	landmarks.push_back(landmark->getLabelL(kFirstData) +
+			landmark->getLabelL(kFirstData+1)*width);
+	scale.push_back(s);
+}
+
+// The first landmark is the node farthest from a random start location.
+// After that, each landmark is the node whose distance to the nearest
+// existing landmark is largest. Nodes not reachable from any landmark are
+// preferred; that way every connected area gets a landmark.
+node*
+LandmarkHeuristic::selectFarthest()
+{
+	graph* g = map->getAbstractGraph(0);
+	if(g->getNumNodes() == 0)
+		return 0;
+
+	if(landmarks.size() == 0)
+	{
+		std::vector<double> dist;
+		dijkstra(selectRandom(), dist);
+
+		int farthest = 0;
+		for(unsigned int i=0; i<dist.size(); i++)
+			if(dist[i] > dist[farthest])
+				farthest = i;
+		return g->getNode(farthest);
+	}
+
+	node* farthest = 0;
+	double farthestdist = -1;
+	for(int i=0; i<g->getNumNodes(); i++)
+	{
+		node* n = g->getNode(i);
+		int x = n->getLabelL(kFirstData);
+		int y = n->getLabelL(kFirstData+1);
+
+		double mindist = -1;
+		for(unsigned int l=0; l<landmarks.size(); l++)
+		{
+			double d = getDistance(l, x, y);
+			if(d >= 0 && (mindist < 0 || d < mindist))
+				mindist = d;
+		}
+		if(mindist < 0)
+			return n;
+
+		if(mindist > farthestdist)
+		{
+			farthest = n;
+			farthestdist = mindist;
+		}
+	}
+	return farthestdist > 0 ? farthest : 0;
+}
+
+// Goldberg and Harrelson's avoid method. A shortest path tree is grown
+// from a random root and each node is weighted by how much the current
+// heuristic underestimates its distance from the root. Subtrees which
+// already contain a landmark are ignored. Starting from the root we move to
+// the child with the heaviest subtree until we reach a leaf; that leaf is
+// the new landmark.
+node*
+LandmarkHeuristic::selectAvoid()
+{
+	graph* g = map->getAbstractGraph(0);
+	node* root = selectRandom();
+	if(root == 0)
+		return 0;
+
+	std::vector<double> dist;
+	std::vector<int> parent;
+	dijkstra(root, dist, &parent);
+
+	// visit children before their parents
+	std::vector<std::pair<double, int> > order;
+	for(unsigned int i=0; i<dist.size(); i++)
+		if(dist[i] >= 0)
+			order.push_back(std::pair<double, int>(dist[i], i));
+	std::sort(order.begin(), order.end());
+
+	std::vector<bool> islandmark(dist.size(), false);
+	for(unsigned int l=0; l<landmarks.size(); l++)
+	{
+		node* n = map->getNodeFromMap(landmarks[l] % width, landmarks[l] / width);
+		if(n)
+			islandmark[n->getNum()] = true;
+	}
+
+	std::vector<double> weight(dist.size(), 0);
+	std::vector<bool> covered(dist.size(), false);
+	for(int i=order.size()-1; i>=0; i--)
+	{
+		int n = order[i].second;
+		if(islandmark[n])
+			covered[n] = true;
+		if(covered[n])
+			weight[n] = 0;
+		else
+			weight[n] += dist[n] - h(root, g->getNode(n));
+
+		int p = parent[n];
+		if(p != -1)
+		{
+			if(covered[n])
+				covered[p] = true;
+			weight[p] += weight[n];
+		}
+	}
+	if(covered[root->getNum()] || weight[root->getNum()] <= 0)
+		return selectRandom();
+
+	// descend towards the heaviest leaf
+	std::vector<std::vector<int> > children(dist.size());
+	for(unsigned int i=0; i<parent.size(); i++)
+		if(parent[i] != -1)
+			children[parent[i]].push_back(i);
+
+	int current = root->getNum();
+	while(children[current].size() > 0)
+	{
+		int heaviest = -1;
+		for(unsigned int i=0; i<children[current].size(); i++)
+		{
+			int child = children[current][i];
+			if(!covered[child] && (heaviest == -1 || weight[child] > weight[heaviest]))
+				heaviest = child;
+		}
+		if(heaviest == -1)
+			break;
+		current = heaviest;
+	}
+	return g->getNode(current);
+}
+
+node*
+LandmarkHeuristic::selectRandom()
+{
+	graph* g = map->getAbstractGraph(0);
+	if(g->getNumNodes() == 0)
+		return 0;
+	return g->getNode(rand() % g->getNumNodes());
+}
+
+double
+LandmarkHeuristic::getDistance(unsigned int landmark, int x, int y) const
+{
+	if(x < 0 || x >= width || y < 0 || y >= height)
+		return -1;
+
+	unsigned short d = distances.at(landmark*width*height + x + y*width);
+	if(d == kUnreachable)
+		return -1;
+	return d / scale.at(landmark);
+}
+
+std::string
+LandmarkHeuristic::getDefaultFileName()
+{
+	std::string filename(map->getMap()->getMapName());
+	return filename + ".landmarks";
+}
+
+void
+LandmarkHeuristic::save(const char* filename) throw(std::invalid_argument)
+{
+	std::ofstream out(filename, std::ios::out | std::ios::binary);
+	if(!out.good())
+	{
+		std::stringstream ss;
+		ss << "LandmarkHeuristic: cannot write landmark file: "<<filename;
+		throw std::invalid_argument(ss.str());
+	}
+
+	int numlandmarks = landmarks.size();
+	out.write((const char*)&kLandmarkFileVersion, sizeof(int));
+	out.write((const char*)&width, sizeof(int));
+	out.write((const char*)&height, sizeof(int));
+	out.write((const char*)&checksum, sizeof(unsigned int));
+	out.write((const char*)&numlandmarks, sizeof(int));
+	for(int l=0; l<numlandmarks; l++)
+	{
+		out.write((const char*)&landmarks[l], sizeof(int));
+		out.write((const char*)&scale[l], sizeof(double));
+	}
+	if(distances.size() > 0)
+		out.write((const char*)&distances[0],
+				distances.size()*sizeof(unsigned short));
+	out.close();
+}
+
+bool
+LandmarkHeuristic::load(const char* filename)
+{
+	std::ifstream in(filename, std::ios::in | std::ios::binary);
+	if(!in.good())
+		return false;
+
+	int version, w, h, numlandmarks;
+	unsigned int filechecksum;
+	in.read((char*)&version, sizeof(int));
+	in.read((char*)&w, sizeof(int));
+	in.read((char*)&h, sizeof(int));
+	in.read((char*)&filechecksum, sizeof(unsigned int));
+	in.read((char*)&numlandmarks, sizeof(int));
+	if(!in.good() || version != kLandmarkFileVersion || w != width ||
+			h != height || filechecksum != checksum || numlandmarks < 0)
+		return false;
+
+	std::vector<int> l(numlandmarks);
+	std::vector<double> s(numlandmarks);
+	for(int i=0; i<numlandmarks; i++)
+	{
+		in.read((char*)&l[i], sizeof(int));
+		in.read((char*)&s[i], sizeof(double));
+	}
+
+	std::vector<unsigned short> d(numlandmarks*width*height);
+	if(d.size() > 0)
+		in.read((char*)&d[0], d.size()*sizeof(unsigned short));
+	if(!in.good())
+		return false;
+
+	landmarks.swap(l);
+	scale.swap(s);
+	distances.swap(d);
+	return true;
+}
@@ -0,0 +1,104 @@
+#ifndef LANDMARKHEURISTIC_H
+#define LANDMARKHEURISTIC_H
+
+// LandmarkHeuristic.h
+//
+// A differential (ALT) heuristic. Distances from a small number of
+// landmark locations to every other location are computed ahead of time,
+// by a Dijkstra search over the grid graph from each landmark (see
+// CanonicalDijkstra).
+// By the triangle inequality |d(L, a) - d(L, b)| never overestimates
+// d(a, b) so the heuristic returns the largest such bound over all
+// landmarks, or the octile distance between a and b if that is larger.
+//
+// Distances are indexed by map coordinates. The heuristic can be used
+// with the grid graph itself or with any abstract graph built on top of it
+// (HPA*, RSR etc.), so long as no abstract edge is shorter than the grid
+// path it represents.
+//
+// Distances are stored in 16 bits, with a scale factor for each landmark.
+// Edge weights are rounded down to that scale before searching from the
+// landmark, so the heuristic remains admissible and consistent. Distances
+// too long for 16 bits saturate, which weakens but does not break the
+// bounds.
+//
+// Saved tables record a checksum of the map (see MapChecksum) and are not
+// loaded for a map with different terrain.
+//
+// @created: 17/10/2026
+
+#include "Heuristic.h"
+#include "OctileHeuristic.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace LandmarkUtil
+{
+	enum LandmarkSelection
+	{
+		kFarthest, // each landmark is the location farthest from those chosen so far
+		kAvoid, // Goldberg and Harrelson's "avoid": favours regions the heuristic covers poorly
+		kRandom // landmarks are traversable locations chosen at random
+	};
+}
+
+class CanonicalDijkstra;
+class mapAbstraction;
+class node;
+class LandmarkHeuristic : public Heuristic
+{
+	public:
+		static const unsigned short kUnreachable = 0xFFFF;
+
+		LandmarkHeuristic(mapAbstraction* map) throw(std::invalid_argument);
+		virtual ~LandmarkHeuristic();
+
+		virtual double h(node* first, node* second) const;
+
+		// Chooses numLandmarks landmarks and computes the distance from each
+		// one to every location on the map. Any existing landmarks are
+		// discarded.
+		void computeLandmarks(unsigned int numLandmarks,
+				LandmarkUtil::LandmarkSelection selection);
+
+		// Writes the distance tables to a file.
+		void save(const char* filename) throw(std::invalid_argument);
+
+		// Reads the distance tables from a file written by ::save.
+		// @return: false if the file does not exist or was written for a map
+		// with different dimensions or terrain.
+		bool load(const char* filename);
+
+		// @return: the default location of the distance tables for the map;
+		// next to the map file itself.
+		std::string getDefaultFileName();
+
+		unsigned int getNumLandmarks() const { return landmarks.size(); }
+		int getLandmark(unsigned int index) const { return landmarks.at(index); }
+
+		// @return: the distance from a landmark to the location with the
+		// given map coordinates or -1 if the location cannot be reached.
+		double getDistance(unsigned int landmark, int x, int y) const;
+
+	private:
+		void dijkstra(node* source, std::vector<double>& dist,
+				std::vector<int>* parent = 0, double weightscale = 0);
+		void addLandmark(node* landmark);
+		node* selectFarthest();
+		node* selectAvoid();
+		node* selectRandom();
+
+		mapAbstraction* map;
+		CanonicalDijkstra* canonical; // created by the first search
+		OctileHeuristic octile;
+		int width, height;
+		unsigned int checksum; // of the map's terrain; see MapChecksum
+
+		std::vector<int> landmarks; // as map indexes; x + y*width
+		std::vector<double> scale; // stored values are distances * scale
+		std::vector<unsigned short> distances; // one row of width*height per landmark
+};
+
+#endif
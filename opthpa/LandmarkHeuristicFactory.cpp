@@ -0,0 +1,56 @@
+#include "LandmarkHeuristicFactory.h"
+
+// Passes every call to a LandmarkHeuristic owned by the factory.
+class SharedLandmarkHeuristic : public Heuristic
+{
+	public:
+		SharedLandmarkHeuristic(LandmarkHeuristic* landmarks_)
+			: landmarks(landmarks_) { }
+
+		virtual double h(node* first, node* second) const
+		{ return landmarks->h(first, second); }
+
+		virtual void h_batch(node** first, unsigned int count, node* second,
+				double* out) const
+		{ landmarks->h_batch(first, count, second, out); }
+
+	private:
+		LandmarkHeuristic* landmarks;
+};
+
+LandmarkHeuristicFactory::LandmarkHeuristicFactory(mapAbstraction* map_, 
+		unsigned int numLandmarks_, LandmarkUtil::LandmarkSelection selection_)
+{
+	this->map = map_;
+	this->numLandmarks = numLandmarks_;
+	this->selection = selection_;
+	this->landmarks = 0;
+}
+
+LandmarkHeuristicFactory::~LandmarkHeuristicFactory()
+{
+	delete landmarks;
+}
+
+Heuristic* LandmarkHeuristicFactory::newHeuristic()
+{
+	if(landmarks == 0)
+	{
+		landmarks = new LandmarkHeuristic(map);
+		std::string filename = landmarks->getDefaultFileName();
+		if(!landmarks->load(filename.c_str()) || 
+				landmarks->getNumLandmarks() != numLandmarks)
+		{
+			landmarks->computeLandmarks(numLandmarks, selection);
+			try
+			{
+				landmarks->save(filename.c_str());
+			}
+			catch(std::invalid_argument&)
+			{
+				// not fatal; the tables are computed again next time
+			}
+		}
+	}
+	return new SharedLandmarkHeuristic(landmarks);
+}
@@ -0,0 +1,35 @@
+#ifndef LANDMARKHEURISTICFACTORY_H
+#define LANDMARKHEURISTICFACTORY_H
+
+// LandmarkHeuristicFactory.h
+//
+// A factory class for creating landmark heuristics.
+// Distance tables are read from the default landmark file of the map if 
+// one exists. Otherwise they are computed and written to that file for 
+// next time. Either happens once, on the first call to ::newHeuristic;
+// every heuristic the factory creates shares those tables, so the factory
+// must outlive them.
+//
+// @created: 17/10/2026
+
+#include "IHeuristicFactory.h"
+#include "LandmarkHeuristic.h"
+
+class mapAbstraction;
+class LandmarkHeuristicFactory : public IHeuristicFactory
+{
+	public:
+		LandmarkHeuristicFactory(mapAbstraction* map, unsigned int numLandmarks,
+				LandmarkUtil::LandmarkSelection selection = LandmarkUtil::kAvoid);
+		virtual ~LandmarkHeuristicFactory();
+		virtual Heuristic* newHeuristic();
+
+	private:
+		mapAbstraction* map;
+		unsigned int numLandmarks;
+		LandmarkUtil::LandmarkSelection selection;
+		LandmarkHeuristic* landmarks; // created by the first ::newHeuristic
+};
+
+#endif
+
@@ -0,0 +1,23 @@
+#include "LazyEdgesExpansionPolicy.h"
+
+#include "GenericClusterAbstraction.h"
+#include "graph.h"
+
+LazyEdgesExpansionPolicy::LazyEdgesExpansionPolicy(
+		GenericClusterAbstraction* map) : IncidentEdgesExpansionPolicy(map)
+{
+	this->map = map;
+}
+
+LazyEdgesExpansionPolicy::~LazyEdgesExpansionPolicy()
+{
+}
+
+double 
+LazyEdgesExpansionPolicy::cost_to_n()
+{
+	edge* e = target->getEdge(which);
+	if(!map->isResolved(e))
+		map->resolveEdge(e);
+	return e->getWeight();
+}
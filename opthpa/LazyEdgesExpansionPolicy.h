@@ -0,0 +1,32 @@
+#ifndef LAZYEDGESEXPANSIONPOLICY_H
+#define LAZYEDGESEXPANSIONPOLICY_H
+
+// LazyEdgesExpansionPolicy.h
+//
+// An IncidentEdgesExpansionPolicy for cluster abstractions built with lazy
+// intra-edges. The weight of an unresolved edge is only a lower bound; 
+// the first time the search asks for the cost of such an edge the
+// abstraction computes (and remembers) its real cost.
+//
+// NB: edges are resolved when a neighbour is relaxed rather than when it is
+// expanded. Edges incident to nodes which are never expanded are never 
+// resolved and abstract search remains optimal.
+//
+// @created: 16/10/2026
+
+#include "IncidentEdgesExpansionPolicy.h"
+
+class GenericClusterAbstraction;
+class LazyEdgesExpansionPolicy : public IncidentEdgesExpansionPolicy
+{
+	public:
+		LazyEdgesExpansionPolicy(GenericClusterAbstraction* map);
+		virtual ~LazyEdgesExpansionPolicy();
+
+		virtual double cost_to_n();
+
+	private:
+		GenericClusterAbstraction* map;
+};
+
+#endif
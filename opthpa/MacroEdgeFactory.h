@@ -12,6 +12,7 @@ class MacroEdgeFactory : public IEdgeFactory
 
 		virtual MacroEdge* newEdge(unsigned int fromId, unsigned int toId, 
 				double weight);
+		virtual MacroEdgeFactory* clone() { return new MacroEdgeFactory(); }
 };
 
 #endif
@@ -3,6 +3,10 @@
 #include "constants.h"
 #include <stdexcept>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 ManhattanHeuristic::ManhattanHeuristic()
 {
 }
@@ -34,3 +38,36 @@ double ManhattanHeuristic::h(node* a, node* b) const
 	answer = deltax + deltay;
 	return answer;
 }
+
+void ManhattanHeuristic::h_batch(node** first, unsigned int count, node* b, 
+		double* out) const
+{
+	if(b == NULL) 
+		throw std::invalid_argument("null node");
+
+	unsigned int i = 0;
+
+#ifdef __SSE2__
+	const __m128d sign = _mm_set1_pd(-0.0);
+	const __m128d bx = _mm_set1_pd(b->getLabelL(kFirstData));
+	const __m128d by = _mm_set1_pd(b->getLabelL(kFirstData+1));
+	for( ; i+2 <= count; i+=2)
+	{
+		node* a0 = first[i];
+		node* a1 = first[i+1];
+		if(a0 == NULL || a1 == NULL) 
+			throw std::invalid_argument("null node");
+
+		__m128d ax = _mm_set_pd(a1->getLabelL(kFirstData), 
+				a0->getLabelL(kFirstData));
+		__m128d ay = _mm_set_pd(a1->getLabelL(kFirstData+1), 
+				a0->getLabelL(kFirstData+1));
+		__m128d deltax = _mm_andnot_pd(sign, _mm_sub_pd(ax, bx));
+		__m128d deltay = _mm_andnot_pd(sign, _mm_sub_pd(ay, by));
+		_mm_storeu_pd(out+i, _mm_add_pd(deltax, deltay));
+	}
+#endif
+
+	for( ; i < count; i++)
+		out[i] = h(first[i], b);
+}
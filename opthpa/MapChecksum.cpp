@@ -0,0 +1,56 @@
+#include "MapChecksum.h"
+
+#include "graph.h"
+#include "map.h"
+
+#include <cstring>
+
+static const unsigned int kFNVOffset = 2166136261u;
+static const unsigned int kFNVPrime = 16777619u;
+
+static unsigned int
+addWord(unsigned int hash, unsigned int word)
+{
+	for(int i=0; i<4; i++)
+	{
+		hash ^= (word >> (8*i)) & 0xFF;
+		hash *= kFNVPrime;
+	}
+	return hash;
+}
+
+unsigned int
+MapChecksum::compute(Map* map)
+{
+	int width = map->getMapWidth();
+	int height = map->getMapHeight();
+
+	unsigned int hash = kFNVOffset;
+	hash = addWord(hash, width);
+	hash = addWord(hash, height);
+	for(int y=0; y<height; y++)
+		for(int x=0; x<width; x++)
+			hash = addWord(hash, map->getTerrainType(x, y));
+	return hash;
+}
+
+unsigned int
+MapChecksum::compute(graph* g)
+{
+	unsigned int hash = kFNVOffset;
+	hash = addWord(hash, g->getNumNodes());
+
+	edge_iterator ei = g->getEdgeIter();
+	for(edge* e = g->edgeIterNext(ei); e; e = g->edgeIterNext(ei))
+	{
+		double weight = e->getWeight();
+		unsigned int words[sizeof(double)/sizeof(unsigned int)];
+		memcpy(words, &weight, sizeof(double));
+
+		hash = addWord(hash, e->getFrom());
+		hash = addWord(hash, e->getTo());
+		for(unsigned int i=0; i<sizeof(double)/sizeof(unsigned int); i++)
+			hash = addWord(hash, words[i]);
+	}
+	return hash;
+}
@@ -0,0 +1,28 @@
+#ifndef MAPCHECKSUM_H
+#define MAPCHECKSUM_H
+
+// MapChecksum.h
+//
+// A checksum of the dimensions and terrain of a map. Files of data
+// computed for one map (landmark distances, path databases) store it so
+// that the data is not used with a map which has since been edited.
+// Data computed for one graph of an abstraction (contraction hierarchies)
+// stores a checksum of that graph instead.
+//
+// @created: 17/10/2026
+
+class Map;
+class graph;
+class MapChecksum
+{
+	public:
+		// 32-bit FNV-1a hash of the width, height and terrain type of every
+		// tile, in row-major order.
+		static unsigned int compute(Map* map);
+
+		// 32-bit FNV-1a hash of the number of nodes of a graph and the
+		// endpoints and weight of every edge, in the graph's edge order.
+		static unsigned int compute(graph* g);
+};
+
+#endif
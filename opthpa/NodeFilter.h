@@ -3,6 +3,7 @@
 
 #include "graph.h"
 
+class ProblemInstance;
 class NodeFilter 
 {
 
@@ -11,6 +12,15 @@ class NodeFilter
 		virtual ~NodeFilter() { }
 
 		virtual bool filter(node* n) = 0;
+
+		// filters which depend on the edge being followed, and not only on
+		// the node it leads to, override this; from is the node being 
+		// expanded
+		virtual bool filter(node* from, node* n) { return filter(n); }
+
+		// called whenever the expansion policy which owns the filter is 
+		// given a new problem instance
+		virtual void setProblemInstance(ProblemInstance* p) { }
 };
 
 #endif
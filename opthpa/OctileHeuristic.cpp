@@ -5,6 +5,10 @@
 
 #include <stdexcept>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 OctileHeuristic::OctileHeuristic()
 {
 }
@@ -33,3 +37,43 @@ double OctileHeuristic::h(node* a, node* b) const
 		answer = root2m1*fabs(y1-y2)+fabs(x1-x2);
 	return answer;
 }
+
+// The smaller of the two distances is scaled and added to the larger, as
+// in ::h, so the results are the same to the last bit.
+void OctileHeuristic::h_batch(node** first, unsigned int count, node* b, 
+		double* out) const
+{
+	if(b == NULL) 
+		throw std::invalid_argument("null node");
+
+	const double x2 = b->getLabelL(kFirstData);
+	const double y2 = b->getLabelL(kFirstData+1);
+	unsigned int i = 0;
+
+#ifdef __SSE2__
+	const __m128d sign = _mm_set1_pd(-0.0);
+	const __m128d goalx = _mm_set1_pd(x2);
+	const __m128d goaly = _mm_set1_pd(y2);
+	const __m128d root2m1 = _mm_set1_pd(ROOT_TWO-1);
+	for( ; i+2 <= count; i+=2)
+	{
+		node* a0 = first[i];
+		node* a1 = first[i+1];
+		if(a0 == NULL || a1 == NULL) 
+			throw std::invalid_argument("null node");
+
+		__m128d x1 = _mm_set_pd(a1->getLabelL(kFirstData), 
+				a0->getLabelL(kFirstData));
+		__m128d y1 = _mm_set_pd(a1->getLabelL(kFirstData+1), 
+				a0->getLabelL(kFirstData+1));
+		__m128d dx = _mm_andnot_pd(sign, _mm_sub_pd(x1, goalx));
+		__m128d dy = _mm_andnot_pd(sign, _mm_sub_pd(y1, goaly));
+		__m128d answer = _mm_add_pd(
+				_mm_mul_pd(root2m1, _mm_min_pd(dx, dy)), _mm_max_pd(dx, dy));
+		_mm_storeu_pd(out+i, answer);
+	}
+#endif
+
+	for( ; i < count; i++)
+		out[i] = h(first[i], b);
+}
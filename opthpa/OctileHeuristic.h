@@ -20,6 +20,10 @@ class OctileHeuristic : public Heuristic
 		virtual ~OctileHeuristic();
 
 		virtual double h(node* first, node* second) const;
+
+		// as ::h; computes two distances at a time where SSE2 is available
+		virtual void h_batch(node** first, unsigned int count, node* second,
+				double* out) const;
 };
 
 #endif
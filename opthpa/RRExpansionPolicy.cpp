@@ -13,6 +13,7 @@ RRExpansionPolicy::RRExpansionPolicy(graphAbstraction* map) :
 	SelectiveExpansionPolicy()
 {
 	this->map = map;	
+	this->ecmap = dynamic_cast<EmptyClusterAbstraction*>(map);
 
 	primary = new IncidentEdgesExpansionPolicy(map);
 	skipSecondary = false;
@@ -49,7 +50,16 @@ void RRExpansionPolicy::expand(node* target_) throw(std::logic_error)
 	}
 
 	whichSecondary = 0;
-	numSecondary = mnTarget->numSecondaryEdges();
+	if(ecmap && ecmap->getImplicitSecondaryEdges())
+	{
+		implicitSecondary.clear();
+		if(!skipSecondary)
+			ecmap->getCluster(mnTarget->getParentClusterId())->
+				getSecondaryNeighbours(mnTarget, implicitSecondary);
+		numSecondary = implicitSecondary.size();
+	}
+	else
+		numSecondary = mnTarget->numSecondaryEdges();
 }
 
 node* RRExpansionPolicy::first_impl()
@@ -69,15 +79,7 @@ node* RRExpansionPolicy::n_impl()
 	{
 		assert(primary->hasNext() == false);
 		if(skipSecondary == false && whichSecondary < numSecondary)
-		{
-			MacroNode* mnTarget = dynamic_cast<MacroNode*>(target);
-			edge* e = mnTarget->getSecondaryEdge(whichSecondary);
-			assert(e);
-			int neighbourid = e->getFrom()==mnTarget->getNum()?e->getTo():e->getFrom();
-			retVal = g->getNode(neighbourid);
-			assert(retVal);
-			cost = e->getWeight();
-		}
+			retVal = secondaryNeighbour(whichSecondary);
 	}
 	return retVal;
 }
@@ -94,13 +96,7 @@ node* RRExpansionPolicy::next_impl()
 	{
 		if(whichSecondary < numSecondary)
 		{
-			MacroNode* mnTarget = dynamic_cast<MacroNode*>(target);
-			edge* e = mnTarget->getSecondaryEdge(whichSecondary);
-			assert(e);
-			int neighbourid = e->getFrom()==mnTarget->getNum()?e->getTo():e->getFrom();
-			retVal = g->getNode(neighbourid);
-			assert(retVal);
-			cost = e->getWeight();
+			retVal = secondaryNeighbour(whichSecondary);
 			whichSecondary++;
 		}
 	}
@@ -108,6 +104,29 @@ node* RRExpansionPolicy::next_impl()
 	return retVal;
 }
 
+// returns the secondary neighbour at position index and sets the cost of
+// reaching it from the target node
+node* RRExpansionPolicy::secondaryNeighbour(int index)
+{
+	node* retVal = 0;
+	if(ecmap && ecmap->getImplicitSecondaryEdges())
+	{
+		retVal = implicitSecondary.at(index);
+		cost = map->h(target, retVal);
+	}
+	else
+	{
+		MacroNode* mnTarget = dynamic_cast<MacroNode*>(target);
+		edge* e = mnTarget->getSecondaryEdge(index);
+		assert(e);
+		int neighbourid = e->getFrom()==mnTarget->getNum()?e->getTo():e->getFrom();
+		retVal = g->getNode(neighbourid);
+		cost = e->getWeight();
+	}
+	assert(retVal);
+	return retVal;
+}
+
 bool RRExpansionPolicy::hasNext()
 {
 	if(primary->hasNext())
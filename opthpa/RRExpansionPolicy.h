@@ -30,15 +30,22 @@
 // 
 // See [Harabor & Botea 2011] for more details.
 //
+// If the abstraction was built with implicit secondary edges, the secondary
+// neighbours of each node are computed from the dimensions of its ERR 
+// during expansion (see EmptyCluster::getSecondaryNeighbours).
+//
 //
 // @author: dharabor
 // @created: 28/11/2010
 
 #include <stdexcept>
+#include <vector>
 
+class EmptyClusterAbstraction;
 class graph;
 class graphAbstraction;
 class IncidentEdgesExpansionPolicy;
+class MacroNode;
 class RRExpansionPolicy : public SelectiveExpansionPolicy
 {
 	public:
@@ -55,14 +62,18 @@ class RRExpansionPolicy : public SelectiveExpansionPolicy
 		virtual node* n_impl();
 
 	private:
+		node* secondaryNeighbour(int index);
+
 		bool skipSecondary;
 		int whichSecondary;
 		int numSecondary;
 		double cost;
 
 		graphAbstraction* map;
+		EmptyClusterAbstraction* ecmap;
 		graph* g;
 		IncidentEdgesExpansionPolicy* primary;
+		std::vector<MacroNode*> implicitSecondary;
 };
 
 #endif
@@ -0,0 +1,242 @@
+#include "RRJumpExpansionPolicy.h"
+
+#include "ClusterNode.h"
+#include "EmptyCluster.h"
+#include "EmptyClusterAbstraction.h"
+#include "Heuristic.h"
+#include "ProblemInstance.h"
+#include "graph.h"
+
+RRJumpExpansionPolicy::RRJumpExpansionPolicy(EmptyClusterAbstraction* map_)
+	: ExpansionPolicy()
+{
+	this->map = map_;
+	neighbourIndex = 0;
+}
+
+RRJumpExpansionPolicy::~RRJumpExpansionPolicy()
+{
+	neighbours.clear();
+}
+
+void
+RRJumpExpansionPolicy::expand(node* t) throw(std::logic_error)
+{
+	ExpansionPolicy::expand(t);
+	neighbours.clear();
+	neighbourIndex = 0;
+
+	node* parent = t->backpointer;
+	if(parent == 0)
+	{
+		graph* g = map->getAbstractGraph(0);
+		neighbor_iterator iter = t->getNeighborIter();
+		for(int nodeId = t->nodeNeighborNext(iter); nodeId != -1;
+				nodeId = t->nodeNeighborNext(iter))
+		{
+			neighbours.push_back(g->getNode(nodeId));
+		}
+		return;
+	}
+
+	int dx = t->getLabelL(kFirstData) - parent->getLabelL(kFirstData);
+	int dy = t->getLabelL(kFirstData+1) - parent->getLabelL(kFirstData+1);
+	addJumpNeighbours(dx > 0 ? 1 : (dx < 0 ? -1 : 0),
+			dy > 0 ? 1 : (dy < 0 ? -1 : 0));
+}
+
+// the natural and forced neighbours of the target, given that it was
+// reached by a move in direction (dx, dy)
+void
+RRJumpExpansionPolicy::addJumpNeighbours(int dx, int dy)
+{
+	int x = target->getLabelL(kFirstData);
+	int y = target->getLabelL(kFirstData+1);
+
+	addJumpNode(dx, dy);
+	if(dx != 0 && dy != 0)
+	{
+		addJumpNode(dx, 0);
+		addJumpNode(0, dy);
+		if(!isTraversable(x-dx, y))
+			addJumpNode(-dx, dy);
+		if(!isTraversable(x, y-dy))
+			addJumpNode(dx, -dy);
+	}
+	else if(dx != 0)
+	{
+		if(!isTraversable(x, y-1))
+			addJumpNode(dx, -1);
+		if(!isTraversable(x, y+1))
+			addJumpNode(dx, 1);
+	}
+	else
+	{
+		if(!isTraversable(x-1, y))
+			addJumpNode(-1, dy);
+		if(!isTraversable(x+1, y))
+			addJumpNode(1, dy);
+	}
+}
+
+void
+RRJumpExpansionPolicy::addJumpNode(int dx, int dy)
+{
+	node* n = findJumpNode(target->getLabelL(kFirstData),
+			target->getLabelL(kFirstData+1), dx, dy);
+	if(n)
+		neighbours.push_back(n);
+}
+
+// Steps from (x, y) in direction (dx, dy) until a jump node is found.
+// Straight scans cross the interior of each room they enter in one step.
+//
+// @return: the jump node or 0 if the scan ran into an obstacle.
+node*
+RRJumpExpansionPolicy::findJumpNode(int x, int y, int dx, int dy)
+{
+	node* goal = problem->getGoalNode();
+	int goalx = goal->getLabelL(kFirstData);
+	int goaly = goal->getLabelL(kFirstData+1);
+
+	// rooms are only looked up when the scan enters them
+	int room = -1;
+	while(true)
+	{
+		int nx = x + dx;
+		int ny = y + dy;
+		node* n = map->getNodeFromMap(nx, ny);
+		if(n == 0)
+			return 0;
+
+		if(nx == goalx && ny == goaly)
+			return n;
+
+		if(dx != 0 && dy != 0)
+		{
+			if(!isTraversable(nx-dx, ny) && isTraversable(nx-dx, ny+dy))
+				return n;
+			if(!isTraversable(nx, ny-dy) && isTraversable(nx+dx, ny-dy))
+				return n;
+
+			// n is a jump node if a straight scan from n finds another
+			if(findJumpNode(nx, ny, dx, 0) || findJumpNode(nx, ny, 0, dy))
+				return n;
+		}
+		else
+		{
+			if(dx != 0)
+			{
+				if(!isTraversable(nx, ny-1) && isTraversable(nx+dx, ny-1))
+					return n;
+				if(!isTraversable(nx, ny+1) && isTraversable(nx+dx, ny+1))
+					return n;
+			}
+			else
+			{
+				if(!isTraversable(nx-1, ny) && isTraversable(nx-1, ny+dy))
+					return n;
+				if(!isTraversable(nx+1, ny) && isTraversable(nx+1, ny+dy))
+					return n;
+			}
+
+			// none of the tiles skipped has a forced neighbour; the scan
+			// stops early only if the goal is among them
+			int cid = static_cast<ClusterNode*>(n)->getParentClusterId();
+			int steps = 0;
+			if(cid != room)
+			{
+				room = cid;
+				ClusterNode* ahead = static_cast<ClusterNode*>(
+						map->getNodeFromMap(nx+dx, ny+dy));
+				if(ahead && ahead->getParentClusterId() == cid)
+					steps = crossRoom(nx, ny, dx, dy);
+			}
+			if(steps > 0)
+			{
+				int gsteps = dx != 0 ? (goalx - nx)*dx : (goaly - ny)*dy;
+				bool ongoalline = dx != 0 ? goaly == ny : goalx == nx;
+				if(ongoalline && gsteps > 0 && gsteps <= steps)
+					return goal;
+				nx += steps*dx;
+				ny += steps*dy;
+			}
+		}
+
+		x = nx;
+		y = ny;
+	}
+}
+
+// @return: the number of steps a straight scan in direction (dx, dy) can 
+// take from (x, y) without leaving the room containing (x, y). This is
+// zero unless the scan runs along a row (or column) strictly inside the
+// room.
+int
+RRJumpExpansionPolicy::crossRoom(int x, int y, int dx, int dy)
+{
+	ClusterNode* n = static_cast<ClusterNode*>(map->getNodeFromMap(x, y));
+	EmptyCluster* room = map->getCluster(n->getParentClusterId());
+	if(room == 0)
+		return 0;
+
+	int x0 = room->getHOrigin();
+	int y0 = room->getVOrigin();
+	int x1 = x0 + room->getWidth() - 1;
+	int y1 = y0 + room->getHeight() - 1;
+	if(dx != 0)
+	{
+		if(y <= y0 || y >= y1)
+			return 0;
+		return dx > 0 ? x1 - x : x - x0;
+	}
+
+	if(x <= x0 || x >= x1)
+		return 0;
+	return dy > 0 ? y1 - y : y - y0;
+}
+
+bool
+RRJumpExpansionPolicy::isTraversable(int x, int y)
+{
+	return map->getNodeFromMap(x, y) != 0;
+}
+
+node*
+RRJumpExpansionPolicy::first()
+{
+	neighbourIndex = 0;
+	return n();
+}
+
+node*
+RRJumpExpansionPolicy::next()
+{
+	node* nextnode = 0;
+	if(hasNext())
+	{
+		neighbourIndex++;
+		nextnode = n();
+	}
+	return nextnode;
+}
+
+node*
+RRJumpExpansionPolicy::n()
+{
+	if(neighbourIndex < neighbours.size())
+		return neighbours.at(neighbourIndex);
+	return 0;
+}
+
+double
+RRJumpExpansionPolicy::cost_to_n()
+{
+	return problem->getHeuristic()->h(target, n());
+}
+
+bool
+RRJumpExpansionPolicy::hasNext()
+{
+	return neighbourIndex+1 < neighbours.size();
+}
@@ -0,0 +1,57 @@
+#ifndef RRJUMPEXPANSIONPOLICY_H
+#define RRJUMPEXPANSIONPOLICY_H
+
+// RRJumpExpansionPolicy.h
+//
+// An expansion policy that combines Jump Points with Empty Rectangular
+// Rooms.
+//
+// Search proceeds on the grid as per JumpPointsExpansionPolicy: neighbours
+// which can be reached optimally via the parent of the target are pruned
+// and the remaining directions are scanned for jump nodes.
+//
+// Scanning through open areas is where most of the effort of a jump point
+// search goes. This policy uses the rooms of an EmptyClusterAbstraction
+// to cross such areas in a single step: no tile on a row (or column)
+// strictly inside a room can have a forced neighbour, so a straight scan
+// which enters such a row jumps directly to the far side of the room
+// (unless the goal lies in between). Tiles in cluttered areas, which are
+// covered by small rooms, are scanned one at a time as usual.
+//
+// Successors, and hence the number of node expansions, are identical
+// to those of JumpPointsExpansionPolicy.
+//
+// @created: 17/10/2026
+
+#include "ExpansionPolicy.h"
+
+#include <stdexcept>
+#include <vector>
+
+class EmptyClusterAbstraction;
+class RRJumpExpansionPolicy : public ExpansionPolicy
+{
+	public:
+		RRJumpExpansionPolicy(EmptyClusterAbstraction* map);
+		virtual ~RRJumpExpansionPolicy();
+
+		virtual void expand(node* t) throw(std::logic_error);
+		virtual node* first();
+		virtual node* next();
+		virtual node* n();
+		virtual double cost_to_n();
+		virtual bool hasNext();
+
+	private:
+		void addJumpNeighbours(int dx, int dy);
+		void addJumpNode(int dx, int dy);
+		node* findJumpNode(int x, int y, int dx, int dy);
+		int crossRoom(int x, int y, int dx, int dy);
+		bool isTraversable(int x, int y);
+
+		EmptyClusterAbstraction* map;
+		std::vector<node*> neighbours;
+		unsigned int neighbourIndex;
+};
+
+#endif
@@ -66,12 +66,19 @@ void SelectiveExpansionPolicy::addFilter(NodeFilter* nf)
 	filters.push_back(nf);
 }
 
+void SelectiveExpansionPolicy::setProblemInstance(ProblemInstance* p)
+{
+	ExpansionPolicy::setProblemInstance(p);
+	for(unsigned int i = 0; i<filters.size(); i++)
+		filters.at(i)->setProblemInstance(p);
+}
+
 bool SelectiveExpansionPolicy::filter(node* n)
 {
 	for(unsigned int i = 0; i<filters.size(); i++)
 	{
 		NodeFilter* nf = filters.at(i);
-		if(nf->filter(n))
+		if(nf->filter(target, n))
 			return true;
 	}
 	return false;
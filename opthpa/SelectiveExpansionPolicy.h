@@ -31,6 +31,9 @@ class SelectiveExpansionPolicy : public ExpansionPolicy
 
 		void addFilter(NodeFilter* nf);
 
+		// also passes the problem instance on to each filter
+		virtual void setProblemInstance(ProblemInstance* p);
+
 	protected:
 		virtual node* n_impl() = 0;
 		virtual node* first_impl() = 0;
@@ -0,0 +1,410 @@
+#include "SubgoalGraphAbstraction.h"
+
+#include "ConnectedComponents.h"
+#include "fpUtil.h"
+#include "IEdgeFactory.h"
+#include "INodeFactory.h"
+#include "graph.h"
+#include "map.h"
+#include "OctileHeuristic.h"
+
+#include <climits>
+
+SubgoalGraphAbstraction::SubgoalGraphAbstraction(Map* _m, INodeFactory* _nf, 
+		IEdgeFactory* _ef, bool _verbose) : mapAbstraction(_m), 
+	verbose(_verbose)
+{
+	nf = _nf;
+	ef = _ef;
+	components = new ConnectedComponents(_m->getMapWidth(), 
+			_m->getMapHeight());
+
+	makeSubgoalGraph();
+}
+
+SubgoalGraphAbstraction::~SubgoalGraphAbstraction()
+{
+	delete nf;
+	delete ef;
+	delete components;
+}
+
+mapAbstraction*
+SubgoalGraphAbstraction::clone(Map* _m)
+{
+	return new SubgoalGraphAbstraction(_m, nf->clone(), ef->clone());
+}
+
+bool 
+SubgoalGraphAbstraction::pathable(node* n, node* m)
+{
+	return components->connected(n, m);
+}
+
+void
+SubgoalGraphAbstraction::verifyHierarchy()
+{
+}
+
+void
+SubgoalGraphAbstraction::removeNode(node* n)
+{
+	if(n->getLabelL(kAbstractionLevel) == 1)
+	{
+		removeParent(n);
+		return;
+	}
+
+	graph* g = getAbstractGraph(0); 
+	edge_iterator ei = n->getEdgeIter();
+	edge* e = n->edgeIterNext(ei);
+	while(e)
+	{
+		g->removeEdge(e);
+		delete e;
+		ei = n->getEdgeIter();
+		e = n->edgeIterNext(ei);
+	}
+	g->removeNode(n);
+	delete n;
+}
+
+void 
+SubgoalGraphAbstraction::removeEdge(edge *e, unsigned int absLevel)
+{
+	graph* g = getAbstractGraph(absLevel);
+	g->removeEdge(e);
+	delete e;
+}
+
+void 
+SubgoalGraphAbstraction::addNode(node *n)
+{
+	graph* g = getAbstractGraph(n->getLabelL(kAbstractionLevel));
+	g->addNode(n);
+}
+
+void 
+SubgoalGraphAbstraction::addEdge(edge *e, unsigned int absLevel)
+{
+	graph* g = getAbstractGraph(absLevel);
+	g->addEdge(e);
+}
+
+void 
+SubgoalGraphAbstraction::repairAbstraction()
+{
+	if(verbose)
+		std::cout << "repairAbstraction"<<std::endl;
+
+	while(getNumAbstractGraphs() > 0)
+	{
+		graph* g = abstractions.back();
+		abstractions.pop_back();
+		delete g;
+	}
+	makeSubgoalGraph();
+}
+
+// The grid graph is built first. Every subgoal is then given a parent in
+// the subgoal graph before any edges are added; that way the search for
+// directly h-reachable nodes can stop whenever it reaches a subgoal.
+void
+SubgoalGraphAbstraction::makeSubgoalGraph()
+{
+	graph* g = getMapGraph(this->getMap(), nf, ef, true);
+	abstractions.push_back(g);
+	abstractions.push_back(new graph());
+	components->label(g);
+
+	for(int i=0; i<g->getNumNodes(); i++)
+	{
+		node* n = g->getNode(i);
+		if(isSubgoal(n))
+			newParent(n);
+	}
+
+	graph* absg = getAbstractGraph(1);
+	for(int i=0; i<absg->getNumNodes(); i++)
+		connect(absg->getNode(i));
+
+	if(verbose)
+		std::cout << "subgoal graph: "<<absg->getNumNodes()<<" nodes, "
+			<<absg->getNumEdges()<<" edges"<<std::endl;
+}
+
+node*
+SubgoalGraphAbstraction::addParent(node* n)
+{
+	if(n->getLabelL(kParent) != -1)
+		return getAbstractGraph(1)->getNode(n->getLabelL(kParent));
+
+	node* absNode = newParent(n);
+	connect(absNode);
+	return absNode;
+}
+
+void
+SubgoalGraphAbstraction::removeParent(node* absNode)
+{
+	graph* absg = getAbstractGraph(1);
+	edge_iterator ei = absNode->getEdgeIter();
+	edge* e = absNode->edgeIterNext(ei);
+	while(e)
+	{
+		absg->removeEdge(e);
+		delete e;
+		ei = absNode->getEdgeIter();
+		e = absNode->edgeIterNext(ei);
+	}
+
+	node* n = getNodeFromMap(absNode->getLabelL(kFirstData), 
+			absNode->getLabelL(kFirstData+1));
+	n->setLabelL(kParent, -1);
+	absg->removeNode(absNode->getNum());
+	delete absNode;
+}
+
+node*
+SubgoalGraphAbstraction::newParent(node* n)
+{
+	node* absNode = nf->newNode(n);
+	absNode->setLabelL(kAbstractionLevel, 1);
+	absNode->setLabelL(kParent, -1);
+	getAbstractGraph(1)->addNode(absNode);
+	n->setLabelL(kParent, absNode->getNum());
+	return absNode;
+}
+
+// adds an edge between absNode and every node in the subgoal graph which 
+// is directly h-reachable from it.
+void
+SubgoalGraphAbstraction::connect(node* absNode)
+{
+	graph* absg = getAbstractGraph(1);
+	node* n = getNodeFromMap(absNode->getLabelL(kFirstData), 
+			absNode->getLabelL(kFirstData+1));
+
+	std::vector<node*> reachable;
+	getDirectHReachable(n, reachable);
+
+	OctileHeuristic octile;
+	for(unsigned int i=0; i<reachable.size(); i++)
+	{
+		node* neighbour = absg->getNode(reachable[i]->getLabelL(kParent));
+		if(absg->findEdge(absNode->getNum(), neighbour->getNum()))
+			continue;
+
+		absg->addEdge(ef->newEdge(absNode->getNum(), neighbour->getNum(), 
+					octile.h(absNode, neighbour)));
+	}
+}
+
+// Optimal paths change direction only where they wrap around an obstacle.
+// A location is a subgoal if some optimal path may turn there; see 
+// ::besideCorner, ::besideCliff and ::turnsInBlock.
+bool
+SubgoalGraphAbstraction::isSubgoal(node* n)
+{
+	return besideCorner(n) || besideCliff(n) || turnsInBlock(n);
+}
+
+// Diagonal moves in the grid graph may cut the corner of an obstacle, so a
+// path which wraps around a convex corner turns on the locations beside 
+// the corner rather than the one diagonal to it. Such a turn is spread 
+// over two moves and is found here rather than by ::turnsInBlock.
+// @return: true if n has an obstacle as a straight neighbour and that 
+// obstacle is not one of three in a row along one side of n: i.e. a wall.
+bool
+SubgoalGraphAbstraction::besideCorner(node* n)
+{
+	const int x = n->getLabelL(kFirstData);
+	const int y = n->getLabelL(kFirstData+1);
+
+	for(int d=0; d<4; d++)
+	{
+		int dx = d < 2 ? (d == 0 ? 1 : -1) : 0;
+		int dy = d < 2 ? 0 : (d == 2 ? 1 : -1);
+		if(getNodeFromMap(x+dx, y+dy))
+			continue;
+
+		bool wall = false;
+		if(dx != 0)
+			wall = !getNodeFromMap(x+dx, y-1) && !getNodeFromMap(x+dx, y+1);
+		else
+			wall = !getNodeFromMap(x-1, y+dy) && !getNodeFromMap(x+1, y+dy);
+		if(!wall)
+			return true;
+	}
+	return false;
+}
+
+// Some map types separate traversable locations by cliffs: edges which
+// are missing between neighbours that both exist. 
+// @return: true if n is beside a cliff. 
+bool
+SubgoalGraphAbstraction::besideCliff(node* n)
+{
+	const int x = n->getLabelL(kFirstData);
+	const int y = n->getLabelL(kFirstData+1);
+
+	for(int dx=-1; dx<=1; dx++)
+		for(int dy=-1; dy<=1; dy++)
+		{
+			if((dx == 0 && dy == 0) || step(n, dx, dy) || 
+					!getNodeFromMap(x+dx, y+dy))
+				continue;
+
+			// obstacles only block a diagonal move when both straight moves
+			// beside it are blocked too
+			if(dx == 0 || dy == 0 || getNodeFromMap(x+dx, y) || 
+					getNodeFromMap(x, y+dy))
+				return true;
+		}
+	return false;
+}
+
+// Paths turn around the ends of a cliff with a single move.
+// @return: true if there are neighbours u and v of n such that the 
+// shortest path from u to v through the 3x3 block around n passes through 
+// n and is longer than the octile distance between u and v.
+bool
+SubgoalGraphAbstraction::turnsInBlock(node* n)
+{
+	const int x = n->getLabelL(kFirstData);
+	const int y = n->getLabelL(kFirstData+1);
+	graph* g = getAbstractGraph(0);
+
+	node* block[9];
+	for(int i=0; i<9; i++)
+		block[i] = getNodeFromMap(x + i%3 - 1, y + i/3 - 1);
+
+	// shortest distances inside the block; Floyd-Warshall over 9 locations
+	const double kInfinity = 1e10;
+	double dist[9][9];
+	bool complete = true;
+	for(int i=0; i<9; i++)
+		for(int j=0; j<9; j++)
+		{
+			dist[i][j] = i == j ? 0 : kInfinity;
+			if(i == j)
+				continue;
+
+			int dx = (j%3) - (i%3);
+			int dy = (j/3) - (i/3);
+			if(dx < -1 || dx > 1 || dy < -1 || dy > 1)
+				continue;
+
+			edge* e = 0;
+			if(block[i] && block[j])
+				e = g->findEdge(block[i]->getNum(), block[j]->getNum());
+			if(e)
+				dist[i][j] = e->getWeight();
+			else
+				complete = false;
+		}
+	if(complete)
+		return false;
+
+	double direct[9];
+	for(int i=0; i<9; i++)
+		direct[i] = dist[i][4];
+
+	for(int k=0; k<9; k++)
+		for(int i=0; i<9; i++)
+			for(int j=0; j<9; j++)
+				if(dist[i][k] + dist[k][j] < dist[i][j])
+					dist[i][j] = dist[i][k] + dist[k][j];
+
+	OctileHeuristic octile;
+	for(int u=0; u<9; u++)
+	{
+		if(u == 4 || direct[u] >= kInfinity)
+			continue;
+
+		for(int v=u+1; v<9; v++)
+		{
+			if(v == 4 || direct[v] >= kInfinity)
+				continue;
+
+			if(fequal(direct[u] + direct[v], dist[u][v]) &&
+					fgreater(dist[u][v], octile.h(block[u], block[v])))
+				return true;
+		}
+	}
+	return false;
+}
+
+// Finds every node with a parent in the subgoal graph which can be reached
+// from n by a path of diagonal moves followed by straight moves that does
+// not pass through another such node. Each straight scan made from the 
+// diagonal is no longer than the one before it; locations further away are 
+// reachable through a subgoal at least as cheaply.
+void
+SubgoalGraphAbstraction::getDirectHReachable(node* n, 
+		std::vector<node*>& reachable)
+{
+	static const int dx[4] = { 1, 1, -1, -1 };
+	static const int dy[4] = { 1, -1, 1, -1 };
+
+	int east = scan(n, 1, 0, INT_MAX, reachable);
+	int west = scan(n, -1, 0, INT_MAX, reachable);
+	int south = scan(n, 0, 1, INT_MAX, reachable);
+	int north = scan(n, 0, -1, INT_MAX, reachable);
+
+	for(int d=0; d<4; d++)
+	{
+		int hlimit = dx[d] == 1 ? east : west;
+		int vlimit = dy[d] == 1 ? south : north;
+
+		node* current = step(n, dx[d], dy[d]);
+		while(current)
+		{
+			if(current->getLabelL(kParent) != -1)
+			{
+				reachable.push_back(current);
+				break;
+			}
+			hlimit = scan(current, dx[d], 0, hlimit, reachable);
+			vlimit = scan(current, 0, dy[d], vlimit, reachable);
+			current = step(current, dx[d], dy[d]);
+		}
+	}
+}
+
+// Moves from n in direction (dx, dy) for at most limit steps, stopping early 
+// at an obstacle or at a node with a parent in the subgoal graph. Such a 
+// node is appended to @param reachable.
+//
+// @return: the number of steps taken before stopping, not counting any
+// step onto a node with a parent.
+int
+SubgoalGraphAbstraction::scan(node* n, int dx, int dy, int limit, 
+		std::vector<node*>& reachable)
+{
+	int steps = 0;
+	while(steps < limit)
+	{
+		n = step(n, dx, dy);
+		if(n == 0)
+			break;
+
+		if(n->getLabelL(kParent) != -1)
+		{
+			reachable.push_back(n);
+			break;
+		}
+		steps++;
+	}
+	return steps;
+}
+
+node*
+SubgoalGraphAbstraction::step(node* n, int dx, int dy)
+{
+	node* m = getNodeFromMap(n->getLabelL(kFirstData) + dx, 
+			n->getLabelL(kFirstData+1) + dy);
+	if(m == 0 || getAbstractGraph(0)->findEdge(n->getNum(), m->getNum()) == 0)
+		return 0;
+	return m;
+}
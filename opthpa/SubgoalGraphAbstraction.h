@@ -0,0 +1,94 @@
+#ifndef SUBGOALGRAPHABSTRACTION_H
+#define SUBGOALGRAPHABSTRACTION_H
+
+// SubgoalGraphAbstraction.h
+//
+// A simple subgoal graph. Subgoals are placed at the corners of obstacles:
+// locations where an optimal path may have to change direction to get
+// around an obstacle. Each subgoal is connected to every other subgoal that
+// is directly h-reachable from it; i.e. the two can be joined by a path,
+// made of diagonal moves followed by straight moves, whose length is equal
+// to the octile distance between them and which does not pass through
+// another subgoal.
+//
+// The grid graph is level 0 of the abstraction and the subgoal graph is
+// level 1. Start and goal locations are connected to the subgoal graph by
+// a SubgoalInsertionPolicy and abstract paths are refined by a 
+// SubgoalRefinementPolicy. The resulting paths are optimal.
+//
+// For more information see:
+// 		[Uras, Koenig and Hernandez, Subgoal Graphs for Optimal Pathfinding in 
+// 		Eight-Neighbor Grids, ICAPS 2013]
+//
+// @created: 17/10/2026
+
+#include "mapAbstraction.h"
+
+#include <vector>
+
+class ConnectedComponents;
+class IEdgeFactory;
+class INodeFactory;
+class Map;
+class node;
+class edge;
+class graph;
+
+class SubgoalGraphAbstraction : public mapAbstraction
+{
+	public:
+		SubgoalGraphAbstraction(Map*, INodeFactory*, IEdgeFactory*, 
+				bool _verbose = false);
+		virtual ~SubgoalGraphAbstraction();
+		virtual mapAbstraction *clone(Map *);
+
+		virtual bool pathable(node*, node*);
+		virtual void verifyHierarchy();
+		virtual void removeNode(node *n);
+		virtual void removeEdge(edge *e, unsigned int absLevel);
+		virtual void addNode(node *n);
+		virtual void addEdge(edge *e, unsigned int absLevel);
+		virtual void repairAbstraction();
+
+		// Adds to the subgoal graph a parent for the map node n and connects
+		// it to every node directly h-reachable from n.
+		// @return: the new parent or the existing one if n already has one.
+		node* addParent(node* n);
+
+		// Removes from the subgoal graph a node added by ::addParent.
+		void removeParent(node* absNode);
+
+		// @return: true if the map node n is a subgoal
+		bool isSubgoal(node* n);
+
+		// Appends to @param reachable every map node which is directly
+		// h-reachable from the map node n and which has a parent in the 
+		// subgoal graph.
+		void getDirectHReachable(node* n, std::vector<node*>& reachable);
+
+		// @return: the map node reached from n by moving one step in the
+		// direction (dx, dy) or 0 if that move is not possible.
+		node* step(node* n, int dx, int dy);
+
+		INodeFactory* getNodeFactory() { return nf; }
+		IEdgeFactory* getEdgeFactory() { return ef; }
+		bool getVerbose() { return verbose; }
+		void setVerbose(bool _verbose) { this->verbose = _verbose; }
+
+	private:
+		bool verbose;
+		INodeFactory* nf;
+		IEdgeFactory* ef;
+		ConnectedComponents* components;
+
+		void makeSubgoalGraph();
+		node* newParent(node* n);
+		bool besideCorner(node* n);
+		bool besideCliff(node* n);
+		bool turnsInBlock(node* n);
+		void connect(node* absNode);
+		int scan(node* n, int dx, int dy, int limit, 
+				std::vector<node*>& reachable);
+};
+
+#endif
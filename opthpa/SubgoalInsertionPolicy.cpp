@@ -0,0 +1,49 @@
+#include "SubgoalInsertionPolicy.h"
+
+#include "graph.h"
+#include "SubgoalGraphAbstraction.h"
+#include "timer.h"
+
+SubgoalInsertionPolicy::SubgoalInsertionPolicy(SubgoalGraphAbstraction* _map)
+	: InsertionPolicy(), map(_map)
+{
+}
+
+SubgoalInsertionPolicy::~SubgoalInsertionPolicy()
+{
+}
+
+node*
+SubgoalInsertionPolicy::insert(node* n) throw(std::invalid_argument)
+{
+	resetMetrics();
+	if(n == 0)
+		throw std::invalid_argument(
+				"SubgoalInsertionPolicy::insert: null node");
+
+	if(n->getLabelL(kParent) != -1)
+		return map->getAbstractGraph(1)->getNode(n->getLabelL(kParent));
+
+	if(getVerbose())
+	{
+		const int x = n->getLabelL(kFirstData);
+		const int y = n->getLabelL(kFirstData+1);
+		std::cout << "inserting node ("<<x<<", "<<y<<") "
+			"into subgoal graph"<<std::endl;
+	}
+
+	Timer t;
+	t.startTimer();
+	node* retVal = map->addParent(n);
+	addNode(retVal);
+	nodesTouched = retVal->getNumEdges();
+	searchTime = t.endTimer();
+	return retVal;
+}
+
+void 
+SubgoalInsertionPolicy::remove(node* n) throw(std::runtime_error)
+{
+	if(removeNode(n))
+		map->removeParent(n);
+}
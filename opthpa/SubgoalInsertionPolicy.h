@@ -0,0 +1,31 @@
+#ifndef SUBGOALINSERTIONPOLICY_H
+#define SUBGOALINSERTIONPOLICY_H
+
+// SubgoalInsertionPolicy.h
+//
+// An insertion policy for maps of type SubgoalGraphAbstraction.
+// A start or goal node which is not a subgoal is added to the subgoal graph
+// and connected to every subgoal directly h-reachable from it. The goal is 
+// inserted after the start; if the two are directly h-reachable from one 
+// another they are connected too.
+//
+// @created: 17/10/2026
+//
+
+#include "InsertionPolicy.h"
+
+class SubgoalGraphAbstraction;
+class SubgoalInsertionPolicy : public InsertionPolicy
+{
+	public:
+		SubgoalInsertionPolicy(SubgoalGraphAbstraction* _map);
+		virtual ~SubgoalInsertionPolicy();
+
+		virtual node* insert(node* n) throw(std::invalid_argument);
+		virtual void remove(node* n) throw(std::runtime_error);
+
+	private:
+		SubgoalGraphAbstraction* map;
+};
+
+#endif
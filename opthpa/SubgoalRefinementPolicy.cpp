@@ -0,0 +1,59 @@
+#include "SubgoalRefinementPolicy.h"
+
+#include "graph.h"
+#include "path.h"
+#include "SubgoalGraphAbstraction.h"
+
+SubgoalRefinementPolicy::SubgoalRefinementPolicy(SubgoalGraphAbstraction* _map)
+	: RefinementPolicy(_map)
+{
+	sgmap = _map;
+}
+
+SubgoalRefinementPolicy::~SubgoalRefinementPolicy()
+{
+}
+
+path* 
+SubgoalRefinementPolicy::refineSegment(node* start, node* goal)
+{
+	path* segment = diagonalFirst(start, goal);
+	if(segment == 0)
+	{
+		segment = diagonalFirst(goal, start);
+		if(segment)
+			segment = segment->reverse();
+	}
+	return segment;
+}
+
+// @return: the path from start to goal which makes every diagonal move 
+// before any straight move, or 0 if that path is blocked.
+path*
+SubgoalRefinementPolicy::diagonalFirst(node* start, node* goal)
+{
+	const int gx = goal->getLabelL(kFirstData);
+	const int gy = goal->getLabelL(kFirstData+1);
+
+	path* segment = new path(start, 0);
+	path* segtail = segment;
+	node* current = start;
+	while(current != goal)
+	{
+		int dx = gx - current->getLabelL(kFirstData);
+		int dy = gy - current->getLabelL(kFirstData+1);
+		dx = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+		dy = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+
+		nodesTouched++;
+		current = sgmap->step(current, dx, dy);
+		if(current == 0)
+		{
+			delete segment;
+			return 0;
+		}
+		segtail->next = new path(current, 0);
+		segtail = segtail->next;
+	}
+	return segment;
+}
@@ -0,0 +1,38 @@
+#ifndef SUBGOALREFINEMENTPOLICY_H
+#define SUBGOALREFINEMENTPOLICY_H
+
+// SubgoalRefinementPolicy.h
+//
+// Refines paths through a SubgoalGraphAbstraction. As with 
+// OctileDistanceRefinementPolicy, each segment is the most direct path 
+// between its endpoints: diagonal moves first and then straight moves. 
+//
+// Edges in the subgoal graph are undirected but each one is only known to
+// be free of obstacles when followed diagonal-first from one of its two
+// endpoints. If the diagonal-first path from the start of a segment is 
+// blocked, the segment is refined from its other end and reversed.
+//
+// @created: 17/10/2026
+//
+
+#include "RefinementPolicy.h"
+
+class node;
+class path;
+class SubgoalGraphAbstraction;
+class SubgoalRefinementPolicy : public RefinementPolicy
+{
+	public:
+		SubgoalRefinementPolicy(SubgoalGraphAbstraction* map);
+		virtual ~SubgoalRefinementPolicy();
+
+	protected:
+		virtual path* refineSegment(node* start, node* goal);
+
+	private:
+		path* diagonalFirst(node* start, node* goal);
+
+		SubgoalGraphAbstraction* sgmap;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "VirtualOverlayExpansionPolicy.h"
+
+#include "EmptyClusterInsertionPolicy.h"
+#include "mapAbstraction.h"
+#include "ProblemInstance.h"
+
+VirtualOverlayExpansionPolicy::VirtualOverlayExpansionPolicy(
+		ExpansionPolicy* policy, EmptyClusterInsertionPolicy* overlay) 
+	: ExpansionPolicy()
+{
+	this->policy = policy;
+	this->overlay = overlay;
+	wrapped = false;
+	neighbourIndex = 0;
+}
+
+VirtualOverlayExpansionPolicy::~VirtualOverlayExpansionPolicy()
+{
+	delete policy;
+}
+
+void 
+VirtualOverlayExpansionPolicy::expand(node* t) throw(std::logic_error)
+{
+	ExpansionPolicy::expand(t);
+
+	neighbours.clear();
+	neighbourIndex = 0;
+	overlay->getVirtualNeighbours(t, neighbours);
+
+	wrapped = !overlay->isVirtual(t);
+	if(wrapped)
+		policy->expand(t);
+}
+
+void
+VirtualOverlayExpansionPolicy::setProblemInstance(ProblemInstance* p)
+{
+	ExpansionPolicy::setProblemInstance(p);
+	policy->setProblemInstance(p ? p->clone() : 0);
+}
+
+node* 
+VirtualOverlayExpansionPolicy::first()
+{
+	neighbourIndex = 0;
+	if(wrapped)
+	{
+		node* retVal = policy->first();
+		if(retVal)
+			return retVal;
+		wrapped = false;
+	}
+	return n();
+}
+
+node* 
+VirtualOverlayExpansionPolicy::next()
+{
+	if(wrapped)
+	{
+		node* retVal = policy->next();
+		if(retVal)
+			return retVal;
+		wrapped = false;
+		return n();
+	}
+
+	node* retVal = 0;
+	if(hasNext())
+	{
+		neighbourIndex++;
+		retVal = n();
+	}
+	return retVal;
+}
+
+node* 
+VirtualOverlayExpansionPolicy::n()
+{
+	if(wrapped)
+		return policy->n();
+
+	if(neighbourIndex < neighbours.size())
+		return neighbours.at(neighbourIndex);
+	return 0;
+}
+
+double 
+VirtualOverlayExpansionPolicy::cost_to_n()
+{
+	if(wrapped)
+		return policy->cost_to_n();
+	return problem->getMap()->h(target, n());
+}
+
+bool 
+VirtualOverlayExpansionPolicy::hasNext()
+{
+	if(wrapped)
+		return true;
+	return neighbourIndex+1 < neighbours.size();
+}
@@ -0,0 +1,51 @@
+#ifndef VIRTUALOVERLAYEXPANSIONPOLICY_H
+#define VIRTUALOVERLAYEXPANSIONPOLICY_H
+
+// VirtualOverlayExpansionPolicy.h
+//
+// Wraps an expansion policy for an EmptyClusterAbstraction and adds to it
+// the virtual start and goal nodes of an EmptyClusterInsertionPolicy.
+//
+// Virtual nodes are not part of the abstract graph. When one is expanded
+// its neighbours are taken from the overlay kept by the insertion policy;
+// when any other node is expanded the neighbours generated by the wrapped 
+// policy are followed by any virtual node adjacent to the target.
+//
+// The wrapped policy is owned by this object; the insertion policy is not.
+//
+// @created: 17/10/2026
+
+#include "ExpansionPolicy.h"
+
+#include <stdexcept>
+#include <vector>
+
+class EmptyClusterInsertionPolicy;
+class VirtualOverlayExpansionPolicy : public ExpansionPolicy
+{
+	public:
+		VirtualOverlayExpansionPolicy(ExpansionPolicy* policy, 
+				EmptyClusterInsertionPolicy* overlay);
+		virtual ~VirtualOverlayExpansionPolicy();
+
+		virtual void expand(node* t) throw(std::logic_error);
+		virtual node* first();
+		virtual node* next();
+		virtual node* n();
+		virtual double cost_to_n();
+		virtual bool hasNext();
+
+		// the wrapped policy is given its own copy of each problem
+		virtual void setProblemInstance(ProblemInstance* p);
+
+	private:
+		ExpansionPolicy* policy;
+		EmptyClusterInsertionPolicy* overlay;
+
+		// true while iterating over the neighbours of the wrapped policy
+		bool wrapped;
+		std::vector<node*> neighbours;
+		unsigned int neighbourIndex;
+};
+
+#endif
@@ -97,7 +97,8 @@ enum {
 
 /** Definitions for edge labels */
 enum {
-  kEdgeCapacity=2
+  kEdgeCapacity=2,
+  kUnresolvedEdge=3 // lazy HPA intra-edge; weight is only a lower bound (LONG label)
 };
 
 const double kUnknownPosition = -50.0;
@@ -18,6 +18,8 @@ class AnnotatedAStarMock : public AbstractAnnotatedAStar
 {
 	public:
 		AnnotatedAStarMock(int capability=0, int clearance=0) : AbstractAnnotatedAStar(capability, clearance) { curexp = NULL; }
+		virtual AbstractAnnotatedAStar* clone() 
+		{ AnnotatedAStarMock* mock = new AnnotatedAStarMock(getCapability(), getClearance()); mock->curexp = curexp; return mock; }
 		virtual path* getPath(graphAbstraction*, node*, node*, reservationProvider *rp=0);
 		virtual const char* getName() { return "AnnotatedAStarMock"; }
 		virtual bool evaluate(node* n, node* target); 
@@ -464,3 +464,63 @@ void AnnotatedAStarTest::logStatsShouldRecordAllMetricsToStatsCollection()
 	CPPUNIT_ASSERT_MESSAGE("couldn't find agentCapability metric in statsCollection", lookupResult == true);
 	CPPUNIT_ASSERT_EQUAL_MESSAGE("agentSize metric in statsCollection doesn't match expected result", aastar->getCapability(), (int)result.lval);
 }
+
+void AnnotatedAStarTest::getPathsFromFindsPathsAsShortAsThoseReturnedByGetPath()
+{
+	TestExperiment *te = expmgr->getExperiment(kPathableToyProblemLST);
+	AnnotatedMapAbstraction ama(new Map(maplocation.c_str()), new AnnotatedAStar());
+	node *start = ama.getNodeFromMap(te->startx,te->starty);
+	
+	/* every location on the map is a target */
+	graph* g = ama.getAbstractGraph(0);
+	std::vector<node*> targets;
+	for(int i=0; i<g->getNumNodes(); i++)
+		targets.push_back(g->getNode(i));
+
+	aastar->setCapability(te->caps);
+	aastar->setClearance(te->size);
+	std::vector<path*> paths;
+	aastar->getPathsFrom(&ama, start, targets, paths);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of paths returned", targets.size(), paths.size());
+	
+	for(unsigned int i=0; i<targets.size(); i++)
+	{
+		path* p = aastar->getPath(&ama, start, targets[i]);
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("getPathsFrom() and getPath() disagree about which targets are reachable", p == 0, paths[i] == 0);
+		if(p)
+		{
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("path returned by getPathsFrom() starts at the wrong node", start, paths[i]->n);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("path returned by getPathsFrom() has the wrong length", ama.distance(p), ama.distance(paths[i]), 0.001);
+		}
+		delete p;
+		delete paths[i];
+	}
+}
+
+void AnnotatedAStarTest::getPathsFromReturnsNullForEachTargetRejectedByGetPath()
+{
+	TestExperiment *te = expmgr->getExperiment(kPathableToyProblemLST);
+	AnnotatedMapAbstraction ama(new Map(maplocation.c_str()), new AnnotatedAStar());
+	node *start = ama.getNodeFromMap(te->startx,te->starty);
+	node* goal = ama.getNodeFromMap(te->goalx, te->goaly);
+	
+	std::vector<node*> targets;
+	targets.push_back(start);
+	targets.push_back(NULL);
+	targets.push_back(goal);
+	
+	aastar->setCapability(te->caps);
+	aastar->setClearance(te->size);
+	std::vector<path*> paths;
+	aastar->getPathsFrom(&ama, start, targets, paths);
+	
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("getPathsFrom() failed to return null when start and target are identical", true, paths[0] == 0);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("getPathsFrom() failed to return null when target is null", true, paths[1] == 0);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("getPathsFrom() returned a NULL solution for a pathable problem", true, paths[2] != 0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("returned solution length does not match length in test experiment", te->distance, ama.distance(paths[2]), 0.001);
+	delete paths[2];
+	
+	aastar->setClearance(0);
+	aastar->getPathsFrom(&ama, start, targets, paths);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("getPathsFrom() failed to return null when agent size is less than min", true, paths[2] == 0);
+}
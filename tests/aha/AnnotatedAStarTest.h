@@ -63,6 +63,8 @@ class AnnotatedAStarTest : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST( getPathFailsToReturnASoltuionWhenNoneExistsWithinTheCorridorBounds );
 	CPPUNIT_TEST( getPathReturnsTheShortestPathWithinCorridorBounds );
 	CPPUNIT_TEST( logStatsShouldRecordAllMetricsToStatsCollection );
+	CPPUNIT_TEST( getPathsFromFindsPathsAsShortAsThoseReturnedByGetPath );
+	CPPUNIT_TEST( getPathsFromReturnsNullForEachTargetRejectedByGetPath );
 
 	CPPUNIT_TEST_SUITE_END();
 	
@@ -112,6 +114,9 @@ class AnnotatedAStarTest : public CPPUNIT_NS::TestFixture
 		
 		void logStatsShouldRecordAllMetricsToStatsCollection();
 		
+		void getPathsFromFindsPathsAsShortAsThoseReturnedByGetPath();
+		void getPathsFromReturnsNullForEachTargetRejectedByGetPath();
+		
 	private:
 		void annotateNode(node* n, int t1, int t1c, int t2, int t2c, int t3, int t3c);
 		node* getNode(int x, int y, int nodeterrain);
@@ -0,0 +1,153 @@
+/*
+ *  AnnotatedHierarchicalAStarBatchTest.cpp
+ *  hog
+ *
+ *  Created on 17/10/2026.
+ *
+ */
+
+#include "AnnotatedHierarchicalAStarBatchTest.h"
+#include "AHAConstants.h"
+#include "AnnotatedAStar.h"
+#include "AnnotatedClusterAbstraction.h"
+#include "AnnotatedClusterFactory.h"
+#include "TestConstants.h"
+#include "graph.h"
+#include "path.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( AnnotatedHierarchicalAStarBatchTest );
+
+void AnnotatedHierarchicalAStarBatchTest::setUp()
+{
+	ahastar = new AnnotatedHierarchicalAStar();
+
+	/* one agent for every capability and size */
+	for(int i=0; i<NUMCAPABILITIES; i++)
+		for(int size=MINAGENTSIZE; size<=MAXAGENTSIZE; size++)
+			agents.push_back(AHAStarUtil::AgentType(capabilities[i], size));
+}
+
+void AnnotatedHierarchicalAStarBatchTest::tearDown()
+{
+	delete ahastar;
+	agents.clear();
+}
+
+void AnnotatedHierarchicalAStarBatchTest::getPathsShouldReturnTheSameSolutionCostsAsGetPathForEachAgent()
+{
+	AnnotatedClusterAbstraction* aca = buildAbstraction(acmap);
+	compareWithGetPath(aca, aca->getNodeFromMap(2,1), aca->getNodeFromMap(4,5));
+	delete aca;
+}
+
+/* every pair of locations on a map with several clusters and all three kinds of terrain */
+void AnnotatedHierarchicalAStarBatchTest::getPathsShouldReturnTheSameSolutionCostsAsGetPathAcrossManyClusters()
+{
+	AnnotatedClusterAbstraction* aca = buildAbstraction(maplocation);
+	graph* g = aca->getAbstractGraph(0);
+	for(int i=0; i<g->getNumNodes(); i+=7)
+		for(int j=0; j<g->getNumNodes(); j+=5)
+			compareWithGetPath(aca, g->getNode(i), g->getNode(j));
+	delete aca;
+}
+
+void AnnotatedHierarchicalAStarBatchTest::getPathsShouldReturnRefinedPathsEachAgentCanFollow()
+{
+	AnnotatedClusterAbstraction* aca = buildAbstraction(maplocation);
+	graph* g = aca->getAbstractGraph(0);
+	int solved = 0;
+	for(int i=0; i<g->getNumNodes(); i+=7)
+		for(int j=0; j<g->getNumNodes(); j+=5)
+		{
+			node* start = g->getNode(i);
+			node* goal = g->getNode(j);
+			std::vector<path*> paths;
+			ahastar->getPaths(aca, start, goal, agents, paths);
+			for(unsigned int k=0; k<paths.size(); k++)
+			{
+				if(paths[k])
+				{
+					checkPathCanBeFollowed(aca, paths[k], start, goal, agents[k]);
+					solved++;
+				}
+				delete paths[k];
+			}
+		}
+	CPPUNIT_ASSERT_MESSAGE("no problems were solved", solved > 0);
+	delete aca;
+}
+
+void AnnotatedHierarchicalAStarBatchTest::getPathsShouldRemoveAllInsertedNodesAndEdgesFromTheAbstractGraph()
+{
+	AnnotatedClusterAbstraction* aca = buildAbstraction(acmap);
+	graph* absmap = aca->getAbstractGraph(1);
+	node *start = aca->getNodeFromMap(2,1);
+	node* goal = aca->getNodeFromMap(4,5);
+
+	std::vector<AHAStarUtil::AgentType> squad;
+	squad.push_back(AHAStarUtil::AgentType(kGround, 1));
+	squad.push_back(AHAStarUtil::AgentType((kGround|kTrees), 2));
+
+	int numExpectedNodes = absmap->getNumNodes();
+	int numExpectedEdges = absmap->getNumEdges();
+	int numExpectedPathCacheSize = aca->getPathCacheSize();
+
+	std::vector<path*> paths;
+	ahastar->getPaths(aca, start, goal, squad, paths);
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("Node count in abstract graph is incorrect following call to getPaths", numExpectedNodes, (int)absmap->getNumNodes());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("Edge count in abstract graph is incorrect following call to getPaths", numExpectedEdges, (int)absmap->getNumEdges());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("Path cache size in ACA is incorrect following call to getPaths", numExpectedPathCacheSize, (int)aca->getPathCacheSize());
+
+	for(unsigned int i=0; i<paths.size(); i++)
+		delete paths[i];
+	delete aca;
+}
+
+AnnotatedClusterAbstraction* AnnotatedHierarchicalAStarBatchTest::buildAbstraction(const std::string& mapfile)
+{
+	AnnotatedClusterAbstraction* aca = new AnnotatedClusterAbstraction(new Map(mapfile.c_str(), true), 
+			new AnnotatedAStar(), TESTCLUSTERSIZE);
+	AnnotatedClusterFactory acfactory;
+	aca->buildClusters(&acfactory);
+	aca->buildEntrances();
+	return aca;
+}
+
+void AnnotatedHierarchicalAStarBatchTest::compareWithGetPath(AnnotatedClusterAbstraction* aca, node* start, node* goal)
+{
+	std::vector<path*> paths;
+	ahastar->getPaths(aca, start, goal, agents, paths);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of solutions", agents.size(), paths.size());
+
+	for(unsigned int i=0; i<agents.size(); i++)
+	{
+		ahastar->setCapability(agents[i].first);
+		ahastar->setClearance(agents[i].second);
+		path* p = ahastar->getPath(aca, start, goal);
+
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("batched query disagrees with getPath about existence of a solution", p == 0, paths[i] == 0);
+		if(p)
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("batched query solution cost differs from getPath", aca->distance(p), aca->distance(paths[i]), 0.001);
+		delete p;
+		delete paths[i];
+	}
+}
+
+/* a refined path runs from start to goal over adjacent level 0 nodes, each with enough clearance for the agent */
+void AnnotatedHierarchicalAStarBatchTest::checkPathCanBeFollowed(AnnotatedClusterAbstraction* aca, path* p, 
+		node* start, node* goal, AHAStarUtil::AgentType agent)
+{
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("path does not begin at the start", start, p->n);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("path does not end at the goal", goal, p->tail()->n);
+
+	graph* g = aca->getAbstractGraph(0);
+	for(path* cur = p; cur; cur = cur->next)
+	{
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("path leaves the map graph", 0L, cur->n->getLabelL(kAbstractionLevel));
+		CPPUNIT_ASSERT_MESSAGE("agent does not fit at a node on its path", cur->n->getClearance(agent.first) >= agent.second);
+		if(cur->next)
+			CPPUNIT_ASSERT_MESSAGE("consecutive nodes on the path are not adjacent", 
+					g->findEdge(cur->n->getNum(), cur->next->n->getNum()) != 0);
+	}
+}
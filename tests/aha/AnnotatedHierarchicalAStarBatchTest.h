@@ -0,0 +1,55 @@
+/*
+ *  AnnotatedHierarchicalAStarBatchTest.h
+ *  hog
+ *
+	Tests batched multi-agent queries (AnnotatedHierarchicalAStar::getPaths) on abstractions built from real maps. 
+	Needs no mock objects, unlike AnnotatedHierarchicalAStarTest.
+ 
+ *  Created on 17/10/2026.
+ *
+ */
+
+#ifndef ANNOTATEDHIERARCHICALASTARBATCHTEST_H
+#define ANNOTATEDHIERARCHICALASTARBATCHTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+#include <vector>
+
+#include "AnnotatedHierarchicalAStar.h"
+
+class AnnotatedClusterAbstraction;
+class node;
+class path;
+
+class AnnotatedHierarchicalAStarBatchTest: public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( AnnotatedHierarchicalAStarBatchTest );
+	CPPUNIT_TEST( getPathsShouldReturnTheSameSolutionCostsAsGetPathForEachAgent );
+	CPPUNIT_TEST( getPathsShouldReturnTheSameSolutionCostsAsGetPathAcrossManyClusters );
+	CPPUNIT_TEST( getPathsShouldReturnRefinedPathsEachAgentCanFollow );
+	CPPUNIT_TEST( getPathsShouldRemoveAllInsertedNodesAndEdgesFromTheAbstractGraph );
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void getPathsShouldReturnTheSameSolutionCostsAsGetPathForEachAgent();
+		void getPathsShouldReturnTheSameSolutionCostsAsGetPathAcrossManyClusters();
+		void getPathsShouldReturnRefinedPathsEachAgentCanFollow();
+		void getPathsShouldRemoveAllInsertedNodesAndEdgesFromTheAbstractGraph();
+
+	private:
+		AnnotatedClusterAbstraction* buildAbstraction(const std::string& mapfile);
+		void compareWithGetPath(AnnotatedClusterAbstraction* aca, node* start, node* goal);
+		void checkPathCanBeFollowed(AnnotatedClusterAbstraction* aca, path* p, node* start, node* goal, 
+				AHAStarUtil::AgentType agent);
+
+		AnnotatedHierarchicalAStar* ahastar;
+		std::vector<AHAStarUtil::AgentType> agents;
+};
+
+#endif
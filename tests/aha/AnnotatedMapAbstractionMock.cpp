@@ -8,12 +8,37 @@
  */
 
 #include "AnnotatedMapAbstractionMock.h"
+#include "AHAConstants.h"
+#include "ClearanceGrid.h"
 #include "ExperimentManager.h"
 #include "aStar3.h"
 
 using namespace std;
 using namespace ExpMgrUtil;
 
+/* nodes keep their clearance in a ClearanceGrid; the mock starts from a grid with every value zeroed and 
+   annotates it selectively (see setCurrentTestExperiment, loadClearanceInfo) */
+AnnotatedMapAbstractionMock::AnnotatedMapAbstractionMock(Map* m, AbstractAnnotatedAStar* searchalg) 
+	: AbstractAnnotatedMapAbstraction(m, searchalg) 
+{
+	clearance = new ClearanceGrid(m, vector<int>(capabilities, capabilities+NUMCAPABILITIES), 255);
+	for(int x=0; x<m->getMapWidth(); x++)
+		for(int y=0; y<m->getMapHeight(); y++)
+		{
+			for(int i=0; i<NUMCAPABILITIES; i++)
+				clearance->setClearance(x, y, capabilities[i], 0);
+			node* n = getNodeFromMap(x, y);
+			if(n)
+				n->setClearanceGrid(clearance);
+		}
+	annotateMap();
+}
+
+AnnotatedMapAbstractionMock::~AnnotatedMapAbstractionMock()
+{
+	delete clearance;
+}
+
 
 /* fake it for every map except "demo.map"; when we have demo.map we still fake pathable using a* instead of annotateda*/
 bool AnnotatedMapAbstractionMock::pathable(node* start, node* goal, int caps, int agentsize)
@@ -113,5 +138,6 @@ void AnnotatedMapAbstractionMock::loadClearanceInfo(const string& filename, Anno
 				current->setClearance(kTrees, kTreesClearance);
 				current->setClearance((kTrees|kGround), kTreesAndGroundClearance);
 			}
+		aMap->computeTraversalMasks();
 	}
 }
@@ -15,11 +15,12 @@
 #include "AnnotatedAStar.h"
 #include "ExperimentManager.h"
 
+class ClearanceGrid;
 class AnnotatedMapAbstractionMock : public AbstractAnnotatedMapAbstraction
 {
 	public:
-		AnnotatedMapAbstractionMock(Map* m, AbstractAnnotatedAStar* searchalg) : AbstractAnnotatedMapAbstraction(m, searchalg) { annotateMap(); }
-		~AnnotatedMapAbstractionMock() {}
+		AnnotatedMapAbstractionMock(Map* m, AbstractAnnotatedAStar* searchalg);
+		~AnnotatedMapAbstractionMock();
 				
 		virtual void annotateMap();
 		virtual bool pathable(node*, node*, int, int);
@@ -38,6 +39,7 @@ class AnnotatedMapAbstractionMock : public AbstractAnnotatedMapAbstraction
 		
 	private:
 		ExpMgrUtil::TestExperiment* curexp;
+		ClearanceGrid* clearance; // all zero until annotated
 		
 };
 
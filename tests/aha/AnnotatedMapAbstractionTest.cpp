@@ -13,12 +13,13 @@
 #include "ExperimentManager.h"
 
 #include "AnnotatedAStarMock.h"
+#include "ClearanceGrid.h"
 #include "mapAbstraction.h"
 #include "map.h"
 #include "aStar3.h"
 
 
-//CPPUNIT_TEST_SUITE_REGISTRATION( AnnotatedMapAbstractionTest );
+CPPUNIT_TEST_SUITE_REGISTRATION( AnnotatedMapAbstractionTest );
 
 using namespace std;
 using namespace ExpMgrUtil;
@@ -28,7 +29,7 @@ void AnnotatedMapAbstractionTest::setUp()
 	expmgr = new ExperimentManager();
 	
 	// need to setup a map
-	testmap = new Map(maplocation.c_str());
+	testmap = new Map(maplocation.c_str(), true);
 	AnnotatedAStarMock* aastar_mock = new AnnotatedAStarMock();
 	ama = new AnnotatedMapAbstraction(testmap, aastar_mock);
 	g = ama->getAbstractGraph(0);
@@ -75,6 +76,50 @@ void AnnotatedMapAbstractionTest::PathableReturnsFalseWhenNoValidPathExistsForLa
 	runExperiment(kPathableToyProblemLST);
 }
 
+void AnnotatedMapAbstractionTest::getTraversalMasksReturnsNullGivenUnsupportedCapabilityOrAgentSize()
+{
+	CPPUNIT_ASSERT_MESSAGE("masks returned for unsupported capability", ama->getTraversalMasks(kWater, 1) == 0);
+	CPPUNIT_ASSERT_MESSAGE("masks returned for agentsize < MINAGENTSIZE", ama->getTraversalMasks(kGround, 0) == 0);
+	CPPUNIT_ASSERT_MESSAGE("masks returned for agentsize > MAXAGENTSIZE", ama->getTraversalMasks(kGround, MAXAGENTSIZE+1) == 0);
+	CPPUNIT_ASSERT_MESSAGE("no masks returned for supported capability and agentsize", ama->getTraversalMasks(kGround, 1) != 0);
+}
+
+/* a move is legal if the agent fits at the target tile and, for diagonal moves, at the two cardinal tiles it cuts between */
+void AnnotatedMapAbstractionTest::traversalMasksAllowOnlyMovesToNodesWithSufficientClearance()
+{
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("one mask per node expected", (unsigned int)g->getNumNodes(), ama->getNumTraversalMasks());
+	for(int i=0; i<NUMCAPABILITIES; i++)
+		for(int size=MINAGENTSIZE; size<=MAXAGENTSIZE; size++)
+		{
+			const unsigned short* masks = ama->getTraversalMasks(capabilities[i], size);
+			for(int num=0; num<g->getNumNodes(); num++)
+			{
+				node* n = g->getNode(num);
+				int x = n->getLabelL(kFirstData);
+				int y = n->getLabelL(kFirstData+1);
+				
+				bool north = fits(x, y-1, capabilities[i], size);
+				bool south = fits(x, y+1, capabilities[i], size);
+				bool east = fits(x+1, y, capabilities[i], size);
+				bool west = fits(x-1, y, capabilities[i], size);
+				CPPUNIT_ASSERT_EQUAL(north, (masks[num]&(1<<kN)) != 0);
+				CPPUNIT_ASSERT_EQUAL(south, (masks[num]&(1<<kS)) != 0);
+				CPPUNIT_ASSERT_EQUAL(east, (masks[num]&(1<<kE)) != 0);
+				CPPUNIT_ASSERT_EQUAL(west, (masks[num]&(1<<kW)) != 0);
+				CPPUNIT_ASSERT_EQUAL(north && east && fits(x+1, y-1, capabilities[i], size), (masks[num]&(1<<kNE)) != 0);
+				CPPUNIT_ASSERT_EQUAL(north && west && fits(x-1, y-1, capabilities[i], size), (masks[num]&(1<<kNW)) != 0);
+				CPPUNIT_ASSERT_EQUAL(south && east && fits(x+1, y+1, capabilities[i], size), (masks[num]&(1<<kSE)) != 0);
+				CPPUNIT_ASSERT_EQUAL(south && west && fits(x-1, y+1, capabilities[i], size), (masks[num]&(1<<kSW)) != 0);
+			}
+		}
+}
+
+bool AnnotatedMapAbstractionTest::fits(int x, int y, int capability, int agentsize)
+{
+	node* n = ama->getNodeFromMap(x, y);
+	return n && n->getClearance(capability) >= agentsize;
+}
+
 void AnnotatedMapAbstractionTest::ValidateAnnotationsTest() 
 {
 	stringstream ss;
@@ -91,22 +136,14 @@ void AnnotatedMapAbstractionTest::ValidateAnnotationsTest()
 
 void AnnotatedMapAbstractionTest::nodeClearanceIsZeroForCapabilityThatDoesNotIncludeTheNodeTerrainType()
 {
-	int nx=1;
-	int ny=2;
-	node* target = ama->getNodeFromMap(nx,ny); // node with kGround terrain and kGround neighbours
-	setupNeighbourAnnotations(nx, ny);
-	ama->annotateNode(target); 
+	node* target = ama->getNodeFromMap(1,2); // node with kGround terrain and kGround neighbours
 
 	CPPUNIT_ASSERT_EQUAL(0, target->getClearance(kTrees)); // no annotations for kTrees capability
 }
 
 void AnnotatedMapAbstractionTest::nodeClearanceZeroWhenTerrainIsHardObstacle()
 {
-	int nx=1;
-	int ny=1;
-	node* target = ama->getNodeFromMap(nx,ny); // node with kWater terrain and kGround neighbours
-	setupNeighbourAnnotations(nx, ny);
-	ama->annotateNode(target); 
+	node* target = ama->getNodeFromMap(1,1); // node with kWater terrain and kGround neighbours
 
 	/* node is not traversable by anything */
 	CPPUNIT_ASSERT_EQUAL(0, target->getClearance(kGround));
@@ -116,10 +153,7 @@ void AnnotatedMapAbstractionTest::nodeClearanceZeroWhenTerrainIsHardObstacle()
 
 void AnnotatedMapAbstractionTest::nodeClearanceMinimumClearanceWhenTerrainIsValidButNoNeighbours()
 {
-	int nx=23;
-	int ny=9;
-	node* target = ama->getNodeFromMap(nx,ny); // node with kGround terrain but no neighbours
-	ama->annotateNode(target); 
+	node* target = ama->getNodeFromMap(23,9); // node with kGround terrain but no neighbours
 
 	/* test if the node is traversable by an agent with capability that includes kGround terrain */
 	CPPUNIT_ASSERT_EQUAL(nclearance, target->getClearance(kGround));
@@ -128,11 +162,7 @@ void AnnotatedMapAbstractionTest::nodeClearanceMinimumClearanceWhenTerrainIsVali
 
 void AnnotatedMapAbstractionTest::nodeClearanceMinimumClearanceWhenTerrainIsValidButAllNeighboursHardObstacles()
 {
-	int nx=23;
-	int ny=2;
-	node* target = ama->getNodeFromMap(nx,ny); // node with kGround terrain & all kWater neighbours
-	setupNeighbourAnnotations(nx, ny);
-	ama->annotateNode(target); 
+	node* target = ama->getNodeFromMap(23,2); // node with kGround terrain & all kWater neighbours
 
 	/* test if the node is traversable by an agent with capability that includes kGround terrain */
 	CPPUNIT_ASSERT_EQUAL(nclearance, target->getClearance(kGround));
@@ -144,29 +174,108 @@ void AnnotatedMapAbstractionTest::nodeClearanceEqualsMinimumOfAllNeighboursPlusO
 	int nx=1;
 	int ny=2;
 	node* target = ama->getNodeFromMap(nx,ny); // node with kGround terrain & all kGround neighbours
-	setupNeighbourAnnotations(nx, ny);
-	ama->annotateNode(target); 
 
-	/* test if the node is traversable by an agent with capability that includes kGround terrain */
+	for(int i=0; i<NUMCAPABILITIES; i++)
+	{
+		int min = ama->getNodeFromMap(nx+1, ny)->getClearance(capabilities[i]);
+		if(ama->getNodeFromMap(nx, ny+1)->getClearance(capabilities[i]) < min)
+			min = ama->getNodeFromMap(nx, ny+1)->getClearance(capabilities[i]);
+		if(ama->getNodeFromMap(nx+1, ny+1)->getClearance(capabilities[i]) < min)
+			min = ama->getNodeFromMap(nx+1, ny+1)->getClearance(capabilities[i]);
+		if((capabilities[i]&kGround) == kGround) // the node is kGround
+			CPPUNIT_ASSERT_EQUAL(min+1, target->getClearance(capabilities[i]));
+	}
 	CPPUNIT_ASSERT_EQUAL(nclearance+1, target->getClearance(kGround));
 	CPPUNIT_ASSERT_EQUAL(nclearance+1, target->getClearance((kGround|kTrees)));
 }
 
-void AnnotatedMapAbstractionTest::setupNeighbourAnnotations(int x, int y)
+/* kWater is not one of the capabilities in AHAConstants; agents that can swim get annotations like any other */
+void AnnotatedMapAbstractionTest::capabilitiesOutsideAHAConstantsAreAnnotated()
 {
-	for(int i=0; i<NUMCAPABILITIES;i++)
-	{
-		ama->getNodeFromMap(x+1, y)->setTerrainType(ama->getMap()->getTerrainType(x+1,y));
-		ama->getNodeFromMap(x+1, y)->setClearance(capabilities[i], nclearance);
+	vector<int> caps;
+	caps.push_back(kGround);
+	caps.push_back(kWater);
+	caps.push_back((kGround|kWater));
+	AnnotatedMapAbstraction* swimmers = new AnnotatedMapAbstraction(new Map(maplocation.c_str(), true), new AnnotatedAStarMock(), caps);
+	ClearanceGrid expected(testmap, caps, 255);
+	Map obstacles(maplocation.c_str()); // loaded without terrain, water is an obstacle
+
+	CPPUNIT_ASSERT_MESSAGE("no masks returned for kWater", swimmers->getTraversalMasks(kWater, 1) != 0);
+	CPPUNIT_ASSERT_MESSAGE("no components returned for kGround|kWater", swimmers->getComponents((kGround|kWater), 1) != 0);
+
+	int numwater = 0;
+	for(int x=0; x<testmap->getMapWidth(); x++)
+		for(int y=0; y<testmap->getMapHeight(); y++)
+		{
+			node* n = swimmers->getNodeFromMap(x, y);
+			if(n == 0)
+				continue;
+			if(testmap->getTerrainType(x, y) == kWater)
+			{
+				numwater++;
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("water kept by default loader", (int)kOutOfBounds, (int)obstacles.getTerrainType(x, y));
+				CPPUNIT_ASSERT_MESSAGE("water tile not traversable by kWater", n->getClearance(kWater) > 0);
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("water tile traversable by kGround", 0, n->getClearance(kGround));
+			}
+			for(unsigned int i=0; i<caps.size(); i++)
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong clearance", expected.getClearance(x, y, caps[i]), n->getClearance(caps[i]));
+		}
+	CPPUNIT_ASSERT_MESSAGE("map has no water", numwater > 0);
 
-		ama->getNodeFromMap(x, y+1)->setTerrainType(ama->getMap()->getTerrainType(x,y+1));
-		ama->getNodeFromMap(x, y+1)->setClearance(capabilities[i], nclearance);
+	delete swimmers;
+}
 
-		ama->getNodeFromMap(x+1, y+1)->setTerrainType(ama->getMap()->getTerrainType(x+1,y+1));
-		ama->getNodeFromMap(x+1, y+1)->setClearance(capabilities[i], nclearance);
-	}
+/* nodes keep no clearance of their own; each reads (and writes) the value of its tile in the abstraction's grid */
+void AnnotatedMapAbstractionTest::nodesReadAndWriteClearanceInTheClearanceGrid()
+{
+	ClearanceGrid* grid = ama->getClearanceGrid();
+	CPPUNIT_ASSERT_MESSAGE("no clearance grid", grid != 0);
+
+	node* n = ama->getNodeFromMap(2, 1);
+	CPPUNIT_ASSERT_MESSAGE("node uses another grid", n->getClearanceGrid() == grid);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("node clearance differs from the grid", grid->getClearance(2, 1, kGround), n->getClearance(kGround));
+
+	node* copy = dynamic_cast<node*>(n->clone());
+	n->setClearance(kGround, 1);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("value not written to the grid", 1, grid->getClearance(2, 1, kGround));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("copy of the node has its own clearance", 1, copy->getClearance(kGround));
+	delete copy;
 }
 
+void AnnotatedMapAbstractionTest::constructorShouldThrowExceptionGivenNoCapabilities()
+{
+	vector<int> caps;
+	AnnotatedMapAbstraction tmp(new Map(maplocation.c_str()), new AnnotatedAStarMock(), caps);
+}
+
+/* annotating a subset of the capabilities gives the same values for that subset and no annotations for the others */
+void AnnotatedMapAbstractionTest::onlyTheGivenCapabilitiesAreAnnotated()
+{
+	vector<int> caps;
+	caps.push_back(kGround);
+	AnnotatedMapAbstraction* groundonly = new AnnotatedMapAbstraction(new Map(maplocation.c_str(), true), new AnnotatedAStarMock(), caps);
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of capabilities", (unsigned int)1, (unsigned int)groundonly->getCapabilities().size());
+	CPPUNIT_ASSERT_MESSAGE("masks returned for capability that was not annotated", groundonly->getTraversalMasks(kTrees, 1) == 0);
+	CPPUNIT_ASSERT_MESSAGE("masks returned for capability that was not annotated", groundonly->getTraversalMasks((kGround|kTrees), 1) == 0);
+	CPPUNIT_ASSERT_MESSAGE("no masks returned for annotated capability", groundonly->getTraversalMasks(kGround, 1) != 0);
+
+	for(int x=0; x<testmap->getMapWidth(); x++)
+		for(int y=0; y<testmap->getMapHeight(); y++)
+		{
+			node* expected = ama->getNodeFromMap(x, y);
+			node* actual = groundonly->getNodeFromMap(x, y);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("node sets differ", expected == 0, actual == 0);
+			if(actual == 0)
+				continue;
+
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("kGround annotations differ", expected->getClearance(kGround), actual->getClearance(kGround));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("kTrees annotated", 0, actual->getClearance(kTrees));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("kGround|kTrees annotated", 0, actual->getClearance((kGround|kTrees)));
+		}
+
+	delete groundonly;
+}
 
 void AnnotatedMapAbstractionTest::checkSingleNodeAnnotations(node* n, int x, int y)
 {
@@ -239,7 +348,7 @@ void AnnotatedMapAbstractionTest::checkSingleNodeAnnotations(node* n, int x, int
 void AnnotatedMapAbstractionTest::checkNodeAnnotationsAgainstExpectations()
 {
 		delete ama;
-		Map* m = new Map(acmap.c_str());
+		Map* m = new Map(acmap.c_str(), true);
 		ama = new AnnotatedMapAbstraction(m, new AnnotatedAStarMock());
 						
 		int clearance[6][9] = 
@@ -29,6 +29,12 @@ class AnnotatedMapAbstractionTest: public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST( PathableReturnsTrueWhenValidPathExistsForLargeSingleTerrainAgent );
 	CPPUNIT_TEST( PathableReturnsFalseWhenNoValidPathExistsForLargeSingleTerrainAgent );
 	CPPUNIT_TEST( checkNodeAnnotationsAgainstExpectations );
+	CPPUNIT_TEST( getTraversalMasksReturnsNullGivenUnsupportedCapabilityOrAgentSize );
+	CPPUNIT_TEST( traversalMasksAllowOnlyMovesToNodesWithSufficientClearance );
+	CPPUNIT_TEST( capabilitiesOutsideAHAConstantsAreAnnotated );
+	CPPUNIT_TEST( nodesReadAndWriteClearanceInTheClearanceGrid );
+	CPPUNIT_TEST_EXCEPTION( constructorShouldThrowExceptionGivenNoCapabilities, std::invalid_argument );
+	CPPUNIT_TEST( onlyTheGivenCapabilitiesAreAnnotated );
 	
 	CPPUNIT_TEST_SUITE_END();
 
@@ -44,6 +50,12 @@ class AnnotatedMapAbstractionTest: public CPPUNIT_NS::TestFixture
 		
 		void ValidateAnnotationsTest();	
 		void checkNodeAnnotationsAgainstExpectations();
+		void getTraversalMasksReturnsNullGivenUnsupportedCapabilityOrAgentSize();
+		void traversalMasksAllowOnlyMovesToNodesWithSufficientClearance();
+		void capabilitiesOutsideAHAConstantsAreAnnotated();
+		void nodesReadAndWriteClearanceInTheClearanceGrid();
+		void constructorShouldThrowExceptionGivenNoCapabilities();
+		void onlyTheGivenCapabilitiesAreAnnotated();
 
 		void PathableReturnsTrueWhenValidPathExistsForLargeSingleTerrainAgent();
 		void PathableReturnsFalseWhenNoValidPathExistsForLargeSingleTerrainAgent();
@@ -51,7 +63,7 @@ class AnnotatedMapAbstractionTest: public CPPUNIT_NS::TestFixture
 	private:
 		void runExperiment(ExpMgrUtil::ExperimentKey);
 		void checkSingleNodeAnnotations(node*, int, int);
-		void setupNeighbourAnnotations(int x, int y);
+		bool fits(int x, int y, int capability, int agentsize);
 
 		AnnotatedMapAbstraction *ama;
 		ExperimentManager* expmgr;
@@ -0,0 +1,112 @@
+/*
+ *  ClearanceGridTest.cpp
+ *  hog
+ *
+ *  Created on 17/10/2026.
+ *
+ */
+
+#include "ClearanceGridTest.h"
+#include "ClearanceGrid.h"
+#include "TestConstants.h"
+#include "AHAConstants.h"
+#include "map.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ClearanceGridTest );
+
+void ClearanceGridTest::setUp()
+{
+	testmap = new Map(maplocation.c_str());
+	caps = std::vector<int>(capabilities, capabilities+NUMCAPABILITIES);
+}
+
+void ClearanceGridTest::tearDown()
+{
+	delete testmap;
+	caps.clear();
+}
+
+void ClearanceGridTest::constructorShouldThrowExceptionGivenNoCapabilities()
+{
+	std::vector<int> nocaps;
+	ClearanceGrid cg(testmap, nocaps, MAXAGENTSIZE);
+}
+
+void ClearanceGridTest::constructorShouldThrowExceptionGivenInvalidMaxAgentSize()
+{
+	ClearanceGrid cg(testmap, caps, 256);
+}
+
+void ClearanceGridTest::constructorShouldThrowExceptionGivenNullMap()
+{
+	ClearanceGrid cg(0, caps, MAXAGENTSIZE);
+}
+
+void ClearanceGridTest::clearanceIsZeroForCapabilityThatDoesNotIncludeTileTerrainType()
+{
+	ClearanceGrid cg(testmap, caps, 255);
+	for(int x=0; x<testmap->getMapWidth(); x++)
+		for(int y=0; y<testmap->getMapHeight(); y++)
+		{
+			int terrain = testmap->getTerrainType(x, y);
+			for(unsigned int i=0; i<caps.size(); i++)
+				if((caps[i]&terrain) != terrain || terrain == 0)
+					CPPUNIT_ASSERT_EQUAL_MESSAGE("non-zero clearance for non-traversable tile", 
+							0, cg.getClearance(x, y, caps[i]));
+		}
+}
+
+void ClearanceGridTest::clearanceIsZeroForUnknownCapabilityOrTileOutsideMap()
+{
+	ClearanceGrid cg(testmap, caps, 255);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("non-zero clearance for unknown capability", 
+			0, cg.getClearance(1, 1, kSwamp));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("non-zero clearance for tile outside map", 
+			0, cg.getClearance(-1, 0, kGround));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("non-zero clearance for tile outside map", 
+			0, cg.getClearance(0, testmap->getMapHeight(), kGround));
+}
+
+void ClearanceGridTest::clearanceEqualsSizeOfLargestSquareWithTileAsTopLeftCorner()
+{
+	ClearanceGrid cg(testmap, caps, 255);
+	for(int x=0; x<testmap->getMapWidth(); x++)
+		for(int y=0; y<testmap->getMapHeight(); y++)
+			for(unsigned int i=0; i<caps.size(); i++)
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("clearance value does not match largest obstacle-free square", 
+						largestSquare(x, y, caps[i], 255), cg.getClearance(x, y, caps[i]));
+}
+
+void ClearanceGridTest::clearanceIsCappedAtMaximumAgentSize()
+{
+	ClearanceGrid cg(testmap, caps, MAXAGENTSIZE);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("maximum agent size not stored", MAXAGENTSIZE, cg.getMaxAgentSize());
+	for(int x=0; x<testmap->getMapWidth(); x++)
+		for(int y=0; y<testmap->getMapHeight(); y++)
+			for(unsigned int i=0; i<caps.size(); i++)
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("clearance value not capped at maximum agent size", 
+						largestSquare(x, y, caps[i], MAXAGENTSIZE), cg.getClearance(x, y, caps[i]));
+}
+
+int ClearanceGridTest::largestSquare(int x, int y, int capability, int limit)
+{
+	int size = 0;
+	while(size < limit)
+	{
+		for(int i=0; i<=size; i++)
+		{
+			if(!traversable(x+size, y+i, capability) || !traversable(x+i, y+size, capability))
+				return size;
+		}
+		size++;
+	}
+	return size;
+}
+
+bool ClearanceGridTest::traversable(int x, int y, int capability)
+{
+	if(x < 0 || x >= testmap->getMapWidth() || y < 0 || y >= testmap->getMapHeight())
+		return false;
+	int terrain = testmap->getTerrainType(x, y);
+	return terrain != 0 && (capability&terrain) == terrain;
+}
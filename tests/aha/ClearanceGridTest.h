@@ -0,0 +1,51 @@
+/*
+ *  ClearanceGridTest.h
+ *  hog
+ *
+ *  Created on 17/10/2026.
+ *
+ */
+
+#ifndef CLEARANCEGRIDTEST_H
+#define CLEARANCEGRIDTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <stdexcept>
+#include <vector>
+
+class Map;
+class ClearanceGridTest: public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ClearanceGridTest );
+	CPPUNIT_TEST_EXCEPTION( constructorShouldThrowExceptionGivenNoCapabilities, std::invalid_argument );
+	CPPUNIT_TEST_EXCEPTION( constructorShouldThrowExceptionGivenInvalidMaxAgentSize, std::invalid_argument );
+	CPPUNIT_TEST_EXCEPTION( constructorShouldThrowExceptionGivenNullMap, std::invalid_argument );
+	CPPUNIT_TEST( clearanceIsZeroForCapabilityThatDoesNotIncludeTileTerrainType );
+	CPPUNIT_TEST( clearanceIsZeroForUnknownCapabilityOrTileOutsideMap );
+	CPPUNIT_TEST( clearanceEqualsSizeOfLargestSquareWithTileAsTopLeftCorner );
+	CPPUNIT_TEST( clearanceIsCappedAtMaximumAgentSize );
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void constructorShouldThrowExceptionGivenNoCapabilities();
+		void constructorShouldThrowExceptionGivenInvalidMaxAgentSize();
+		void constructorShouldThrowExceptionGivenNullMap();
+		void clearanceIsZeroForCapabilityThatDoesNotIncludeTileTerrainType();
+		void clearanceIsZeroForUnknownCapabilityOrTileOutsideMap();
+		void clearanceEqualsSizeOfLargestSquareWithTileAsTopLeftCorner();
+		void clearanceIsCappedAtMaximumAgentSize();
+
+	private:
+		int largestSquare(int x, int y, int capability, int limit);
+		bool traversable(int x, int y, int capability);
+
+		Map* testmap;
+		std::vector<int> caps;
+};
+
+#endif
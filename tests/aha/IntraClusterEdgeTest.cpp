@@ -0,0 +1,178 @@
+/*
+ *  IntraClusterEdgeTest.cpp
+ *  hog
+ *
+ *  Created on 17/10/2026.
+ *
+ */
+
+#include "IntraClusterEdgeTest.h"
+#include "AnnotatedClusterAbstraction.h"
+#include "AnnotatedClusterFactory.h"
+#include "AnnotatedAStar.h"
+#include "AHAConstants.h"
+#include "TestConstants.h"
+#include "WorkerThreads.h"
+#include "graph.h"
+#include "path.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( IntraClusterEdgeTest );
+
+void IntraClusterEdgeTest::setUp()
+{
+	aca = new AnnotatedClusterAbstraction(new Map(maplocation.c_str(), true), new AnnotatedAStar(), TESTCLUSTERSIZE);
+	AnnotatedClusterFactory acfactory;
+	aca->buildClusters(&acfactory);
+	aca->buildEntrances();
+
+	aastar = new AnnotatedAStar();
+	aastar->limitSearchToClusterCorridor(true);
+}
+
+void IntraClusterEdgeTest::tearDown()
+{
+	delete aastar;
+	delete aca;
+}
+
+/* the edge weight of every intra-cluster edge is the cost of the best path between its endpoints for the edge's 
+   capability and clearance */
+void IntraClusterEdgeTest::intraClusterEdgeWeightsEqualTheCostOfACorridorSearch()
+{
+	graph* absg = aca->getAbstractGraph(1);
+	int intraedges = 0;
+	edge_iterator ei = absg->getEdgeIter();
+	for(edge* e = absg->edgeIterNext(ei); e; e = absg->edgeIterNext(ei))
+	{
+		node* from = absg->getNode(e->getFrom());
+		node* to = absg->getNode(e->getTo());
+		if(from->getParentCluster() != to->getParentCluster())
+			continue;
+
+		int capability = e->getCapability();
+		path* p = findPathInCluster(from, to, capability, e->getClearance(capability));
+		CPPUNIT_ASSERT_MESSAGE("no path between the endpoints of an intra-cluster edge", p != 0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("intra-cluster edge weight differs from the cost of a corridor search", 
+				aca->distance(p), e->getWeight(), 0.001);
+		delete p;
+		intraedges++;
+	}
+	CPPUNIT_ASSERT_MESSAGE("no intra-cluster edges built", intraedges > 0);
+}
+
+/* for every capability and size that can travel between two endpoints without leaving their cluster, an edge at least 
+   as good as the best path exists */
+void IntraClusterEdgeTest::everyPairOfEndpointsConnectedInsideAClusterHasAnEdge()
+{
+	for(int cid=0; cid<aca->getNumClusters(); cid++)
+	{
+		AnnotatedCluster* ac = aca->getCluster(cid);
+		for(unsigned int i=0; i<ac->getParents().size(); i++)
+			for(unsigned int j=i+1; j<ac->getParents().size(); j++)
+			{
+				node* n1 = ac->getParents()[i];
+				node* n2 = ac->getParents()[j];
+				for(int capindex=0; capindex<NUMCAPABILITIES; capindex++)
+					for(int sizeindex=0; sizeindex<NUMAGENTSIZES; sizeindex++)
+					{
+						int capability = capabilities[capindex];
+						int size = agentsizes[sizeindex];
+						path* p = findPathInCluster(n1, n2, capability, size);
+						if(p == 0)
+							continue;
+
+						CPPUNIT_ASSERT_MESSAGE("no intra-cluster edge between endpoints connected inside their cluster", 
+								n1->findAnnotatedEdge(n2, capability, size, aca->distance(p)) != 0);
+						delete p;
+					}
+			}
+	}
+}
+
+/* recorded from the abstraction built with one corridor search per pair of endpoints, capability and size */
+void IntraClusterEdgeTest::abstractGraphMatchesTheGraphBuiltWithOneSearchPerPair()
+{
+	graph* absg = aca->getAbstractGraph(1);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract nodes", 33, absg->getNumNodes());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract edges", 75, absg->getNumEdges());
+
+	double totalweight = 0;
+	edge_iterator ei = absg->getEdgeIter();
+	for(edge* e = absg->edgeIterNext(ei); e; e = absg->edgeIterNext(ei))
+		totalweight += e->getWeight();
+	CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("wrong total edge weight", 217.397, totalweight, 0.001);
+}
+
+/* tiles with hard obstacles have no nodes; clusters and entrances must be built around them */
+void IntraClusterEdgeTest::clustersOnAMapWithHardObstaclesAreBuilt()
+{
+	AnnotatedClusterAbstraction* obstacles = new AnnotatedClusterAbstraction(new Map(maplocation.c_str()), 
+			new AnnotatedAStar(), TESTCLUSTERSIZE);
+	AnnotatedClusterFactory acfactory;
+	obstacles->buildClusters(&acfactory);
+	obstacles->buildEntrances();
+
+	CPPUNIT_ASSERT_MESSAGE("no entrances built", obstacles->getAbstractGraph(1)->getNumEdges() > 0);
+	delete obstacles;
+}
+
+/* clusters are searched on worker threads; the abstract graph, down to the order of its edges, is the same whatever 
+   their number */
+void IntraClusterEdgeTest::abstractGraphDoesNotDependOnTheNumberOfThreads()
+{
+	int threads = WorkerThreads::getNumThreads();
+	for(int lowquality=0; lowquality<2; lowquality++)
+	{
+		AnnotatedClusterAbstraction* one = buildWithThreads(1, lowquality);
+		AnnotatedClusterAbstraction* four = buildWithThreads(4, lowquality);
+		assertSameGraphs(one, four);
+		delete one;
+		delete four;
+	}
+	WorkerThreads::setNumThreads(threads);
+}
+
+AnnotatedClusterAbstraction* IntraClusterEdgeTest::buildWithThreads(int numthreads, bool lowquality)
+{
+	WorkerThreads::setNumThreads(numthreads);
+	AnnotatedClusterAbstraction* abs = new AnnotatedClusterAbstraction(new Map(maplocation.c_str(), true), new AnnotatedAStar(), 
+			TESTCLUSTERSIZE, lowquality?ACAUtil::kLowQualityAbstraction:ACAUtil::kHighQualityAbstraction);
+	AnnotatedClusterFactory acfactory;
+	abs->buildClusters(&acfactory);
+	abs->buildEntrances();
+	return abs;
+}
+
+void IntraClusterEdgeTest::assertSameGraphs(AnnotatedClusterAbstraction* expected, AnnotatedClusterAbstraction* actual)
+{
+	graph* g1 = expected->getAbstractGraph(1);
+	graph* g2 = actual->getAbstractGraph(1);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract nodes", g1->getNumNodes(), g2->getNumNodes());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract edges", g1->getNumEdges(), g2->getNumEdges());
+	for(int i=0; i<g1->getNumNodes(); i++)
+	{
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("abstract node moved", g1->getNode(i)->getLabelL(kFirstData), g2->getNode(i)->getLabelL(kFirstData));
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("abstract node moved", g1->getNode(i)->getLabelL(kFirstData+1), g2->getNode(i)->getLabelL(kFirstData+1));
+	}
+
+	edge_iterator ei1 = g1->getEdgeIter();
+	edge_iterator ei2 = g2->getEdgeIter();
+	edge* e2 = g2->edgeIterNext(ei2);
+	for(edge* e1 = g1->edgeIterNext(ei1); e1; e1 = g1->edgeIterNext(ei1), e2 = g2->edgeIterNext(ei2))
+	{
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("edges differ", e1->getFrom(), e2->getFrom());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("edges differ", e1->getTo(), e2->getTo());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("edge capabilities differ", e1->getCapability(), e2->getCapability());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("edge clearances differ", e1->getClearance(e1->getCapability()), e2->getClearance(e2->getCapability()));
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("edge weights differ", e1->getWeight(), e2->getWeight(), 0.001);
+	}
+}
+
+path* IntraClusterEdgeTest::findPathInCluster(node* absfrom, node* absto, int capability, int size)
+{
+	node* from = aca->getNodeFromMap(absfrom->getLabelL(kFirstData), absfrom->getLabelL(kFirstData+1));
+	node* to = aca->getNodeFromMap(absto->getLabelL(kFirstData), absto->getLabelL(kFirstData+1));
+	aastar->setCapability(capability);
+	aastar->setClearance(size);
+	return aastar->getPath(aca, from, to);
+}
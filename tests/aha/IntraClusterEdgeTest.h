@@ -0,0 +1,52 @@
+/*
+ *  IntraClusterEdgeTest.h
+ *  hog
+ *
+	Checks the intra-cluster edges that AnnotatedCluster builds between entrance endpoints against separate 
+	corridor-limited searches between every pair of endpoints.
+ 
+ *  Created on 17/10/2026.
+ *
+ */
+
+#ifndef INTRACLUSTEREDGETEST_H
+#define INTRACLUSTEREDGETEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class AnnotatedClusterAbstraction;
+class AnnotatedAStar;
+class node;
+class path;
+
+class IntraClusterEdgeTest: public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( IntraClusterEdgeTest );
+	CPPUNIT_TEST( intraClusterEdgeWeightsEqualTheCostOfACorridorSearch );
+	CPPUNIT_TEST( everyPairOfEndpointsConnectedInsideAClusterHasAnEdge );
+	CPPUNIT_TEST( abstractGraphMatchesTheGraphBuiltWithOneSearchPerPair );
+	CPPUNIT_TEST( clustersOnAMapWithHardObstaclesAreBuilt );
+	CPPUNIT_TEST( abstractGraphDoesNotDependOnTheNumberOfThreads );
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void intraClusterEdgeWeightsEqualTheCostOfACorridorSearch();
+		void everyPairOfEndpointsConnectedInsideAClusterHasAnEdge();
+		void abstractGraphMatchesTheGraphBuiltWithOneSearchPerPair();
+		void clustersOnAMapWithHardObstaclesAreBuilt();
+		void abstractGraphDoesNotDependOnTheNumberOfThreads();
+
+	private:
+		path* findPathInCluster(node* absfrom, node* absto, int capability, int size);
+		AnnotatedClusterAbstraction* buildWithThreads(int numthreads, bool lowquality);
+		void assertSameGraphs(AnnotatedClusterAbstraction* expected, AnnotatedClusterAbstraction* actual);
+
+		AnnotatedClusterAbstraction* aca;
+		AnnotatedAStar* aastar;
+};
+
+#endif
@@ -12,6 +12,7 @@
 #include "TestConstants.h"
 
 #include "HPAClusterFactory.h"
+#include "ClusterNode.h"
 #include "ClusterNodeFactory.h"
 #include "ClusterAStarFactory.h"
 #include "EdgeFactory.h"
@@ -23,6 +24,7 @@
 #include "ClusterAStarMock.h"
 #include "NodeMock.h"
 #include <mockpp/chaining/ChainingMockObjectSupport.h>
+#include <vector>
 
 CPPUNIT_TEST_SUITE_REGISTRATION( HPAClusterAbstractionTest );
 
@@ -66,6 +68,47 @@ void HPAClusterAbstractionTest::buildClustersShouldCalculateCorrectClusterSize()
 	}
 }
 
+void HPAClusterAbstractionTest::buildClustersShouldCoverOpenAreasWithLargeClustersWhenAdaptiveClustersAreEnabled()
+{
+	HPAClusterAbstraction hpacaMap(new Map(emptymap.c_str()),  cf, nf, ef);
+	hpacaMap.setClusterSize(TESTCLUSTERSIZE);
+	hpacaMap.setAdaptiveClusters(true);
+	hpacaMap.buildClusters();
+	hpacaMap.buildEntrances();
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("open map split into several clusters", 
+			1, hpacaMap.getNumClusters());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("single cluster has entrances", 
+			0, hpacaMap.getAbstractGraph(1)->getNumNodes());
+}
+
+void HPAClusterAbstractionTest::buildClustersShouldAssignEveryNodeToAClusterWhenAdaptiveClustersAreEnabled()
+{
+	HPAClusterAbstraction hpacaMap(new Map(acmap.c_str()),  cf, nf, ef);
+	hpacaMap.setClusterSize(TESTCLUSTERSIZE);
+	hpacaMap.setAdaptiveClusters(true);
+	hpacaMap.buildClusters();
+
+	int numNodes = 0;
+	cluster_iterator it = hpacaMap.getClusterIter();
+	AbstractCluster* cluster = hpacaMap.clusterIterNext(it);
+	while(cluster)
+	{
+		numNodes += cluster->getNumNodes();
+		cluster = hpacaMap.clusterIterNext(it);
+	}
+
+	graph* g = hpacaMap.getAbstractGraph(0);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("clusters overlap or leave nodes unassigned", 
+			g->getNumNodes(), numNodes);
+	for(int i=0; i<g->getNumNodes(); i++)
+	{
+		ClusterNode* n = dynamic_cast<ClusterNode*>(g->getNode(i));
+		CPPUNIT_ASSERT_MESSAGE("node not assigned to any cluster", 
+				n->getParentClusterId() != -1);
+	}
+}
+
 void HPAClusterAbstractionTest::constructorShouldSetDefaultClusterSizeTo10()
 {
 	HPAClusterAbstraction hpacaMap(new Map(acmap.c_str()),  cf, nf, ef);
@@ -490,3 +533,183 @@ void HPAClusterAbstractionTest::buildEntrancesCallsBuildEntranceMethodOnEachClus
 	c1->verify();
 	c2->verify();
 }
+
+void HPAClusterAbstractionTest::closeTileShouldRemoveNodeFromMapAndQueueItsClusterForRepair()
+{
+	HPAClusterAbstraction hpacaMap(new Map(emptymap.c_str()),  cf, nf, ef);
+	hpacaMap.setClusterSize(TESTCLUSTERSIZE);
+	hpacaMap.buildClusters();
+	hpacaMap.buildEntrances();
+
+	int numNodes = hpacaMap.getAbstractGraph(0)->getNumNodes();
+	hpacaMap.closeTile(4,2);
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("closed tile still has a node in the map graph", 
+			true, hpacaMap.getNodeFromMap(4,2) == 0);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of nodes in map graph", 
+			numNodes-1, hpacaMap.getAbstractGraph(0)->getNumNodes());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of clusters queued for repair", 
+			1, hpacaMap.getNumClustersToRepair());
+
+	hpacaMap.repairAbstraction();
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("repair queue not empty after repairAbstraction", 
+			0, hpacaMap.getNumClustersToRepair());
+}
+
+void HPAClusterAbstractionTest::repairAbstractionShouldRestoreAbstractGraphWhenAClosedTileIsReopened()
+{
+	HPAClusterAbstraction hpacaMap(new Map(emptymap.c_str()),  cf, nf, ef);
+	hpacaMap.setClusterSize(TESTCLUSTERSIZE);
+	hpacaMap.buildClusters();
+	hpacaMap.buildEntrances();
+
+	graph* absg = hpacaMap.getAbstractGraph(1);
+	int numAbstractNodes = absg->getNumNodes();
+	int numAbstractEdges = absg->getNumEdges();
+	int cacheSize = hpacaMap.getPathCacheSize();
+
+	// (4,2) is the endpoint of an entrance; closing it splits the entrance
+	hpacaMap.closeTile(4,2);
+	hpacaMap.repairAbstraction();
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("entrance not split after closing tile", 
+			numAbstractNodes+2, absg->getNumNodes());
+
+	hpacaMap.openTile(4,2);
+	hpacaMap.repairAbstraction();
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract nodes after repair", 
+			numAbstractNodes, absg->getNumNodes());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract edges after repair", 
+			numAbstractEdges, absg->getNumEdges());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of cached paths after repair", 
+			cacheSize, hpacaMap.getPathCacheSize());
+}
+
+void HPAClusterAbstractionTest::buildEntrancesShouldCreateUnresolvedIntraEdgesWhenLazyIntraEdgesAreEnabled()
+{
+	HPAClusterAbstraction eager(new Map(emptymap.c_str()),  cf, nf, ef);
+	eager.setClusterSize(TESTCLUSTERSIZE);
+	eager.buildClusters();
+	eager.buildEntrances();
+
+	HPAClusterAbstraction lazy(new Map(emptymap.c_str()),  
+			new HPAClusterFactory(), new ClusterNodeFactory(), new EdgeFactory());
+	lazy.setClusterSize(TESTCLUSTERSIZE);
+	lazy.setLazyIntraEdges(true);
+	lazy.buildClusters();
+	lazy.buildEntrances();
+
+	graph* absg = lazy.getAbstractGraph(1);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract nodes", 
+			eager.getAbstractGraph(1)->getNumNodes(), absg->getNumNodes());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract edges", 
+			eager.getAbstractGraph(1)->getNumEdges(), absg->getNumEdges());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("intra-edge paths computed during build", 
+			0, lazy.getPathCacheSize());
+
+	int numUnresolved = 0;
+	edge_iterator it = absg->getEdgeIter();
+	for(edge* e = absg->edgeIterNext(it); e != 0; e = absg->edgeIterNext(it))
+	{
+		if(lazy.isResolved(e))
+			continue;
+
+		numUnresolved++;
+		node* from = absg->getNode(e->getFrom());
+		node* to = absg->getNode(e->getTo());
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("unresolved edge not weighted "
+				"with lower bound", lazy.h(from, to), e->getWeight(), 0.0001);
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("unresolved mark written over the edge "
+				"capacity label", (long)MAXINT, e->getLabelL(kEdgeCapacity));
+	}
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of unresolved edges", 
+			eager.getPathCacheSize(), numUnresolved);
+}
+
+void HPAClusterAbstractionTest::resolveEdgeShouldReplaceLowerBoundWithCostOfShortestIntraClusterPath()
+{
+	HPAClusterAbstraction eager(new Map(acmap.c_str()),  cf, nf, ef);
+	eager.setClusterSize(TESTCLUSTERSIZE);
+	eager.buildClusters();
+	eager.buildEntrances();
+
+	HPAClusterAbstraction lazy(new Map(acmap.c_str()),  
+			new HPAClusterFactory(), new ClusterNodeFactory(), new EdgeFactory());
+	lazy.setClusterSize(TESTCLUSTERSIZE);
+	lazy.setLazyIntraEdges(true);
+	lazy.buildClusters();
+	lazy.buildEntrances();
+
+	graph* absg = lazy.getAbstractGraph(1);
+	graph* eagerg = eager.getAbstractGraph(1);
+	edge_iterator it = absg->getEdgeIter();
+	for(edge* e = absg->edgeIterNext(it); e != 0; e = absg->edgeIterNext(it))
+	{
+		bool resolved = lazy.isResolved(e);
+		lazy.resolveEdge(e);
+		CPPUNIT_ASSERT_MESSAGE("edge not resolved", lazy.isResolved(e));
+		if(!resolved)
+			CPPUNIT_ASSERT_MESSAGE("resolved edge has no cached path", 
+					lazy.getPathFromCache(e) != 0);
+
+		// abstract nodes are created in the same order by both abstractions
+		edge* expected = eagerg->findEdge(e->getFrom(), e->getTo());
+		CPPUNIT_ASSERT_MESSAGE("edge missing from eagerly built graph", 
+				expected != 0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("wrong weight for resolved edge", 
+				expected->getWeight(), e->getWeight(), 0.0001);
+	}
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of cached paths", 
+			eager.getPathCacheSize(), lazy.getPathCacheSize());
+}
+
+// all-pairs shortest distances in a (small) graph 
+static std::vector<std::vector<double> > allPairsDistances(graph* g)
+{
+	int n = g->getNumNodes();
+	std::vector<std::vector<double> > dist(n, std::vector<double>(n, MAXINT));
+	for(int i=0; i<n; i++)
+		dist[i][i] = 0;
+
+	edge_iterator it = g->getEdgeIter();
+	for(edge* e = g->edgeIterNext(it); e != 0; e = g->edgeIterNext(it))
+	{
+		if(e->getWeight() < dist[e->getFrom()][e->getTo()])
+		{
+			dist[e->getFrom()][e->getTo()] = e->getWeight();
+			dist[e->getTo()][e->getFrom()] = e->getWeight();
+		}
+	}
+
+	for(int k=0; k<n; k++)
+		for(int i=0; i<n; i++)
+			for(int j=0; j<n; j++)
+				if(dist[i][k] + dist[k][j] < dist[i][j])
+					dist[i][j] = dist[i][k] + dist[k][j];
+	return dist;
+}
+
+void HPAClusterAbstractionTest::pruneDominatedEdgesShouldRemoveEdgesWithoutChangingAbstractDistances()
+{
+	HPAClusterAbstraction hpacaMap(new Map(hpaentrancetest.c_str()),  cf, nf, ef);
+	hpacaMap.setClusterSize(TESTCLUSTERSIZE);
+	hpacaMap.buildClusters();
+	hpacaMap.buildEntrances();
+
+	graph* absg = hpacaMap.getAbstractGraph(1);
+	int numAbstractEdges = absg->getNumEdges();
+	int cacheSize = hpacaMap.getPathCacheSize();
+	std::vector<std::vector<double> > before = allPairsDistances(absg);
+
+	int numPruned = hpacaMap.pruneDominatedEdges();
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of edges pruned", 1, numPruned);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("edge count not reduced", 
+			numAbstractEdges - numPruned, absg->getNumEdges());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("cached path of pruned edge not deleted", 
+			cacheSize - numPruned, hpacaMap.getPathCacheSize());
+
+	std::vector<std::vector<double> > after = allPairsDistances(absg);
+	for(unsigned int i=0; i<before.size(); i++)
+		for(unsigned int j=0; j<before.size(); j++)
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("abstract distance changed", 
+					before[i][j], after[i][j], 0.0001);
+}
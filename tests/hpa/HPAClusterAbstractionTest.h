@@ -29,6 +29,8 @@ class HPAClusterAbstractionTest : public CPPUNIT_NS::TestFixture
 	
 	CPPUNIT_TEST( buildClustersShouldSplitTheMapAreaIntoCorrectNumberOfClusters );
 	CPPUNIT_TEST( buildClustersShouldCalculateCorrectClusterSize );
+	CPPUNIT_TEST( buildClustersShouldCoverOpenAreasWithLargeClustersWhenAdaptiveClustersAreEnabled );
+	CPPUNIT_TEST( buildClustersShouldAssignEveryNodeToAClusterWhenAdaptiveClustersAreEnabled );
 	
 	CPPUNIT_TEST( getClusterShouldReturnZeroWhenIdParameterIsLessThanZero );
 	CPPUNIT_TEST( getClusterShouldReturnZeroWhenIdParameterIsGreaterThanNumberOfClusters );
@@ -50,6 +52,14 @@ class HPAClusterAbstractionTest : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST( insertStartAndGoalNodesIntoAbstractGraphShouldNotCreateNewAbstractNodesIfASuitableNodeAlreadyExistsInTheAbstractGraph );
 	
 	CPPUNIT_TEST( buildEntrancesCallsBuildEntranceMethodOnEachCluster );
+
+	CPPUNIT_TEST( closeTileShouldRemoveNodeFromMapAndQueueItsClusterForRepair );
+	CPPUNIT_TEST( repairAbstractionShouldRestoreAbstractGraphWhenAClosedTileIsReopened );
+
+	CPPUNIT_TEST( buildEntrancesShouldCreateUnresolvedIntraEdgesWhenLazyIntraEdgesAreEnabled );
+	CPPUNIT_TEST( resolveEdgeShouldReplaceLowerBoundWithCostOfShortestIntraClusterPath );
+
+	CPPUNIT_TEST( pruneDominatedEdgesShouldRemoveEdgesWithoutChangingAbstractDistances );
 	
 /*	CPPUNIT_TEST( hShouldProduceIdenticalResultsToOverriddenMethodInMapAbstractionGivenTwoValidNodeParameters );
 	CPPUNIT_TEST_EXCEPTION( hShouldThrowExceptionGivenANullNodeParameter, NodeIsNullException );
@@ -68,6 +78,8 @@ class HPAClusterAbstractionTest : public CPPUNIT_NS::TestFixture
 		
 		void buildClustersShouldSplitTheMapAreaIntoCorrectNumberOfClusters();
 		void buildClustersShouldCalculateCorrectClusterSize();
+		void buildClustersShouldCoverOpenAreasWithLargeClustersWhenAdaptiveClustersAreEnabled();
+		void buildClustersShouldAssignEveryNodeToAClusterWhenAdaptiveClustersAreEnabled();
 		
 		void getClusterSizeShouldReturnSameValueAsConstructorParameter();		
 		void getClusterShouldReturnZeroWhenIdParameterIsLessThanZero();
@@ -89,6 +101,14 @@ class HPAClusterAbstractionTest : public CPPUNIT_NS::TestFixture
 		void insertStartAndGoalNodesIntoAbstractGraphShouldNotCreateNewAbstractNodesIfASuitableNodeAlreadyExistsInTheAbstractGraph();
 		
 		void buildEntrancesCallsBuildEntranceMethodOnEachCluster();
+
+		void closeTileShouldRemoveNodeFromMapAndQueueItsClusterForRepair();
+		void repairAbstractionShouldRestoreAbstractGraphWhenAClosedTileIsReopened();
+
+		void buildEntrancesShouldCreateUnresolvedIntraEdgesWhenLazyIntraEdgesAreEnabled();
+		void resolveEdgeShouldReplaceLowerBoundWithCostOfShortestIntraClusterPath();
+
+		void pruneDominatedEdgesShouldRemoveEdgesWithoutChangingAbstractDistances();
 		
 
 	private:
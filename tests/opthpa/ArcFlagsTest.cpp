@@ -0,0 +1,176 @@
+#include "ArcFlagsTest.h"
+
+#include "ArcFlags.h"
+#include "ArcFlagsFilter.h"
+#include "ClusterNodeFactory.h"
+#include "EdgeFactory.h"
+#include "FlexibleAStar.h"
+#include "HPAClusterAbstraction.h"
+#include "HPAClusterFactory.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "OctileHeuristic.h"
+#include "PathComparison.h"
+#include "WorkerThreads.h"
+#include "graph.h"
+#include "map.h"
+#include "path.h"
+#include "TestConstants.h"
+#include <cstdio>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ArcFlagsTest );
+
+void ArcFlagsTest::setUp()
+{
+	map = new HPAClusterAbstraction(new Map(deadendtest.c_str()), 
+			new HPAClusterFactory(), new ClusterNodeFactory(), 
+			new EdgeFactory());
+	map->setClusterSize(5);
+	map->buildClusters();
+	flags = new ArcFlags(map);
+	flags->build();
+}
+
+void ArcFlagsTest::tearDown()
+{
+	delete flags;
+	delete map;
+}
+
+void ArcFlagsTest::constructorThrowsExceptionGivenANullMapAbstraction()
+{
+	ArcFlags f(0);
+}
+
+void ArcFlagsTest::buildFlagsArcsWithinAClusterForThatCluster()
+{
+	CPPUNIT_ASSERT_MESSAGE("no flags built", flags->isBuilt());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of regions", 
+			(unsigned int)map->getNumClusters(), flags->getNumRegions());
+
+	graph* g = map->getAbstractGraph(0);
+	edge_iterator ei = g->getEdgeIter();
+	for(edge* e = g->edgeIterNext(ei); e; e = g->edgeIterNext(ei))
+	{
+		node* from = g->getNode(e->getFrom());
+		node* to = g->getNode(e->getTo());
+		int region = flags->getRegion(from);
+		if(region != flags->getRegion(to))
+			continue;
+		CPPUNIT_ASSERT_MESSAGE("arc within a cluster not flagged for it", 
+				flags->isFlagged(from, to, region));
+		CPPUNIT_ASSERT_MESSAGE("arc within a cluster not flagged for it", 
+				flags->isFlagged(to, from, region));
+	}
+	CPPUNIT_ASSERT_MESSAGE("flag sets not shared between arcs", 
+			flags->getNumFlagSets() < flags->getNumArcs());
+}
+
+// the room (x 10-14, y 0-9) is entered only at (9, 2); moving further into
+// it never helps to reach a goal outside.
+void ArcFlagsTest::buildDoesNotFlagArcsWhichLeadAwayFromTheGoal()
+{
+	node* from = map->getNodeFromMap(12, 5);
+	node* to = map->getNodeFromMap(13, 5);
+	int region = flags->getRegion(map->getNodeFromMap(0, 2));
+	CPPUNIT_ASSERT_MESSAGE("arc leading away from the goal is flagged", 
+			!flags->isFlagged(from, to, region));
+	CPPUNIT_ASSERT_MESSAGE("arc leading towards the goal not flagged", 
+			flags->isFlagged(to, from, region));
+	CPPUNIT_ASSERT_MESSAGE("arc not flagged when there is no goal region", 
+			flags->isFlagged(from, to, ArcFlags::kNoRegion));
+}
+
+void ArcFlagsTest::searchWithFilterExpandsFewerNodesAndFindsOptimalPaths()
+{
+	ArcFlags af(map);
+	af.build();
+	IncidentEdgesExpansionPolicy* policy = new IncidentEdgesExpansionPolicy(map);
+	policy->addFilter(new ArcFlagsFilter(&af));
+	FlexibleAStar pruned(policy, new OctileHeuristic());
+	FlexibleAStar astar(new IncidentEdgesExpansionPolicy(map), 
+			new OctileHeuristic());
+
+	// the room lies between these two locations; without the flags
+	// the search is drawn into it.
+	node* start = map->getNodeFromMap(0, 2);
+	node* goal = map->getNodeFromMap(19, 2);
+	path* p1 = astar.getPath(map, start, goal);
+	long expanded = astar.getNodesExpanded();
+	path* p2 = pruned.getPath(map, start, goal);
+	CPPUNIT_ASSERT_MESSAGE("no path found with the flags", p2 != 0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("path with the flags not optimal", 
+			map->distance(p1), map->distance(p2), 0.0001);
+	CPPUNIT_ASSERT_MESSAGE("flags did not reduce the number of nodes expanded", 
+			pruned.getNodesExpanded() < expanded);
+	delete p1;
+	delete p2;
+
+	// a sample of the other pairs of locations
+	PathComparison::assertOptimalPaths(map, &astar, &pruned, 
+			map->getAbstractGraph(0), true, 3, 7, 1);
+}
+
+void ArcFlagsTest::loadReadsTheFlagsWrittenBySave()
+{
+	std::string filename("arcflagstest.arcflags");
+	flags->save(filename.c_str());
+
+	ArcFlags af(map);
+	CPPUNIT_ASSERT_MESSAGE("failed to load arc flags file", 
+			af.load(filename.c_str()));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of flag sets after load", 
+			flags->getNumFlagSets(), af.getNumFlagSets());
+
+	graph* g = map->getAbstractGraph(0);
+	edge_iterator ei = g->getEdgeIter();
+	for(edge* e = g->edgeIterNext(ei); e; e = g->edgeIterNext(ei))
+	{
+		node* from = g->getNode(e->getFrom());
+		node* to = g->getNode(e->getTo());
+		for(unsigned int r=0; r<flags->getNumRegions(); r++)
+		{
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("flag differs after load", 
+					flags->isFlagged(from, to, r), af.isFlagged(from, to, r));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("flag differs after load", 
+					flags->isFlagged(to, from, r), af.isFlagged(to, from, r));
+		}
+	}
+	remove(filename.c_str());
+}
+
+void ArcFlagsTest::loadFailsGivenAMissingFile()
+{
+	ArcFlags af(map);
+	CPPUNIT_ASSERT_MESSAGE("loaded a file which does not exist", 
+			!af.load("nosuchfile.arcflags"));
+	CPPUNIT_ASSERT_MESSAGE("failed load changed the flags", !af.isBuilt());
+}
+
+void ArcFlagsTest::flagsDoNotDependOnTheNumberOfThreads()
+{
+	int threads = WorkerThreads::getNumThreads();
+	WorkerThreads::setNumThreads(1);
+	ArcFlags one(map);
+	one.build();
+	WorkerThreads::setNumThreads(4);
+	ArcFlags four(map);
+	four.build();
+	WorkerThreads::setNumThreads(threads);
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of flag sets", 
+			one.getNumFlagSets(), four.getNumFlagSets());
+	graph* g = map->getAbstractGraph(0);
+	edge_iterator ei = g->getEdgeIter();
+	for(edge* e = g->edgeIterNext(ei); e; e = g->edgeIterNext(ei))
+	{
+		node* from = g->getNode(e->getFrom());
+		node* to = g->getNode(e->getTo());
+		for(unsigned int r=0; r<one.getNumRegions(); r++)
+		{
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("flag differs with 4 threads", 
+					one.isFlagged(from, to, r), four.isFlagged(from, to, r));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("flag differs with 4 threads", 
+					one.isFlagged(to, from, r), four.isFlagged(to, from, r));
+		}
+	}
+}
@@ -0,0 +1,41 @@
+#ifndef ARCFLAGSTEST_H
+#define ARCFLAGSTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+
+class ArcFlags;
+class HPAClusterAbstraction;
+class ArcFlagsTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ArcFlagsTest );
+
+	CPPUNIT_TEST_EXCEPTION( constructorThrowsExceptionGivenANullMapAbstraction, std::invalid_argument );
+	CPPUNIT_TEST( buildFlagsArcsWithinAClusterForThatCluster );
+	CPPUNIT_TEST( buildDoesNotFlagArcsWhichLeadAwayFromTheGoal );
+	CPPUNIT_TEST( searchWithFilterExpandsFewerNodesAndFindsOptimalPaths );
+	CPPUNIT_TEST( loadReadsTheFlagsWrittenBySave );
+	CPPUNIT_TEST( loadFailsGivenAMissingFile );
+	CPPUNIT_TEST( flagsDoNotDependOnTheNumberOfThreads );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void constructorThrowsExceptionGivenANullMapAbstraction();
+		void buildFlagsArcsWithinAClusterForThatCluster();
+		void buildDoesNotFlagArcsWhichLeadAwayFromTheGoal();
+		void searchWithFilterExpandsFewerNodesAndFindsOptimalPaths();
+		void loadReadsTheFlagsWrittenBySave();
+		void loadFailsGivenAMissingFile();
+		void flagsDoNotDependOnTheNumberOfThreads();
+
+	private:
+		HPAClusterAbstraction* map;
+		ArcFlags* flags;
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "CachedHeuristicTest.h"
+
+#include "CachedHeuristic.h"
+#include "ClusterNodeFactory.h"
+#include "EdgeFactory.h"
+#include "EmptyClusterAbstraction.h"
+#include "EmptyClusterFactory.h"
+#include "OctileHeuristic.h"
+#include "constants.h"
+#include "graph.h"
+#include "map.h"
+#include "TestConstants.h"
+
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( CachedHeuristicTest );
+
+void CachedHeuristicTest::setUp()
+{
+	map = new EmptyClusterAbstraction(new Map(maplocation.c_str()), 
+			new EmptyClusterFactory(), new ClusterNodeFactory(), 
+			new EdgeFactory());
+}
+
+void CachedHeuristicTest::tearDown()
+{
+	delete map;
+}
+
+void CachedHeuristicTest::hReturnsTheSameValuesAsTheWrappedHeuristic()
+{
+	OctileHeuristic octile;
+	CachedHeuristic cached(new OctileHeuristic());
+	graph* g = map->getAbstractGraph(0);
+	std::vector<node*> nodes;
+	for(int i=0; i<g->getNumNodes(); i++)
+		nodes.push_back(g->getNode(i));
+	node* goal = nodes.at(nodes.size()/2);
+
+	// twice; once to fill the cache and once to read from it
+	for(int pass=0; pass<2; pass++)
+	{
+		for(unsigned int i=0; i<nodes.size(); i++)
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("cached value differs from h", 
+					octile.h(nodes[i], goal), cached.h(nodes[i], goal));
+
+		double out[5];
+		for(unsigned int i=0; i+5<=nodes.size(); i+=5)
+		{
+			cached.h_batch(&nodes[i], 5, goal, out);
+			for(unsigned int j=0; j<5; j++)
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("cached batch differs from h", 
+						octile.h(nodes[i+j], goal), out[j]);
+		}
+	}
+}
+
+void CachedHeuristicTest::hRemembersValuesForTheSameGoal()
+{
+	CachedHeuristic cached(new OctileHeuristic());
+	graph* g = map->getAbstractGraph(0);
+	node* a = g->getNode(0);
+	node* b = g->getNode(1);
+	node* goal = g->getNode(g->getNumNodes()-1);
+
+	cached.h(a, goal);
+	node* nodes[2] = { a, b };
+	double out[2];
+	cached.h_batch(nodes, 2, goal, out);
+	cached.h(b, goal);
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of lookups", 4L, 
+			cached.getLookups());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of hits", 2L, cached.getHits());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("wrong hit rate", 0.5, 
+			cached.getHitRate(), 0.0001);
+
+	cached.resetMetrics();
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("lookups not reset", 0L, cached.getLookups());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("hits not reset", 0L, cached.getHits());
+}
+
+void CachedHeuristicTest::hForgetsValuesWhenTheGoalChanges()
+{
+	OctileHeuristic octile;
+	CachedHeuristic cached(new OctileHeuristic());
+	graph* g = map->getAbstractGraph(0);
+	node* a = g->getNode(0);
+	node* goal1 = g->getNode(g->getNumNodes()-1);
+	node* goal2 = g->getNode(g->getNumNodes()/2);
+
+	cached.h(a, goal1);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("value for old goal returned", 
+			octile.h(a, goal2), cached.h(a, goal2));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("value for old goal returned", 
+			octile.h(a, goal1), cached.h(a, goal1));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("lookup for a new goal counted as a hit", 
+			0L, cached.getHits());
+}
+
+// insertion policies reuse the numbers of the nodes they remove
+void CachedHeuristicTest::hDoesNotConfuseNodesWithTheSameNumber()
+{
+	OctileHeuristic octile;
+	CachedHeuristic cached(new OctileHeuristic());
+	graph* g = map->getAbstractGraph(0);
+	node* a = g->getNode(0);
+	node* goal = g->getNode(g->getNumNodes()-1);
+	cached.h(a, goal);
+
+	long x = a->getLabelL(kFirstData);
+	a->setLabelL(kFirstData, x+1);
+	double expected = octile.h(a, goal);
+	double actual = cached.h(a, goal);
+	a->setLabelL(kFirstData, x);
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("value for old location returned", 
+			expected, actual);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("moved node counted as a hit", 
+			0L, cached.getHits());
+}
+
+void CachedHeuristicTest::hThrowsExceptionGivenANullNode()
+{
+	CachedHeuristic cached(new OctileHeuristic());
+	cached.h(map->getAbstractGraph(0)->getNode(0), 0);
+}
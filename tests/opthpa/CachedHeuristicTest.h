@@ -0,0 +1,35 @@
+#ifndef CACHEDHEURISTICTEST_H
+#define CACHEDHEURISTICTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+
+class EmptyClusterAbstraction;
+class CachedHeuristicTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( CachedHeuristicTest );
+
+	CPPUNIT_TEST( hReturnsTheSameValuesAsTheWrappedHeuristic );
+	CPPUNIT_TEST( hRemembersValuesForTheSameGoal );
+	CPPUNIT_TEST( hForgetsValuesWhenTheGoalChanges );
+	CPPUNIT_TEST( hDoesNotConfuseNodesWithTheSameNumber );
+	CPPUNIT_TEST_EXCEPTION( hThrowsExceptionGivenANullNode, std::invalid_argument );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void hReturnsTheSameValuesAsTheWrappedHeuristic();
+		void hRemembersValuesForTheSameGoal();
+		void hForgetsValuesWhenTheGoalChanges();
+		void hDoesNotConfuseNodesWithTheSameNumber();
+		void hThrowsExceptionGivenANullNode();
+
+	private:
+		EmptyClusterAbstraction* map;
+};
+
+#endif
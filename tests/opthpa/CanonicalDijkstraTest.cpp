@@ -0,0 +1,119 @@
+#include "CanonicalDijkstraTest.h"
+
+#include "CanonicalDijkstra.h"
+#include "ClusterNodeFactory.h"
+#include "EdgeFactory.h"
+#include "EmptyClusterAbstraction.h"
+#include "EmptyClusterFactory.h"
+#include "FlexibleAStar.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "OctileHeuristic.h"
+#include "graph.h"
+#include "map.h"
+#include "path.h"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( CanonicalDijkstraTest );
+
+void CanonicalDijkstraTest::setUp()
+{
+	map = new EmptyClusterAbstraction(new Map(deadendtest.c_str()), 
+			new EmptyClusterFactory(), new ClusterNodeFactory(), 
+			new EdgeFactory());
+	search = new CanonicalDijkstra(map);
+}
+
+void CanonicalDijkstraTest::tearDown()
+{
+	delete search;
+	delete map;
+}
+
+void CanonicalDijkstraTest::constructorThrowsExceptionGivenANullMapAbstraction()
+{
+	CanonicalDijkstra cd(0);
+}
+
+void CanonicalDijkstraTest::searchFindsTheSameDistancesAsAStar()
+{
+	FlexibleAStar astar(new IncidentEdgesExpansionPolicy(map), 
+			new OctileHeuristic());
+	graph* g = map->getAbstractGraph(0);
+	for(int i=0; i<g->getNumNodes(); i+=11)
+	{
+		node* source = g->getNode(i);
+		search->search(source);
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("source has a distance other than zero", 
+				0.0, search->getDistance(source->getLabelL(kFirstData), 
+					source->getLabelL(kFirstData+1)));
+
+		for(int j=0; j<g->getNumNodes(); j++)
+		{
+			if(i == j)
+				continue;
+			node* target = g->getNode(j);
+			path* p = astar.getPath(map, source, target);
+			double expected = p ? map->distance(p) : -1;
+			CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("wrong distance", expected, 
+					search->getDistance(target->getLabelL(kFirstData), 
+						target->getLabelL(kFirstData+1)), 0.0001);
+			delete p;
+		}
+	}
+}
+
+void CanonicalDijkstraTest::searchFollowsFewerEdgesThanThereAreInTheGraph()
+{
+	graph* g = map->getAbstractGraph(0);
+	search->search(map->getNodeFromMap(0, 14));
+	CPPUNIT_ASSERT_MESSAGE("search followed every edge", 
+			search->getEdgesFollowed() < 2*(unsigned long)g->getNumEdges());
+}
+
+void CanonicalDijkstraTest::parentsAndFirstMovesLieOnOptimalPaths()
+{
+	graph* g = map->getAbstractGraph(0);
+	node* source = map->getNodeFromMap(12, 5);
+	search->search(source);
+	int width = map->getMap()->getMapWidth();
+	int start = 12 + 5*width;
+
+	for(int i=0; i<g->getNumNodes(); i++)
+	{
+		node* n = g->getNode(i);
+		int index = n->getLabelL(kFirstData) + n->getLabelL(kFirstData+1)*width;
+		if(index == start)
+		{
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("source has a parent", 
+					-1, search->getParent(index));
+			continue;
+		}
+
+		int p = search->getParent(index);
+		CPPUNIT_ASSERT_MESSAGE("location has no parent", p != -1);
+		int dx = p % width - index % width;
+		int dy = p / width - index / width;
+		double cost = (dx != 0 && dy != 0) ? ROOT_TWO : 1.0;
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("parent not on an optimal path", 
+				search->getDistances()[index], 
+				search->getDistances()[p] + cost, 0.0001);
+
+		int move = search->getFirstMove(index);
+		CPPUNIT_ASSERT_MESSAGE("location has no first move", 
+				move != CanonicalDijkstra::kNoMove);
+		if(p != start)
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("first move differs from that of parent", 
+					search->getFirstMove(p), move);
+	}
+}
+
+void CanonicalDijkstraTest::blockedLocationsHaveNoDistance()
+{
+	search->search(map->getNodeFromMap(0, 0));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("blocked location has a distance", 
+			-1.0, search->getDistance(9, 0));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("location off the map has a distance", 
+			-1.0, search->getDistance(20, 0));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("distance to open location is wrong", 
+			4.0, search->getDistance(4, 0));
+}
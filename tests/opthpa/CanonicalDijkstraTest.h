@@ -0,0 +1,37 @@
+#ifndef CANONICALDIJKSTRATEST_H
+#define CANONICALDIJKSTRATEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+
+class CanonicalDijkstra;
+class EmptyClusterAbstraction;
+class CanonicalDijkstraTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( CanonicalDijkstraTest );
+
+	CPPUNIT_TEST_EXCEPTION( constructorThrowsExceptionGivenANullMapAbstraction, std::invalid_argument );
+	CPPUNIT_TEST( searchFindsTheSameDistancesAsAStar );
+	CPPUNIT_TEST( searchFollowsFewerEdgesThanThereAreInTheGraph );
+	CPPUNIT_TEST( parentsAndFirstMovesLieOnOptimalPaths );
+	CPPUNIT_TEST( blockedLocationsHaveNoDistance );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void constructorThrowsExceptionGivenANullMapAbstraction();
+		void searchFindsTheSameDistancesAsAStar();
+		void searchFollowsFewerEdgesThanThereAreInTheGraph();
+		void parentsAndFirstMovesLieOnOptimalPaths();
+		void blockedLocationsHaveNoDistance();
+
+	private:
+		EmptyClusterAbstraction* map;
+		CanonicalDijkstra* search;
+};
+
+#endif
@@ -0,0 +1,242 @@
+#include "CompressedPathDatabaseTest.h"
+
+#include "ClusterNodeFactory.h"
+#include "CompressedPathDatabase.h"
+#include "CPDSearch.h"
+#include "EdgeFactory.h"
+#include "EmptyClusterAbstraction.h"
+#include "EmptyClusterFactory.h"
+#include "FlexibleAStar.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "MapChecksum.h"
+#include "OctileHeuristic.h"
+#include "PathComparison.h"
+#include "WorkerThreads.h"
+#include "graph.h"
+#include "map.h"
+#include "path.h"
+#include "TestConstants.h"
+#include <cstdio>
+#include <fstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( CompressedPathDatabaseTest );
+
+void CompressedPathDatabaseTest::setUp()
+{
+	map = new EmptyClusterAbstraction(new Map(hpastartest.c_str()), 
+			new EmptyClusterFactory(), new ClusterNodeFactory(), new EdgeFactory());
+}
+
+void CompressedPathDatabaseTest::tearDown()
+{
+	delete map;
+}
+
+void CompressedPathDatabaseTest::constructorThrowsExceptionGivenANullMapAbstraction()
+{
+	CompressedPathDatabase cpd(0);
+}
+
+void CompressedPathDatabaseTest::getPathReturnsAnOptimalPathBetweenEveryPairOfLocations()
+{
+	CompressedPathDatabase cpd(map);
+	cpd.build();
+	CPDSearch search(&cpd);
+	FlexibleAStar astar(new IncidentEdgesExpansionPolicy(map), new OctileHeuristic());
+
+	PathComparison::assertOptimalPaths(map, &astar, &search, 
+			map->getAbstractGraph(0), true);
+}
+
+void CompressedPathDatabaseTest::getPathReturnsNullGivenTheSameStartAndGoal()
+{
+	CompressedPathDatabase cpd(map);
+	cpd.build();
+	CPDSearch search(&cpd);
+
+	node* n = map->getAbstractGraph(0)->getNode(0);
+	path* p = search.getPath(map, n, n);
+	CPPUNIT_ASSERT_MESSAGE("found a path from a location to itself", p == 0);
+	delete p;
+}
+
+void CompressedPathDatabaseTest::loadReadsTheDatabaseWrittenBySave()
+{
+	CompressedPathDatabase cpd(map);
+	cpd.build();
+	std::string filename("compressedpathdatabasetest.cpd");
+	cpd.save(filename.c_str());
+
+	CompressedPathDatabase cpd2(map);
+	CPPUNIT_ASSERT_MESSAGE("failed to load database file", cpd2.load(filename.c_str()));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of runs after load", 
+			cpd.getNumRuns(), cpd2.getNumRuns());
+
+	graph* g = map->getAbstractGraph(0);
+	for(int i=0; i<g->getNumNodes(); i++)
+		for(int j=0; j<g->getNumNodes(); j++)
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("first move differs after load", 
+					cpd.getFirstMove(g->getNode(i), g->getNode(j)), 
+					cpd2.getFirstMove(g->getNode(i), g->getNode(j)));
+	remove(filename.c_str());
+}
+
+void CompressedPathDatabaseTest::loadFailsGivenAMissingFile()
+{
+	CompressedPathDatabase cpd(map);
+	CPPUNIT_ASSERT_MESSAGE("loaded a file which does not exist", 
+			!cpd.load("nosuchfile.cpd"));
+	CPPUNIT_ASSERT_MESSAGE("failed load changed the database", !cpd.isBuilt());
+}
+
+void CompressedPathDatabaseTest::loadFailsGivenAFileWrittenForAMapWithDifferentTerrain()
+{
+	CompressedPathDatabase cpd(map);
+	cpd.build();
+	std::string filename("compressedpathdatabasetest.cpd");
+	cpd.save(filename.c_str());
+
+	// same dimensions and number of nodes; different terrain
+	Map* edited = new Map(hpastartest.c_str());
+	for(int x=0; x<edited->getMapWidth(); x++)
+		if(edited->getTerrainType(x, 0) == kGround)
+		{
+			edited->setTerrainType(x, 0, kSwamp);
+			break;
+		}
+	EmptyClusterAbstraction editedmap(edited, new EmptyClusterFactory(), 
+			new ClusterNodeFactory(), new EdgeFactory());
+
+	CompressedPathDatabase cpd2(&editedmap);
+	CPPUNIT_ASSERT_MESSAGE("loaded a file written for a different map", 
+			!cpd2.load(filename.c_str()));
+	CPPUNIT_ASSERT_MESSAGE("failed load changed the database", !cpd2.isBuilt());
+	remove(filename.c_str());
+}
+
+void CompressedPathDatabaseTest::loadFailsGivenRowsOutsideTheRuns()
+{
+	int numnodes = map->getAbstractGraph(0)->getNumNodes();
+	std::vector<unsigned int> runs(numnodes, CompressedPathDatabase::kNoMove);
+	std::string filename("compressedpathdatabasetest.cpd");
+
+	std::vector<unsigned int> past(numnodes+1);
+	for(int i=0; i<=numnodes; i++)
+		past[i] = i;
+	past[numnodes/2] = numnodes+1;
+	writeDatabase(filename.c_str(), past, runs);
+	CompressedPathDatabase cpd(map);
+	CPPUNIT_ASSERT_MESSAGE("loaded a row which starts past the last run", 
+			!cpd.load(filename.c_str()));
+
+	std::vector<unsigned int> backwards(numnodes+1);
+	for(int i=0; i<=numnodes; i++)
+		backwards[i] = i;
+	backwards[numnodes/2] = 0;
+	writeDatabase(filename.c_str(), backwards, runs);
+	CPPUNIT_ASSERT_MESSAGE("loaded a row which starts before the one above it", 
+			!cpd.load(filename.c_str()));
+	CPPUNIT_ASSERT_MESSAGE("failed load changed the database", !cpd.isBuilt());
+	remove(filename.c_str());
+}
+
+void CompressedPathDatabaseTest::getPathReturnsNullWhenTheMovesLeadAroundACycle()
+{
+	// every row holds a single move: east from even columns, west from odd
+	// ones, so a walk bounces between two neighbours forever
+	graph* g = map->getAbstractGraph(0);
+	int numnodes = g->getNumNodes();
+	std::vector<unsigned int> rowStart(numnodes+1);
+	std::vector<unsigned int> runs(numnodes);
+	for(int i=0; i<numnodes; i++)
+	{
+		rowStart[i] = i;
+		runs[i] = g->getNode(i)->getLabelL(kFirstData) % 2 == 0 ? 2 : 6;
+	}
+	rowStart[numnodes] = numnodes;
+	std::string filename("compressedpathdatabasetest.cpd");
+	writeDatabase(filename.c_str(), rowStart, runs);
+
+	CompressedPathDatabase cpd(map);
+	CPPUNIT_ASSERT_MESSAGE("failed to load database file", cpd.load(filename.c_str()));
+	remove(filename.c_str());
+	CPDSearch search(&cpd);
+
+	node* start = 0;
+	for(int i=0; i<numnodes && start == 0; i++)
+	{
+		node* n = g->getNode(i);
+		int x = n->getLabelL(kFirstData);
+		int y = n->getLabelL(kFirstData+1);
+		if(x % 2 == 0 && map->getNodeFromMap(x+1, y))
+			start = n;
+	}
+	CPPUNIT_ASSERT_MESSAGE("no location with an eastern neighbour", start != 0);
+	node* goal = map->getNodeFromMap(start->getLabelL(kFirstData), 
+			start->getLabelL(kFirstData+1)+1);
+	if(goal == 0)
+		goal = map->getNodeFromMap(start->getLabelL(kFirstData), 
+				start->getLabelL(kFirstData+1)-1);
+	CPPUNIT_ASSERT_MESSAGE("no goal off the cycle", goal != 0);
+
+	path* p = search.getPath(map, start, goal);
+	CPPUNIT_ASSERT_MESSAGE("returned a path the database cannot reach", p == 0);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("walk did not stop after one step per node", 
+			(long)numnodes, (long)search.getNodesExpanded());
+	delete p;
+}
+
+// Writes a database file for the test map, in the format of 
+// CompressedPathDatabase::save, with targets ordered by node number.
+// rows are built in blocks on worker threads; every row must come out the
+// same however many threads there are
+void CompressedPathDatabaseTest::databaseDoesNotDependOnTheNumberOfThreads()
+{
+	EmptyClusterAbstraction csc(new Map(csc2f.c_str()), 
+			new EmptyClusterFactory(), new ClusterNodeFactory(), new EdgeFactory());
+	int threads = WorkerThreads::getNumThreads();
+
+	WorkerThreads::setNumThreads(1);
+	CompressedPathDatabase one(&csc);
+	one.build();
+	WorkerThreads::setNumThreads(4);
+	CompressedPathDatabase four(&csc);
+	four.build();
+	WorkerThreads::setNumThreads(threads);
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of runs", 
+			one.getNumRuns(), four.getNumRuns());
+	graph* g = csc.getAbstractGraph(0);
+	for(int i=0; i<g->getNumNodes(); i+=7)
+		for(int j=0; j<g->getNumNodes(); j++)
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("first move differs", 
+					one.getFirstMove(g->getNode(i), g->getNode(j)), 
+					four.getFirstMove(g->getNode(i), g->getNode(j)));
+}
+
+void CompressedPathDatabaseTest::writeDatabase(const char* filename, 
+		const std::vector<unsigned int>& rowStart, 
+		const std::vector<unsigned int>& runs)
+{
+	int version = 2;
+	int width = map->getMap()->getMapWidth();
+	int height = map->getMap()->getMapHeight();
+	unsigned int checksum = MapChecksum::compute(map->getMap());
+	int numnodes = map->getAbstractGraph(0)->getNumNodes();
+	int numruns = runs.size();
+	std::vector<int> order(numnodes);
+	for(int i=0; i<numnodes; i++)
+		order[i] = i;
+
+	std::ofstream out(filename, std::ios::out | std::ios::binary);
+	out.write((const char*)&version, sizeof(int));
+	out.write((const char*)&width, sizeof(int));
+	out.write((const char*)&height, sizeof(int));
+	out.write((const char*)&checksum, sizeof(unsigned int));
+	out.write((const char*)&numnodes, sizeof(int));
+	out.write((const char*)&numruns, sizeof(int));
+	out.write((const char*)&order[0], numnodes*sizeof(int));
+	out.write((const char*)&rowStart[0], rowStart.size()*sizeof(unsigned int));
+	out.write((const char*)&runs[0], numruns*sizeof(unsigned int));
+	out.close();
+}
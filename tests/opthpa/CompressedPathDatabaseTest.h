@@ -0,0 +1,48 @@
+#ifndef COMPRESSEDPATHDATABASETEST_H
+#define COMPRESSEDPATHDATABASETEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include <vector>
+
+class EmptyClusterAbstraction;
+class CompressedPathDatabaseTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( CompressedPathDatabaseTest );
+
+	CPPUNIT_TEST_EXCEPTION( constructorThrowsExceptionGivenANullMapAbstraction, std::invalid_argument );
+	CPPUNIT_TEST( getPathReturnsAnOptimalPathBetweenEveryPairOfLocations );
+	CPPUNIT_TEST( getPathReturnsNullGivenTheSameStartAndGoal );
+	CPPUNIT_TEST( loadReadsTheDatabaseWrittenBySave );
+	CPPUNIT_TEST( loadFailsGivenAMissingFile );
+	CPPUNIT_TEST( loadFailsGivenAFileWrittenForAMapWithDifferentTerrain );
+	CPPUNIT_TEST( loadFailsGivenRowsOutsideTheRuns );
+	CPPUNIT_TEST( getPathReturnsNullWhenTheMovesLeadAroundACycle );
+	CPPUNIT_TEST( databaseDoesNotDependOnTheNumberOfThreads );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void constructorThrowsExceptionGivenANullMapAbstraction();
+		void getPathReturnsAnOptimalPathBetweenEveryPairOfLocations();
+		void getPathReturnsNullGivenTheSameStartAndGoal();
+		void loadReadsTheDatabaseWrittenBySave();
+		void loadFailsGivenAMissingFile();
+		void loadFailsGivenAFileWrittenForAMapWithDifferentTerrain();
+		void loadFailsGivenRowsOutsideTheRuns();
+		void getPathReturnsNullWhenTheMovesLeadAroundACycle();
+		void databaseDoesNotDependOnTheNumberOfThreads();
+
+	private:
+		void writeDatabase(const char* filename, 
+				const std::vector<unsigned int>& rowStart, 
+				const std::vector<unsigned int>& runs);
+
+		EmptyClusterAbstraction* map;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include "ConnectedComponentsTest.h"
+
+#include "ConnectedComponents.h"
+#include "graph.h"
+#include "map.h"
+#include "mapAbstraction.h"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ConnectedComponentsTest );
+
+void ConnectedComponentsTest::setUp()
+{
+	// (8, 0) is walled off from every other location on this map
+	m = new Map(hpastartest.c_str());
+	g = getMapGraph(m);
+	components = new ConnectedComponents(m->getMapWidth(), m->getMapHeight());
+	components->label(g);
+}
+
+void ConnectedComponentsTest::tearDown()
+{
+	delete components;
+	delete g;
+	delete m;
+}
+
+void ConnectedComponentsTest::constructorThrowsExceptionGivenNonPositiveDimensions()
+{
+	ConnectedComponents cc(0, 5);
+}
+
+void ConnectedComponentsTest::labelSeparatesLocationsWhichCannotReachOneAnother()
+{
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of components", 
+			2u, components->getNumComponents());
+	CPPUNIT_ASSERT_MESSAGE("isolated location shares a component", 
+			components->getComponent(8, 0) != components->getComponent(0, 0));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("distant locations in different components", 
+			components->getComponent(0, 0), components->getComponent(7, 5));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("obstacle has a component", 
+			ConnectedComponents::kNoComponent, components->getComponent(5, 0));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("location off the map has a component", 
+			ConnectedComponents::kNoComponent, components->getComponent(9, 0));
+}
+
+void ConnectedComponentsTest::connectedComparesTheLocationsOfNodesAtAnyLevel()
+{
+	node first("first"), second("second");
+	first.setLabelL(kAbstractionLevel, 1);
+	first.setLabelL(kFirstData, 0);
+	first.setLabelL(kFirstData+1, 0);
+	second.setLabelL(kAbstractionLevel, 1);
+	second.setLabelL(kFirstData, 7);
+	second.setLabelL(kFirstData+1, 5);
+	CPPUNIT_ASSERT_MESSAGE("nodes in the same component not connected", 
+			components->connected(&first, &second));
+
+	second.setLabelL(kFirstData, 8);
+	second.setLabelL(kFirstData+1, 0);
+	CPPUNIT_ASSERT_MESSAGE("nodes in different components connected", 
+			!components->connected(&first, &second));
+
+	second.setLabelL(kFirstData, 5);
+	CPPUNIT_ASSERT_MESSAGE("node on an obstacle connected", 
+			!components->connected(&first, &second));
+}
+
+void ConnectedComponentsTest::joinMergesComponentsOfLocationsAddedByHand()
+{
+	ConnectedComponents cc(4, 1);
+	cc.addLocation(0, 0);
+	cc.addLocation(1, 0);
+	cc.addLocation(3, 0);
+	cc.join(0, 0, 1, 0);
+	cc.join(1, 0, 2, 0); // (2, 0) was never added
+	cc.compact();
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of components", 
+			2u, cc.getNumComponents());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("joined locations in different components", 
+			cc.getComponent(0, 0), cc.getComponent(1, 0));
+	CPPUNIT_ASSERT_MESSAGE("separate locations share a component", 
+			cc.getComponent(0, 0) != cc.getComponent(3, 0));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("location which was never added has a component", 
+			ConnectedComponents::kNoComponent, cc.getComponent(2, 0));
+}
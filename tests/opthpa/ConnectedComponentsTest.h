@@ -0,0 +1,37 @@
+#ifndef CONNECTEDCOMPONENTSTEST_H
+#define CONNECTEDCOMPONENTSTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+
+class ConnectedComponents;
+class Map;
+class graph;
+class ConnectedComponentsTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ConnectedComponentsTest );
+
+	CPPUNIT_TEST_EXCEPTION( constructorThrowsExceptionGivenNonPositiveDimensions, std::invalid_argument );
+	CPPUNIT_TEST( labelSeparatesLocationsWhichCannotReachOneAnother );
+	CPPUNIT_TEST( connectedComparesTheLocationsOfNodesAtAnyLevel );
+	CPPUNIT_TEST( joinMergesComponentsOfLocationsAddedByHand );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void constructorThrowsExceptionGivenNonPositiveDimensions();
+		void labelSeparatesLocationsWhichCannotReachOneAnother();
+		void connectedComparesTheLocationsOfNodesAtAnyLevel();
+		void joinMergesComponentsOfLocationsAddedByHand();
+
+	private:
+		Map* m;
+		graph* g;
+		ConnectedComponents* components;
+};
+
+#endif
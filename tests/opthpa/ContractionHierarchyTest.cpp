@@ -0,0 +1,154 @@
+#include "ContractionHierarchyTest.h"
+
+#include "CHSearch.h"
+#include "ClusterNodeFactory.h"
+#include "ContractionHierarchy.h"
+#include "DefaultInsertionPolicy.h"
+#include "DefaultRefinementPolicy.h"
+#include "EdgeFactory.h"
+#include "FlexibleAStar.h"
+#include "HierarchicalSearch.h"
+#include "HPAClusterAbstraction.h"
+#include "HPAClusterFactory.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "mapFlatAbstraction.h"
+#include "OctileHeuristic.h"
+#include "PathComparison.h"
+#include "graph.h"
+#include "map.h"
+#include "path.h"
+#include "TestConstants.h"
+#include <cstdio>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ContractionHierarchyTest );
+
+void ContractionHierarchyTest::setUp()
+{
+	map = new mapFlatAbstraction(new Map(hpastartest.c_str()));
+}
+
+void ContractionHierarchyTest::tearDown()
+{
+	delete map;
+}
+
+void ContractionHierarchyTest::constructorThrowsExceptionGivenANullGraph()
+{
+	ContractionHierarchy ch(0);
+}
+
+// every shortcut must have been unpacked, so each step of each path is an
+// edge of the graph
+void ContractionHierarchyTest::getPathReturnsAnOptimalPathBetweenEveryPairOfLocations()
+{
+	graph* g = map->getAbstractGraph(0);
+	ContractionHierarchy ch(g);
+	ch.build();
+	CHSearch search(&ch);
+	FlexibleAStar astar(new IncidentEdgesExpansionPolicy(map), new OctileHeuristic());
+
+	PathComparison::assertOptimalPaths(map, &astar, &search, g, true);
+}
+
+// the hierarchy is built over the abstract graph of HPA*; start and goal 
+// are added to that graph for each query and are not part of it
+void ContractionHierarchyTest::getPathReturnsAnOptimalAbstractPathBetweenInsertedNodes()
+{
+	HPAClusterAbstraction hpamap(new Map(hpastartest.c_str()), 
+			new HPAClusterFactory(), new ClusterNodeFactory(), new EdgeFactory());
+	hpamap.setClusterSize(TESTCLUSTERSIZE);
+	hpamap.buildClusters();
+	hpamap.buildEntrances();
+
+	ContractionHierarchy ch(hpamap.getAbstractGraph(1));
+	ch.build();
+	HierarchicalSearch search(new DefaultInsertionPolicy(&hpamap), 
+			new CHSearch(&ch), new DefaultRefinementPolicy(&hpamap));
+	HierarchicalSearch hpastar(new DefaultInsertionPolicy(&hpamap), 
+			new FlexibleAStar(new IncidentEdgesExpansionPolicy(&hpamap), 
+				new OctileHeuristic()), 
+			new DefaultRefinementPolicy(&hpamap));
+
+	graph* g = hpamap.getAbstractGraph(0);
+	int numAbsNodes = hpamap.getAbstractGraph(1)->getNumNodes();
+	for(int i=0; i<g->getNumNodes(); i++)
+		for(int j=0; j<g->getNumNodes(); j++)
+		{
+			if(i == j)
+				continue;
+
+			PathComparison::assertOptimalPath(&hpamap, &hpastar, &search, 
+					g->getNode(i), g->getNode(j));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("inserted nodes were not removed", 
+					numAbsNodes, hpamap.getAbstractGraph(1)->getNumNodes());
+		}
+}
+
+void ContractionHierarchyTest::loadReadsTheHierarchyWrittenBySave()
+{
+	graph* g = map->getAbstractGraph(0);
+	ContractionHierarchy ch(g);
+	ch.build();
+	std::string filename("contractionhierarchytest.ch");
+	ch.save(filename.c_str());
+
+	ContractionHierarchy ch2(g);
+	CPPUNIT_ASSERT_MESSAGE("failed to load hierarchy file", ch2.load(filename.c_str()));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of shortcuts after load", 
+			ch.getNumShortcuts(), ch2.getNumShortcuts());
+
+	for(int i=0; i<g->getNumNodes(); i++)
+		for(int j=0; j<g->getNumNodes(); j++)
+		{
+			path* expected = ch.getPath(g->getNode(i), g->getNode(j));
+			path* p = ch2.getPath(g->getNode(i), g->getNode(j));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("path differs after load", 
+					expected == 0, p == 0);
+			if(p)
+				CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("path differs after load", 
+						map->distance(expected), map->distance(p), 0.0001);
+			delete expected;
+			delete p;
+		}
+	remove(filename.c_str());
+}
+
+void ContractionHierarchyTest::loadFailsGivenAHierarchyBuiltForAnotherGraph()
+{
+	ContractionHierarchy ch(map->getAbstractGraph(0));
+	ch.build();
+	std::string filename("contractionhierarchytest.ch");
+	ch.save(filename.c_str());
+
+	mapFlatAbstraction other(new Map(hpaentrancetest.c_str()));
+	ContractionHierarchy ch2(other.getAbstractGraph(0));
+	CPPUNIT_ASSERT_MESSAGE("loaded a hierarchy built for another graph", 
+			!ch2.load(filename.c_str()));
+	CPPUNIT_ASSERT_MESSAGE("failed load changed the hierarchy", !ch2.isBuilt());
+	CPPUNIT_ASSERT_MESSAGE("loaded a file which does not exist", 
+			!ch2.load("nosuchfile.ch"));
+	remove(filename.c_str());
+}
+
+// same nodes and edges, but the hierarchy's shortcuts no longer match
+void ContractionHierarchyTest::loadFailsGivenAHierarchyBuiltWithOtherEdgeWeights()
+{
+	graph* g = map->getAbstractGraph(0);
+	ContractionHierarchy ch(g);
+	ch.build();
+	std::string filename("contractionhierarchytest.ch");
+	ch.save(filename.c_str());
+
+	edge_iterator ei = g->getEdgeIter();
+	edge* e = g->edgeIterNext(ei);
+	double weight = e->getWeight();
+	e->setWeight(weight + 1);
+	ContractionHierarchy ch2(g);
+	bool loaded = ch2.load(filename.c_str());
+	e->setWeight(weight);
+
+	CPPUNIT_ASSERT_MESSAGE("loaded a hierarchy built with other edge weights", 
+			!loaded);
+	CPPUNIT_ASSERT_MESSAGE("failed load changed the hierarchy", !ch2.isBuilt());
+	remove(filename.c_str());
+}
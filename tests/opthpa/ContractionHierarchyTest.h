@@ -0,0 +1,37 @@
+#ifndef CONTRACTIONHIERARCHYTEST_H
+#define CONTRACTIONHIERARCHYTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+
+class mapFlatAbstraction;
+class ContractionHierarchyTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( ContractionHierarchyTest );
+
+	CPPUNIT_TEST_EXCEPTION( constructorThrowsExceptionGivenANullGraph, std::invalid_argument );
+	CPPUNIT_TEST( getPathReturnsAnOptimalPathBetweenEveryPairOfLocations );
+	CPPUNIT_TEST( getPathReturnsAnOptimalAbstractPathBetweenInsertedNodes );
+	CPPUNIT_TEST( loadReadsTheHierarchyWrittenBySave );
+	CPPUNIT_TEST( loadFailsGivenAHierarchyBuiltForAnotherGraph );
+	CPPUNIT_TEST( loadFailsGivenAHierarchyBuiltWithOtherEdgeWeights );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void constructorThrowsExceptionGivenANullGraph();
+		void getPathReturnsAnOptimalPathBetweenEveryPairOfLocations();
+		void getPathReturnsAnOptimalAbstractPathBetweenInsertedNodes();
+		void loadReadsTheHierarchyWrittenBySave();
+		void loadFailsGivenAHierarchyBuiltForAnotherGraph();
+		void loadFailsGivenAHierarchyBuiltWithOtherEdgeWeights();
+
+	private:
+		mapFlatAbstraction* map;
+};
+
+#endif
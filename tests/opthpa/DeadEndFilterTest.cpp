@@ -0,0 +1,113 @@
+#include "DeadEndFilterTest.h"
+
+#include "ClusterNodeFactory.h"
+#include "DeadEndFilter.h"
+#include "EdgeFactory.h"
+#include "FlexibleAStar.h"
+#include "HPAClusterAbstraction.h"
+#include "HPAClusterFactory.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "OctileHeuristic.h"
+#include "PathComparison.h"
+#include "ProblemInstance.h"
+#include "graph.h"
+#include "map.h"
+#include "path.h"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DeadEndFilterTest );
+
+// the map has a room (x 10-14, y 0-9) whose only entrance is at (9, 2) and
+// a corridor (x 16-19) which joins the rest of the map only at the bottom.
+void DeadEndFilterTest::setUp()
+{
+	map = new HPAClusterAbstraction(new Map(deadendtest.c_str()), 
+			new HPAClusterFactory(), new ClusterNodeFactory(), 
+			new EdgeFactory());
+	map->setClusterSize(5);
+	map->buildClusters();
+	map->buildEntrances();
+	filter = new DeadEndFilter(map);
+}
+
+void DeadEndFilterTest::tearDown()
+{
+	delete filter;
+	delete map;
+}
+
+void DeadEndFilterTest::constructorThrowsExceptionGivenANullMapAbstraction()
+{
+	DeadEndFilter f(0);
+}
+
+void DeadEndFilterTest::constructorFindsRegionsBehindNarrowEntrances()
+{
+	int room = filter->getRegion(12, 5);
+	CPPUNIT_ASSERT_MESSAGE("room behind a narrow entrance is not a dead end", 
+			room != DeadEndFilter::kNoRegion);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("room is split over several regions", 
+			room, filter->getRegion(10, 0));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("entrance to the room is part of a dead end", 
+			DeadEndFilter::kNoRegion, filter->getRegion(9, 2));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("main part of the map is part of a dead end", 
+			DeadEndFilter::kNoRegion, filter->getRegion(2, 2));
+
+	int corridor = filter->getRegion(17, 2);
+	CPPUNIT_ASSERT_MESSAGE("corridor is not a dead end", 
+			corridor != DeadEndFilter::kNoRegion);
+	CPPUNIT_ASSERT_MESSAGE("corridor and room are the same dead end", 
+			corridor != room);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of dead ends", 
+			2u, filter->getNumRegions());
+}
+
+void DeadEndFilterTest::filterSkipsDeadEndsWhichHoldNeitherStartNorGoal()
+{
+	OctileHeuristic h;
+	node* start = map->getNodeFromMap(0, 2);
+	node* inroom = map->getNodeFromMap(12, 5);
+	node* incorridor = map->getNodeFromMap(17, 2);
+
+	ProblemInstance p1(start, incorridor, map, &h);
+	filter->setProblemInstance(&p1);
+	CPPUNIT_ASSERT_MESSAGE("room not skipped", filter->filter(inroom));
+	CPPUNIT_ASSERT_MESSAGE("region holding the goal skipped", 
+			!filter->filter(map->getNodeFromMap(19, 0)));
+	CPPUNIT_ASSERT_MESSAGE("location outside any dead end skipped", 
+			!filter->filter(map->getNodeFromMap(9, 2)));
+
+	ProblemInstance p2(inroom, start, map, &h);
+	filter->setProblemInstance(&p2);
+	CPPUNIT_ASSERT_MESSAGE("region holding the start skipped", 
+			!filter->filter(map->getNodeFromMap(14, 9)));
+	CPPUNIT_ASSERT_MESSAGE("corridor not skipped", filter->filter(incorridor));
+}
+
+void DeadEndFilterTest::searchWithFilterExpandsFewerNodesAndFindsOptimalPaths()
+{
+	IncidentEdgesExpansionPolicy* policy = new IncidentEdgesExpansionPolicy(map);
+	policy->addFilter(new DeadEndFilter(map));
+	FlexibleAStar pruned(policy, new OctileHeuristic());
+	FlexibleAStar astar(new IncidentEdgesExpansionPolicy(map), 
+			new OctileHeuristic());
+
+	// the room lies between these two locations; without the filter
+	// the search is drawn into it.
+	node* start = map->getNodeFromMap(0, 2);
+	node* goal = map->getNodeFromMap(19, 2);
+	path* p1 = astar.getPath(map, start, goal);
+	long expanded = astar.getNodesExpanded();
+	path* p2 = pruned.getPath(map, start, goal);
+	CPPUNIT_ASSERT_MESSAGE("no path found with the filter", p2 != 0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("path with the filter not optimal", 
+			map->distance(p1), map->distance(p2), 0.0001);
+	CPPUNIT_ASSERT_MESSAGE("filter did not reduce the number of nodes expanded", 
+			pruned.getNodesExpanded() < expanded);
+	delete p1;
+	delete p2;
+
+	// a sample of the other pairs of locations
+	PathComparison::assertOptimalPaths(map, &astar, &pruned, 
+			map->getAbstractGraph(0), true, 3, 7, 1);
+}
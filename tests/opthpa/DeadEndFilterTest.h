@@ -0,0 +1,35 @@
+#ifndef DEADENDFILTERTEST_H
+#define DEADENDFILTERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+
+class DeadEndFilter;
+class HPAClusterAbstraction;
+class DeadEndFilterTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( DeadEndFilterTest );
+
+	CPPUNIT_TEST_EXCEPTION( constructorThrowsExceptionGivenANullMapAbstraction, std::invalid_argument );
+	CPPUNIT_TEST( constructorFindsRegionsBehindNarrowEntrances );
+	CPPUNIT_TEST( filterSkipsDeadEndsWhichHoldNeitherStartNorGoal );
+	CPPUNIT_TEST( searchWithFilterExpandsFewerNodesAndFindsOptimalPaths );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void constructorThrowsExceptionGivenANullMapAbstraction();
+		void constructorFindsRegionsBehindNarrowEntrances();
+		void filterSkipsDeadEndsWhichHoldNeitherStartNorGoal();
+		void searchWithFilterExpandsFewerNodesAndFindsOptimalPaths();
+
+	private:
+		HPAClusterAbstraction* map;
+		DeadEndFilter* filter;
+};
+
+#endif
@@ -6,6 +6,8 @@
 #include "EmptyClusterAbstraction.h"
 #include "EmptyClusterFactory.h"
 #include "HPAUtil.h"
+#include "MacroEdgeFactory.h"
+#include "MacroNodeFactory.h"
 #include "map.h"
 #include "TestConstants.h"
 #include <sstream>
@@ -59,6 +61,25 @@ void EmptyClusterAbstractionTest::buildClustersDecomposesTheMapIntoEmptyClusters
 	}
 }
 
+void EmptyClusterAbstractionTest::buildClustersCoversAnObstacleFreeMapWithASingleCluster()
+{
+	EmptyClusterAbstraction ecmap(new Map(emptymap.c_str()), new EmptyClusterFactory(), 
+			new ClusterNodeFactory(), new EdgeFactory());
+	ecmap.buildClusters();
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("failed to build correct # of clusters", 
+			1, ecmap.getNumClusters());
+
+	cluster_iterator it = ecmap.getClusterIter();
+	EmptyCluster* cluster = ecmap.clusterIterNext(it);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("cluster has wrong origin", 0, 
+			cluster->getHOrigin() + cluster->getVOrigin());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("cluster has wrong width", 
+			ecmap.getMap()->getMapWidth(), cluster->getWidth());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("cluster has wrong height", 
+			ecmap.getMap()->getMapHeight(), cluster->getHeight());
+}
+
 void EmptyClusterAbstractionTest::buildEntrancesConnectsAllClusters()
 {
 	EmptyClusterAbstraction ecmap(new Map(hpastartest.c_str()), new EmptyClusterFactory(), 
@@ -106,6 +127,29 @@ void EmptyClusterAbstractionTest::buildEntrancesConnectsAllClustersWhenAllowDiag
 			expectedNumAbstractNodes, g->getNumNodes());
 }
 
+void EmptyClusterAbstractionTest::buildEntrancesStoresNoSecondaryEdgesWhenImplicitSecondaryEdgesIsSet()
+{
+	EmptyClusterAbstraction stored(new Map(hpastartest.c_str()), 
+			new EmptyClusterFactory(), new MacroNodeFactory(), 
+			new MacroEdgeFactory(), true, true, true);
+	stored.buildClusters();
+	stored.buildEntrances();
+
+	EmptyClusterAbstraction implicit(new Map(hpastartest.c_str()), 
+			new EmptyClusterFactory(), new MacroNodeFactory(), 
+			new MacroEdgeFactory(), true, true, true);
+	implicit.setImplicitSecondaryEdges(true);
+	implicit.buildClusters();
+	implicit.buildEntrances();
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("abstract edge count is wrong", 
+			stored.getAbstractGraph(1)->getNumEdges(), 
+			implicit.getAbstractGraph(1)->getNumEdges());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("secondary edges were stored", 
+			implicit.getAbstractGraph(1)->getNumEdges(), 
+			implicit.getNumAbsEdges());
+}
+
 void EmptyClusterAbstractionTest::insertStartAndGoalNodesIntoAbstractGraphWorksAsAdvertised()
 {
 	EmptyClusterAbstraction ecmap(new Map(hpastartest.c_str()), new EmptyClusterFactory(), 
@@ -220,3 +264,34 @@ void EmptyClusterAbstractionTest::hComputesTileDistanceBetweenTwoNodes()
 	CPPUNIT_ASSERT_EQUAL_MESSAGE("h computes wrong cost", expectedCost, 
 		   ecmap.h(goal, start));	
 }
+
+void EmptyClusterAbstractionTest::repairAbstractionSplitsAndMergesRoomsWhenATileIsClosedAndReopened()
+{
+	EmptyClusterAbstraction ecmap(new Map(emptymap.c_str()), 
+			new EmptyClusterFactory(), new MacroNodeFactory(), 
+			new MacroEdgeFactory());
+	ecmap.buildClusters();
+	ecmap.buildEntrances();
+
+	graph* absg = ecmap.getAbstractGraph(1);
+	int numAbstractNodes = absg->getNumNodes();
+	int numAbstractEdges = absg->getNumEdges();
+
+	ecmap.closeTile(4,4);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of clusters queued for repair", 
+			1, ecmap.getNumClustersToRepair());
+	ecmap.repairAbstraction();
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("room not split after closing tile", 
+			true, ecmap.getNumClusters() > 1);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("closed tile assigned to a room", 
+			true, ecmap.findClusterContaining(4,4) == 0);
+
+	ecmap.openTile(4,4);
+	ecmap.repairAbstraction();
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("rooms not merged after reopening tile", 
+			1, ecmap.getNumClusters());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract nodes after repair", 
+			numAbstractNodes, absg->getNumNodes());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of abstract edges after repair", 
+			numAbstractEdges, absg->getNumEdges());
+}
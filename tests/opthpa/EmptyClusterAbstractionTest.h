@@ -9,11 +9,14 @@ class EmptyClusterAbstractionTest : public CPPUNIT_NS::TestFixture
 	CPPUNIT_TEST_SUITE( EmptyClusterAbstractionTest );
 
 	CPPUNIT_TEST( buildClustersDecomposesTheMapIntoEmptyClusters );
+	CPPUNIT_TEST( buildClustersCoversAnObstacleFreeMapWithASingleCluster );
 	CPPUNIT_TEST( buildEntrancesConnectsAllClusters );
 	CPPUNIT_TEST( buildEntrancesConnectsAllClustersWhenAllowDiagonalsIsSet );
+	CPPUNIT_TEST( buildEntrancesStoresNoSecondaryEdgesWhenImplicitSecondaryEdgesIsSet );
 	CPPUNIT_TEST( insertStartAndGoalNodesIntoAbstractGraphWorksAsAdvertised );
 	CPPUNIT_TEST( insertStartAndGoalNodesIntoAbstractGraphDoesNotAddAnythingIfStartOrGoalExistInGraphAlready );
 	CPPUNIT_TEST( hComputesTileDistanceBetweenTwoNodes );
+	CPPUNIT_TEST( repairAbstractionSplitsAndMergesRoomsWhenATileIsClosedAndReopened );
 
 	CPPUNIT_TEST_SUITE_END();
 
@@ -23,12 +26,15 @@ class EmptyClusterAbstractionTest : public CPPUNIT_NS::TestFixture
 		void tearDown();
 
 		void buildClustersDecomposesTheMapIntoEmptyClusters();
+		void buildClustersCoversAnObstacleFreeMapWithASingleCluster();
 		void buildEntrancesConnectsAllClusters();
 		void buildEntrancesConnectsAllClustersWhenAllowDiagonalsIsSet();
+		void buildEntrancesStoresNoSecondaryEdgesWhenImplicitSecondaryEdgesIsSet();
 
 		void insertStartAndGoalNodesIntoAbstractGraphWorksAsAdvertised();
 		void insertStartAndGoalNodesIntoAbstractGraphDoesNotAddAnythingIfStartOrGoalExistInGraphAlready();
 		void hComputesTileDistanceBetweenTwoNodes();
+		void repairAbstractionSplitsAndMergesRoomsWhenATileIsClosedAndReopened();
 
 };
 
@@ -0,0 +1,202 @@
+#include "LandmarkHeuristicTest.h"
+
+#include "ClusterNodeFactory.h"
+#include "EdgeFactory.h"
+#include "EmptyClusterAbstraction.h"
+#include "EmptyClusterFactory.h"
+#include "FlexibleAStar.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "OctileHeuristic.h"
+#include "graph.h"
+#include "map.h"
+#include "mapFlatAbstraction.h"
+#include "path.h"
+#include "TestConstants.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( LandmarkHeuristicTest );
+
+void LandmarkHeuristicTest::setUp()
+{
+	map = new EmptyClusterAbstraction(new Map(hpastartest.c_str()), 
+			new EmptyClusterFactory(), new ClusterNodeFactory(), new EdgeFactory());
+}
+
+void LandmarkHeuristicTest::tearDown()
+{
+	delete map;
+}
+
+void LandmarkHeuristicTest::constructorThrowsExceptionGivenANullMapAbstraction()
+{
+	LandmarkHeuristic lh(0);
+}
+
+void LandmarkHeuristicTest::computeLandmarksMeasuresDistancesFromEachLandmark()
+{
+	LandmarkHeuristic lh(map);
+	lh.computeLandmarks(3, LandmarkUtil::kFarthest);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of landmarks", 3u, lh.getNumLandmarks());
+
+	int width = map->getMap()->getMapWidth();
+	for(unsigned int l=0; l<lh.getNumLandmarks(); l++)
+	{
+		int x = lh.getLandmark(l) % width;
+		int y = lh.getLandmark(l) / width;
+		CPPUNIT_ASSERT_MESSAGE("landmark is not a traversable location", 
+				map->getNodeFromMap(x, y) != 0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("landmark is not at distance 0 from itself", 
+				0.0, lh.getDistance(l, x, y), 0.0001);
+	}
+}
+
+void LandmarkHeuristicTest::hIsAdmissibleAndNoLessThanOctileDistanceForEachSelectionMethod()
+{
+	checkAdmissible(LandmarkUtil::kFarthest);
+	checkAdmissible(LandmarkUtil::kAvoid);
+	checkAdmissible(LandmarkUtil::kRandom);
+}
+
+void LandmarkHeuristicTest::loadReadsTheDistanceTablesWrittenBySave()
+{
+	LandmarkHeuristic lh(map);
+	lh.computeLandmarks(2, LandmarkUtil::kAvoid);
+	std::string filename("landmarkheuristictest.landmarks");
+	lh.save(filename.c_str());
+
+	LandmarkHeuristic lh2(map);
+	CPPUNIT_ASSERT_MESSAGE("failed to load landmark file", lh2.load(filename.c_str()));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of landmarks after load", 
+			lh.getNumLandmarks(), lh2.getNumLandmarks());
+
+	int width = map->getMap()->getMapWidth();
+	int height = map->getMap()->getMapHeight();
+	for(unsigned int l=0; l<lh.getNumLandmarks(); l++)
+	{
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("landmark differs after load", 
+				lh.getLandmark(l), lh2.getLandmark(l));
+		for(int x=0; x<width; x++)
+			for(int y=0; y<height; y++)
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("distance differs after load", 
+						lh.getDistance(l, x, y), lh2.getDistance(l, x, y));
+	}
+	remove(filename.c_str());
+}
+
+void LandmarkHeuristicTest::loadFailsGivenAMissingFile()
+{
+	LandmarkHeuristic lh(map);
+	CPPUNIT_ASSERT_MESSAGE("loaded a file which does not exist", 
+			!lh.load("nosuchfile.landmarks"));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("failed load changed the distance tables", 
+			0u, lh.getNumLandmarks());
+}
+
+void LandmarkHeuristicTest::loadFailsGivenAFileWrittenForAMapWithDifferentTerrain()
+{
+	LandmarkHeuristic lh(map);
+	lh.computeLandmarks(2, LandmarkUtil::kAvoid);
+	std::string filename("landmarkheuristictest.landmarks");
+	lh.save(filename.c_str());
+
+	// same dimensions; one more obstacle
+	Map* edited = new Map(hpastartest.c_str());
+	for(int x=0; x<edited->getMapWidth(); x++)
+		if(edited->getTerrainType(x, 0) != kOutOfBounds)
+		{
+			edited->setTerrainType(x, 0, kOutOfBounds);
+			break;
+		}
+	mapFlatAbstraction editedmap(edited);
+
+	LandmarkHeuristic lh2(&editedmap);
+	CPPUNIT_ASSERT_MESSAGE("loaded a file written for a different map", 
+			!lh2.load(filename.c_str()));
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("failed load changed the distance tables", 
+			0u, lh2.getNumLandmarks());
+	remove(filename.c_str());
+}
+
+// A serpentine corridor longer than 16 bits can measure. The stored
+// distances must saturate rather than be scaled down to nothing.
+void LandmarkHeuristicTest::distancesTooLongFor16BitsSaturate()
+{
+	int width = 256;
+	int height = 540;
+	std::string filename("landmarkheuristictest.map");
+	std::ofstream out(filename.c_str());
+	out << "type octile\nheight "<<height<<"\nwidth "<<width<<"\nmap\n";
+	for(int y=0; y<height; y++)
+	{
+		for(int x=0; x<width; x++)
+		{
+			// every other row is a wall with a gap at alternating ends
+			bool gap = (y % 4 == 1 && x == width-1) || (y % 4 == 3 && x == 0);
+			out << (y % 2 == 0 || gap ? '.' : '@');
+		}
+		out << "\n";
+	}
+	out.close();
+
+	mapFlatAbstraction corridor(new Map(filename.c_str()));
+	remove(filename.c_str());
+
+	LandmarkHeuristic lh(&corridor);
+	lh.computeLandmarks(1, LandmarkUtil::kFarthest);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of landmarks", 1u, lh.getNumLandmarks());
+
+	int l = lh.getLandmark(0);
+	node* landmark = corridor.getNodeFromMap(l % width, l / width);
+	node* farthest = landmark;
+	graph* g = corridor.getAbstractGraph(0);
+	for(int i=0; i<g->getNumNodes(); i++)
+	{
+		node* n = g->getNode(i);
+		double d = lh.getDistance(0, n->getLabelL(kFirstData), n->getLabelL(kFirstData+1));
+		CPPUNIT_ASSERT_MESSAGE("reachable location has no distance", d >= 0);
+		if(d > lh.getDistance(0, farthest->getLabelL(kFirstData), farthest->getLabelL(kFirstData+1)))
+			farthest = n;
+	}
+
+	double h = lh.h(landmark, farthest);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("longest distance did not saturate", 
+			LandmarkHeuristic::kUnreachable - 1, h, 0.0001);
+
+	FlexibleAStar astar(new IncidentEdgesExpansionPolicy(&corridor), new OctileHeuristic());
+	path* p = astar.getPath(&corridor, landmark, farthest);
+	CPPUNIT_ASSERT_MESSAGE("no path along the corridor", p != 0);
+	CPPUNIT_ASSERT_MESSAGE("h overestimates the length of the corridor", h <= corridor.distance(p));
+	delete p;
+}
+
+// compares h against the length of an optimal path between every pair of 
+// locations
+void LandmarkHeuristicTest::checkAdmissible(LandmarkUtil::LandmarkSelection selection)
+{
+	LandmarkHeuristic lh(map);
+	lh.computeLandmarks(4, selection);
+	OctileHeuristic octile;
+
+	graph* g = map->getAbstractGraph(0);
+	for(int i=0; i<g->getNumNodes(); i++)
+		for(int j=0; j<g->getNumNodes(); j++)
+		{
+			node* first = g->getNode(i);
+			node* second = g->getNode(j);
+			double h = lh.h(first, second);
+			CPPUNIT_ASSERT_MESSAGE("h is less than octile distance", 
+					h >= octile.h(first, second));
+
+			FlexibleAStar astar(new IncidentEdgesExpansionPolicy(map), new OctileHeuristic());
+			path* p = astar.getPath(map, first, second);
+			if(p)
+			{
+				std::stringstream err;
+				err << "h overestimates the distance from "<<first->getName()<<" to "<<second->getName();
+				CPPUNIT_ASSERT_MESSAGE(err.str().c_str(), h <= map->distance(p) + 0.0001);
+			}
+			delete p;
+		}
+}
@@ -0,0 +1,43 @@
+#ifndef LANDMARKHEURISTICTEST_H
+#define LANDMARKHEURISTICTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+
+#include "LandmarkHeuristic.h"
+
+class EmptyClusterAbstraction;
+class LandmarkHeuristicTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( LandmarkHeuristicTest );
+
+	CPPUNIT_TEST_EXCEPTION( constructorThrowsExceptionGivenANullMapAbstraction, std::invalid_argument );
+	CPPUNIT_TEST( computeLandmarksMeasuresDistancesFromEachLandmark );
+	CPPUNIT_TEST( hIsAdmissibleAndNoLessThanOctileDistanceForEachSelectionMethod );
+	CPPUNIT_TEST( loadReadsTheDistanceTablesWrittenBySave );
+	CPPUNIT_TEST( loadFailsGivenAMissingFile );
+	CPPUNIT_TEST( loadFailsGivenAFileWrittenForAMapWithDifferentTerrain );
+	CPPUNIT_TEST( distancesTooLongFor16BitsSaturate );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void constructorThrowsExceptionGivenANullMapAbstraction();
+		void computeLandmarksMeasuresDistancesFromEachLandmark();
+		void hIsAdmissibleAndNoLessThanOctileDistanceForEachSelectionMethod();
+		void loadReadsTheDistanceTablesWrittenBySave();
+		void loadFailsGivenAMissingFile();
+		void loadFailsGivenAFileWrittenForAMapWithDifferentTerrain();
+		void distancesTooLongFor16BitsSaturate();
+
+	private:
+		void checkAdmissible(LandmarkUtil::LandmarkSelection selection);
+
+		EmptyClusterAbstraction* map;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#include "OctileHeuristicTest.h"
+
+#include "ClusterNodeFactory.h"
+#include "EdgeFactory.h"
+#include "EmptyClusterAbstraction.h"
+#include "EmptyClusterFactory.h"
+#include "ManhattanHeuristic.h"
+#include "OctileHeuristic.h"
+#include "constants.h"
+#include "graph.h"
+#include "map.h"
+#include "TestConstants.h"
+
+#include <vector>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( OctileHeuristicTest );
+
+void OctileHeuristicTest::setUp()
+{
+	map = new EmptyClusterAbstraction(new Map(maplocation.c_str()), 
+			new EmptyClusterFactory(), new ClusterNodeFactory(), 
+			new EdgeFactory());
+}
+
+void OctileHeuristicTest::tearDown()
+{
+	delete map;
+}
+
+void OctileHeuristicTest::hReturnsOctileDistance()
+{
+	OctileHeuristic h;
+	graph* g = map->getAbstractGraph(0);
+	node* a = g->getNode(0);
+	node* b = g->getNode(g->getNumNodes()-1);
+	double dx = fabs(a->getLabelL(kFirstData) - b->getLabelL(kFirstData));
+	double dy = fabs(a->getLabelL(kFirstData+1) - b->getLabelL(kFirstData+1));
+	double expected = dx < dy ? (ROOT_TWO-1)*dx + dy : (ROOT_TWO-1)*dy + dx;
+
+	CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("wrong octile distance", 
+			expected, h.h(a, b), 0.0001);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE("octile distance not symmetric", 
+			h.h(a, b), h.h(b, a), 0.0001);
+}
+
+// batches of every size up to 9 so that the last node of a batch is 
+// sometimes handled on its own
+void OctileHeuristicTest::hBatchReturnsTheSameValuesAsH()
+{
+	OctileHeuristic octile;
+	ManhattanHeuristic manhattan;
+	graph* g = map->getAbstractGraph(0);
+	std::vector<node*> nodes;
+	for(int i=0; i<g->getNumNodes(); i++)
+		nodes.push_back(g->getNode(i));
+	node* goal = nodes.at(nodes.size()/2);
+
+	double out[9];
+	for(unsigned int count=1; count<=9; count++)
+	{
+		for(unsigned int i=0; i+count<=nodes.size(); i+=count)
+		{
+			octile.h_batch(&nodes[i], count, goal, out);
+			for(unsigned int j=0; j<count; j++)
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("octile batch differs from h", 
+						octile.h(nodes[i+j], goal), out[j]);
+
+			manhattan.h_batch(&nodes[i], count, goal, out);
+			for(unsigned int j=0; j<count; j++)
+				CPPUNIT_ASSERT_EQUAL_MESSAGE("manhattan batch differs from h", 
+						manhattan.h(nodes[i+j], goal), out[j]);
+		}
+	}
+}
+
+void OctileHeuristicTest::hBatchThrowsExceptionGivenANullNode()
+{
+	OctileHeuristic h;
+	graph* g = map->getAbstractGraph(0);
+	node* nodes[2] = { g->getNode(0), 0 };
+	double out[2];
+	h.h_batch(nodes, 2, g->getNode(1), out);
+}
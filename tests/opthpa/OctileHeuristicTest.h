@@ -0,0 +1,31 @@
+#ifndef OCTILEHEURISTICTEST_H
+#define OCTILEHEURISTICTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+
+class EmptyClusterAbstraction;
+class OctileHeuristicTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( OctileHeuristicTest );
+
+	CPPUNIT_TEST( hReturnsOctileDistance );
+	CPPUNIT_TEST( hBatchReturnsTheSameValuesAsH );
+	CPPUNIT_TEST_EXCEPTION( hBatchThrowsExceptionGivenANullNode, std::invalid_argument );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void hReturnsOctileDistance();
+		void hBatchReturnsTheSameValuesAsH();
+		void hBatchThrowsExceptionGivenANullNode();
+
+	private:
+		EmptyClusterAbstraction* map;
+};
+
+#endif
@@ -0,0 +1,122 @@
+#include "RRJumpExpansionPolicyTest.h"
+
+#include "EmptyClusterAbstraction.h"
+#include "EmptyClusterFactory.h"
+#include "EmptyClusterInsertionPolicy.h"
+#include "FlexibleAStar.h"
+#include "HierarchicalSearch.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "JumpPointsExpansionPolicy.h"
+#include "MacroEdgeFactory.h"
+#include "MacroNodeFactory.h"
+#include "NoInsertionPolicy.h"
+#include "OctileDistanceRefinementPolicy.h"
+#include "OctileHeuristic.h"
+#include "PathComparison.h"
+#include "RRJumpExpansionPolicy.h"
+#include "VirtualOverlayExpansionPolicy.h"
+#include "graph.h"
+#include "map.h"
+#include "path.h"
+#include "TestConstants.h"
+#include <sstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( RRJumpExpansionPolicyTest );
+
+void RRJumpExpansionPolicyTest::setUp()
+{
+}
+
+void RRJumpExpansionPolicyTest::tearDown()
+{
+}
+
+EmptyClusterAbstraction* RRJumpExpansionPolicyTest::newMap(
+		const char* filename)
+{
+	EmptyClusterAbstraction* map = new EmptyClusterAbstraction(
+			new Map(filename), new EmptyClusterFactory(), 
+			new MacroNodeFactory(), new MacroEdgeFactory());
+	map->buildClusters();
+	map->buildEntrances();
+	return map;
+}
+
+// RSR, set up as in hog
+HierarchicalSearch* RRJumpExpansionPolicyTest::newRoomSearch(
+		EmptyClusterAbstraction* map)
+{
+	EmptyClusterInsertionPolicy* insertion = 
+		new EmptyClusterInsertionPolicy(map);
+	return new HierarchicalSearch(insertion, 
+			new FlexibleAStar(new VirtualOverlayExpansionPolicy(
+					new IncidentEdgesExpansionPolicy(map), insertion), 
+				new OctileHeuristic()),
+			new OctileDistanceRefinementPolicy(map));
+}
+
+HierarchicalSearch* RRJumpExpansionPolicyTest::newRoomJumpSearch(
+		EmptyClusterAbstraction* map)
+{
+	return new HierarchicalSearch(new NoInsertionPolicy(), 
+			new FlexibleAStar(new RRJumpExpansionPolicy(map), 
+				new OctileHeuristic()),
+			new OctileDistanceRefinementPolicy(map));
+}
+
+void RRJumpExpansionPolicyTest::assertSameCosts(const char* filename)
+{
+	EmptyClusterAbstraction* map = newMap(filename);
+	HierarchicalSearch* rsr = newRoomSearch(map);
+	HierarchicalSearch* rsrjps = newRoomJumpSearch(map);
+
+	PathComparison::assertOptimalPaths(map, rsr, rsrjps, 
+			map->getAbstractGraph(0), false, 3);
+
+	delete rsrjps;
+	delete rsr;
+	delete map;
+}
+
+void RRJumpExpansionPolicyTest::pathCostsAreTheSameAsThoseOfRoomSearch()
+{
+	assertSameCosts(maplocation.c_str());
+}
+
+// a single room; every scan crosses it in one step
+void RRJumpExpansionPolicyTest::
+	pathCostsAreTheSameAsThoseOfRoomSearchOnAnObstacleFreeMap()
+{
+	assertSameCosts(emptymap.c_str());
+}
+
+void RRJumpExpansionPolicyTest::expandsAsManyNodesAsJumpPointSearch()
+{
+	EmptyClusterAbstraction* map = newMap(maplocation.c_str());
+	HierarchicalSearch* jps = new HierarchicalSearch(new NoInsertionPolicy(),
+			new FlexibleAStar(new JumpPointsExpansionPolicy(), 
+				new OctileHeuristic()),
+			new OctileDistanceRefinementPolicy(map));
+	HierarchicalSearch* rsrjps = newRoomJumpSearch(map);
+
+	graph* g = map->getAbstractGraph(0);
+	unsigned int numnodes = g->getNumNodes();
+	for(unsigned int i=0; i<numnodes; i+=5)
+		for(unsigned int j=1; j<numnodes; j+=3)
+		{
+			node* start = g->getNode(i);
+			node* goal = g->getNode(j);
+			delete jps->getPath(map, start, goal);
+			delete rsrjps->getPath(map, start, goal);
+
+			std::stringstream err;
+			err << "wrong # of expansions from "<<start->getName()<<
+				" to "<<goal->getName();
+			CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), 
+					jps->getNodesExpanded(), rsrjps->getNodesExpanded());
+		}
+
+	delete rsrjps;
+	delete jps;
+	delete map;
+}
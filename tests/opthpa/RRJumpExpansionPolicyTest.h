@@ -0,0 +1,34 @@
+#ifndef RRJUMPEXPANSIONPOLICYTEST_H
+#define RRJUMPEXPANSIONPOLICYTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class EmptyClusterAbstraction;
+class HierarchicalSearch;
+class RRJumpExpansionPolicyTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( RRJumpExpansionPolicyTest );
+
+	CPPUNIT_TEST( pathCostsAreTheSameAsThoseOfRoomSearch );
+	CPPUNIT_TEST( pathCostsAreTheSameAsThoseOfRoomSearchOnAnObstacleFreeMap );
+	CPPUNIT_TEST( expandsAsManyNodesAsJumpPointSearch );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void pathCostsAreTheSameAsThoseOfRoomSearch();
+		void pathCostsAreTheSameAsThoseOfRoomSearchOnAnObstacleFreeMap();
+		void expandsAsManyNodesAsJumpPointSearch();
+
+	private:
+		EmptyClusterAbstraction* newMap(const char* filename);
+		HierarchicalSearch* newRoomSearch(EmptyClusterAbstraction* map);
+		HierarchicalSearch* newRoomJumpSearch(EmptyClusterAbstraction* map);
+		void assertSameCosts(const char* filename);
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include "RoomDecompositionTest.h"
+
+#include "EmptyCluster.h"
+#include "EmptyClusterAbstraction.h"
+#include "EmptyClusterFactory.h"
+#include "MacroEdgeFactory.h"
+#include "MacroNodeFactory.h"
+#include "map.h"
+#include "TestConstants.h"
+#include "WorkerThreads.h"
+#include <sstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( RoomDecompositionTest );
+
+void RoomDecompositionTest::setUp()
+{
+}
+
+void RoomDecompositionTest::tearDown()
+{
+	WorkerThreads::setNumThreads(1);
+}
+
+// @param rooms: the origin and size {x, y, width, height} of each room, 
+// in the order the rooms are created
+void RoomDecompositionTest::assertRooms(const char* filename, 
+		int rooms[][4], int numExpectedRooms)
+{
+	EmptyClusterAbstraction ecmap(new Map(filename), 
+			new EmptyClusterFactory(), new MacroNodeFactory(), 
+			new MacroEdgeFactory());
+	ecmap.buildClusters();
+
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong # of rooms", numExpectedRooms, 
+			ecmap.getNumClusters());
+
+	int index = 0;
+	cluster_iterator it = ecmap.getClusterIter();
+	for(EmptyCluster* room = ecmap.clusterIterNext(it); room; 
+			room = ecmap.clusterIterNext(it), index++)
+	{
+		std::stringstream err;
+		err << "room "<<index<<" differs";
+		CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), rooms[index][0], 
+				room->getHOrigin());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), rooms[index][1], 
+				room->getVOrigin());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), rooms[index][2], 
+				room->getWidth());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), rooms[index][3], 
+				room->getHeight());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), 
+				rooms[index][2]*rooms[index][3], room->getNumNodes());
+	}
+}
+
+// Both abstractions have the same rooms, in the same order
+void RoomDecompositionTest::assertSameRooms(EmptyClusterAbstraction& expected,
+		EmptyClusterAbstraction& actual)
+{
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong # of rooms", 
+			expected.getNumClusters(), actual.getNumClusters());
+
+	int index = 0;
+	cluster_iterator it = actual.getClusterIter();
+	cluster_iterator expectedit = expected.getClusterIter();
+	for(EmptyCluster* exp = expected.clusterIterNext(expectedit); exp;
+			exp = expected.clusterIterNext(expectedit), index++)
+	{
+		std::stringstream err;
+		err << "room "<<index<<" differs";
+		EmptyCluster* room = actual.clusterIterNext(it);
+		CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), 
+				exp->getHOrigin(), room->getHOrigin());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), 
+				exp->getVOrigin(), room->getVOrigin());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), 
+				exp->getWidth(), room->getWidth());
+		CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), 
+				exp->getHeight(), room->getHeight());
+	}
+}
+
+void RoomDecompositionTest::demoMapIsDecomposedIntoTheSameRoomsAsBefore()
+{
+	int rooms[21][4] = {
+		{1, 7, 18, 2}, {17, 1, 4, 5}, {2, 1, 5, 3}, {7, 3, 3, 4}, 
+		{21, 7, 3, 3}, {2, 9, 7, 1}, {10, 4, 7, 1}, {1, 4, 2, 3}, 
+		{15, 6, 5, 1}, {15, 1, 2, 2}, {15, 9, 4, 1}, {22, 1, 2, 2}, 
+		{23, 4, 1, 3}, {7, 1, 2, 1}, {8, 2, 2, 1}, {1, 2, 1, 2}, 
+		{20, 8, 1, 2}, {15, 5, 1, 1}, {21, 4, 1, 1}, {15, 3, 1, 1}, 
+		{22, 6, 1, 1}};
+	assertRooms(maplocation.c_str(), rooms, 21);
+}
+
+void RoomDecompositionTest::deadEndMapIsDecomposedIntoTheSameRoomsAsBefore()
+{
+	int rooms[5][4] = {
+		{0, 0, 9, 15}, {16, 0, 4, 15}, {10, 0, 5, 10}, {9, 11, 7, 4}, 
+		{9, 2, 1, 1}};
+	assertRooms(deadendtest.c_str(), rooms, 5);
+}
+
+// CSC2F is taller than one strip (see EmptyClusterAbstraction::buildRooms),
+// so rooms are carved on several threads and joined across the strip edge
+void RoomDecompositionTest::roomsDoNotDependOnTheNumberOfThreads()
+{
+	WorkerThreads::setNumThreads(1);
+	EmptyClusterAbstraction serial(new Map(csc2f.c_str()), 
+			new EmptyClusterFactory(), new MacroNodeFactory(), 
+			new MacroEdgeFactory());
+	serial.buildClusters();
+	serial.buildEntrances();
+
+	WorkerThreads::setNumThreads(4);
+	EmptyClusterAbstraction parallel(new Map(csc2f.c_str()), 
+			new EmptyClusterFactory(), new MacroNodeFactory(), 
+			new MacroEdgeFactory());
+	parallel.buildClusters();
+	parallel.buildEntrances();
+
+	assertSameRooms(serial, parallel);
+
+	graph* expectedg = serial.getAbstractGraph(1);
+	graph* absg = parallel.getAbstractGraph(1);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong # of abstract nodes", 
+			expectedg->getNumNodes(), absg->getNumNodes());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong # of abstract edges", 
+			expectedg->getNumEdges(), absg->getNumEdges());
+	edge_iterator edgeit = expectedg->getEdgeIter();
+	for(edge* e = expectedg->edgeIterNext(edgeit); e; 
+			e = expectedg->edgeIterNext(edgeit))
+	{
+		edge* found = absg->findEdge(e->getFrom(), e->getTo());
+		CPPUNIT_ASSERT_MESSAGE("abstract edge missing", found != 0);
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("abstract edge has wrong weight", 
+				e->getWeight(), found->getWeight());
+	}
+}
+
+// CSC2F has rooms of every shape, so a room size the table gets wrong 
+// changes the order in which rooms are carved
+void RoomDecompositionTest::seedingFromTheTableGivesTheSameRoomsAsTrialRooms()
+{
+	EmptyClusterAbstraction trial(new Map(csc2f.c_str()), 
+			new EmptyClusterFactory(), new MacroNodeFactory(), 
+			new MacroEdgeFactory());
+	trial.setTrialRoomSeeds(true);
+	trial.buildClusters();
+
+	EmptyClusterAbstraction table(new Map(csc2f.c_str()), 
+			new EmptyClusterFactory(), new MacroNodeFactory(), 
+			new MacroEdgeFactory());
+	table.buildClusters();
+
+	assertSameRooms(trial, table);
+}
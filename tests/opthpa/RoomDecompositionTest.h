@@ -0,0 +1,44 @@
+#ifndef ROOMDECOMPOSITIONTEST_H
+#define ROOMDECOMPOSITIONTEST_H
+
+// RoomDecompositionTest.h
+//
+// Regression tests for the rooms which EmptyClusterAbstraction::buildClusters
+// carves from a map. The expected rooms were recorded when every trial 
+// room was still built (and discarded) as a cluster.
+//
+// @created: 17/10/2026
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class EmptyClusterAbstraction;
+
+class RoomDecompositionTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( RoomDecompositionTest );
+
+	CPPUNIT_TEST( demoMapIsDecomposedIntoTheSameRoomsAsBefore );
+	CPPUNIT_TEST( deadEndMapIsDecomposedIntoTheSameRoomsAsBefore );
+	CPPUNIT_TEST( roomsDoNotDependOnTheNumberOfThreads );
+	CPPUNIT_TEST( seedingFromTheTableGivesTheSameRoomsAsTrialRooms );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void demoMapIsDecomposedIntoTheSameRoomsAsBefore();
+		void deadEndMapIsDecomposedIntoTheSameRoomsAsBefore();
+		void roomsDoNotDependOnTheNumberOfThreads();
+		void seedingFromTheTableGivesTheSameRoomsAsTrialRooms();
+
+	private:
+		void assertRooms(const char* filename, int rooms[][4], 
+				int numExpectedRooms);
+		void assertSameRooms(EmptyClusterAbstraction& expected, 
+				EmptyClusterAbstraction& actual);
+};
+
+#endif
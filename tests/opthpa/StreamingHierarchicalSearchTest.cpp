@@ -0,0 +1,150 @@
+#include "StreamingHierarchicalSearchTest.h"
+
+#include "ClusterNodeFactory.h"
+#include "DefaultInsertionPolicy.h"
+#include "DefaultRefinementPolicy.h"
+#include "EdgeFactory.h"
+#include "FlexibleAStar.h"
+#include "HierarchicalSearch.h"
+#include "HPAClusterAbstraction.h"
+#include "HPAClusterFactory.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "OctileHeuristic.h"
+#include "StreamingHierarchicalSearch.h"
+#include "graph.h"
+#include "map.h"
+#include "path.h"
+#include "TestConstants.h"
+#include <sstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( StreamingHierarchicalSearchTest );
+
+void StreamingHierarchicalSearchTest::setUp()
+{
+	map = new HPAClusterAbstraction(new Map(maplocation.c_str()), 
+			new HPAClusterFactory(), new ClusterNodeFactory(), 
+			new EdgeFactory());
+	map->setClusterSize(TESTCLUSTERSIZE);
+	map->buildClusters();
+	map->buildEntrances();
+}
+
+void StreamingHierarchicalSearchTest::tearDown()
+{
+	delete map;
+}
+
+HierarchicalSearch* StreamingHierarchicalSearchTest::newSearch()
+{
+	return new HierarchicalSearch(new DefaultInsertionPolicy(map), 
+			new FlexibleAStar(new IncidentEdgesExpansionPolicy(map), 
+				new OctileHeuristic()), 
+			new DefaultRefinementPolicy(map));
+}
+
+// joins the segments returned by the search, as a unit following them 
+// would; each new segment begins where the last one ended.
+path* StreamingHierarchicalSearchTest::streamPath(
+		StreamingHierarchicalSearch* search, node* start, node* goal, 
+		int& numSegments)
+{
+	numSegments = 0;
+	path* thepath = search->getPath(map, start, goal);
+	if(thepath == 0)
+		return 0;
+	numSegments++;
+
+	path* segment;
+	while((segment = search->think()))
+	{
+		numSegments++;
+		path* tail = thepath->tail();
+		CPPUNIT_ASSERT_MESSAGE("segment does not begin where the last one ended", 
+				segment->n == tail->n);
+		tail->next = segment->next;
+		segment->next = 0;
+		delete segment;
+	}
+	return thepath;
+}
+
+void StreamingHierarchicalSearchTest::assertSamePath(path* expected, path* p)
+{
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("path found by only one search", 
+			expected == 0, p == 0);
+	for( ; expected && p; expected = expected->next, p = p->next)
+		CPPUNIT_ASSERT_MESSAGE("streamed path differs", expected->n == p->n);
+	CPPUNIT_ASSERT_MESSAGE("streamed path has a different length", 
+			expected == 0 && p == 0);
+}
+
+void StreamingHierarchicalSearchTest::streamedPathIsTheSameAsTheFullyRefinedPath()
+{
+	HierarchicalSearch* full = newSearch();
+	StreamingHierarchicalSearch streamed(newSearch());
+
+	graph* g = map->getAbstractGraph(0);
+	int maxSegments = 0;
+	for(int i=0; i<g->getNumNodes(); i+=5)
+		for(int j=1; j<g->getNumNodes(); j+=3)
+		{
+			if(i == j)
+				continue;
+
+			node* start = g->getNode(i);
+			node* goal = g->getNode(j);
+			int numSegments;
+			path* expected = full->getPath(map, start, goal);
+			path* p = streamPath(&streamed, start, goal, numSegments);
+			assertSamePath(expected, p);
+			if(numSegments > maxSegments)
+				maxSegments = numSegments;
+			delete expected;
+			delete p;
+		}
+	CPPUNIT_ASSERT_MESSAGE("no path was streamed in more than one segment", 
+			maxSegments > 1);
+	delete full;
+}
+
+void StreamingHierarchicalSearchTest::thinkReturnsZeroOnceThePlanIsExhausted()
+{
+	StreamingHierarchicalSearch streamed(newSearch());
+	node* start = map->getNodeFromMap(2, 1);
+	node* goal = map->getNodeFromMap(18, 8);
+
+	int numSegments;
+	path* p = streamPath(&streamed, start, goal, numSegments);
+	CPPUNIT_ASSERT_MESSAGE("no path found", p != 0);
+	CPPUNIT_ASSERT_MESSAGE("path does not end at the goal", 
+			p->tail()->n == goal);
+	CPPUNIT_ASSERT_MESSAGE("think returned a segment after the plan ended", 
+			streamed.think() == 0);
+	delete p;
+}
+
+// a unit which changes its goal part way along a path follows a new plan 
+// from wherever it has got to
+void StreamingHierarchicalSearchTest::newGoalStartsANewPlan()
+{
+	HierarchicalSearch* full = newSearch();
+	StreamingHierarchicalSearch streamed(newSearch());
+	node* start = map->getNodeFromMap(2, 1);
+	node* goal = map->getNodeFromMap(18, 8);
+	node* newgoal = map->getNodeFromMap(2, 9);
+
+	path* first = streamed.getPath(map, start, goal);
+	CPPUNIT_ASSERT_MESSAGE("no path found", first != 0);
+	node* current = first->tail()->n;
+	CPPUNIT_ASSERT_MESSAGE("path was not streamed", current != goal);
+
+	int numSegments;
+	path* expected = full->getPath(map, current, newgoal);
+	path* p = streamPath(&streamed, current, newgoal, numSegments);
+	assertSamePath(expected, p);
+
+	delete first;
+	delete expected;
+	delete p;
+	delete full;
+}
@@ -0,0 +1,39 @@
+#ifndef STREAMINGHIERARCHICALSEARCHTEST_H
+#define STREAMINGHIERARCHICALSEARCHTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class HierarchicalSearch;
+class HPAClusterAbstraction;
+class StreamingHierarchicalSearch;
+class node;
+class path;
+class StreamingHierarchicalSearchTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( StreamingHierarchicalSearchTest );
+
+	CPPUNIT_TEST( streamedPathIsTheSameAsTheFullyRefinedPath );
+	CPPUNIT_TEST( thinkReturnsZeroOnceThePlanIsExhausted );
+	CPPUNIT_TEST( newGoalStartsANewPlan );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void streamedPathIsTheSameAsTheFullyRefinedPath();
+		void thinkReturnsZeroOnceThePlanIsExhausted();
+		void newGoalStartsANewPlan();
+
+	private:
+		HierarchicalSearch* newSearch();
+		path* streamPath(StreamingHierarchicalSearch* search, node* start, 
+				node* goal, int& numSegments);
+		void assertSamePath(path* expected, path* p);
+
+		HPAClusterAbstraction* map;
+};
+
+#endif
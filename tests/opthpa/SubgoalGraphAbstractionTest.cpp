@@ -0,0 +1,107 @@
+#include "SubgoalGraphAbstractionTest.h"
+
+#include "EdgeFactory.h"
+#include "FlexibleAStar.h"
+#include "HierarchicalSearch.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "NodeFactory.h"
+#include "OctileHeuristic.h"
+#include "PathComparison.h"
+#include "SubgoalGraphAbstraction.h"
+#include "SubgoalInsertionPolicy.h"
+#include "SubgoalRefinementPolicy.h"
+#include "graph.h"
+#include "map.h"
+#include "path.h"
+#include "TestConstants.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SubgoalGraphAbstractionTest );
+
+void SubgoalGraphAbstractionTest::setUp()
+{
+	map = new SubgoalGraphAbstraction(new Map(hpastartest.c_str()), 
+			new NodeFactory(), new EdgeFactory());
+}
+
+void SubgoalGraphAbstractionTest::tearDown()
+{
+	delete map;
+}
+
+void SubgoalGraphAbstractionTest::constructorPlacesSubgoalsAtObstacleCornersButNotBesideWalls()
+{
+	CPPUNIT_ASSERT_MESSAGE("no subgoal beside the end of a wall", 
+			map->isSubgoal(map->getNodeFromMap(1, 2)));
+	CPPUNIT_ASSERT_MESSAGE("no subgoal beside the end of a wall", 
+			map->isSubgoal(map->getNodeFromMap(0, 3)));
+	CPPUNIT_ASSERT_MESSAGE("subgoal beside the middle of a wall", 
+			!map->isSubgoal(map->getNodeFromMap(3, 2)));
+	CPPUNIT_ASSERT_MESSAGE("subgoal away from any obstacle", 
+			!map->isSubgoal(map->getNodeFromMap(2, 1)));
+}
+
+void SubgoalGraphAbstractionTest::constructorConnectsEachSubgoalToItsParent()
+{
+	graph* g = map->getAbstractGraph(0);
+	graph* absg = map->getAbstractGraph(1);
+
+	int numSubgoals = 0;
+	for(int i=0; i<g->getNumNodes(); i++)
+	{
+		node* n = g->getNode(i);
+		if(!map->isSubgoal(n))
+		{
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("location which is not a subgoal has a parent", 
+					-1L, n->getLabelL(kParent));
+			continue;
+		}
+
+		numSubgoals++;
+		node* parent = absg->getNode(n->getLabelL(kParent));
+		CPPUNIT_ASSERT_MESSAGE("subgoal has no parent", parent != 0);
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("parent has wrong x coordinate", 
+				n->getLabelL(kFirstData), parent->getLabelL(kFirstData));
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("parent has wrong y coordinate", 
+				n->getLabelL(kFirstData+1), parent->getLabelL(kFirstData+1));
+		CPPUNIT_ASSERT_EQUAL_MESSAGE("parent has wrong abstraction level", 
+				1L, parent->getLabelL(kAbstractionLevel));
+	}
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of nodes in the subgoal graph", 
+			numSubgoals, absg->getNumNodes());
+}
+
+void SubgoalGraphAbstractionTest::insertThenRemoveLeavesTheSubgoalGraphUnchanged()
+{
+	graph* absg = map->getAbstractGraph(1);
+	int numNodes = absg->getNumNodes();
+	int numEdges = absg->getNumEdges();
+
+	SubgoalInsertionPolicy policy(map);
+	node* n = map->getNodeFromMap(2, 1);
+	node* absn = policy.insert(n);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("inserted node not added to the subgoal graph", 
+			numNodes+1, absg->getNumNodes());
+	CPPUNIT_ASSERT_MESSAGE("inserted node not connected to any subgoal", 
+			absn->getNumEdges() > 0);
+
+	policy.remove(absn);
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of nodes after remove", 
+			numNodes, absg->getNumNodes());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong number of edges after remove", 
+			numEdges, absg->getNumEdges());
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("removed node still has a parent", 
+			-1L, n->getLabelL(kParent));
+}
+
+// paths are checked against those found by A* on the grid
+void SubgoalGraphAbstractionTest::getPathReturnsAnOptimalPathBetweenEveryPairOfLocations()
+{
+	HierarchicalSearch search(new SubgoalInsertionPolicy(map), 
+			new FlexibleAStar(new IncidentEdgesExpansionPolicy(map), 
+				new OctileHeuristic()), 
+			new SubgoalRefinementPolicy(map));
+	FlexibleAStar astar(new IncidentEdgesExpansionPolicy(map), new OctileHeuristic());
+
+	PathComparison::assertOptimalPaths(map, &astar, &search, 
+			map->getAbstractGraph(0), true);
+}
@@ -0,0 +1,32 @@
+#ifndef SUBGOALGRAPHABSTRACTIONTEST_H
+#define SUBGOALGRAPHABSTRACTIONTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class SubgoalGraphAbstraction;
+class SubgoalGraphAbstractionTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( SubgoalGraphAbstractionTest );
+
+	CPPUNIT_TEST( constructorPlacesSubgoalsAtObstacleCornersButNotBesideWalls );
+	CPPUNIT_TEST( constructorConnectsEachSubgoalToItsParent );
+	CPPUNIT_TEST( insertThenRemoveLeavesTheSubgoalGraphUnchanged );
+	CPPUNIT_TEST( getPathReturnsAnOptimalPathBetweenEveryPairOfLocations );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void constructorPlacesSubgoalsAtObstacleCornersButNotBesideWalls();
+		void constructorConnectsEachSubgoalToItsParent();
+		void insertThenRemoveLeavesTheSubgoalGraphUnchanged();
+		void getPathReturnsAnOptimalPathBetweenEveryPairOfLocations();
+
+	private:
+		SubgoalGraphAbstraction* map;
+};
+
+#endif
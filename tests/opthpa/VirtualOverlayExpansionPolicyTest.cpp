@@ -0,0 +1,248 @@
+#include "VirtualOverlayExpansionPolicyTest.h"
+
+#include "EmptyClusterAbstraction.h"
+#include "EmptyClusterFactory.h"
+#include "EmptyClusterInsertionPolicy.h"
+#include "FlexibleAStar.h"
+#include "HierarchicalSearch.h"
+#include "IncidentEdgesExpansionPolicy.h"
+#include "MacroEdgeFactory.h"
+#include "MacroNode.h"
+#include "MacroNodeFactory.h"
+#include "OctileDistanceRefinementPolicy.h"
+#include "OctileHeuristic.h"
+#include "PathComparison.h"
+#include "ProblemInstance.h"
+#include "RRExpansionPolicy.h"
+#include "VirtualOverlayExpansionPolicy.h"
+#include "graph.h"
+#include "map.h"
+#include "path.h"
+#include "TestConstants.h"
+#include <sstream>
+
+CPPUNIT_TEST_SUITE_REGISTRATION( VirtualOverlayExpansionPolicyTest );
+
+void VirtualOverlayExpansionPolicyTest::setUp()
+{
+	map = new EmptyClusterAbstraction(new Map(maplocation.c_str()), 
+			new EmptyClusterFactory(), new MacroNodeFactory(), 
+			new MacroEdgeFactory());
+	map->buildClusters();
+	map->buildEntrances();
+	insertion = 0;
+}
+
+void VirtualOverlayExpansionPolicyTest::tearDown()
+{
+	delete map;
+}
+
+// RSR, set up as in hog. The insertion policy is owned by the search.
+HierarchicalSearch* VirtualOverlayExpansionPolicyTest::newRoomSearch()
+{
+	insertion = new EmptyClusterInsertionPolicy(map);
+	return new HierarchicalSearch(insertion, 
+			new FlexibleAStar(new VirtualOverlayExpansionPolicy(
+					new IncidentEdgesExpansionPolicy(map), insertion), 
+				new OctileHeuristic()),
+			new OctileDistanceRefinementPolicy(map));
+}
+
+// every node of g, with its parent label and the endpoints and weight 
+// of each incident edge
+std::string VirtualOverlayExpansionPolicyTest::describe(graph* g)
+{
+	std::stringstream desc;
+	desc << g->getNumNodes() << " " << g->getNumEdges() << std::endl;
+	node_iterator nit = g->getNodeIter();
+	for(node* n = g->nodeIterNext(nit); n; n = g->nodeIterNext(nit))
+	{
+		desc << n->getNum() << " " << n->getLabelL(kParent) << ":";
+		edge_iterator eit = n->getEdgeIter();
+		for(edge* e = n->edgeIterNext(eit); e; e = n->edgeIterNext(eit))
+			desc << " " << e->getFrom() << "-" << e->getTo() << "/" << 
+				e->getWeight();
+		desc << std::endl;
+	}
+	return desc.str();
+}
+
+void VirtualOverlayExpansionPolicyTest::searchLeavesTheAbstractGraphUnchanged()
+{
+	HierarchicalSearch* rsr = newRoomSearch();
+	graph* absg = map->getAbstractGraph(1);
+	graph* g = map->getAbstractGraph(0);
+	std::string absBefore = describe(absg);
+	std::string before = describe(g);
+
+	unsigned int numnodes = g->getNumNodes();
+	for(unsigned int i=0; i<numnodes; i+=5)
+		for(unsigned int j=1; j<numnodes; j+=3)
+		{
+			node* start = g->getNode(i);
+			node* goal = g->getNode(j);
+			delete rsr->getPath(map, start, goal);
+
+			std::stringstream err;
+			err << "graph changed by search from "<<start->getName()<<
+				" to "<<goal->getName();
+			CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), absBefore, 
+					describe(absg));
+			CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), before, 
+					describe(g));
+		}
+
+	delete rsr;
+}
+
+void VirtualOverlayExpansionPolicyTest::pathsThroughTheOverlayAreOptimal()
+{
+	FlexibleAStar astar(new IncidentEdgesExpansionPolicy(map), 
+			new OctileHeuristic());
+	HierarchicalSearch* rsr = newRoomSearch();
+
+	PathComparison::assertOptimalPaths(map, &astar, rsr, 
+			map->getAbstractGraph(0), false, 3);
+
+	delete rsr;
+}
+
+void VirtualOverlayExpansionPolicyTest::
+	expandingAVirtualNodeYieldsTheOtherVirtualNodeInTheSameRoom()
+{
+	// two tiles from the same room, neither of them on its perimeter
+	graph* g = map->getAbstractGraph(0);
+	MacroNode* start = 0;
+	MacroNode* goal = 0;
+	unsigned int numnodes = g->getNumNodes();
+	for(unsigned int i=0; i<numnodes && !goal; i++)
+	{
+		MacroNode* n = dynamic_cast<MacroNode*>(g->getNode(i));
+		if(n->getLabelL(kParent) != -1)
+			continue;
+		if(start == 0)
+			start = n;
+		else if(n->getParentClusterId() == start->getParentClusterId())
+			goal = n;
+	}
+	CPPUNIT_ASSERT_MESSAGE("no room with two interior tiles", goal != 0);
+
+	OctileHeuristic heuristic;
+	insertion = new EmptyClusterInsertionPolicy(map);
+	VirtualOverlayExpansionPolicy policy(
+			new IncidentEdgesExpansionPolicy(map), insertion);
+	node* absStart = insertion->insert(start);
+	node* absGoal = insertion->insert(goal);
+	policy.setProblemInstance(new ProblemInstance(absStart, absGoal, map, 
+				&heuristic));
+
+	graph* absg = map->getAbstractGraph(1);
+	CPPUNIT_ASSERT_MESSAGE("start was added to the abstract graph", 
+			absg->getNode(absStart->getNum()) != absStart);
+
+	int numVirtual = 0;
+	int numNeighbours = 0;
+	policy.expand(absStart);
+	for(node* n = policy.first(); n; n = policy.next())
+	{
+		numNeighbours++;
+		if(n == absGoal)
+		{
+			numVirtual++;
+			CPPUNIT_ASSERT_EQUAL_MESSAGE("wrong cost to goal", 
+					map->h(absStart, absGoal), policy.cost_to_n());
+		}
+		else
+			CPPUNIT_ASSERT_MESSAGE("neighbour is not in the abstract graph", 
+					absg->getNode(n->getNum()) == n);
+	}
+	CPPUNIT_ASSERT_EQUAL_MESSAGE("goal is not a neighbour of start", 1, 
+			numVirtual);
+	CPPUNIT_ASSERT_MESSAGE("start has no perimeter neighbours", 
+			numNeighbours > 1);
+
+	insertion->remove(absGoal);
+	insertion->remove(absStart);
+	delete insertion;
+}
+
+// CSC2F with perimeter and branching factor reduction, as for err_pr_bfr
+EmptyClusterAbstraction* VirtualOverlayExpansionPolicyTest::newReducedRooms(
+		bool allowDiagonals, bool implicitSecondaryEdges)
+{
+	EmptyClusterAbstraction* rooms = new EmptyClusterAbstraction(
+			new Map(csc2f.c_str()), new EmptyClusterFactory(), 
+			new MacroNodeFactory(), new MacroEdgeFactory(), allowDiagonals, 
+			true, true);
+	rooms->setImplicitSecondaryEdges(implicitSecondaryEdges);
+	rooms->buildClusters();
+	rooms->buildEntrances();
+	return rooms;
+}
+
+// RSR with RRExpansionPolicy, set up as in hog
+HierarchicalSearch* VirtualOverlayExpansionPolicyTest::newReducedRoomSearch(
+		EmptyClusterAbstraction* m)
+{
+	EmptyClusterInsertionPolicy* ins = new EmptyClusterInsertionPolicy(m);
+	return new HierarchicalSearch(ins, 
+			new FlexibleAStar(new VirtualOverlayExpansionPolicy(
+					new RRExpansionPolicy(m), ins), new OctileHeuristic()),
+			new OctileDistanceRefinementPolicy(m));
+}
+
+// paths between the same pairs of locations cost as much whether the
+// secondary edges are stored or generated by 
+// EmptyCluster::getSecondaryNeighbours
+void VirtualOverlayExpansionPolicyTest::assertSameCosts(bool allowDiagonals)
+{
+	EmptyClusterAbstraction* stored = newReducedRooms(allowDiagonals, false);
+	EmptyClusterAbstraction* implicit = newReducedRooms(allowDiagonals, true);
+	CPPUNIT_ASSERT_MESSAGE("no secondary edges left out", 
+			implicit->getNumAbsEdges() < stored->getNumAbsEdges());
+
+	HierarchicalSearch* storedSearch = newReducedRoomSearch(stored);
+	HierarchicalSearch* implicitSearch = newReducedRoomSearch(implicit);
+	graph* g = stored->getAbstractGraph(0);
+	unsigned int numnodes = g->getNumNodes();
+	for(unsigned int i=0; i<numnodes; i+=97)
+		for(unsigned int j=13; j<numnodes; j+=61)
+		{
+			node* start = g->getNode(i);
+			node* goal = g->getNode(j);
+			int sx = start->getLabelL(kFirstData);
+			int sy = start->getLabelL(kFirstData+1);
+			int gx = goal->getLabelL(kFirstData);
+			int gy = goal->getLabelL(kFirstData+1);
+
+			path* expected = storedSearch->getPath(stored, start, goal);
+			path* p = implicitSearch->getPath(implicit, 
+					implicit->getNodeFromMap(sx, sy), 
+					implicit->getNodeFromMap(gx, gy));
+
+			std::stringstream err;
+			err << "wrong path from ("<<sx<<", "<<sy<<") to ("<<gx<<", "<<
+				gy<<")";
+			CPPUNIT_ASSERT_EQUAL_MESSAGE(err.str().c_str(), expected == 0, 
+					p == 0);
+			if(p)
+				CPPUNIT_ASSERT_DOUBLES_EQUAL_MESSAGE(err.str().c_str(), 
+						stored->distance(expected), implicit->distance(p), 
+						0.0001);
+			delete expected;
+			delete p;
+		}
+
+	delete implicitSearch;
+	delete storedSearch;
+	delete implicit;
+	delete stored;
+}
+
+void VirtualOverlayExpansionPolicyTest::
+	implicitSecondaryEdgesGiveTheSameCostsAsStoredOnes()
+{
+	assertSameCosts(true);
+	assertSameCosts(false);
+}
@@ -0,0 +1,44 @@
+#ifndef VIRTUALOVERLAYEXPANSIONPOLICYTEST_H
+#define VIRTUALOVERLAYEXPANSIONPOLICYTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <string>
+
+class EmptyClusterAbstraction;
+class EmptyClusterInsertionPolicy;
+class HierarchicalSearch;
+class graph;
+class VirtualOverlayExpansionPolicyTest : public CPPUNIT_NS::TestFixture
+{
+	CPPUNIT_TEST_SUITE( VirtualOverlayExpansionPolicyTest );
+
+	CPPUNIT_TEST( searchLeavesTheAbstractGraphUnchanged );
+	CPPUNIT_TEST( pathsThroughTheOverlayAreOptimal );
+	CPPUNIT_TEST( expandingAVirtualNodeYieldsTheOtherVirtualNodeInTheSameRoom );
+	CPPUNIT_TEST( implicitSecondaryEdgesGiveTheSameCostsAsStoredOnes );
+
+	CPPUNIT_TEST_SUITE_END();
+
+	public:
+		void setUp();
+		void tearDown();
+
+		void searchLeavesTheAbstractGraphUnchanged();
+		void pathsThroughTheOverlayAreOptimal();
+		void expandingAVirtualNodeYieldsTheOtherVirtualNodeInTheSameRoom();
+		void implicitSecondaryEdgesGiveTheSameCostsAsStoredOnes();
+
+	private:
+		HierarchicalSearch* newRoomSearch();
+		EmptyClusterAbstraction* newReducedRooms(bool allowDiagonals, 
+				bool implicitSecondaryEdges);
+		HierarchicalSearch* newReducedRoomSearch(EmptyClusterAbstraction* m);
+		void assertSameCosts(bool allowDiagonals);
+		std::string describe(graph* g);
+
+		EmptyClusterAbstraction* map;
+		EmptyClusterInsertionPolicy* insertion;
+};
+
+#endif
@@ -0,0 +1,46 @@
+#include "PathComparison.h"
+
+#include "graph.h"
+#include "graphAbstraction.h"
+#include "path.h"
+#include "searchAlgorithm.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <sstream>
+
+void
+PathComparison::assertOptimalPath(graphAbstraction* map, 
+		searchAlgorithm* reference, searchAlgorithm* search, node* start, 
+		node* goal, graph* g)
+{
+	path* expected = reference->getPath(map, start, goal);
+	path* p = search->getPath(map, start, goal);
+
+	std::stringstream err;
+	err << "wrong path from "<<start->getName()<<" to "<<goal->getName();
+	bool ok = (expected == 0) == (p == 0);
+	if(ok && p)
+	{
+		ok = p->n == start && p->tail()->n == goal;
+		for(path* step = p; ok && g && step->next; step = step->next)
+			ok = g->findEdge(step->n->getNum(), step->next->n->getNum()) != 0;
+		double dist = map->distance(p) - map->distance(expected);
+		ok = ok && dist < 0.0001 && dist > -0.0001;
+	}
+	delete expected;
+	delete p;
+	CPPUNIT_ASSERT_MESSAGE(err.str().c_str(), ok);
+}
+
+void
+PathComparison::assertOptimalPaths(graphAbstraction* map, 
+		searchAlgorithm* reference, searchAlgorithm* search, graph* g, 
+		bool followsEdges, unsigned int stride, unsigned int goalStride, 
+		unsigned int goalOffset)
+{
+	unsigned int numnodes = g->getNumNodes();
+	for(unsigned int i=0; i<numnodes; i+=stride)
+		for(unsigned int j=goalOffset; j<numnodes; j+=goalStride)
+			assertOptimalPath(map, reference, search, g->getNode(i), 
+					g->getNode(j), followsEdges ? g : 0);
+}
@@ -0,0 +1,32 @@
+#ifndef PATHCOMPARISON_H
+#define PATHCOMPARISON_H
+
+// PathComparison.h
+//
+// Assertions for tests which check the paths found by one search against
+// those found by a reference search (usually A* on the grid graph).
+//
+// @created: 17/10/2026
+
+class graph;
+class graphAbstraction;
+class node;
+class searchAlgorithm;
+namespace PathComparison
+{
+	// Asserts that search finds a path from start to goal exactly when
+	// reference does, that the path runs from start to goal and that it
+	// costs as much as the reference path. If g is not null, each step of
+	// the path must also follow an edge of g.
+	void assertOptimalPath(graphAbstraction* map, searchAlgorithm* reference,
+			searchAlgorithm* search, node* start, node* goal, graph* g = 0);
+
+	// As ::assertOptimalPath, from every stride'th node of g to every
+	// goalStride'th node of g (starting from goalOffset).
+	void assertOptimalPaths(graphAbstraction* map, searchAlgorithm* reference,
+			searchAlgorithm* search, graph* g, bool followsEdges, 
+			unsigned int stride = 1, unsigned int goalStride = 1, 
+			unsigned int goalOffset = 0);
+}
+
+#endif
@@ -0,0 +1,96 @@
+#include "WorkerThreads.h"
+
+#include <pthread.h>
+#include <unistd.h>
+#include <vector>
+
+// 0 until set or first asked for
+static int numThreads = 0;
+
+// state shared by the threads of one call to WorkerThreads::run
+struct WorkQueue
+{
+	ParallelTask* task;
+	int numPieces;
+	int next;
+	pthread_mutex_t lock;
+};
+
+struct Worker
+{
+	WorkQueue* queue;
+	int thread;
+};
+
+static void*
+work(void* arg)
+{
+	Worker* w = (Worker*)arg;
+	WorkQueue* q = w->queue;
+	while(true)
+	{
+		pthread_mutex_lock(&q->lock);
+		int piece = q->next++;
+		pthread_mutex_unlock(&q->lock);
+		if(piece >= q->numPieces)
+			break;
+		q->task->run(piece, w->thread);
+	}
+	return 0;
+}
+
+void
+WorkerThreads::run(ParallelTask* task, int numPieces, int num)
+{
+	if(num > numPieces)
+		num = numPieces;
+	if(num <= 1)
+	{
+		for(int i=0; i<numPieces; i++)
+			task->run(i, 0);
+		return;
+	}
+
+	WorkQueue q;
+	q.task = task;
+	q.numPieces = numPieces;
+	q.next = 0;
+	pthread_mutex_init(&q.lock, 0);
+
+	std::vector<Worker> workers(num);
+	std::vector<pthread_t> threads(num);
+	std::vector<bool> started(num, false);
+	for(int i=0; i<num; i++)
+	{
+		workers[i].queue = &q;
+		workers[i].thread = i;
+	}
+
+	// thread 0 is the caller; a thread which cannot be created leaves its
+	// share of the work to the others
+	for(int i=1; i<num; i++)
+		started[i] = pthread_create(&threads[i], 0, work, &workers[i]) == 0;
+	work(&workers[0]);
+	for(int i=1; i<num; i++)
+		if(started[i])
+			pthread_join(threads[i], 0);
+
+	pthread_mutex_destroy(&q.lock);
+}
+
+int
+WorkerThreads::getNumThreads()
+{
+	if(numThreads == 0)
+	{
+		long online = sysconf(_SC_NPROCESSORS_ONLN);
+		numThreads = online > 0 ? (int)online : 1;
+	}
+	return numThreads;
+}
+
+void
+WorkerThreads::setNumThreads(int num)
+{
+	numThreads = num > 0 ? num : 1;
+}
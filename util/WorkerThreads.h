@@ -0,0 +1,44 @@
+#ifndef WORKERTHREADS_H
+#define WORKERTHREADS_H
+
+// WorkerThreads.h
+//
+// Runs independent pieces of work on POSIX threads. The pieces are
+// numbered 0..n-1 and handed to whichever thread is idle, so the order in
+// which they finish is not fixed. Tasks write their results into slots
+// indexed by piece (or into per-thread buffers) and the caller combines
+// them afterwards in piece order; results then do not depend on the
+// number of threads.
+//
+// Tasks must not throw and must not change state another piece reads.
+// HOG graphs, nodes and abstractions are not synchronised: worker threads
+// may read them but every change has to wait until ::run returns.
+//
+// @created: 17/10/2026
+
+class ParallelTask
+{
+	public:
+		virtual ~ParallelTask() { }
+
+		// does one piece of work. thread is in [0, numThreads) and is
+		// never shared by two pieces running at the same time.
+		virtual void run(int piece, int thread) = 0;
+};
+
+class WorkerThreads
+{
+	public:
+		// runs every piece of task and returns once all are done. At most
+		// numThreads threads are used, the calling thread among them.
+		static void run(ParallelTask* task, int numPieces, int numThreads);
+		static void run(ParallelTask* task, int numPieces)
+		{ run(task, numPieces, getNumThreads()); }
+
+		// the number of threads ::run uses when none is given; by default
+		// the number of processors online.
+		static int getNumThreads();
+		static void setNumThreads(int num);
+};
+
+#endif
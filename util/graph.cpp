@@ -29,6 +29,8 @@
 #include <cstdlib>
 #include "graph.h"
 #include "constants.h"
+#include "ClearanceGrid.h"
+#include "map.h"
 
 #include <vector>
 #include <cstdlib>
@@ -711,8 +713,7 @@ node::node(const char *n)
 
 	clusterid = -1; // no parent cluster set
 	terraintype=0; // no default terraintype assumed (untraversable node)
-	for(int i=0;i<3;i++) 	// init clvals. everything is zero unless otherwise specified.
-		clearance[i]=0;	
+	clearanceGrid = 0; // clearance is zero until a grid is set
 
 	drawColor=0;
 }
@@ -730,6 +731,10 @@ node::node(const node* n)
 	drawColor=0;
 	markedEdge = 0;
 	backpointer = 0;
+
+	clusterid = -1;
+	terraintype = n->terraintype;
+	clearanceGrid = n->clearanceGrid;
 }
 
 // clones all labels, all annotations, nodeNum, weight etc. DOES NOT clone edges or parentclusterid
@@ -741,7 +746,7 @@ graph_object *node::clone() const
   
   n->setParentCluster(-1); // cloned node is not assigned to any cluster intially
   n->setTerrainType(terraintype);
-  for(int i=0; i<3;i++) n->clearance[i] = clearance[i];
+  n->clearanceGrid = clearanceGrid;
 
   n->keyLabel = keyLabel;
   n->nodeNum = nodeNum;
@@ -758,10 +763,9 @@ graph_object *node::clone() const
 		if a node is traversable, minval = 1, maxval = unbounded.
 		else, minvalue = maxvalue = 0. 
 			
-		The number of annotations for each node is a function of the # of basic terrain types. More precisely, 
-		total # of node annotations = (2^n - n), where n is the number of basic terrains.
-		
-		Supported terrains: kGround, kTrees, kGround|kTrees.
+		The annotations are not stored on the node but in the ClearanceGrid of its abstraction (see setClearanceGrid), at the 
+		node's (x, y) location; the node and every copy of it share the values of that tile. Any capability the grid was built 
+		for is supported; values are capped at the grid's maximum agent size.
 */
 void node::setClearance(int terraintype, int value)
 {
@@ -775,45 +779,25 @@ void node::setClearance(int terraintype, int value)
 		if(debuginfo) cout << "node::setClearance: Clearance value < 0 ("<<terraintype<<")"<<endl;
 		return;
 	}
-	
-	switch(terraintype)
+	if(clearanceGrid == 0)
 	{
-		case 0x04:
-			clearance[0] = value;
-			break;
-		case 0x40:
-			clearance[1] = value;
-			break;
-		case 0x44:
-			clearance[2] = value;
-			break;
-		default:
-			if(debuginfo) cout << "node::setClearance: Invalid terrain type ("<<terraintype<<")"<<endl;
-			break;
+		if(debuginfo) cout << "node::setClearance: no clearance grid ("<<terraintype<<")"<<endl;
+		return;
 	}
-
+	
+	clearanceGrid->setClearance(getLabelL(kFirstData), getLabelL(kFirstData+1), terraintype, value);
 }
 
+/* getClearance
+	The clearance of the node's tile for the given capability; 0 if the node has no clearance grid or the grid was not
+	built for the capability.
+*/
 int node::getClearance(int terrain)
 {
-	int cv = 0;
-	switch(terrain)
-	{
-		case 0x04:
-			cv = clearance[0];
-			break;
-		case 0x40:
-			cv = clearance[1];
-			break;
-		case 0x44:
-			cv = clearance[2];
-			break;
-		default:
-			if(debuginfo) cout << "node::getClearance: Invalid terrain type ("<<terraintype<<")"<<endl;
-			break;
-	}
+	if(clearanceGrid == 0)
+		return 0;
 
-	return cv;
+	return clearanceGrid->getClearance(getLabelL(kFirstData), getLabelL(kFirstData+1), terrain);
 }
 
 int node::getTerrainType()
@@ -821,23 +805,15 @@ int node::getTerrainType()
 	return terraintype;
 }
 
+// any terrain a tile can have, or a combination of such terrains
 void node::setTerrainType(int terrain)
 {	
-	switch(terrain)
+	if(terrain <= kOutOfBounds2 || terrain == kUndefined)
 	{
-		case 0x04:
-			terraintype = terrain;
-			break;
-		case 0x40:
-			terraintype = terrain;
-			break;
-		case 0x44:
-			terraintype = terrain;
-			break;
-		default:
-			if(debuginfo) cout << "node::setTerraintype: Invalid terrain type ("<<terraintype<<")"<<endl;
-			break;
+		if(debuginfo) cout << "node::setTerraintype: Invalid terrain type ("<<terrain<<")"<<endl;
+		return;
 	}
+	terraintype = terrain;
 }
 
 int node::getParentCluster()
@@ -33,6 +33,7 @@
 class graph;
 class node;
 class edge;
+class ClearanceGrid;
 
 typedef std::vector<edge *>::const_iterator edge_iterator;
 typedef std::vector<node *>::const_iterator node_iterator;
@@ -250,6 +251,8 @@ public:
   /* AHA* extensions */
   void setClearance(int terraintype, int value);
   int getClearance(int terrain);
+  void setClearanceGrid(ClearanceGrid* grid) { clearanceGrid = grid; }
+  ClearanceGrid* getClearanceGrid() { return clearanceGrid; }
   void setTerrainType(int terrain);
   int getTerrainType();
   void setParentCluster(int clusterid);
@@ -271,7 +274,7 @@ private:
   int keyLabel;
   double width;
   
-  int clearance[3];
+  ClearanceGrid* clearanceGrid; // holds the clearance of the node's tile
   int terraintype;
   int clusterid;
 
@@ -65,6 +65,7 @@ Map::Map(long _width, long _height)
 	tileSet = kFall;
 	map_name[0] = 0;
 	sizeMultiplier = 1;
+	keepTerrain = false;
 	land = new Tile *[width];
 	//	for (int x = 0; x < 8; x++)
 	//		g[x] = 0;
@@ -88,6 +89,7 @@ Map::Map(Map *m)
 	tileSet = m->tileSet;
 	strncpy(map_name, m->map_name, 128);
 	sizeMultiplier = m->sizeMultiplier;
+	keepTerrain = m->keepTerrain;
 	width = m->width;
 	height = m->height;
 	
@@ -108,10 +110,13 @@ Map::Map(Map *m)
 * Create a new map by loading it from a file.
 *
 * Creates a new map and initializes it with the file passed to it.
+* Octile maps treat swamp, water and tree tiles as obstacles unless
+* keepTerrain is set.
 */
-Map::Map(const char *filename)
+Map::Map(const char *filename, bool _keepTerrain)
 {
 	sizeMultiplier = 1;
+	keepTerrain = _keepTerrain;
 	land = 0;
 	load(filename);
 	tileSet = kFall;
@@ -125,6 +130,7 @@ Map::Map(const char *filename)
 Map::Map(FILE *f)
 {
 	sizeMultiplier = 1;
+	keepTerrain = false;
 	map_name[0] = 0;
 	land = 0;
 	load(f);
@@ -139,6 +145,7 @@ Map::Map(FILE *f)
 Map::Map(std::istringstream &/*data*/)
 {
 	sizeMultiplier = 1;
+	keepTerrain = false;
 	dList = 0;
 	tileSet = kFall;
 }
@@ -303,42 +310,27 @@ void Map::loadOctile(FILE *f, int high, int wide)
 			char what;
 			fscanf(f, "%c", &what);
 			char upperWhat = toupper(what);
-	//		if(upperWhat == '@')
-	//			upperWhat = 'W';
-				
-// dharabor: disabled terrain types (only traversable and obstacle exists)
+
+// dharabor: by default only traversable and obstacle tiles exist;
+// swamp, water and trees are kept only for maps loaded with keepTerrain
+			tTerrain terrain;
 			switch (upperWhat)
 			{
 				case 'S':
+					terrain = keepTerrain ? kSwamp : kOutOfBounds; break;
 				case 'W': 
+					terrain = keepTerrain ? kWater : kOutOfBounds; break;
 				case 'T':
+					terrain = keepTerrain ? kTrees : kOutOfBounds; break;
 				case '@':
 				case 'O':
-					for (int r = 0; r < sizeMultiplier; r++)
-						for (int s = 0; s < sizeMultiplier; s++)
-							setTerrainType(x*sizeMultiplier+r, y*sizeMultiplier+s,
-														 kOutOfBounds); break;
-//				case 'S':
-//					for (int r = 0; r < sizeMultiplier; r++)
-//						for (int s = 0; s < sizeMultiplier; s++)
-//							setTerrainType(x*sizeMultiplier+r, y*sizeMultiplier+s,
-//														 kSwamp); break;
-//				case 'W':
-//					for (int r = 0; r < sizeMultiplier; r++)
-//						for (int s = 0; s < sizeMultiplier; s++)
-//							setTerrainType(x*sizeMultiplier+r, y*sizeMultiplier+s,
-//														 kWater); break;
-//				case 'T':
-//					for (int r = 0; r < sizeMultiplier; r++)
-//						for (int s = 0; s < sizeMultiplier; s++)
-//							setTerrainType(x*sizeMultiplier+r, y*sizeMultiplier+s,
-//														 kTrees); break;
+					terrain = kOutOfBounds; break;
 				default:
-					for (int r = 0; r < sizeMultiplier; r++)
-						for (int s = 0; s < sizeMultiplier; s++)
-							setTerrainType(x*sizeMultiplier+r, y*sizeMultiplier+s,
-														 kGround); break;
+					terrain = kGround; break;
 			}
+			for (int r = 0; r < sizeMultiplier; r++)
+				for (int s = 0; s < sizeMultiplier; s++)
+					setTerrainType(x*sizeMultiplier+r, y*sizeMultiplier+s, terrain);
 			for (int r = 0; r < sizeMultiplier; r++)
 				for (int s = 0; s < sizeMultiplier; s++)
 				{
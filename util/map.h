@@ -151,7 +151,7 @@ class Map {
 
 public:
   Map(long width, long height);
-  Map(const char *filename);
+  Map(const char *filename, bool keepTerrain = false);
 	Map(Map *);
 	Map(FILE *);
   Map(std::istringstream &data);
@@ -246,6 +246,7 @@ private:
   GLuint dList;
   bool updated;
 	int sizeMultiplier;
+	bool keepTerrain; // octile maps: load S, W and T tiles as kSwamp, kWater and kTrees, not obstacles
   int revision;
 	char map_name[128];
 	tMapType mapType;
@@ -27,11 +27,12 @@
 #include "path.h"
 #include "constants.h"
 
+// paths are also made by searches on worker threads (see WorkerThreads.h)
 int path::ref = 0;
 path::path(node* _n, path* _next) : n(_n), next(_next)
 {
 	//std::cout << "new path()"<<std::endl;
-	ref++;
+	__sync_add_and_fetch(&ref, 1);
 }
 
 path::~path() 
@@ -39,7 +40,7 @@ path::~path()
 	//std::cout << "delete path"<<std::endl; 
 	if (next != NULL)
 	   	delete next; 
-	ref--;
+	__sync_sub_and_fetch(&ref, 1);
 }
 
 // Returns the length of the path -- number of steps